@@ -1,6 +1,7 @@
 #include "../src/meshoptimizer.h"
 
 #include <assert.h>
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -329,6 +330,11 @@ void optCache(Mesh& mesh)
 	meshopt_optimizeVertexCache(&mesh.indices[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size());
 }
 
+void optCachePar(Mesh& mesh)
+{
+	meshopt_optimizeVertexCacheParallel(&mesh.indices[0], &mesh.indices[0], mesh.indices.size(), &mesh.vertices[0].px, mesh.vertices.size(), sizeof(Vertex), 8, NULL, NULL);
+}
+
 void optCacheFifo(Mesh& mesh)
 {
 	meshopt_optimizeVertexCacheFifo(&mesh.indices[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), kCacheSize);
@@ -547,23 +553,28 @@ void simplifyComplete(const Mesh& mesh)
 
 	lods[0] = mesh.indices;
 
+	size_t target_index_counts[lod_count - 1];
+	float target_errors[lod_count - 1];
+
 	for (size_t i = 1; i < lod_count; ++i)
 	{
-		std::vector<unsigned int>& lod = lods[i];
-
 		float threshold = powf(0.7f, float(i));
-		size_t target_index_count = size_t(mesh.indices.size() * threshold) / 3 * 3;
-		float target_error = 1e-2f;
 
-		// we can simplify all the way from base level or from the last result
-		// simplifying from the base level sometimes produces better results, but simplifying from last level is faster
-		const std::vector<unsigned int>& source = lods[i - 1];
+		target_index_counts[i - 1] = size_t(mesh.indices.size() * threshold) / 3 * 3;
+		target_errors[i - 1] = 1e-2f;
+	}
+
+	// all levels are generated in one call which reuses simplifier state between levels
+	// this is faster than simplifying each level from the last result, and measures errors relative to the base level
+	std::vector<unsigned int> chain(mesh.indices.size() * (lod_count - 1));
+	size_t chain_index_counts[lod_count - 1];
 
-		if (source.size() < target_index_count)
-			target_index_count = source.size();
+	meshopt_simplifyLods(&chain[0], chain_index_counts, NULL, &mesh.indices[0], mesh.indices.size(), &mesh.vertices[0].px, mesh.vertices.size(), sizeof(Vertex), NULL, 0, NULL, 0, NULL, target_index_counts, target_errors, lod_count - 1);
 
-		lod.resize(source.size());
-		lod.resize(meshopt_simplify(&lod[0], &source[0], source.size(), &mesh.vertices[0].px, mesh.vertices.size(), sizeof(Vertex), target_index_count, target_error));
+	for (size_t i = 1, offset = 0; i < lod_count; ++i)
+	{
+		lods[i].assign(chain.begin() + offset, chain.begin() + offset + chain_index_counts[i - 1]);
+		offset += chain_index_counts[i - 1];
 	}
 
 	double middle = timestamp();
@@ -645,7 +656,7 @@ void simplifyComplete(const Mesh& mesh)
 
 void simplifyClusters(const Mesh& mesh, float threshold = 0.2f)
 {
-	// note: we use clusters that are larger than normal to give simplifier room to work; in practice you'd use cluster groups merged from smaller clusters and build a cluster DAG
+	// note: we use clusters that are larger than normal to give simplifier room to work; in practice you'd use cluster groups merged from smaller clusters and build a cluster DAG (see simplifyClusterLod)
 	const size_t max_vertices = 255;
 	const size_t max_triangles = 512;
 
@@ -698,6 +709,50 @@ void simplifyClusters(const Mesh& mesh, float threshold = 0.2f)
 	    (end - middle) * 1000, (middle - start) * 1000);
 }
 
+void simplifyClusterLod(const Mesh& mesh)
+{
+	const size_t max_vertices = 64;
+	const size_t max_triangles = 124;
+	const size_t group_size = 8;
+
+	double start = timestamp();
+
+	size_t max_clusters = meshopt_buildClusterLodBound(mesh.indices.size(), max_vertices, max_triangles);
+	std::vector<meshopt_ClusterLod> clusters(max_clusters);
+	std::vector<unsigned int> cluster_vertices(max_clusters * max_vertices);
+	std::vector<unsigned char> cluster_triangles(max_clusters * max_triangles * 3);
+
+	clusters.resize(meshopt_buildClusterLod(&clusters[0], &cluster_vertices[0], &cluster_triangles[0], &mesh.indices[0], mesh.indices.size(), &mesh.vertices[0].px, mesh.vertices.size(), sizeof(Vertex), max_vertices, max_triangles, group_size, NULL, NULL));
+
+	double end = timestamp();
+
+	float scale = meshopt_simplifyScale(&mesh.vertices[0].px, mesh.vertices.size(), sizeof(Vertex));
+
+	// clusters that are never simplified further form the coarsest cut of the hierarchy
+	size_t levels = 0, root_clusters = 0, root_triangles = 0;
+	float error = 0.f;
+
+	for (size_t i = 0; i < clusters.size(); ++i)
+	{
+		const meshopt_ClusterLod& cluster = clusters[i];
+
+		levels = cluster.level + 1 > levels ? cluster.level + 1 : levels;
+
+		if (cluster.parent_error == FLT_MAX)
+		{
+			root_clusters++;
+			root_triangles += cluster.triangle_count;
+			error = cluster.self_error > error ? cluster.self_error : error;
+		}
+	}
+
+	printf("%-9s: %d triangles => %d clusters in %d levels, coarsest cut %d clusters with %d triangles (%.2f%% deviation) in %.2f msec\n",
+	    "SimplifyD", // D for DAG
+	    int(mesh.indices.size() / 3), int(clusters.size()), int(levels),
+	    int(root_clusters), int(root_triangles), error / scale * 100,
+	    (end - start) * 1000);
+}
+
 void optimize(const Mesh& mesh, const char* name, void (*optf)(Mesh& mesh))
 {
 	Mesh copy = mesh;
@@ -843,14 +898,17 @@ void encodeVertex(const Mesh& mesh, const char* pvn)
 	    (double(result.size() * sizeof(PV)) / (1 << 30)) / (end - middle));
 }
 
-void stripify(const Mesh& mesh, bool use_restart, char desc)
+void stripify(const Mesh& mesh, bool use_restart, char desc, size_t window_size = 0)
 {
 	unsigned int restart_index = use_restart ? ~0u : 0;
 
 	// note: input mesh is assumed to be optimized for vertex cache and vertex fetch
 	double start = timestamp();
 	std::vector<unsigned int> strip(meshopt_stripifyBound(mesh.indices.size()));
-	strip.resize(meshopt_stripify(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index));
+	if (window_size)
+		strip.resize(meshopt_stripifyWindowed(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index, window_size));
+	else
+		strip.resize(meshopt_stripify(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index));
 	double end = timestamp();
 
 	Mesh copy = mesh;
@@ -957,6 +1015,26 @@ void meshlets(const Mesh& mesh, bool scan)
 	    scan ? 'S' : ' ',
 	    int(meshlets.size()), avg_vertices, avg_triangles, int(not_full), (end - start) * 1000);
 
+	if (meshlets.size())
+	{
+		std::vector<unsigned char> mbuf(meshopt_encodeMeshletsBound(meshlets.size(), max_vertices, max_triangles));
+		mbuf.resize(meshopt_encodeMeshlets(&mbuf[0], mbuf.size(), &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0]));
+
+		std::vector<meshopt_Meshlet> dmeshlets(meshlets.size());
+		std::vector<unsigned int> dvertices(meshlet_vertices.size());
+		std::vector<unsigned char> dtriangles(meshlet_triangles.size());
+
+		double startd = timestamp();
+		int dres = meshopt_decodeMeshlets(&dmeshlets[0], dmeshlets.size(), &dvertices[0], dvertices.size(), &dtriangles[0], dtriangles.size(), &mbuf[0], mbuf.size());
+		double endd = timestamp();
+
+		size_t raw_size = meshlets.size() * sizeof(meshopt_Meshlet) + meshlet_vertices.size() * sizeof(unsigned int) + meshlet_triangles.size();
+
+		printf("MeshletC%c: %.1f bits/triangle (%.1f%% of raw); decode %.2f msec (%d)\n",
+		    scan ? 'S' : ' ',
+		    double(mbuf.size() * 8) / double(mesh.indices.size() / 3), double(mbuf.size()) / double(raw_size) * 100, (endd - startd) * 1000, dres);
+	}
+
 	float camera[3] = {100, 100, 100};
 
 	size_t rejected = 0;
@@ -1246,6 +1324,7 @@ void process(const char* path)
 	optimize(mesh, "Original", optNone);
 	optimize(mesh, "Random", optRandomShuffle);
 	optimize(mesh, "Cache", optCache);
+	optimize(mesh, "CachePar", optCachePar);
 	optimize(mesh, "CacheFifo", optCacheFifo);
 	optimize(mesh, "CacheStrp", optCacheStrip);
 	optimize(mesh, "Overdraw", optOverdraw);
@@ -1264,6 +1343,7 @@ void process(const char* path)
 	stripify(copy, false, ' ');
 	stripify(copy, true, 'R');
 	stripify(copystrip, true, 'S');
+	stripify(copy, false, 'W', 64);
 
 	meshlets(copy, false);
 	meshlets(copy, true);
@@ -1289,6 +1369,7 @@ void process(const char* path)
 	simplifyComplete(mesh);
 	simplifyPoints(mesh);
 	simplifyClusters(mesh);
+	simplifyClusterLod(mesh);
 
 	spatialSort(mesh);
 	spatialSortTriangles(mesh);
@@ -1305,6 +1386,7 @@ void processDev(const char* path)
 
 	simplify(mesh);
 	simplifyClusters(mesh);
+	simplifyClusterLod(mesh);
 }
 
 int main(int argc, char** argv)
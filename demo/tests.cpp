@@ -1,6 +1,7 @@
 #include "../src/meshoptimizer.h"
 
 #include <assert.h>
+#include <float.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -80,6 +81,25 @@ static void decodeIndexV1()
 	assert(memcmp(decoded, kIndexBufferTricky, sizeof(kIndexBufferTricky)) == 0);
 }
 
+static void decodeIndexOffset()
+{
+	const size_t index_count = sizeof(kIndexBufferTricky) / sizeof(kIndexBufferTricky[0]);
+
+	std::vector<unsigned char> buffer(kIndexDataV1, kIndexDataV1 + sizeof(kIndexDataV1));
+
+	unsigned int decoded[index_count];
+	assert(meshopt_decodeIndexBufferOffset(decoded, index_count, 4, 1000, &buffer[0], buffer.size()) == 0);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(decoded[i] == kIndexBufferTricky[i] + 1000);
+
+	unsigned short decoded16[index_count];
+	assert(meshopt_decodeIndexBufferOffset(decoded16, index_count, 2, 1000, &buffer[0], buffer.size()) == 0);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(decoded16[i] == kIndexBufferTricky[i] + 1000);
+}
+
 static void decodeIndex16()
 {
 	const size_t index_count = sizeof(kIndexBuffer) / sizeof(kIndexBuffer[0]);
@@ -232,6 +252,19 @@ static void decodeIndexSequence()
 	assert(memcmp(decoded, kIndexSequence, sizeof(kIndexSequence)) == 0);
 }
 
+static void decodeIndexSequenceOffset()
+{
+	const size_t index_count = sizeof(kIndexSequence) / sizeof(kIndexSequence[0]);
+
+	std::vector<unsigned char> buffer(kIndexSequenceV1, kIndexSequenceV1 + sizeof(kIndexSequenceV1));
+
+	unsigned int decoded[index_count];
+	assert(meshopt_decodeIndexSequenceOffset(decoded, index_count, 4, 1000, &buffer[0], buffer.size()) == 0);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(decoded[i] == kIndexSequence[i] + 1000);
+}
+
 static void decodeIndexSequence16()
 {
 	const size_t index_count = sizeof(kIndexSequence) / sizeof(kIndexSequence[0]);
@@ -291,6 +324,43 @@ static void decodeIndexSequenceMemorySafe()
 	}
 }
 
+static void decodeIndexSequencePartial()
+{
+	const size_t index_count = sizeof(kIndexSequence) / sizeof(kIndexSequence[0]);
+
+	std::vector<unsigned char> buffer(kIndexSequenceV1, kIndexSequenceV1 + sizeof(kIndexSequenceV1));
+
+	// feed the data one byte at a time, keeping unconsumed bytes around for the next call
+	unsigned int decoded[index_count];
+
+	meshopt_IndexSequenceDecoder decoder;
+	meshopt_initIndexSequenceDecoder(&decoder, index_count, 4);
+
+	std::vector<unsigned char> pending;
+
+	for (size_t i = 0; i < buffer.size(); ++i)
+	{
+		pending.push_back(buffer[i]);
+
+		size_t consumed = 0;
+		assert(meshopt_decodeIndexSequencePartial(&decoder, decoded, &pending[0], pending.size(), &consumed) == 0);
+		pending.erase(pending.begin(), pending.begin() + consumed);
+
+		// decoded indices must be final as soon as they are reported
+		assert(memcmp(decoded, kIndexSequence, decoder.index_offset * sizeof(unsigned int)) == 0);
+	}
+
+	assert(decoder.index_offset == index_count);
+	assert(meshopt_finishIndexSequenceDecoder(&decoder, &pending[0], pending.size()) == 0);
+
+	// finishing before the end of the stream must fail
+	meshopt_initIndexSequenceDecoder(&decoder, index_count, 4);
+
+	size_t consumed = 0;
+	assert(meshopt_decodeIndexSequencePartial(&decoder, decoded, &buffer[0], buffer.size() - 5, &consumed) == 0);
+	assert(meshopt_finishIndexSequenceDecoder(&decoder, &buffer[consumed], buffer.size() - 5 - consumed) < 0);
+}
+
 static void decodeIndexSequenceRejectExtraBytes()
 {
 	const size_t index_count = sizeof(kIndexSequence) / sizeof(kIndexSequence[0]);
@@ -504,6 +574,145 @@ static void decodeVertexLarge()
 	assert(memcmp(decoded, data, sizeof(data)) == 0);
 }
 
+static void decodeVertexBlocks()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned char> data(vertex_count * 16);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (unsigned char)(i * 7 + (i / 16) % 13);
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), &data[0], vertex_count, 16));
+
+	std::vector<unsigned char> index(meshopt_encodeVertexBlockIndexBound(vertex_count, 16));
+	size_t block_count = meshopt_encodeVertexBlockIndex(&index[0], index.size(), &buffer[0], buffer.size(), &data[0], vertex_count, 16);
+	assert(block_count == 4); // 256 vertices per block
+
+	// decode blocks out of order, one at a time; this must match the sequential decoder
+	std::vector<unsigned char> decoded(vertex_count * 16);
+
+	for (size_t i = block_count; i > 0; --i)
+		assert(meshopt_decodeVertexBlocks(&decoded[0], vertex_count, 16, &buffer[0], buffer.size(), &index[0], i - 1, i) == 0);
+
+	assert(decoded == data);
+
+	// decode block ranges that don't start at 0
+	std::vector<unsigned char> decoded2(vertex_count * 16);
+	assert(meshopt_decodeVertexBlocks(&decoded2[0], vertex_count, 16, &buffer[0], buffer.size(), &index[0], 1, 4) == 0);
+	assert(meshopt_decodeVertexBlocks(&decoded2[0], vertex_count, 16, &buffer[0], buffer.size(), &index[0], 0, 1) == 0);
+	assert(decoded2 == data);
+
+	// out of range blocks and short index tables must be rejected
+	assert(meshopt_decodeVertexBlocks(&decoded2[0], vertex_count, 16, &buffer[0], buffer.size(), &index[0], 0, 5) < 0);
+	assert(meshopt_encodeVertexBlockIndex(&index[0], index.size() - 1, &buffer[0], buffer.size(), &data[0], vertex_count, 16) == 0);
+
+	// corrupted offsets must be rejected
+	std::vector<unsigned char> brokenindex(index);
+	brokenindex[(4 + 16) * 2] ^= 1;
+
+	assert(meshopt_decodeVertexBlocks(&decoded2[0], vertex_count, 16, &buffer[0], buffer.size(), &brokenindex[0], 1, 2) < 0);
+}
+
+static void encodeVertexBlocks()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned char> data(vertex_count * 16);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (unsigned char)(i * 7 + (i / 16) % 13);
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), &data[0], vertex_count, 16));
+
+	size_t block_count = meshopt_getVertexBlockCount(vertex_count, 16);
+	assert(block_count == 4); // 256 vertices per block
+
+	// encode block ranges separately; concatenated results must match the sequential encoder
+	const size_t ranges[] = {0, 1, 3, 4};
+
+	std::vector<unsigned char> result;
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		size_t range_vertices = (ranges[i + 1] * 256 < vertex_count ? ranges[i + 1] * 256 : vertex_count) - ranges[i] * 256;
+
+		std::vector<unsigned char> chunk(meshopt_encodeVertexBufferBound(range_vertices, 16));
+		chunk.resize(meshopt_encodeVertexBlocks(&chunk[0], chunk.size(), &data[0], vertex_count, 16, ranges[i], ranges[i + 1]));
+		assert(!chunk.empty());
+
+		result.insert(result.end(), chunk.begin(), chunk.end());
+	}
+
+	assert(result == buffer);
+
+	// empty vertex buffers still produce header and tail
+	std::vector<unsigned char> empty(meshopt_encodeVertexBufferBound(0, 16));
+	assert(meshopt_getVertexBlockCount(0, 16) == 0);
+	assert(meshopt_encodeVertexBlocks(&empty[0], empty.size(), NULL, 0, 16, 0, 0) == meshopt_encodeVertexBuffer(&empty[0], empty.size(), NULL, 0, 16));
+}
+
+static void decodeVertexPartial()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned char> data(vertex_count * 16);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (unsigned char)(i * 7 + (i / 16) % 13);
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), &data[0], vertex_count, 16));
+
+	for (int tail = 0; tail < 2; ++tail)
+	{
+		std::vector<unsigned char> decoded(vertex_count * 16);
+
+		meshopt_VertexDecoder decoder;
+		meshopt_initVertexDecoder(&decoder, vertex_count, 16, tail ? &buffer[buffer.size() - 16] : NULL);
+
+		// feed the data in small chunks, keeping unconsumed bytes around for the next call
+		std::vector<unsigned char> pending;
+
+		for (size_t i = 0; i < buffer.size(); i += 97)
+		{
+			size_t chunk = buffer.size() - i < 97 ? buffer.size() - i : 97;
+			pending.insert(pending.end(), buffer.begin() + i, buffer.begin() + i + chunk);
+
+			size_t consumed = 0;
+			assert(meshopt_decodeVertexBufferPartial(&decoder, &decoded[0], &pending[0], pending.size(), &consumed) == 0);
+			pending.erase(pending.begin(), pending.begin() + consumed);
+
+			// with the tail available upfront, decoded vertices must be final as soon as they are reported
+			if (tail)
+				assert(memcmp(&decoded[0], &data[0], decoder.vertex_offset * 16) == 0);
+		}
+
+		assert(decoder.vertex_offset == vertex_count);
+		assert(meshopt_finishVertexDecoder(&decoder, &decoded[0], &pending[0], pending.size()) == 0);
+		assert(decoded == data);
+	}
+
+	// finishing before the end of the stream must fail
+	std::vector<unsigned char> decoded(vertex_count * 16);
+
+	meshopt_VertexDecoder decoder;
+	meshopt_initVertexDecoder(&decoder, vertex_count, 16, NULL);
+
+	size_t consumed = 0;
+	assert(meshopt_decodeVertexBufferPartial(&decoder, &decoded[0], &buffer[0], buffer.size() / 2, &consumed) == 0);
+	assert(decoder.vertex_offset < vertex_count);
+	assert(meshopt_finishVertexDecoder(&decoder, &decoded[0], &buffer[consumed], buffer.size() / 2 - consumed) < 0);
+
+	// malformed headers must be rejected
+	unsigned char header = 0xff;
+
+	meshopt_initVertexDecoder(&decoder, vertex_count, 16, NULL);
+	assert(meshopt_decodeVertexBufferPartial(&decoder, &decoded[0], &header, 1, &consumed) < 0);
+}
+
 static void encodeVertexEmpty()
 {
 	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(0, 16));
@@ -539,6 +748,14 @@ static void decodeFilterOct8()
 	memcpy(tail, data, sizeof(tail));
 	meshopt_decodeFilterOct(tail, 3, 4);
 	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+
+	// Wide processing for larger counts
+	unsigned char wide[4 * 4 * 5];
+	for (size_t i = 0; i < 5; ++i)
+		memcpy(&wide[i * 4 * 4], data, sizeof(data));
+	meshopt_decodeFilterOct(wide, 4 * 5, 4);
+	for (size_t i = 0; i < 5; ++i)
+		assert(memcmp(&wide[i * 4 * 4], expected, sizeof(expected)) == 0);
 }
 
 static void decodeFilterOct12()
@@ -568,6 +785,14 @@ static void decodeFilterOct12()
 	memcpy(tail, data, sizeof(tail));
 	meshopt_decodeFilterOct(tail, 3, 8);
 	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+
+	// Wide processing for larger counts
+	unsigned short wide[4 * 4 * 5];
+	for (size_t i = 0; i < 5; ++i)
+		memcpy(&wide[i * 4 * 4], data, sizeof(data));
+	meshopt_decodeFilterOct(wide, 4 * 5, 8);
+	for (size_t i = 0; i < 5; ++i)
+		assert(memcmp(&wide[i * 4 * 4], expected, sizeof(expected)) == 0);
 }
 
 static void decodeFilterQuat12()
@@ -597,6 +822,14 @@ static void decodeFilterQuat12()
 	memcpy(tail, data, sizeof(tail));
 	meshopt_decodeFilterQuat(tail, 3, 8);
 	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+
+	// Wide processing for larger counts
+	unsigned short wide[4 * 4 * 5];
+	for (size_t i = 0; i < 5; ++i)
+		memcpy(&wide[i * 4 * 4], data, sizeof(data));
+	meshopt_decodeFilterQuat(wide, 4 * 5, 8);
+	for (size_t i = 0; i < 5; ++i)
+		assert(memcmp(&wide[i * 4 * 4], expected, sizeof(expected)) == 0);
 }
 
 static void decodeFilterExp()
@@ -626,6 +859,51 @@ static void decodeFilterExp()
 	memcpy(tail, data, sizeof(tail));
 	meshopt_decodeFilterExp(tail, 3, 4);
 	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+
+	// Wide processing for larger counts
+	unsigned int wide[4 * 5];
+	for (size_t i = 0; i < 5; ++i)
+		memcpy(&wide[i * 4], data, sizeof(data));
+	meshopt_decodeFilterExp(wide, 4 * 5, 4);
+	for (size_t i = 0; i < 5; ++i)
+		assert(memcmp(&wide[i * 4], expected, sizeof(expected)) == 0);
+}
+
+static void decodeFilterFused()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned char> data(vertex_count * 8);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (unsigned char)(i * 37 + (i / 8) % 11);
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 8));
+	buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), &data[0], vertex_count, 8));
+
+	// fused decoding must match decoding followed by a separate filter pass
+	const meshopt_DecodeFilter filters[] = {meshopt_DecodeFilterNone, meshopt_DecodeFilterOct, meshopt_DecodeFilterQuat, meshopt_DecodeFilterExp};
+
+	for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); ++i)
+	{
+		std::vector<unsigned char> expected(vertex_count * 8);
+		assert(meshopt_decodeVertexBuffer(&expected[0], vertex_count, 8, &buffer[0], buffer.size()) == 0);
+
+		if (filters[i] == meshopt_DecodeFilterOct)
+			meshopt_decodeFilterOct(&expected[0], vertex_count, 8);
+		else if (filters[i] == meshopt_DecodeFilterQuat)
+			meshopt_decodeFilterQuat(&expected[0], vertex_count, 8);
+		else if (filters[i] == meshopt_DecodeFilterExp)
+			meshopt_decodeFilterExp(&expected[0], vertex_count, 8);
+
+		std::vector<unsigned char> decoded(vertex_count * 8);
+		assert(meshopt_decodeVertexBufferFiltered(&decoded[0], vertex_count, 8, &buffer[0], buffer.size(), filters[i]) == 0);
+		assert(decoded == expected);
+	}
+
+	// malformed input must still be rejected
+	std::vector<unsigned char> decoded(vertex_count * 8);
+	assert(meshopt_decodeVertexBufferFiltered(&decoded[0], vertex_count, 8, &buffer[0], buffer.size() - 1, meshopt_DecodeFilterOct) < 0);
 }
 
 void encodeFilterOct8()
@@ -811,6 +1089,220 @@ void encodeFilterExpZero()
 	assert(decoded == data);
 }
 
+void encodeFilterBatch()
+{
+	const size_t count = 13;
+
+	float data[count * 4];
+
+	for (size_t i = 0; i < count * 4; ++i)
+		data[i] = ((i * 37) % 29) / 14.f - 1.f;
+
+	// zero and negative zero vectors exercise division and sign edge cases
+	data[4 * 5 + 0] = data[4 * 5 + 1] = data[4 * 5 + 2] = 0.f;
+	data[4 * 6 + 0] = data[4 * 6 + 1] = data[4 * 6 + 2] = -0.f;
+
+	// encoding large batches should produce the same results as encoding each vector individually
+	unsigned short batch[count * 4], single[count * 4];
+
+	meshopt_encodeFilterOct(batch, count, 4, 8, data);
+	for (size_t i = 0; i < count; ++i)
+		meshopt_encodeFilterOct(reinterpret_cast<unsigned char*>(single) + i * 4, 1, 4, 8, &data[i * 4]);
+	assert(memcmp(batch, single, count * 4) == 0);
+
+	meshopt_encodeFilterOct(batch, count, 8, 12, data);
+	for (size_t i = 0; i < count; ++i)
+		meshopt_encodeFilterOct(&single[i * 4], 1, 8, 12, &data[i * 4]);
+	assert(memcmp(batch, single, count * 8) == 0);
+
+	meshopt_encodeFilterQuat(batch, count, 8, 12, data);
+	for (size_t i = 0; i < count; ++i)
+		meshopt_encodeFilterQuat(&single[i * 4], 1, 8, 12, &data[i * 4]);
+	assert(memcmp(batch, single, count * 8) == 0);
+
+	unsigned int batche[count * 4], singlee[count * 4];
+
+	meshopt_encodeFilterExp(batche, count, 16, 15, data, meshopt_EncodeExpSeparate);
+	for (size_t i = 0; i < count; ++i)
+		meshopt_encodeFilterExp(&singlee[i * 4], 1, 16, 15, &data[i * 4], meshopt_EncodeExpSeparate);
+	assert(memcmp(batche, singlee, sizeof(batche)) == 0);
+
+	meshopt_encodeFilterExp(batche, count, 12, 15, data, meshopt_EncodeExpSharedVector);
+	for (size_t i = 0; i < count; ++i)
+		meshopt_encodeFilterExp(&singlee[i * 3], 1, 12, 15, &data[i * 3], meshopt_EncodeExpSharedVector);
+	assert(memcmp(batche, singlee, count * 12) == 0);
+}
+
+static float gridBumps5(size_t x, size_t y)
+{
+	return float((x * x + y * y) % 5) * 0.1f;
+}
+
+static float gridBumps7(size_t x, size_t y)
+{
+	return float((x * x + y * y) % 7) * 0.1f;
+}
+
+static float gridWave(size_t x, size_t y)
+{
+	return sinf(float(x + y));
+}
+
+static float gridHills(size_t x, size_t y)
+{
+	return sinf(float(x) * 0.2f) * cosf(float(y) * 0.3f) * 4.f;
+}
+
+// generates an NxN vertex grid with two triangles per quad; height is 0 when the callback is NULL, and scatter > 1 permutes the quad order
+static void makeGridMesh(std::vector<float>& vb, std::vector<unsigned int>& ib, size_t N, float (*height)(size_t, size_t), size_t scatter)
+{
+	vb.assign(N * N * 3, 0.f);
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			vb[(y * N + x) * 3 + 0] = float(x);
+			vb[(y * N + x) * 3 + 1] = float(y);
+			vb[(y * N + x) * 3 + 2] = height ? height(x, y) : 0.f;
+		}
+
+	size_t quad_count = (N - 1) * (N - 1);
+
+	ib.assign(quad_count * 6, 0);
+
+	for (size_t i = 0; i < quad_count; ++i)
+	{
+		size_t q = (i * scatter) % quad_count;
+		size_t x = q % (N - 1), y = q / (N - 1);
+
+		unsigned int v0 = unsigned(y * N + x), v1 = v0 + 1, v2 = v0 + unsigned(N), v3 = v2 + 1;
+		unsigned int* quad = &ib[i * 6];
+
+		quad[0] = v0, quad[1] = v1, quad[2] = v2;
+		quad[3] = v2, quad[4] = v1, quad[5] = v3;
+	}
+}
+
+static void buildMeshletsGrid(std::vector<meshopt_Meshlet>& meshlets, std::vector<unsigned int>& meshlet_vertices, std::vector<unsigned char>& meshlet_triangles, size_t N)
+{
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 1);
+
+	const size_t max_vertices = 64, max_triangles = 124;
+	size_t bound = meshopt_buildMeshletsBound(ib.size(), max_vertices, max_triangles);
+
+	meshlets.resize(bound);
+	meshlet_vertices.resize(bound * max_vertices);
+	meshlet_triangles.resize(bound * max_triangles * 3);
+
+	meshlets.resize(meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 0.f));
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
+		meshopt_optimizeMeshlet(&meshlet_vertices[meshlets[i].vertex_offset], &meshlet_triangles[meshlets[i].triangle_offset], meshlets[i].triangle_count, meshlets[i].vertex_count);
+
+	const meshopt_Meshlet& last = meshlets.back();
+
+	meshlet_vertices.resize(last.vertex_offset + last.vertex_count);
+	meshlet_triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3));
+}
+
+static void roundtripMeshlets()
+{
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+	buildMeshletsGrid(meshlets, meshlet_vertices, meshlet_triangles, 33);
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletsBound(meshlets.size(), 64, 124));
+	buffer.resize(meshopt_encodeMeshlets(&buffer[0], buffer.size(), &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0]));
+	assert(buffer.size() > 0);
+
+	// encoded data should be much smaller than the source data
+	size_t source_size = meshlets.size() * sizeof(meshopt_Meshlet) + meshlet_vertices.size() * sizeof(unsigned int) + meshlet_triangles.size();
+	assert(buffer.size() < source_size / 2);
+
+	std::vector<meshopt_Meshlet> decoded(meshlets.size());
+	std::vector<unsigned int> decoded_vertices(meshlet_vertices.size());
+	std::vector<unsigned char> decoded_triangles(meshlet_triangles.size());
+
+	assert(meshopt_decodeMeshlets(&decoded[0], decoded.size(), &decoded_vertices[0], decoded_vertices.size(), &decoded_triangles[0], decoded_triangles.size(), &buffer[0], buffer.size()) == 0);
+
+	// meshopt_buildMeshlets output is compact, so the layout is preserved exactly
+	assert(memcmp(&decoded[0], &meshlets[0], meshlets.size() * sizeof(meshopt_Meshlet)) == 0);
+	assert(decoded_vertices == meshlet_vertices);
+
+	// triangles may be rotated
+	for (size_t i = 0; i < meshlets.size(); ++i)
+		for (size_t j = 0; j < meshlets[i].triangle_count * 3; j += 3)
+		{
+			const unsigned char* a = &meshlet_triangles[meshlets[i].triangle_offset + j];
+			const unsigned char* b = &decoded_triangles[meshlets[i].triangle_offset + j];
+
+			assert((a[0] == b[0] && a[1] == b[1] && a[2] == b[2]) || (a[0] == b[1] && a[1] == b[2] && a[2] == b[0]) || (a[0] == b[2] && a[1] == b[0] && a[2] == b[1]));
+		}
+}
+
+static void encodeMeshletsMemorySafe()
+{
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+	buildMeshletsGrid(meshlets, meshlet_vertices, meshlet_triangles, 9);
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletsBound(meshlets.size(), 64, 124));
+	buffer.resize(meshopt_encodeMeshlets(&buffer[0], buffer.size(), &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0]));
+
+	// check that encode is memory-safe; note that we reallocate the buffer for each try to make sure ASAN can verify buffer access
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(i);
+		size_t result = meshopt_encodeMeshlets(i == 0 ? NULL : &shortbuffer[0], i, &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0]);
+
+		if (i == buffer.size())
+			assert(result == buffer.size());
+		else
+			assert(result == 0);
+	}
+}
+
+static void decodeMeshletsMemorySafe()
+{
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+	buildMeshletsGrid(meshlets, meshlet_vertices, meshlet_triangles, 9);
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletsBound(meshlets.size(), 64, 124));
+	buffer.resize(meshopt_encodeMeshlets(&buffer[0], buffer.size(), &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0]));
+
+	std::vector<meshopt_Meshlet> decoded(meshlets.size());
+	std::vector<unsigned int> decoded_vertices(meshlet_vertices.size());
+	std::vector<unsigned char> decoded_triangles(meshlet_triangles.size());
+
+	// check that decode is memory-safe; note that we reallocate the buffer for each try to make sure ASAN can verify buffer access
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+		int result = meshopt_decodeMeshlets(&decoded[0], decoded.size(), &decoded_vertices[0], decoded_vertices.size(), &decoded_triangles[0], decoded_triangles.size(), i == 0 ? NULL : &shortbuffer[0], i);
+
+		if (i == buffer.size())
+			assert(result == 0);
+		else
+			assert(result < 0);
+	}
+
+	// check that decoder doesn't accept extra bytes after a valid stream
+	std::vector<unsigned char> largebuffer(buffer);
+	largebuffer.push_back(0);
+
+	assert(meshopt_decodeMeshlets(&decoded[0], decoded.size(), &decoded_vertices[0], decoded_vertices.size(), &decoded_triangles[0], decoded_triangles.size(), &largebuffer[0], largebuffer.size()) < 0);
+
+	// check that decoder validates output sizes
+	assert(meshopt_decodeMeshlets(&decoded[0], decoded.size(), &decoded_vertices[0], decoded_vertices.size() - 1, &decoded_triangles[0], decoded_triangles.size(), &buffer[0], buffer.size()) < 0);
+	assert(meshopt_decodeMeshlets(&decoded[0], decoded.size(), &decoded_vertices[0], decoded_vertices.size(), &decoded_triangles[0], decoded_triangles.size() - 4, &buffer[0], buffer.size()) < 0);
+}
+
 static void clusterBoundsDegenerate()
 {
 	const float vbd[] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -896,6 +1388,122 @@ static void customAllocator()
 	allocCount = freeCount = 0;
 }
 
+struct ContextCounters
+{
+	size_t allocs;
+	size_t frees;
+};
+
+static void* contextAlloc(void* userdata, size_t size)
+{
+	static_cast<ContextCounters*>(userdata)->allocs++;
+
+	return malloc(size);
+}
+
+static void contextFree(void* userdata, void* ptr)
+{
+	static_cast<ContextCounters*>(userdata)->frees++;
+
+	free(ptr);
+}
+
+static void contextAllocator()
+{
+	const size_t N = 17;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridBumps5, 1);
+
+	std::vector<unsigned int> expected(ib.size()), actual(ib.size());
+	std::vector<unsigned int> remap(N * N), remap_context(N * N);
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(ib.size(), 64, 64);
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets), meshlets_context(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(max_meshlets * 64), meshlet_vertices_context(max_meshlets * 64);
+	std::vector<unsigned char> meshlet_triangles(max_meshlets * 64 * 3), meshlet_triangles_context(max_meshlets * 64 * 3);
+
+	ContextCounters counters = {};
+	meshopt_Context* context = meshopt_createContext(contextAlloc, contextFree, &counters);
+	assert(counters.allocs == 1);
+
+	size_t baseline = 0;
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		size_t unique = meshopt_generateVertexRemap(&remap[0], &ib[0], ib.size(), &vb[0], N * N, 12);
+		assert(meshopt_generateVertexRemapWithContext(context, &remap_context[0], &ib[0], ib.size(), &vb[0], N * N, 12) == unique);
+		assert(remap == remap_context);
+
+		meshopt_optimizeVertexCache(&expected[0], &ib[0], ib.size(), N * N);
+		meshopt_optimizeVertexCacheWithContext(context, &actual[0], &ib[0], ib.size(), N * N);
+		assert(expected == actual);
+
+		meshopt_optimizeOverdraw(&expected[0], &ib[0], ib.size(), &vb[0], N * N, 12, 1.05f);
+		meshopt_optimizeOverdrawWithContext(context, &actual[0], &ib[0], ib.size(), &vb[0], N * N, 12, 1.05f);
+		assert(expected == actual);
+
+		float error = 0.f, error_context = 0.f;
+		size_t count = meshopt_simplify(&expected[0], &ib[0], ib.size(), &vb[0], N * N, 12, ib.size() / 4, 1e-2f, 0, &error);
+		assert(meshopt_simplifyWithContext(context, &actual[0], &ib[0], ib.size(), &vb[0], N * N, 12, NULL, 0, NULL, 0, NULL, ib.size() / 4, 1e-2f, 0, &error_context) == count);
+		assert(memcmp(&expected[0], &actual[0], count * sizeof(unsigned int)) == 0 && error == error_context);
+
+		size_t meshlet_count = meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], N * N, 12, 64, 64, 0.25f);
+		assert(meshopt_buildMeshletsWithContext(context, &meshlets_context[0], &meshlet_vertices_context[0], &meshlet_triangles_context[0], &ib[0], ib.size(), &vb[0], N * N, 12, 64, 64, 0.25f) == meshlet_count);
+		assert(memcmp(&meshlets[0], &meshlets_context[0], meshlet_count * sizeof(meshopt_Meshlet)) == 0);
+		assert(meshlet_vertices == meshlet_vertices_context && meshlet_triangles == meshlet_triangles_context);
+
+		// once the arena has grown to the peak usage, subsequent calls with the same inputs don't allocate
+		if (pass == 0)
+			baseline = counters.allocs;
+		else
+			assert(counters.allocs == baseline);
+	}
+
+	meshopt_destroyContext(context);
+	assert(counters.allocs == counters.frees);
+}
+
+static void contextAllocate()
+{
+	ContextCounters counters = {};
+	meshopt_Context* context = meshopt_createContext(contextAlloc, contextFree, &counters);
+	assert(counters.allocs == 1);
+
+	// first use goes through the callbacks since the arena is empty
+	unsigned char* a = static_cast<unsigned char*>(meshopt_allocateContext(context, 100));
+	unsigned int* b = static_cast<unsigned int*>(meshopt_allocateContext(context, 40 * sizeof(unsigned int)));
+	assert(counters.allocs == 3);
+	assert(size_t(a) % 16 == 0 && size_t(b) % 16 == 0);
+
+	memset(a, 0xcd, 100);
+	for (int i = 0; i < 40; ++i)
+		b[i] = i;
+
+	meshopt_deallocateContext(context, b);
+	meshopt_deallocateContext(context, a);
+
+	// releasing all blocks grows the arena to the peak usage, so the same allocations no longer hit the callbacks
+	size_t baseline = counters.allocs;
+
+	a = static_cast<unsigned char*>(meshopt_allocateContext(context, 100));
+	b = static_cast<unsigned int*>(meshopt_allocateContext(context, 40 * sizeof(unsigned int)));
+	assert(counters.allocs == baseline);
+	assert(b > reinterpret_cast<unsigned int*>(a));
+
+	// allocations that don't fit into the arena fall back to the callbacks
+	void* c = meshopt_allocateContext(context, 4096);
+	assert(counters.allocs == baseline + 1);
+
+	meshopt_deallocateContext(context, c);
+	meshopt_deallocateContext(context, b);
+	meshopt_deallocateContext(context, a);
+
+	meshopt_destroyContext(context);
+	assert(counters.allocs == counters.frees);
+}
+
 static void emptyMesh()
 {
 	meshopt_optimizeVertexCache(NULL, NULL, 0, 0);
@@ -1338,24 +1946,1131 @@ static void simplifyErrorAbsolute()
 	assert(fabsf(error - 0.85f) < 0.01f);
 }
 
-static void adjacency()
+static void simplifyLods()
 {
-	// 0 1/4
-	// 2/5 3
-	const float vb[] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 0, 1, 0};
-	const unsigned int ib[] = {0, 1, 2, 5, 4, 3};
+	const size_t N = 33;
 
-	unsigned int adjib[12];
-	meshopt_generateAdjacencyIndexBuffer(adjib, ib, 6, vb, 6, 12);
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridBumps7, 1);
 
-	unsigned int expected[] = {
-	    // patch 0
-	    0, 0,
-	    1, 3,
-	    2, 2,
+	const size_t lod_count = 3;
 
-	    // patch 1
-	    5, 0,
+	size_t targets[lod_count] = {ib.size() / 2 / 3 * 3, ib.size() / 4 / 3 * 3, ib.size() / 8 / 3 * 3};
+	float target_errors[lod_count] = {1.f, 1.f, 1.f};
+
+	std::vector<unsigned int> chain(ib.size() * lod_count);
+	size_t counts[lod_count];
+	float errors[lod_count];
+
+	size_t total = meshopt_simplifyLods(&chain[0], counts, errors, &ib[0], ib.size(), &vb[0], N * N, 12, NULL, 0, NULL, 0, NULL, targets, target_errors, lod_count);
+	assert(total == counts[0] + counts[1] + counts[2]);
+
+	for (size_t i = 0; i < lod_count; ++i)
+	{
+		assert(counts[i] > 0 && counts[i] <= targets[i]);
+		assert(i == 0 || errors[i] >= errors[i - 1]);
+	}
+
+	// first level must match the regular simplifier since the state is the same up to that point
+	std::vector<unsigned int> lod0(ib.size());
+	float error0 = 0.f;
+	lod0.resize(meshopt_simplify(&lod0[0], &ib[0], ib.size(), &vb[0], N * N, 12, targets[0], target_errors[0], 0, &error0));
+
+	assert(lod0.size() == counts[0]);
+	assert(memcmp(&lod0[0], &chain[0], counts[0] * sizeof(unsigned int)) == 0);
+	assert(error0 == errors[0]);
+
+	// errors limit each level independently
+	float limited_errors[lod_count] = {1e-3f, 1e-3f, 1.f};
+	meshopt_simplifyLods(&chain[0], counts, errors, &ib[0], ib.size(), &vb[0], N * N, 12, NULL, 0, NULL, 0, NULL, targets, limited_errors, lod_count);
+
+	assert(errors[0] <= 1e-3f && errors[1] <= 1e-3f);
+	assert(counts[2] <= targets[2]);
+}
+
+static void simplifyParallelScheduler(void* context, void (*task)(void*, size_t), void* task_data, size_t task_count)
+{
+	*static_cast<size_t*>(context) += task_count;
+
+	// run tasks in reverse order to make sure they don't depend on each other
+	for (size_t i = task_count; i > 0; --i)
+		task(task_data, i - 1);
+}
+
+static void simplifyParallel()
+{
+	const size_t N = 65;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 1);
+
+	size_t target = ib.size() / 8 / 3 * 3;
+
+	std::vector<unsigned int> result1(ib.size());
+	std::vector<unsigned int> result2(ib.size());
+
+	size_t tasks = 0;
+	float error = 1.f;
+
+	// flat grid can be simplified to the target without error, including seams between partitions
+	size_t count1 = meshopt_simplifyParallel(&result1[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-2f, 0, &error, 4, simplifyParallelScheduler, &tasks);
+	assert(tasks == 4);
+	assert(count1 <= target);
+	assert(error < 1e-4f);
+
+	// NULL scheduler runs the same tasks serially
+	size_t count2 = meshopt_simplifyParallel(&result2[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-2f, 0, NULL, 4, NULL, NULL);
+	assert(count1 == count2);
+	assert(memcmp(&result1[0], &result2[0], count1 * sizeof(unsigned int)) == 0);
+
+	// border vertices must be preserved when requested, even though partition seams are unlocked in the end
+	size_t count3 = meshopt_simplifyParallel(&result1[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-2f, meshopt_SimplifyLockBorder, NULL, 4, NULL, NULL);
+	assert(count3 > 0 && count3 < ib.size());
+
+	std::vector<unsigned char> used(N * N);
+	for (size_t i = 0; i < count3; ++i)
+		used[result1[i]] = 1;
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		assert(used[i] && used[(N - 1) * N + i]);
+		assert(used[i * N] && used[i * N + N - 1]);
+	}
+}
+
+static void simplifySloppyParallel()
+{
+	// needs enough triangles and vertices to split the passes into several tasks
+	const size_t N = 257;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridBumps7, 1);
+
+	size_t target = ib.size() / 100 / 3 * 3;
+
+	std::vector<unsigned int> expected(ib.size());
+	std::vector<unsigned int> result1(ib.size());
+	std::vector<unsigned int> result2(ib.size());
+
+	float expected_error = 0.f, error1 = 0.f, error2 = 0.f;
+	size_t expected_count = meshopt_simplifySloppy(&expected[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-1f, &expected_error);
+
+	size_t tasks = 0;
+	size_t count1 = meshopt_simplifySloppyParallel(&result1[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-1f, &error1, simplifyParallelScheduler, &tasks);
+	assert(tasks > 0);
+
+	// grid search is the same as in the serial version
+	assert(count1 == expected_count);
+	assert(count1 > 0 && count1 <= target);
+	assert(fabsf(error1 - expected_error) < 1e-3f);
+
+	// NULL scheduler runs the same tasks serially
+	size_t count2 = meshopt_simplifySloppyParallel(&result2[0], &ib[0], ib.size(), &vb[0], N * N, 12, target, 1e-1f, &error2, NULL, NULL);
+	assert(count1 == count2 && error1 == error2);
+	assert(memcmp(&result1[0], &result2[0], count1 * sizeof(unsigned int)) == 0);
+}
+
+struct SloppyStream
+{
+	const float* vertices;
+	const unsigned int* indices;
+	size_t triangle_count;
+	size_t offset;
+
+	std::vector<unsigned int> result;
+	size_t batches;
+};
+
+static size_t sloppyStreamRead(void* context, float* triangle_positions, size_t triangle_count)
+{
+	SloppyStream& stream = *static_cast<SloppyStream*>(context);
+
+	// return short batches to make sure the simplifier doesn't depend on batch boundaries
+	size_t count = stream.triangle_count - stream.offset;
+	count = count < 37 ? count : 37;
+	count = count < triangle_count ? count : triangle_count;
+
+	for (size_t i = 0; i < count * 3; ++i)
+		memcpy(&triangle_positions[i * 3], &stream.vertices[stream.indices[stream.offset * 3 + i] * 3], 3 * sizeof(float));
+
+	stream.offset += count;
+	return count;
+}
+
+static void sloppyStreamWrite(void* context, const unsigned int* indices, size_t index_count)
+{
+	SloppyStream& stream = *static_cast<SloppyStream*>(context);
+
+	stream.result.insert(stream.result.end(), indices, indices + index_count);
+	stream.batches++;
+}
+
+static void simplifySloppyStream()
+{
+	const size_t N = 33;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridBumps7, 1);
+
+	float bounds_min[3] = {0, 0, 0};
+	float bounds_max[3] = {float(N - 1), float(N - 1), 0.6f};
+
+	SloppyStream stream = {&vb[0], &ib[0], ib.size() / 3, 0};
+	std::vector<float> vertices(N * N * 3);
+
+	float error = 0.f;
+	size_t vertex_count = meshopt_simplifySloppyStream(&vertices[0], N * N, ib.size() / 3, sloppyStreamRead, sloppyStreamWrite, &stream, bounds_min, bounds_max, 0.125f, &error);
+	assert(vertex_count > 0 && vertex_count < N * N);
+	assert(stream.offset == ib.size() / 3 && stream.batches > 1);
+
+	// clustering uses the same grid as non-streaming simplifier with the same error limit
+	std::vector<unsigned int> expected(ib.size());
+	size_t expected_count = meshopt_simplifySloppy(&expected[0], &ib[0], ib.size(), &vb[0], N * N, 12, 0, 0.125f);
+	assert(stream.result.size() == expected_count);
+	assert(error > 0.f && error <= 0.125f);
+
+	for (size_t i = 0; i < stream.result.size(); ++i)
+		assert(stream.result[i] < vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(vertices[i * 3 + 0] >= 0 && vertices[i * 3 + 0] <= bounds_max[0]);
+		assert(vertices[i * 3 + 1] >= 0 && vertices[i * 3 + 1] <= bounds_max[1]);
+	}
+
+	// output that doesn't fit into the working memory is reported as a failure
+	SloppyStream small = {&vb[0], &ib[0], ib.size() / 3, 0};
+	assert(meshopt_simplifySloppyStream(&vertices[0], vertex_count - 1, ib.size() / 3, sloppyStreamRead, sloppyStreamWrite, &small, bounds_min, bounds_max, 0.125f, NULL) == 0);
+}
+
+static void simplifyPointsLods()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb(N * N * 3);
+	std::vector<float> colors(N * N * 3);
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			vb[(y * N + x) * 3 + 0] = float(x);
+			vb[(y * N + x) * 3 + 1] = float(y);
+			vb[(y * N + x) * 3 + 2] = float((x * x + y * y) % 7) * 0.1f;
+
+			colors[(y * N + x) * 3 + 0] = float(x % 3) * 0.5f;
+			colors[(y * N + x) * 3 + 1] = float(y % 2);
+			colors[(y * N + x) * 3 + 2] = 0.f;
+		}
+
+	const size_t lod_count = 4;
+	size_t targets[lod_count] = {50, 200, 800, N * N};
+
+	std::vector<unsigned int> order(N * N);
+	size_t counts[lod_count];
+
+	size_t tasks = 0;
+	size_t total = meshopt_simplifyPointsLods(&order[0], counts, &vb[0], N * N, 12, &colors[0], 12, 1.f, targets, lod_count, simplifyParallelScheduler, &tasks);
+	assert(total == N * N && counts[lod_count - 1] == total);
+
+	for (size_t i = 0; i < lod_count; ++i)
+		assert(counts[i] > 0 && counts[i] <= targets[i] && (i == 0 || counts[i] > counts[i - 1]));
+
+	// the last level contains every point exactly once
+	std::vector<unsigned char> seen(N * N);
+	for (size_t i = 0; i < total; ++i)
+	{
+		assert(order[i] < N * N && !seen[order[i]]);
+		seen[order[i]] = 1;
+	}
+
+	// the first level is the same as the regular point simplifier
+	std::vector<unsigned int> expected(targets[0]);
+	size_t expected_count = meshopt_simplifyPoints(&expected[0], &vb[0], N * N, 12, &colors[0], 12, 1.f, targets[0]);
+	assert(expected_count == counts[0]);
+	assert(memcmp(&expected[0], &order[0], expected_count * sizeof(unsigned int)) == 0);
+
+	// NULL scheduler produces the same ordering
+	std::vector<unsigned int> order2(N * N);
+	size_t counts2[lod_count];
+	meshopt_simplifyPointsLods(&order2[0], counts2, &vb[0], N * N, 12, &colors[0], 12, 1.f, targets, lod_count, NULL, NULL);
+	assert(order == order2 && memcmp(counts, counts2, sizeof(counts)) == 0);
+}
+
+static void optimizeVertexCacheTable()
+{
+	const size_t N = 33;
+
+	// emit quads in a scattered order so that the input is not vertex cache friendly
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 337);
+
+	// same scores as the built-in table
+	const meshopt_VertexScoreTable table = {
+	    {0.779f, 0.791f, 0.789f, 0.981f, 0.843f, 0.726f, 0.847f, 0.882f, 0.867f, 0.799f, 0.642f, 0.613f, 0.600f, 0.568f, 0.372f, 0.234f},
+	    {0.995f, 0.713f, 0.450f, 0.404f, 0.059f, 0.005f, 0.147f, 0.006f},
+	};
+
+	std::vector<unsigned int> expected(ib.size());
+	std::vector<unsigned int> actual(ib.size());
+
+	meshopt_optimizeVertexCache(&expected[0], &ib[0], ib.size(), N * N);
+	meshopt_optimizeVertexCacheTable(&actual[0], &ib[0], ib.size(), N * N, &table);
+	assert(expected == actual);
+
+	// a table that only favors recently used vertices still produces a reasonable order
+	meshopt_VertexScoreTable lru = {};
+
+	for (int i = 0; i < 16; ++i)
+		lru.cache[i] = 1.f - float(i) / 16.f;
+
+	for (int i = 0; i < 8; ++i)
+		lru.live[i] = 1e-3f;
+
+	std::vector<unsigned short> ib16(ib.begin(), ib.end());
+	std::vector<unsigned short> result16(ib.size());
+
+	meshopt_optimizeVertexCacheTable(&result16[0], &ib16[0], ib16.size(), N * N, &lru);
+
+	std::vector<unsigned int> result(result16.begin(), result16.end());
+
+	meshopt_VertexCacheStatistics vcs_input = meshopt_analyzeVertexCache(&ib[0], ib.size(), N * N, 16, 0, 0);
+	meshopt_VertexCacheStatistics vcs = meshopt_analyzeVertexCache(&result[0], result.size(), N * N, 16, 0, 0);
+	assert(vcs.acmr < vcs_input.acmr * 0.5f);
+}
+
+static void optimizeVertexCacheParallel()
+{
+	// needs enough triangles to split the mesh into several partitions
+	const size_t N = 257;
+
+	// emit quads in a scattered order so that the input is not vertex cache friendly
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 7919);
+
+	std::vector<unsigned int> ref(ib.size());
+	meshopt_optimizeVertexCache(&ref[0], &ib[0], ib.size(), N * N);
+
+	std::vector<unsigned int> result(ib.size());
+
+	size_t tasks = 0;
+	meshopt_optimizeVertexCacheParallel(&result[0], &ib[0], ib.size(), &vb[0], N * N, 12, 4, simplifyParallelScheduler, &tasks);
+	assert(tasks == 4);
+
+	// every vertex is referenced as many times as in the source mesh
+	std::vector<unsigned int> refs(N * N);
+
+	for (size_t i = 0; i < ib.size(); ++i)
+		refs[ib[i]]++;
+
+	for (size_t i = 0; i < result.size(); ++i)
+		refs[result[i]]--;
+
+	for (size_t i = 0; i < N * N; ++i)
+		assert(refs[i] == 0);
+
+	// partition seams add a small amount of vertex transforms
+	meshopt_VertexCacheStatistics vcs_ref = meshopt_analyzeVertexCache(&ref[0], ref.size(), N * N, 16, 0, 0);
+	meshopt_VertexCacheStatistics vcs = meshopt_analyzeVertexCache(&result[0], result.size(), N * N, 16, 0, 0);
+	assert(vcs.acmr < vcs_ref.acmr * 1.02f);
+
+	// NULL scheduler produces the same result, including in-place optimization
+	std::vector<unsigned int> result2(ib);
+	meshopt_optimizeVertexCacheParallel(&result2[0], &result2[0], ib.size(), &vb[0], N * N, 12, 4, NULL, NULL);
+	assert(result == result2);
+
+	// small meshes use a single partition
+	std::vector<unsigned int> small(6 * 100);
+	meshopt_optimizeVertexCacheParallel(&small[0], &ib[0], small.size(), &vb[0], N * N, 12, 4, simplifyParallelScheduler, &tasks);
+	assert(tasks == 4);
+}
+
+static float spatialSortPathLength(const std::vector<float>& vb, const std::vector<unsigned int>& remap)
+{
+	std::vector<unsigned int> order(remap.size());
+
+	for (size_t i = 0; i < remap.size(); ++i)
+		order[remap[i]] = unsigned(i);
+
+	float result = 0;
+
+	for (size_t i = 1; i < order.size(); ++i)
+	{
+		const float* a = &vb[order[i - 1] * 3];
+		const float* b = &vb[order[i] * 3];
+
+		result += sqrtf((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+	}
+
+	return result;
+}
+
+static void spatialSortRemapParallel()
+{
+	// shuffled 48^3 grid with one far away point, which makes 10-bit quantization merge neighboring points
+	const size_t N = 48;
+	const size_t vertex_count = N * N * N + 1;
+
+	std::vector<float> vb(vertex_count * 3);
+
+	for (size_t i = 0; i < N * N * N; ++i)
+	{
+		size_t k = (i * 7919) % (N * N * N);
+
+		vb[i * 3 + 0] = float(k % N);
+		vb[i * 3 + 1] = float((k / N) % N);
+		vb[i * 3 + 2] = float(k / (N * N));
+	}
+
+	vb[N * N * N * 3 + 0] = 1e4f;
+
+	std::vector<unsigned int> ref(vertex_count), result(vertex_count), result2(vertex_count);
+	meshopt_spatialSortRemap(&ref[0], &vb[0], vertex_count, 12);
+
+	// default options match the serial version
+	size_t tasks = 0;
+	meshopt_spatialSortRemapParallel(&result[0], &vb[0], vertex_count, 12, 0, simplifyParallelScheduler, &tasks);
+	assert(tasks > 2);
+	assert(result == ref);
+
+	float length_ref = spatialSortPathLength(vb, ref);
+
+	// 21-bit keys keep grid points apart
+	meshopt_spatialSortRemapParallel(&result[0], &vb[0], vertex_count, 12, meshopt_SpatialSortPrecise, simplifyParallelScheduler, &tasks);
+	meshopt_spatialSortRemapParallel(&result2[0], &vb[0], vertex_count, 12, meshopt_SpatialSortPrecise, NULL, NULL);
+	assert(result == result2);
+
+	float length_precise = spatialSortPathLength(vb, result);
+	assert(length_precise < length_ref * 0.8f);
+
+	// Hilbert curve only moves between adjacent cells so the path is shorter still
+	meshopt_spatialSortRemapParallel(&result[0], &vb[0], vertex_count, 12, meshopt_SpatialSortHilbert, simplifyParallelScheduler, &tasks);
+	meshopt_spatialSortRemapParallel(&result2[0], &vb[0], vertex_count, 12, meshopt_SpatialSortHilbert, NULL, NULL);
+	assert(result == result2);
+
+	float length_hilbert = spatialSortPathLength(vb, result);
+	assert(length_hilbert < length_precise);
+
+	// every vertex gets a unique slot
+	std::vector<unsigned char> used(vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(result[i] < vertex_count && !used[result[i]]);
+		used[result[i]] = 1;
+	}
+
+	// triangle sort uses the same ordering on triangle centroids
+	unsigned int ib[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+	unsigned int sorted[9];
+
+	meshopt_spatialSortTrianglesParallel(sorted, ib, 9, &vb[0], vertex_count, 12, meshopt_SpatialSortHilbert, NULL, NULL);
+
+	std::vector<unsigned int> tri(9);
+	meshopt_spatialSortTriangles(&tri[0], ib, 9, &vb[0], vertex_count, 12);
+	meshopt_spatialSortTrianglesParallel(ib, ib, 9, &vb[0], vertex_count, 12, 0, NULL, NULL);
+	assert(memcmp(ib, &tri[0], sizeof(ib)) == 0);
+}
+
+static unsigned long long canonicalTriangle(const unsigned int* tri)
+{
+	// rotate the triangle so that the smallest index comes first, preserving winding
+	int r = (tri[0] < tri[1] && tri[0] < tri[2]) ? 0 : (tri[1] < tri[2] ? 1 : 2);
+
+	unsigned long long a = tri[r], b = tri[(r + 1) % 3], c = tri[(r + 2) % 3];
+
+	return (a << 42) | (b << 21) | c;
+}
+
+static void stripifyWindowed()
+{
+	const size_t N = 32;
+	const size_t window = 16;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 1);
+
+	meshopt_optimizeVertexCache(&ib[0], &ib[0], ib.size(), N * N);
+
+	std::vector<unsigned int> strip(meshopt_stripifyBound(ib.size()));
+	std::vector<unsigned int> list(meshopt_unstripifyBound(strip.size()));
+
+	for (int restart = 0; restart < 2; ++restart)
+	{
+		unsigned int restart_index = restart ? ~0u : 0;
+
+		strip.resize(meshopt_stripifyBound(ib.size()));
+		strip.resize(meshopt_stripifyWindowed(&strip[0], &ib[0], ib.size(), N * N, restart_index, window));
+
+		list.resize(meshopt_unstripifyBound(strip.size()));
+		list.resize(meshopt_unstripify(&list[0], &strip[0], strip.size(), restart_index));
+		assert(list.size() == ib.size());
+
+		// each window contains the same triangles as the corresponding window of the source list
+		for (size_t begin = 0; begin < ib.size(); begin += window * 3)
+		{
+			size_t end = begin + window * 3 < ib.size() ? begin + window * 3 : ib.size();
+
+			bool used[window] = {};
+
+			for (size_t i = begin; i < end; i += 3)
+			{
+				unsigned long long tri = canonicalTriangle(&list[i]);
+
+				size_t j = begin;
+				while (j < end && (used[(j - begin) / 3] || canonicalTriangle(&ib[j]) != tri))
+					j += 3;
+
+				assert(j < end);
+				used[(j - begin) / 3] = true;
+			}
+		}
+
+		meshopt_StripStatistics ss = meshopt_analyzeStrip(&strip[0], strip.size(), N * N, restart_index, 16, 0, 0);
+		meshopt_VertexCacheStatistics vcs = meshopt_analyzeVertexCache(&list[0], list.size(), N * N, 16, 0, 0);
+
+		assert(ss.triangles == ib.size() / 3);
+		assert(ss.indices == strip.size());
+		assert(ss.index_ratio > 0.f && ss.index_ratio < 1.f);
+		assert(ss.vertex_cache.vertices_transformed == vcs.vertices_transformed);
+	}
+
+	// a single window matches meshopt_stripify
+	std::vector<unsigned int> ref(meshopt_stripifyBound(ib.size()));
+	ref.resize(meshopt_stripify(&ref[0], &ib[0], ib.size(), N * N, ~0u));
+
+	strip.resize(meshopt_stripifyBound(ib.size()));
+	strip.resize(meshopt_stripifyWindowed(&strip[0], &ib[0], ib.size(), N * N, ~0u, ib.size() / 3));
+	assert(strip == ref);
+
+	// empty strips produce empty statistics
+	meshopt_StripStatistics ss = meshopt_analyzeStrip(&ib[0], 0, N * N, 0, 16, 0, 0);
+	assert(ss.triangles == 0 && ss.indices == 0);
+}
+
+static void analyzeMesh()
+{
+	const size_t N = 128;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, NULL, 1);
+
+	// add an extra row of vertices that the index buffer doesn't reference to make sure unused vertices are handled
+	size_t vertex_count = N * N + N;
+
+	meshopt_VertexCacheProfile profiles[] = {{16, 0, 0}, {32, 32, 32}, {14, 64, 128}, {128, 0, 0}};
+	unsigned int lines[] = {64, 32, 128};
+	size_t interleaved[] = {32};
+
+	meshopt_MeshStatistics ms = meshopt_analyzeMesh(&ib[0], ib.size(), vertex_count, profiles, 4, interleaved, 1, lines, 1);
+
+	assert(ms.triangles == ib.size() / 3);
+	assert(ms.unique_vertices == N * N);
+
+	// results match separate analyzers
+	for (size_t k = 0; k < 4; ++k)
+	{
+		meshopt_VertexCacheStatistics vcs = meshopt_analyzeVertexCache(&ib[0], ib.size(), vertex_count, profiles[k].cache_size, profiles[k].warp_size, profiles[k].primgroup_size);
+
+		assert(ms.vertex_cache[k].vertices_transformed == vcs.vertices_transformed);
+		assert(ms.vertex_cache[k].warps_executed == vcs.warps_executed);
+		assert(ms.vertex_cache[k].acmr == vcs.acmr && ms.vertex_cache[k].atvr == vcs.atvr);
+	}
+
+	meshopt_VertexFetchStatistics vfs = meshopt_analyzeVertexFetch(&ib[0], ib.size(), vertex_count, 32);
+
+	assert(ms.vertex_fetch[0].bytes_fetched == vfs.bytes_fetched);
+	assert(ms.vertex_fetch[0].overfetch == vfs.overfetch);
+
+	// deinterleaved streams fetch every vertex byte at least once for every line size
+	size_t deinterleaved[] = {12, 4, 16};
+
+	ms = meshopt_analyzeMesh(&ib[0], ib.size(), vertex_count, profiles, 0, deinterleaved, 3, lines, 3);
+
+	for (size_t l = 0; l < 3; ++l)
+	{
+		assert(ms.vertex_fetch[l].bytes_fetched >= N * N * 32);
+		assert(ms.vertex_fetch[l].overfetch >= 1.f);
+	}
+
+	// larger lines fetch more data for a random vertex order once the streams don't fit into the cache
+	for (size_t i = 0; i < ib.size(); ++i)
+		ib[i] = unsigned((ib[i] * 7919) % (N * N));
+
+	ms = meshopt_analyzeMesh(&ib[0], ib.size(), vertex_count, profiles, 0, deinterleaved, 3, lines, 3);
+	assert(ms.vertex_fetch[2].bytes_fetched > ms.vertex_fetch[0].bytes_fetched);
+	assert(ms.vertex_fetch[0].bytes_fetched > ms.vertex_fetch[1].bytes_fetched);
+
+	// without vertex streams nothing is fetched
+	ms = meshopt_analyzeMesh(&ib[0], ib.size(), vertex_count, profiles, 0, NULL, 0, lines, 1);
+	assert(ms.vertex_fetch[0].bytes_fetched == 0 && ms.vertex_fetch[0].overfetch == 0);
+
+	// empty meshes produce empty statistics
+	ms = meshopt_analyzeMesh(&ib[0], 0, vertex_count, profiles, 4, deinterleaved, 3, lines, 3);
+	assert(ms.triangles == 0 && ms.unique_vertices == 0);
+	assert(ms.vertex_cache[0].vertices_transformed == 0 && ms.vertex_fetch[0].bytes_fetched == 0);
+}
+
+static void generateWeldRemap()
+{
+	// vertex 1 is a near-duplicate of vertex 0, vertex 2 has a different normal, vertex 3 has a different UV, vertex 4 is far away
+	const float vb[] = {
+	    0, 0, 0, 0, 0, 1, 0, 0,
+	    1e-4f, 0, 0, 0, 0.01f, 1, 0, 0,
+	    0, 1e-4f, 0, 0, 1, 0, 0, 0,
+	    0, 0, 1e-4f, 0, 0, 1, 0.5f, 0,
+	    1, 0, 0, 0, 0, 1, 0, 0, // clang-format :-/
+	};
+
+	const unsigned int ib[] = {4, 0, 1, 2, 3, 0};
+
+	unsigned int remap[5];
+	size_t unique = meshopt_generateWeldRemap(remap, ib, 6, vb, 5, 32, 1e-3f, vb + 3, 32, 0.1f, vb + 6, 32, 1e-2f, NULL, NULL);
+
+	// remap uses the first-occurrence order
+	assert(unique == 4);
+	assert(remap[4] == 0 && remap[0] == 1 && remap[1] == 1 && remap[2] == 2 && remap[3] == 3);
+
+	// without normals and UVs, only positions are compared
+	unique = meshopt_generateWeldRemap(remap, ib, 6, vb, 5, 32, 1e-3f, NULL, 0, 0.f, NULL, 0, 0.f, NULL, NULL);
+	assert(unique == 2);
+	assert(remap[4] == 0 && remap[0] == 1 && remap[1] == 1 && remap[2] == 1 && remap[3] == 1);
+
+	// zero tolerance merges exact duplicates only
+	unique = meshopt_generateWeldRemap(remap, ib, 6, vb, 5, 32, 0.f, NULL, 0, 0.f, NULL, 0, 0.f, NULL, NULL);
+	assert(unique == 5);
+
+	// grid with jittered duplicates; results are stable across schedulers and compatible with remap functions
+	const size_t N = 200;
+
+	std::vector<float> gb(N * N * 2 * 3);
+	std::vector<unsigned int> gib((N - 1) * (N - 1) * 6);
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+			for (int k = 0; k < 2; ++k)
+			{
+				float* v = &gb[((y * N + x) * 2 + k) * 3];
+
+				v[0] = float(x) + (k ? 1e-3f : 0.f);
+				v[1] = float(y);
+				v[2] = k ? -1e-3f : 0.f;
+			}
+
+	for (size_t y = 0; y + 1 < N; ++y)
+		for (size_t x = 0; x + 1 < N; ++x)
+		{
+			// adjacent quads use different copies of shared vertices
+			int k = int((x + y) & 1);
+
+			unsigned int v0 = unsigned((y * N + x) * 2 + k), v1 = v0 + 2, v2 = v0 + unsigned(N * 2), v3 = v2 + 2;
+			unsigned int* quad = &gib[(y * (N - 1) + x) * 6];
+
+			quad[0] = v0, quad[1] = v1, quad[2] = v2;
+			quad[3] = v2, quad[4] = v1, quad[5] = v3;
+		}
+
+	std::vector<unsigned int> r1(N * N * 2), r2(N * N * 2);
+
+	size_t tasks = 0;
+	size_t u1 = meshopt_generateWeldRemap(&r1[0], &gib[0], gib.size(), &gb[0], N * N * 2, 12, 1e-2f, NULL, 0, 0.f, NULL, 0, 0.f, simplifyParallelScheduler, &tasks);
+	size_t u2 = meshopt_generateWeldRemap(&r2[0], &gib[0], gib.size(), &gb[0], N * N * 2, 12, 1e-2f, NULL, 0, 0.f, NULL, 0, 0.f, NULL, NULL);
+
+	assert(tasks > 1);
+	assert(u1 == N * N && u2 == u1);
+	assert(r1 == r2);
+
+	std::vector<unsigned int> wib(gib.size());
+	meshopt_remapIndexBuffer(&wib[0], &gib[0], gib.size(), &r1[0]);
+
+	std::vector<float> wvb(u1 * 3);
+	meshopt_remapVertexBuffer(&wvb[0], &gb[0], N * N * 2, 12, &r1[0]);
+
+	// welded mesh has no gaps in vertex cache optimized order as the vertices are shared between quads
+	std::vector<unsigned int> oib(gib.size());
+	meshopt_optimizeVertexCache(&oib[0], &wib[0], wib.size(), u1);
+	assert(meshopt_analyzeVertexCache(&oib[0], oib.size(), u1, 16, 0, 0).atvr < 1.3f);
+}
+
+static void reindexMesh()
+{
+	// two streams with a duplicate vertex (0 and 3) and an unused vertex (4); vertices are referenced out of order
+	const float pos[] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 5, 5, 5};
+	const unsigned short uv[] = {1, 2, 3, 4, 5, 6, 1, 2, 7, 8};
+	const unsigned int ib[] = {2, 1, 0, 1, 2, 3};
+
+	meshopt_Stream streams[] = {
+	    {pos, 12, 12},
+	    {uv, 4, 4},
+	};
+
+	float rpos[5 * 3];
+	unsigned short ruv[5 * 2];
+	void* dest[] = {rpos, ruv};
+
+	unsigned int rib[6];
+	assert(meshopt_reindexMesh(rib, dest, ib, 6, 5, streams, 2) == 3);
+
+	const unsigned int expib[] = {0, 1, 2, 1, 0, 2};
+	const float exppos[] = {0, 1, 0, 1, 0, 0, 0, 0, 0};
+	const unsigned short expuv[] = {5, 6, 3, 4, 1, 2};
+
+	assert(memcmp(rib, expib, sizeof(expib)) == 0);
+	assert(memcmp(rpos, exppos, sizeof(exppos)) == 0);
+	assert(memcmp(ruv, expuv, sizeof(expuv)) == 0);
+
+	// matches the result of separate remap calls followed by vertex fetch optimization
+	unsigned int remap[5];
+	size_t unique = meshopt_generateVertexRemapMulti(remap, ib, 6, 5, streams, 2);
+
+	unsigned int sib[6];
+	meshopt_remapIndexBuffer(sib, ib, 6, remap);
+
+	float spos[5 * 3];
+	meshopt_remapVertexBuffer(spos, pos, 5, 12, remap);
+	meshopt_optimizeVertexFetch(spos, sib, 6, spos, unique, 12);
+
+	assert(memcmp(sib, rib, sizeof(rib)) == 0);
+	assert(memcmp(spos, rpos, unique * 12) == 0);
+
+	// in-place index buffer and unindexed input using a 16-bit index buffer
+	unsigned short ib16[] = {0, 1, 2, 3, 1, 2};
+	assert(meshopt_reindexMesh(ib16, dest, ib16, 6, 5, streams, 2) == 3);
+	assert(ib16[0] == 0 && ib16[3] == 0 && ib16[4] == 1 && ib16[5] == 2);
+
+	unsigned int unindexed[6];
+	assert(meshopt_reindexMesh(unindexed, dest, (const unsigned int*)NULL, 3, 3, streams, 1) == 3);
+	assert(unindexed[0] == 0 && unindexed[1] == 1 && unindexed[2] == 2);
+}
+
+static void generateVertexRemapParallel()
+{
+	// needs enough vertices to use several chunks; vertices repeat with a period that isn't aligned to chunks
+	const size_t vertex_count = 210000;
+
+	std::vector<float> vb(vertex_count * 3);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		size_t k = (i * 7) % 70001;
+
+		vb[i * 3 + 0] = float(k % 97);
+		vb[i * 3 + 1] = float(k / 97);
+		vb[i * 3 + 2] = 0.f;
+	}
+
+	// index buffer visits vertices out of order and leaves some vertices unreferenced
+	std::vector<unsigned int> ib(150000 * 3);
+
+	for (size_t i = 0; i < ib.size(); ++i)
+		ib[i] = unsigned((i * 104729) % (vertex_count - 1000));
+
+	std::vector<unsigned int> ref(vertex_count), result(vertex_count);
+
+	size_t tasks = 0;
+	size_t unique = meshopt_generateVertexRemap(&ref[0], &ib[0], ib.size(), &vb[0], vertex_count, 12);
+	assert(meshopt_generateVertexRemapParallel(&result[0], &ib[0], ib.size(), &vb[0], vertex_count, 12, simplifyParallelScheduler, &tasks) == unique);
+	assert(result == ref);
+	assert(tasks > 0);
+	assert(ref[vertex_count - 1] == ~0u);
+
+	// unindexed input, multiple streams and NULL scheduler
+	meshopt_Stream streams[] = {
+	    {&vb[0], 8, 12},
+	    {&vb[2], 4, 12},
+	};
+
+	unique = meshopt_generateVertexRemapMulti(&ref[0], NULL, vertex_count, vertex_count, streams, 2);
+	assert(unique == 70001);
+	assert(meshopt_generateVertexRemapMultiParallel(&result[0], NULL, vertex_count, vertex_count, streams, 2, NULL, NULL) == unique);
+	assert(result == ref);
+
+	// small meshes are processed serially
+	for (size_t i = 0; i < 999; ++i)
+		ib[i] = unsigned((i * 7) % 1000);
+
+	unique = meshopt_generateVertexRemap(&ref[0], &ib[0], 999, &vb[0], 1000, 12);
+	assert(meshopt_generateVertexRemapParallel(&result[0], &ib[0], 999, &vb[0], 1000, 12, NULL, NULL) == unique);
+	assert(memcmp(&result[0], &ref[0], 1000 * sizeof(unsigned int)) == 0);
+}
+
+static void sortOverdrawClusters()
+{
+	// four disjoint unit quads stacked along Z, facing +Z
+	float vb[4 * 4 * 3];
+	unsigned int ib[4 * 6];
+
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int k = 0; k < 4; ++k)
+		{
+			vb[(i * 4 + k) * 3 + 0] = float(k & 1);
+			vb[(i * 4 + k) * 3 + 1] = float(k >> 1);
+			vb[(i * 4 + k) * 3 + 2] = float(i);
+		}
+
+		unsigned int v0 = unsigned(i * 4);
+		unsigned int* quad = &ib[i * 6];
+
+		quad[0] = v0, quad[1] = v0 + 1, quad[2] = v0 + 2;
+		quad[3] = v0 + 2, quad[4] = v0 + 1, quad[5] = v0 + 3;
+	}
+
+	// every quad starts with a full cache miss so it ends up in a separate cluster
+	unsigned int clusters[4 * 2];
+	size_t cluster_count = meshopt_generateOverdrawClusters(clusters, ib, 24, 16, 1.05f);
+
+	assert(cluster_count == 4);
+	assert(clusters[0] == 0 && clusters[1] == 2 && clusters[2] == 4 && clusters[3] == 6);
+
+	// the first view sees front faces, the second view sees back faces
+	const float views[] = {0, 0, -2, 0, 0, 1};
+
+	unsigned int orders[2 * 4];
+	meshopt_sortOverdrawClusters(orders, ib, 24, vb, 16, 12, clusters, cluster_count, views, 2);
+
+	// both orders are front to back
+	const unsigned int expected[] = {3, 2, 1, 0, 0, 1, 2, 3};
+	assert(memcmp(orders, expected, sizeof(expected)) == 0);
+
+	// rendering clusters in the order for the first view shades each pixel once; reverse order shades each pixel four times
+	unsigned int sorted[24], reversed[24];
+
+	for (size_t i = 0; i < cluster_count; ++i)
+	{
+		memcpy(&sorted[i * 6], &ib[clusters[orders[i]] * 3], 6 * sizeof(unsigned int));
+		memcpy(&reversed[i * 6], &ib[clusters[orders[cluster_count - 1 - i]] * 3], 6 * sizeof(unsigned int));
+	}
+
+	meshopt_OverdrawStatistics os = meshopt_analyzeOverdrawViews(sorted, 24, vb, 16, 12, views, 1, 64, NULL, NULL);
+	meshopt_OverdrawStatistics osr = meshopt_analyzeOverdrawViews(reversed, 24, vb, 16, 12, views, 1, 64, NULL, NULL);
+	assert(os.pixels_covered > 0 && os.overdraw == 1.f);
+	assert(osr.pixels_covered == os.pixels_covered && osr.overdraw == 4.f);
+
+	// facing clusters come before clusters facing away regardless of depth
+	float vbf[4 * 4 * 3];
+	memcpy(vbf, vb, sizeof(vb));
+
+	for (int k = 0; k < 4; ++k)
+		vbf[(1 * 4 + k) * 3 + 0] = 1.f - vbf[(1 * 4 + k) * 3 + 0];
+
+	meshopt_sortOverdrawClusters(orders, ib, 24, vbf, 16, 12, clusters, cluster_count, views, 1);
+
+	const unsigned int expectedf[] = {3, 2, 0, 1};
+	assert(memcmp(orders, expectedf, sizeof(expectedf)) == 0);
+}
+
+static void analyzeOverdrawDepth()
+{
+	// two unit quads that intersect along x = 0.5; each quad is in front of the other one on one side of the intersection
+	const float vb[] = {
+	    0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1,
+	    0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 0, // clang-format :-/
+	};
+
+	const unsigned int ib[] = {0, 1, 2, 2, 1, 3, 4, 5, 6, 6, 5, 7};
+
+	// the second quad is only shaded on the half where it's in front of the first quad, which requires correct depth gradients
+	meshopt_OverdrawStatistics os = meshopt_analyzeOverdraw(ib, 12, vb, 8, 12);
+	assert(os.pixels_covered == 196608);
+	assert(os.pixels_shaded == 229376);
+}
+
+static void analyzeOverdrawViews()
+{
+	// two overlapping unit quads facing +Z; when viewing along -Z, the quad at Z=0 is further away and is rendered first
+	const float vb[] = {
+	    0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0,
+	    0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, // clang-format :-/
+	};
+
+	const unsigned int ib[] = {0, 1, 2, 2, 1, 3, 4, 5, 6, 6, 5, 7};
+	const unsigned int ibr[] = {4, 5, 6, 6, 5, 7, 0, 1, 2, 2, 1, 3};
+
+	const float views[] = {0, 0, -1, 0, 0, 1};
+
+	size_t tasks = 0;
+	meshopt_OverdrawStatistics os = meshopt_analyzeOverdrawViews(ib, 12, vb, 8, 12, views, 1, 512, simplifyParallelScheduler, &tasks);
+	assert(tasks == 2); // two bands of rows
+
+	// the quads cover the entire image and every pixel is shaded twice when rendering back to front
+	assert(os.pixels_covered == 512 * 512);
+	assert(os.pixels_shaded == 512 * 512 * 2);
+
+	meshopt_OverdrawStatistics osr = meshopt_analyzeOverdrawViews(ibr, 12, vb, 8, 12, views, 1, 512, NULL, NULL);
+	assert(osr.pixels_covered == 512 * 512);
+	assert(osr.pixels_shaded == 512 * 512);
+
+	// opposite view direction renders the quads as back faces with reversed depth, which produces the same results
+	meshopt_OverdrawStatistics osb = meshopt_analyzeOverdrawViews(ib, 12, vb, 8, 12, views + 3, 1, 512, NULL, NULL);
+	assert(osb.pixels_covered == os.pixels_covered);
+	assert(osb.pixels_shaded == os.pixels_shaded);
+
+	// results don't depend on the scheduler
+	const size_t N = 33;
+
+	std::vector<float> gb;
+	std::vector<unsigned int> gib;
+	makeGridMesh(gb, gib, N, gridWave, 1);
+
+	const float gviews[] = {1, 1, 1, -1, 0.5f, 0.2f, 0, 0, 1, 0, 1, 0};
+
+	tasks = 0;
+	meshopt_OverdrawStatistics gs1 = meshopt_analyzeOverdrawViews(&gib[0], gib.size(), &gb[0], N * N, 12, gviews, 4, 1000, simplifyParallelScheduler, &tasks);
+	meshopt_OverdrawStatistics gs2 = meshopt_analyzeOverdrawViews(&gib[0], gib.size(), &gb[0], N * N, 12, gviews, 4, 1000, NULL, NULL);
+	assert(tasks == 16);
+	assert(gs1.pixels_covered == gs2.pixels_covered && gs1.pixels_shaded == gs2.pixels_shaded);
+	assert(gs1.pixels_covered > 0 && gs1.overdraw >= 1.f);
+
+	// default views match meshopt_analyzeOverdraw
+	meshopt_OverdrawStatistics ds1 = meshopt_analyzeOverdraw(&gib[0], gib.size(), &gb[0], N * N, 12);
+	meshopt_OverdrawStatistics ds2 = meshopt_analyzeOverdrawViews(&gib[0], gib.size(), &gb[0], N * N, 12, NULL, 0, 256, NULL, NULL);
+	assert(ds1.pixels_covered == ds2.pixels_covered && ds1.pixels_shaded == ds2.pixels_shaded);
+}
+
+static void buildMeshletsParallel()
+{
+	// needs enough triangles to split the mesh into several partitions
+	const size_t N = 129;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridBumps7, 1);
+
+	const size_t max_vertices = 64, max_triangles = 124;
+	size_t bound = meshopt_buildMeshletsBound(ib.size(), max_vertices, max_triangles);
+
+	std::vector<meshopt_Meshlet> meshlets1(bound), meshlets2(bound);
+	std::vector<unsigned int> vertices1(bound * max_vertices), vertices2(bound * max_vertices);
+	std::vector<unsigned char> triangles1(bound * max_triangles * 3), triangles2(bound * max_triangles * 3);
+
+	size_t tasks = 0;
+	size_t count1 = meshopt_buildMeshletsParallel(&meshlets1[0], &vertices1[0], &triangles1[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 0.f, 4, simplifyParallelScheduler, &tasks);
+	assert(tasks == 4);
+	assert(count1 > 0 && count1 <= bound);
+
+	// meshlets cover every triangle exactly once, so every vertex is referenced as many times as in the source mesh
+	std::vector<unsigned int> refs(N * N);
+	size_t triangle_count = 0;
+
+	for (size_t i = 0; i < count1; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets1[i];
+		assert(m.vertex_count <= max_vertices && m.triangle_count <= max_triangles);
+
+		for (size_t j = 0; j < m.triangle_count * 3; ++j)
+		{
+			unsigned char v = triangles1[m.triangle_offset + j];
+			assert(v < m.vertex_count);
+
+			refs[vertices1[m.vertex_offset + v]]++;
+		}
+
+		triangle_count += m.triangle_count;
+	}
+
+	assert(triangle_count * 3 == ib.size());
+
+	for (size_t i = 0; i < ib.size(); ++i)
+		refs[ib[i]]--;
+
+	for (size_t i = 0; i < N * N; ++i)
+		assert(refs[i] == 0);
+
+	// partition seams only add a few meshlets compared to the serial builder
+	size_t serial = meshopt_buildMeshlets(&meshlets2[0], &vertices2[0], &triangles2[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 0.f);
+	assert(count1 <= serial + serial / 10);
+
+	// NULL scheduler produces the same meshlets
+	size_t count2 = meshopt_buildMeshletsParallel(&meshlets2[0], &vertices2[0], &triangles2[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 0.f, 4, NULL, NULL);
+	assert(count1 == count2);
+	assert(memcmp(&meshlets1[0], &meshlets2[0], count1 * sizeof(meshopt_Meshlet)) == 0);
+
+	const meshopt_Meshlet& last = meshlets1[count1 - 1];
+	assert(memcmp(&vertices1[0], &vertices2[0], (last.vertex_offset + last.vertex_count) * sizeof(unsigned int)) == 0);
+	assert(memcmp(&triangles1[0], &triangles2[0], last.triangle_offset + last.triangle_count * 3) == 0);
+}
+
+static void buildClusterLod()
+{
+	const size_t N = 97;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridHills, 1);
+
+	const size_t max_vertices = 64, max_triangles = 124;
+	size_t bound = meshopt_buildClusterLodBound(ib.size(), max_vertices, max_triangles);
+
+	std::vector<meshopt_ClusterLod> clusters(bound);
+	std::vector<unsigned int> vertices(bound * max_vertices);
+	std::vector<unsigned char> triangles(bound * max_triangles * 3);
+
+	size_t tasks = 0;
+	size_t count = meshopt_buildClusterLod(&clusters[0], &vertices[0], &triangles[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 8, simplifyParallelScheduler, &tasks);
+	assert(tasks > 0);
+	assert(count > 0 && count <= bound);
+
+	size_t levels = 0, roots = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const meshopt_ClusterLod& c = clusters[i];
+		assert(c.vertex_count <= max_vertices && c.triangle_count <= max_triangles);
+		assert(c.parent_error >= c.self_error);
+		assert(c.level == 0 ? c.self_error == 0.f : c.self_error > 0.f);
+
+		levels = c.level + 1 > levels ? c.level + 1 : levels;
+		roots += c.parent_error == FLT_MAX;
+	}
+
+	assert(levels > 2);
+	assert(roots > 0 && roots < count / 10);
+
+	// every cut through the hierarchy covers the grid without cracks or overlaps; since grid borders are preserved, the area projected to XY plane is unchanged
+	float cuts[] = {0.f, 0.05f, 0.2f, 1.f, 1e30f};
+
+	for (size_t k = 0; k < sizeof(cuts) / sizeof(cuts[0]); ++k)
+	{
+		double area = 0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const meshopt_ClusterLod& c = clusters[i];
+
+			if (c.self_error > cuts[k] || c.parent_error <= cuts[k])
+				continue;
+
+			for (size_t j = 0; j < c.triangle_count; ++j)
+			{
+				const float* a = &vb[vertices[c.vertex_offset + triangles[c.triangle_offset + j * 3 + 0]] * 3];
+				const float* b = &vb[vertices[c.vertex_offset + triangles[c.triangle_offset + j * 3 + 1]] * 3];
+				const float* d = &vb[vertices[c.vertex_offset + triangles[c.triangle_offset + j * 3 + 2]] * 3];
+
+				area += ((b[0] - a[0]) * (d[1] - a[1]) - (b[1] - a[1]) * (d[0] - a[0])) * 0.5;
+			}
+		}
+
+		assert(fabs(area - double((N - 1) * (N - 1))) < 1e-3);
+	}
+
+	// NULL scheduler produces the same hierarchy
+	std::vector<meshopt_ClusterLod> clusters2(bound);
+	std::vector<unsigned int> vertices2(bound * max_vertices);
+	std::vector<unsigned char> triangles2(bound * max_triangles * 3);
+
+	size_t count2 = meshopt_buildClusterLod(&clusters2[0], &vertices2[0], &triangles2[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 8, NULL, NULL);
+	assert(count == count2);
+	assert(memcmp(&clusters[0], &clusters2[0], count * sizeof(meshopt_ClusterLod)) == 0);
+
+	const meshopt_ClusterLod& last = clusters[count - 1];
+	assert(memcmp(&vertices[0], &vertices2[0], (last.vertex_offset + last.vertex_count) * sizeof(unsigned int)) == 0);
+	assert(memcmp(&triangles[0], &triangles2[0], last.triangle_offset + last.triangle_count * 3) == 0);
+}
+
+static void computeMeshletBoundsBatch()
+{
+	const size_t N = 129;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+	makeGridMesh(vb, ib, N, gridHills, 1);
+
+	const size_t max_vertices = 64, max_triangles = 124;
+	size_t bound = meshopt_buildMeshletsBound(ib.size(), max_vertices, max_triangles);
+
+	std::vector<meshopt_Meshlet> meshlets(bound);
+	std::vector<unsigned int> meshlet_vertices(bound * max_vertices);
+	std::vector<unsigned char> meshlet_triangles(bound * max_triangles * 3 + 4);
+
+	size_t count = meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], N * N, 12, max_vertices, max_triangles, 0.f);
+	assert(count > 256); // multiple tasks
+
+	// degenerate meshlet reuses the vertices of the first meshlet
+	meshopt_Meshlet& degenerate = meshlets[count];
+	degenerate.vertex_offset = 0;
+	degenerate.vertex_count = 3;
+	degenerate.triangle_offset = unsigned(bound * max_triangles * 3);
+	degenerate.triangle_count = 1;
+	memset(&meshlet_triangles[degenerate.triangle_offset], 0, 3);
+	count++;
+
+	std::vector<meshopt_Bounds> bounds(count);
+	std::vector<meshopt_PackedBounds> packed(count);
+
+	size_t tasks = 0;
+	meshopt_computeMeshletBoundsBatch(&bounds[0], &packed[0], &meshlets[0], count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], N * N, 12, simplifyParallelScheduler, &tasks);
+	assert(tasks > 1);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+		const meshopt_Bounds& b = bounds[i];
+
+		meshopt_Bounds ref = meshopt_computeMeshletBounds(&meshlet_vertices[m.vertex_offset], &meshlet_triangles[m.triangle_offset], m.triangle_count, &vb[0], N * N, 12);
+
+		// normal cone is computed from the same triangle normals
+		assert(memcmp(b.cone_axis, ref.cone_axis, sizeof(b.cone_axis)) == 0);
+		assert(b.cone_cutoff == ref.cone_cutoff);
+		assert(memcmp(b.cone_axis_s8, ref.cone_axis_s8, sizeof(b.cone_axis_s8)) == 0);
+		assert(b.cone_cutoff_s8 == ref.cone_cutoff_s8);
+
+		// sphere is computed from a different set of points but should have a similar size and contain all vertices
+		assert(b.radius <= ref.radius * 1.1f && b.radius >= ref.radius * 0.9f);
+
+		if (i + 1 < count)
+			for (size_t j = 0; j < m.vertex_count; ++j)
+			{
+				const float* p = &vb[meshlet_vertices[m.vertex_offset + j] * 3];
+				float dx = p[0] - b.center[0], dy = p[1] - b.center[1], dz = p[2] - b.center[2];
+
+				assert(sqrtf(dx * dx + dy * dy + dz * dz) <= b.radius * (1 + 1e-5f));
+			}
+
+		assert(memcmp(packed[i].center, b.center, sizeof(b.center)) == 0 && packed[i].radius == b.radius);
+		assert(memcmp(packed[i].cone_axis_s8, b.cone_axis_s8, sizeof(b.cone_axis_s8)) == 0 && packed[i].cone_cutoff_s8 == b.cone_cutoff_s8);
+	}
+
+	// degenerate meshlets get empty bounds, same as meshopt_computeMeshletBounds
+	const meshopt_Bounds zero = {};
+	assert(memcmp(&bounds[count - 1], &zero, sizeof(zero)) == 0);
+
+	// NULL scheduler produces the same bounds; either output can be omitted
+	std::vector<meshopt_Bounds> bounds2(count);
+	std::vector<meshopt_PackedBounds> packed2(count);
+
+	meshopt_computeMeshletBoundsBatch(&bounds2[0], NULL, &meshlets[0], count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], N * N, 12, NULL, NULL);
+	meshopt_computeMeshletBoundsBatch(NULL, &packed2[0], &meshlets[0], count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], N * N, 12, NULL, NULL);
+
+	assert(memcmp(&bounds[0], &bounds2[0], count * sizeof(meshopt_Bounds)) == 0);
+	assert(memcmp(&packed[0], &packed2[0], count * sizeof(meshopt_PackedBounds)) == 0);
+}
+
+static void adjacency()
+{
+	// 0 1/4
+	// 2/5 3
+	const float vb[] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 0, 1, 0};
+	const unsigned int ib[] = {0, 1, 2, 5, 4, 3};
+
+	unsigned int adjib[12];
+	meshopt_generateAdjacencyIndexBuffer(adjib, ib, 6, vb, 6, 12);
+
+	unsigned int expected[] = {
+	    // patch 0
+	    0, 0,
+	    1, 3,
+	    2, 2,
+
+	    // patch 1
+	    5, 0,
 	    4, 4,
 	    3, 3,
 
@@ -1493,10 +3208,100 @@ static void dequantizeHalf()
 	assert(nanf != nanf);
 }
 
+static void quantizeArray()
+{
+	// float bit patterns cover all exponents including denormals, inf and nan; vectors are 3 wide with a 4-float stride
+	const size_t count = 70001;
+
+	std::vector<float> data(count * 4);
+
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		unsigned int bits = unsigned(i) * 61379u;
+		memcpy(&data[i], &bits, 4);
+	}
+
+	std::vector<unsigned short> half(count * 4);
+
+	meshopt_quantizeHalfArray(&half[0], 8, &data[0], 16, count, 3);
+
+	for (size_t i = 0; i < count; ++i)
+		for (size_t j = 0; j < 4; ++j)
+			assert(half[i * 4 + j] == (j < 3 ? meshopt_quantizeHalf(data[i * 4 + j]) : 0));
+
+	meshopt_quantizeHalfArray(&half[0], 2, &data[0], 4, data.size(), 1);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		assert(half[i] == meshopt_quantizeHalf(data[i]));
+
+	// all half values roundtrip through dequantization exactly like the scalar version, including nan payloads
+	std::vector<unsigned short> halfs(65536);
+	std::vector<float> floats(65536 * 2);
+
+	for (size_t i = 0; i < halfs.size(); ++i)
+		halfs[i] = (unsigned short)(i);
+
+	meshopt_dequantizeHalfArray(&floats[0], 4, &halfs[0], 2, 65536, 1);
+
+	for (size_t i = 0; i < halfs.size(); ++i)
+	{
+		float r = meshopt_dequantizeHalf((unsigned short)(i));
+		assert(memcmp(&floats[i], &r, 4) == 0);
+	}
+
+	meshopt_dequantizeHalfArray(&floats[0], 8, &halfs[0], 2, 65536, 1);
+
+	for (size_t i = 0; i < halfs.size(); ++i)
+	{
+		float r = meshopt_dequantizeHalf((unsigned short)(i));
+		assert(memcmp(&floats[i * 2], &r, 4) == 0);
+	}
+
+	// normalized values around and outside of the valid range, along with nan
+	volatile float zero = 0.f; // avoids div-by-zero warnings
+
+	std::vector<float> norm(4001 * 3);
+
+	for (size_t i = 0; i < norm.size(); ++i)
+		norm[i] = float(int(i) - 6000) / 5000.f;
+
+	norm[7] = zero / zero;
+	norm[8] = 1.f / zero;
+	norm[9] = -1.f / zero;
+
+	const int bits[] = {2, 8, 10, 16, 20};
+
+	for (size_t k = 0; k < sizeof(bits) / sizeof(bits[0]); ++k)
+	{
+		int N = bits[k];
+		size_t size = N <= 8 ? 1 : N <= 16 ? 2 : 4;
+
+		// destination has one padding element per vector
+		std::vector<unsigned char> unorm(4001 * 4 * size), snorm(4001 * 4 * size);
+
+		meshopt_quantizeUnormArray(&unorm[0], 4 * size, &norm[0], 12, 4001, 3, N);
+		meshopt_quantizeSnormArray(&snorm[0], 4 * size, &norm[0], 12, 4001, 3, N);
+
+		for (size_t i = 0; i < 4001; ++i)
+			for (size_t j = 0; j < 3; ++j)
+			{
+				const unsigned char* ue = &unorm[(i * 4 + j) * size];
+				const unsigned char* se = &snorm[(i * 4 + j) * size];
+
+				int ur = size == 1 ? *ue : size == 2 ? *(const unsigned short*)ue : *(const int*)ue;
+				int sr = size == 1 ? *(const signed char*)se : size == 2 ? *(const short*)se : *(const int*)se;
+
+				assert(ur == meshopt_quantizeUnorm(norm[i * 3 + j], N));
+				assert(sr == meshopt_quantizeSnorm(norm[i * 3 + j], N));
+			}
+	}
+}
+
 void runTests()
 {
 	decodeIndexV0();
 	decodeIndexV1();
+	decodeIndexOffset();
 	decodeIndex16();
 	encodeIndexMemorySafe();
 	decodeIndexMemorySafe();
@@ -1508,9 +3313,11 @@ void runTests()
 	encodeIndexEmpty();
 
 	decodeIndexSequence();
+	decodeIndexSequenceOffset();
 	decodeIndexSequence16();
 	encodeIndexSequenceMemorySafe();
 	decodeIndexSequenceMemorySafe();
+	decodeIndexSequencePartial();
 	decodeIndexSequenceRejectExtraBytes();
 	decodeIndexSequenceRejectMalformedHeaders();
 	decodeIndexSequenceRejectInvalidVersion();
@@ -1524,22 +3331,33 @@ void runTests()
 	decodeVertexBitGroups();
 	decodeVertexBitGroupSentinels();
 	decodeVertexLarge();
+	decodeVertexBlocks();
+	encodeVertexBlocks();
+	decodeVertexPartial();
 	encodeVertexEmpty();
 
 	decodeFilterOct8();
 	decodeFilterOct12();
 	decodeFilterQuat12();
 	decodeFilterExp();
+	decodeFilterFused();
 
 	encodeFilterOct8();
 	encodeFilterOct12();
 	encodeFilterQuat12();
 	encodeFilterExp();
 	encodeFilterExpZero();
+	encodeFilterBatch();
 
 	clusterBoundsDegenerate();
 
+	roundtripMeshlets();
+	encodeMeshletsMemorySafe();
+	decodeMeshletsMemorySafe();
+
 	customAllocator();
+	contextAllocator();
+	contextAllocate();
 
 	emptyMesh();
 
@@ -1555,6 +3373,26 @@ void runTests()
 	simplifyLockFlags();
 	simplifySparse();
 	simplifyErrorAbsolute();
+	simplifyLods();
+	simplifyParallel();
+	simplifySloppyParallel();
+	simplifySloppyStream();
+	simplifyPointsLods();
+
+	optimizeVertexCacheTable();
+	optimizeVertexCacheParallel();
+	analyzeOverdrawDepth();
+	analyzeOverdrawViews();
+	sortOverdrawClusters();
+	generateVertexRemapParallel();
+	reindexMesh();
+	generateWeldRemap();
+	spatialSortRemapParallel();
+	stripifyWindowed();
+	analyzeMesh();
+	buildMeshletsParallel();
+	buildClusterLod();
+	computeMeshletBoundsBatch();
 
 	adjacency();
 	tessellation();
@@ -1562,4 +3400,5 @@ void runTests()
 	quantizeFloat();
 	quantizeHalf();
 	dequantizeHalf();
+	quantizeArray();
 }
@@ -137,6 +137,8 @@ static void resampleKeyframes(std::vector<Attr>& data, const std::vector<float>&
 {
 	size_t cursor = 0;
 
+	data.reserve(size_t(frames) * components);
+
 	for (int i = 0; i < frames; ++i)
 	{
 		float time = mint + float(i) / freq;
@@ -274,7 +276,7 @@ static float getWorldScale(cgltf_node* node)
 	return powf(fabsf(det), 1.f / 3.f);
 }
 
-void processAnimation(Animation& animation, const Settings& settings)
+void prepareAnimation(Animation& animation, const Settings& settings)
 {
 	float mint = FLT_MAX, maxt = 0;
 
@@ -296,41 +298,39 @@ void processAnimation(Animation& animation, const Settings& settings)
 
 	animation.start = mint;
 	animation.frames = frames;
+}
 
-	std::vector<Attr> base;
-
-	for (size_t i = 0; i < animation.tracks.size(); ++i)
-	{
-		Track& track = animation.tracks[i];
+void processAnimationTrack(Track& track, const Animation& animation, const Settings& settings)
+{
+	int frames = animation.frames;
 
-		std::vector<Attr> result;
-		resampleKeyframes(result, track.time, track.data, track.path, track.interpolation, track.components, frames, mint, settings.anim_freq);
+	std::vector<Attr> result;
+	resampleKeyframes(result, track.time, track.data, track.path, track.interpolation, track.components, frames, animation.start, settings.anim_freq);
 
-		track.time.clear();
-		track.data.swap(result);
+	std::vector<float>().swap(track.time);
+	track.data.swap(result);
 
-		float tolerance = getDeltaTolerance(track.path);
+	float tolerance = getDeltaTolerance(track.path);
 
-		// translation tracks use world space tolerance; in the future, we should compute all errors as linear using hierarchy
-		if (track.node && track.node->parent && track.path == cgltf_animation_path_type_translation)
-		{
-			float scale = getWorldScale(track.node->parent);
-			tolerance /= scale == 0.f ? 1.f : scale;
-		}
+	// translation tracks use world space tolerance; in the future, we should compute all errors as linear using hierarchy
+	if (track.node && track.node->parent && track.path == cgltf_animation_path_type_translation)
+	{
+		float scale = getWorldScale(track.node->parent);
+		tolerance /= scale == 0.f ? 1.f : scale;
+	}
 
-		float deviation = getMaxDelta(track.data, track.path, frames, &track.data[0], track.components);
+	float deviation = getMaxDelta(track.data, track.path, frames, &track.data[0], track.components);
 
-		if (deviation <= tolerance)
-		{
-			// track is constant (equal to first keyframe), we only need the first keyframe
-			track.constant = true;
-			track.data.resize(track.components);
+	if (deviation <= tolerance)
+	{
+		// track is constant (equal to first keyframe), we only need the first keyframe
+		track.constant = true;
+		track.data.resize(track.components);
 
-			// track.dummy is true iff track redundantly sets up the value to be equal to default node transform
-			base.resize(track.components);
-			getBaseTransform(&base[0], track.components, track.path, track.node);
+		// track.dummy is true iff track redundantly sets up the value to be equal to default node transform
+		std::vector<Attr> base(track.components);
+		getBaseTransform(&base[0], track.components, track.path, track.node);
 
-			track.dummy = getMaxDelta(track.data, track.path, 1, &base[0], track.components) <= tolerance;
-		}
+		track.dummy = getMaxDelta(track.data, track.path, 1, &base[0], track.components) <= tolerance;
 	}
 }
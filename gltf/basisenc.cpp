@@ -14,6 +14,7 @@
 #endif
 
 #include "encoder/basisu_comp.h"
+#include "transcoder/basisu_transcoder.h"
 
 #include "gltfpack.h"
 
@@ -94,7 +95,7 @@ static void fillParams(basisu::basis_compressor_params& params, const char* inpu
 	params.m_status_output = false;
 }
 
-static const char* prepareEncode(basisu::basis_compressor_params& params, const cgltf_image& image, const char* input_path, const ImageInfo& info, const Settings& settings, const std::string& temp_prefix, std::string& temp_input, std::string& temp_output)
+static const char* prepareEncode(basisu::basis_compressor_params& params, std::string& encoded, uint64_t& cache_key, const cgltf_image& image, const char* input_path, const ImageInfo& info, const Settings& settings, const std::string& temp_prefix, std::string& temp_input, std::string& temp_output)
 {
 	std::string img_data;
 	std::string mime_type;
@@ -111,15 +112,33 @@ static const char* prepareEncode(basisu::basis_compressor_params& params, const
 
 	adjustDimensions(width, height, settings);
 
+	int quality = settings.texture_quality[info.kind];
+	bool uastc = settings.texture_mode[info.kind] == TextureMode_UASTC;
+
+	if (settings.cache_path)
+	{
+		// the key covers everything fillParams depends on
+		cache_key = hashCacheSeed("ktx2");
+		cache_key = hashCache(cache_key, img_data.data(), img_data.size());
+		cache_key = hashCache(cache_key, width);
+		cache_key = hashCache(cache_key, height);
+		cache_key = hashCache(cache_key, uastc);
+		cache_key = hashCache(cache_key, quality);
+		cache_key = hashCache(cache_key, info.srgb);
+		cache_key = hashCache(cache_key, info.normal_map);
+		cache_key = hashCache(cache_key, settings.texture_flipy);
+		cache_key = hashCache(cache_key, BASISD_LIB_VERSION);
+
+		if (readCache(settings, "ktx2", cache_key, encoded))
+			return NULL;
+	}
+
 	temp_input = temp_prefix + mimeExtension(mime_type.c_str());
 	temp_output = temp_prefix + ".ktx2";
 
 	if (!writeFile(temp_input.c_str(), img_data))
 		return "error writing temporary file";
 
-	int quality = settings.texture_quality[info.kind];
-	bool uastc = settings.texture_mode[info.kind] == TextureMode_UASTC;
-
 	const BasisSettings& bs = kBasisSettings[quality - 1];
 
 	fillParams(params, temp_input.c_str(), temp_output.c_str(), uastc, width, height, bs, info, settings);
@@ -133,6 +152,7 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 
 	basisu::vector<basisu::basis_compressor_params> params(data->images_count);
 	basisu::vector<basisu::parallel_results> results(data->images_count);
+	std::vector<uint64_t> cache_keys(data->images_count);
 
 	std::string temp_prefix = getTempPrefix();
 
@@ -147,7 +167,7 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 		if (settings.texture_mode[info.kind] == TextureMode_Raw)
 			continue;
 
-		if (const char* error = prepareEncode(params[i], image, input_path, info, settings, temp_prefix + "-" + std::to_string(i), temp_inputs[i], temp_outputs[i]))
+		if (const char* error = prepareEncode(params[i], encoded[i], cache_keys[i], image, input_path, info, settings, temp_prefix + "-" + std::to_string(i), temp_inputs[i], temp_outputs[i]))
 			encoded[i] = error;
 
 		// image is ready to encode in parallel
@@ -160,13 +180,15 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 	for (size_t i = 0; i < data->images_count; ++i)
 	{
 		if (params[i].m_source_filenames.empty())
-			; // encoding was skipped or preparation resulted in an error
+			; // encoding was skipped, the image was found in the cache or preparation resulted in an error
 		else if (results[i].m_error_code == basisu::basis_compressor::cECFailedReadingSourceImages)
 			encoded[i] = "error decoding source image";
 		else if (results[i].m_error_code != basisu::basis_compressor::cECSuccess)
 			encoded[i] = "error encoding image";
 		else if (!readFile(temp_outputs[i].c_str(), encoded[i]))
 			encoded[i] = "error reading temporary file";
+		else
+			writeCache(settings, "ktx2", cache_keys[i], encoded[i]);
 	}
 
 	for (size_t i = 0; i < data->images_count; ++i)
@@ -0,0 +1,323 @@
+// This file is part of gltfpack; see gltfpack.h for version/license details
+#include "gltfpack.h"
+
+#include <atomic>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <process.h>
+#elif !defined(__wasi__)
+#include <unistd.h>
+#endif
+
+#include "../src/meshoptimizer.h"
+
+// bump when the contents of cached items change for the same inputs; hashCacheSeed mixes this and the library version into every key
+static const uint64_t kCacheVersion = 3;
+
+static uint64_t rotl64(uint64_t v, int r)
+{
+	return (v << r) | (v >> (64 - r));
+}
+
+static uint64_t hashMix(uint64_t h, uint64_t k)
+{
+	// MurmurHash3 x64 mixing step
+	k *= 0xc4ceb9fe1a85ec53ull;
+	k = rotl64(k, 31);
+	k *= 0xff51afd7ed558ccdull;
+
+	h ^= k;
+	h = rotl64(h, 27);
+	return h * 5 + 0x52dce729;
+}
+
+uint64_t hashCache(uint64_t hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	hash = hashMix(hash, size);
+
+	while (size >= 8)
+	{
+		uint64_t k;
+		memcpy(&k, bytes, 8);
+
+		hash = hashMix(hash, k);
+		bytes += 8;
+		size -= 8;
+	}
+
+	uint64_t tail = 0;
+	if (size)
+		memcpy(&tail, bytes, size);
+
+	return hashMix(hash, tail);
+}
+
+uint64_t hashCache(uint64_t hash, uint64_t value)
+{
+	return hashMix(hash, value);
+}
+
+// every cache key must start from this seed so that version bumps invalidate all cached items
+uint64_t hashCacheSeed(const char* kind)
+{
+	uint64_t hash = hashCache(0, kind, strlen(kind));
+	hash = hashCache(hash, kCacheVersion);
+	hash = hashCache(hash, MESHOPTIMIZER_VERSION);
+
+	return hash;
+}
+
+static std::string getCachePath(const Settings& settings, const char* kind, uint64_t key)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "/%s-%016llx.bin", kind, (unsigned long long)key);
+
+	return settings.cache_path + std::string(name);
+}
+
+bool readCache(const Settings& settings, const char* kind, uint64_t key, std::string& data)
+{
+	if (!settings.cache_path)
+		return false;
+
+	return readFile(getCachePath(settings, kind, key).c_str(), data);
+}
+
+void writeCache(const Settings& settings, const char* kind, uint64_t key, const std::string& data)
+{
+	if (!settings.cache_path)
+		return;
+
+	static std::atomic<unsigned int> counter;
+
+	std::string path = getCachePath(settings, kind, key);
+
+	// write through a temporary file so that concurrent runs never observe partial contents
+	std::string temp_path = path + ".tmp" + std::to_string(counter++);
+#if defined(_WIN32)
+	temp_path += "-" + std::to_string(_getpid());
+#elif !defined(__wasi__)
+	temp_path += "-" + std::to_string(getpid());
+#endif
+
+	if (!writeFile(temp_path.c_str(), data))
+	{
+		removeFile(temp_path.c_str());
+		return;
+	}
+
+	// on Windows rename fails if the file exists; since items are content-addressed, the existing file has the same contents
+	if (rename(temp_path.c_str(), path.c_str()) != 0)
+		removeFile(temp_path.c_str());
+}
+
+uint64_t hashMesh(const Mesh& mesh, const Settings& settings)
+{
+	uint64_t hash = hashCacheSeed("mesh");
+
+	hash = hashCache(hash, mesh.type);
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		const Stream& stream = mesh.streams[i];
+
+		hash = hashCache(hash, stream.type);
+		hash = hashCache(hash, stream.index);
+		hash = hashCache(hash, stream.target);
+
+		if (stream.custom_name)
+			hash = hashCache(hash, stream.custom_name, strlen(stream.custom_name));
+
+		hash = hashCache(hash, stream.data.empty() ? NULL : &stream.data[0], stream.data.size() * sizeof(float));
+	}
+
+	hash = hashCache(hash, mesh.indices.empty() ? NULL : &mesh.indices[0], mesh.indices.size() * sizeof(unsigned int));
+
+	// only settings that affect processMesh are included
+	hash = hashCache(hash, &settings.simplify_threshold, sizeof(settings.simplify_threshold));
+	hash = hashCache(hash, settings.simplify_aggressive);
+	hash = hashCache(hash, settings.simplify_lock_borders);
+	hash = hashCache(hash, settings.simplify_attributes);
+	hash = hashCache(hash, settings.compressmore);
+	hash = hashCache(hash, settings.meshlet_vertices);
+
+	return hash;
+}
+
+static void appendCacheData(std::string& data, const void* value, size_t size)
+{
+	if (size)
+		data.append(static_cast<const char*>(value), size);
+}
+
+static bool readCacheData(const std::string& data, size_t& offset, void* value, size_t size)
+{
+	if (data.size() - offset < size)
+		return false;
+
+	memcpy(value, data.data() + offset, size);
+	offset += size;
+	return true;
+}
+
+static bool isSameStream(const Stream& stream, int type, int index, int target, const std::string& name)
+{
+	if (stream.type != type || stream.index != index || stream.target != target)
+		return false;
+
+	return stream.custom_name ? name == stream.custom_name : name.empty();
+}
+
+void writeCachedMesh(const Mesh& mesh, uint64_t key, const Settings& settings)
+{
+	if (!settings.cache_path)
+		return;
+
+	std::string data;
+
+	uint64_t stream_count = mesh.streams.size();
+	appendCacheData(data, &stream_count, sizeof(stream_count));
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		const Stream& stream = mesh.streams[i];
+
+		int header[3] = {stream.type, stream.index, stream.target};
+		appendCacheData(data, header, sizeof(header));
+
+		uint64_t name_length = stream.custom_name ? strlen(stream.custom_name) : 0;
+		appendCacheData(data, &name_length, sizeof(name_length));
+		appendCacheData(data, stream.custom_name, name_length);
+
+		uint64_t vertex_count = getVertexCount(stream);
+		appendCacheData(data, &vertex_count, sizeof(vertex_count));
+		appendCacheData(data, stream.data.empty() ? NULL : &stream.data[0], stream.data.size() * sizeof(float));
+	}
+
+	uint64_t index_count = mesh.indices.size();
+	appendCacheData(data, &index_count, sizeof(index_count));
+	appendCacheData(data, mesh.indices.empty() ? NULL : &mesh.indices[0], mesh.indices.size() * sizeof(unsigned int));
+
+	uint64_t meshlet_counts[3] = {mesh.meshlets.size(), mesh.meshlet_vertices.size(), mesh.meshlet_triangles.size()};
+	appendCacheData(data, meshlet_counts, sizeof(meshlet_counts));
+	appendCacheData(data, mesh.meshlets.empty() ? NULL : &mesh.meshlets[0], mesh.meshlets.size() * sizeof(Meshlet));
+	appendCacheData(data, mesh.meshlet_vertices.empty() ? NULL : &mesh.meshlet_vertices[0], mesh.meshlet_vertices.size() * sizeof(unsigned int));
+	appendCacheData(data, mesh.meshlet_triangles.empty() ? NULL : &mesh.meshlet_triangles[0], mesh.meshlet_triangles.size() * sizeof(unsigned int));
+
+	writeCache(settings, "mesh", key, data);
+}
+
+bool readCachedMesh(Mesh& mesh, uint64_t key, const Settings& settings)
+{
+	std::string data;
+	if (!readCache(settings, "mesh", key, data))
+		return false;
+
+	size_t offset = 0;
+
+	uint64_t stream_count = 0;
+	if (!readCacheData(data, offset, &stream_count, sizeof(stream_count)) || stream_count > mesh.streams.size())
+		return false;
+
+	// processing only removes or rewrites streams, so every cached stream must match one of the source streams
+	std::vector<Stream> streams(static_cast<size_t>(stream_count));
+
+	for (size_t i = 0; i < streams.size(); ++i)
+	{
+		int header[3] = {};
+		uint64_t name_length = 0;
+
+		if (!readCacheData(data, offset, header, sizeof(header)) || !readCacheData(data, offset, &name_length, sizeof(name_length)) || name_length > data.size() - offset)
+			return false;
+
+		std::string name(data.data() + offset, size_t(name_length));
+		offset += size_t(name_length);
+
+		const Stream* source = NULL;
+
+		for (size_t j = 0; j < mesh.streams.size() && !source; ++j)
+			if (isSameStream(mesh.streams[j], header[0], header[1], header[2], name))
+				source = &mesh.streams[j];
+
+		uint64_t vertex_count = 0;
+
+		if (!source || !readCacheData(data, offset, &vertex_count, sizeof(vertex_count)) || vertex_count > (data.size() - offset) / (source->components * sizeof(float)))
+			return false;
+
+		streams[i].type = source->type;
+		streams[i].index = source->index;
+		streams[i].target = source->target;
+		streams[i].custom_name = source->custom_name;
+		streams[i].components = source->components;
+
+		streams[i].data.resize(size_t(vertex_count) * source->components);
+
+		if (vertex_count && !readCacheData(data, offset, &streams[i].data[0], streams[i].data.size() * sizeof(float)))
+			return false;
+	}
+
+	uint64_t index_count = 0;
+
+	if (!readCacheData(data, offset, &index_count, sizeof(index_count)) || index_count > (data.size() - offset) / sizeof(unsigned int))
+		return false;
+
+	std::vector<unsigned int> indices(static_cast<size_t>(index_count));
+
+	if (index_count && !readCacheData(data, offset, &indices[0], size_t(index_count) * sizeof(unsigned int)))
+		return false;
+
+	uint64_t meshlet_counts[3] = {};
+
+	if (!readCacheData(data, offset, meshlet_counts, sizeof(meshlet_counts)))
+		return false;
+
+	if (meshlet_counts[0] > (data.size() - offset) / sizeof(Meshlet) || meshlet_counts[1] > (data.size() - offset) / sizeof(unsigned int) || meshlet_counts[2] > (data.size() - offset) / sizeof(unsigned int))
+		return false;
+
+	if (meshlet_counts[0] * sizeof(Meshlet) + (meshlet_counts[1] + meshlet_counts[2]) * sizeof(unsigned int) != data.size() - offset)
+		return false;
+
+	std::vector<Meshlet> meshlets(static_cast<size_t>(meshlet_counts[0]));
+	std::vector<unsigned int> meshlet_vertices(static_cast<size_t>(meshlet_counts[1]));
+	std::vector<unsigned int> meshlet_triangles(static_cast<size_t>(meshlet_counts[2]));
+
+	if (meshlets.size() && !readCacheData(data, offset, &meshlets[0], meshlets.size() * sizeof(Meshlet)))
+		return false;
+	if (meshlet_vertices.size() && !readCacheData(data, offset, &meshlet_vertices[0], meshlet_vertices.size() * sizeof(unsigned int)))
+		return false;
+	if (meshlet_triangles.size() && !readCacheData(data, offset, &meshlet_triangles[0], meshlet_triangles.size() * sizeof(unsigned int)))
+		return false;
+
+	size_t vertex_count = streams.empty() ? 0 : getVertexCount(streams[0]);
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		if (indices[i] >= vertex_count)
+			return false;
+
+	for (size_t i = 0; i < meshlet_vertices.size(); ++i)
+		if (meshlet_vertices[i] >= vertex_count)
+			return false;
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const Meshlet& m = meshlets[i];
+
+		if (m.vertex_offset > meshlet_vertices.size() || m.vertex_count > meshlet_vertices.size() - m.vertex_offset)
+			return false;
+		if (m.triangle_offset > meshlet_triangles.size() || m.triangle_count > meshlet_triangles.size() - m.triangle_offset)
+			return false;
+	}
+
+	mesh.streams.swap(streams);
+	mesh.indices.swap(indices);
+	mesh.meshlets.swap(meshlets);
+	mesh.meshlet_vertices.swap(meshlet_vertices);
+	mesh.meshlet_triangles.swap(meshlet_triangles);
+	return true;
+}
@@ -1,16 +1,24 @@
 // This file is part of gltfpack; see gltfpack.h for version/license details
 #include "gltfpack.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #ifdef _WIN32
 #include <process.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #endif
 
+#if !defined(_WIN32) && !defined(__wasi__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 std::string getTempPrefix()
 {
 #if defined(_WIN32)
@@ -97,6 +105,100 @@ bool readFile(const char* path, std::string& data)
 	return rc == 0 && result == data.size();
 }
 
+#if !defined(_WIN32) && !defined(__wasi__)
+// munmap needs the mapping size, so we keep track of active mappings; files are only mapped from the main thread
+static std::vector<std::pair<void*, size_t> > gMappedFiles;
+#endif
+
+void* mapFile(const char* path, size_t& size)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER length = {};
+	if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 || uint64_t(length.QuadPart) > SIZE_MAX)
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+
+	// copy-on-write mapping keeps the file intact if the data is modified in memory
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle(file);
+
+	if (!mapping)
+		return NULL;
+
+	void* result = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if (!result)
+		return NULL;
+
+	size = size_t(length.QuadPart);
+	return result;
+#elif defined(__wasi__)
+	std::string data;
+	if (!readFile(path, data))
+		return NULL;
+
+	void* result = malloc(data.size());
+	if (!result)
+		return NULL;
+
+	memcpy(result, data.data(), data.size());
+
+	size = data.size();
+	return result;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0)
+		return NULL;
+
+	struct stat st = {};
+	if (fstat(file, &st) != 0 || st.st_size <= 0 || uint64_t(st.st_size) > SIZE_MAX)
+	{
+		close(file);
+		return NULL;
+	}
+
+	// copy-on-write mapping keeps the file intact if the data is modified in memory
+	void* result = mmap(NULL, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	close(file);
+
+	if (result == MAP_FAILED)
+		return NULL;
+
+	gMappedFiles.push_back(std::make_pair(result, size_t(st.st_size)));
+
+	size = size_t(st.st_size);
+	return result;
+#endif
+}
+
+void unmapFile(void* data)
+{
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+#elif defined(__wasi__)
+	free(data);
+#else
+	for (size_t i = 0; i < gMappedFiles.size(); ++i)
+		if (gMappedFiles[i].first == data)
+		{
+			munmap(data, gMappedFiles[i].second);
+
+			gMappedFiles[i] = gMappedFiles.back();
+			gMappedFiles.pop_back();
+			return;
+		}
+
+	assert(!"Unknown file mapping");
+#endif
+}
+
 bool writeFile(const char* path, const std::string& data)
 {
 	FILE* file = fopen(path, "wb");
@@ -113,3 +215,13 @@ void removeFile(const char* path)
 {
 	remove(path);
 }
+
+bool renameFile(const char* from, const char* to)
+{
+#ifdef _WIN32
+	// rename fails on Windows if the target exists
+	return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(from, to) == 0;
+#endif
+}
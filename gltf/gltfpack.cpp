@@ -22,56 +22,142 @@ std::string getVersion()
 	return result;
 }
 
-static void finalizeBufferViews(std::string& json, std::vector<BufferView>& views, std::string& bin, std::string* fallback, size_t& fallback_size)
+// small views are faster to compress than to load from the cache
+const size_t kCacheMinViewSize = 64 * 1024;
+
+struct CompressTasks
 {
-	for (size_t i = 0; i < views.size(); ++i)
+	const std::vector<BufferView>* views;
+	size_t offset;
+
+	const Settings* settings;
+
+	std::vector<std::string> compressed;
+};
+
+static void compressBufferViewTask(void* task_data, size_t task_index)
+{
+	CompressTasks& tasks = *static_cast<CompressTasks*>(task_data);
+
+	const BufferView& view = (*tasks.views)[tasks.offset + task_index];
+	std::string& result = tasks.compressed[task_index];
+
+	size_t count = view.data.size() / view.stride;
+
+	if (view.compression == BufferView::Compression_None)
+		return;
+
+	const Settings& settings = *tasks.settings;
+
+	bool cached = settings.cache_path && view.data.size() >= kCacheMinViewSize;
+	uint64_t key = 0;
+
+	if (cached)
 	{
-		BufferView& view = views[i];
+		key = hashCacheSeed("view");
+		key = hashCache(key, view.data.data(), view.data.size());
+		key = hashCache(key, view.stride);
+		key = hashCache(key, view.compression);
 
-		size_t bin_offset = bin.size();
-		size_t fallback_offset = fallback_size;
+		if (readCache(settings, "view", key, result))
+			return;
+	}
 
-		size_t count = view.data.size() / view.stride;
+	switch (view.compression)
+	{
+	case BufferView::Compression_Attribute:
+		compressVertexStream(result, view.data, count, view.stride);
+		break;
+	case BufferView::Compression_Index:
+		compressIndexStream(result, view.data, count, view.stride);
+		break;
+	case BufferView::Compression_IndexSequence:
+		compressIndexSequence(result, view.data, count, view.stride);
+		break;
+	default:
+		assert(!"Unknown compression type");
+	}
 
-		if (view.compression == BufferView::Compression_None)
-		{
-			bin += view.data;
-		}
-		else
+	if (cached)
+		writeCache(settings, "view", key, result);
+}
+
+static void writeOutput(BufferOutput& output, const char* data, size_t size)
+{
+	if (output.file)
+		output.error |= fwrite(data, 1, size, output.file) != size;
+	else if (output.data)
+		output.data->append(data, size);
+
+	output.size += size;
+}
+
+static void alignOutput(BufferOutput& output)
+{
+	static const char zero[4] = {};
+
+	writeOutput(output, zero, ((output.size + 3) & ~size_t(3)) - output.size);
+}
+
+static void finalizeBufferViews(std::string& json, std::vector<BufferView>& views, BufferOutput& bin, BufferOutput& fallback, const Settings& settings)
+{
+	// views are compressed in small batches so that only a few compressed views are in memory at once; the output is written serially so it doesn't depend on the job count
+	int jobs = getJobCount(settings.jobs);
+	size_t batch_size = size_t(jobs) * 4;
+
+	CompressTasks tasks;
+	tasks.views = &views;
+	tasks.settings = &settings;
+
+	for (size_t batch = 0; batch < views.size(); batch += batch_size)
+	{
+		size_t batch_count = std::min(batch_size, views.size() - batch);
+
+		tasks.offset = batch;
+		tasks.compressed.clear();
+		tasks.compressed.resize(batch_count);
+
+		runTasks(&jobs, compressBufferViewTask, &tasks, batch_count);
+
+		for (size_t i = batch; i < batch + batch_count; ++i)
 		{
-			switch (view.compression)
+			BufferView& view = views[i];
+
+			size_t bin_offset = bin.size;
+			size_t fallback_offset = fallback.size;
+
+			size_t count = view.data.size() / view.stride;
+
+			if (view.compression == BufferView::Compression_None)
 			{
-			case BufferView::Compression_Attribute:
-				compressVertexStream(bin, view.data, count, view.stride);
-				break;
-			case BufferView::Compression_Index:
-				compressIndexStream(bin, view.data, count, view.stride);
-				break;
-			case BufferView::Compression_IndexSequence:
-				compressIndexSequence(bin, view.data, count, view.stride);
-				break;
-			default:
-				assert(!"Unknown compression type");
+				writeOutput(bin, view.data.data(), view.data.size());
 			}
+			else
+			{
+				std::string& compressed = tasks.compressed[i - batch];
 
-			if (fallback)
-				*fallback += view.data;
-			fallback_size += view.data.size();
-		}
+				writeOutput(bin, compressed.data(), compressed.size());
+				writeOutput(fallback, view.data.data(), view.data.size());
+
+				// release compressed data early to reduce peak memory usage
+				std::string().swap(compressed);
+			}
 
-		size_t raw_offset = (view.compression != BufferView::Compression_None) ? fallback_offset : bin_offset;
+			size_t raw_offset = (view.compression != BufferView::Compression_None) ? fallback_offset : bin_offset;
 
-		comma(json);
-		writeBufferView(json, view.kind, view.filter, count, view.stride, raw_offset, view.data.size(), view.compression, bin_offset, bin.size() - bin_offset);
+			comma(json);
+			writeBufferView(json, view.kind, view.filter, count, view.stride, raw_offset, view.data.size(), view.compression, bin_offset, bin.size - bin_offset);
 
-		// record written bytes for statistics
-		view.bytes = bin.size() - bin_offset;
+			// record written bytes for statistics; view data is no longer needed after this
+			view.bytes = bin.size - bin_offset;
+			view.raw_bytes = view.data.size();
 
-		// align each bufferView by 4 bytes
-		bin.resize((bin.size() + 3) & ~3);
-		if (fallback)
-			fallback->resize((fallback->size() + 3) & ~3);
-		fallback_size = (fallback_size + 3) & ~3;
+			std::string().swap(view.data);
+
+			// align each bufferView by 4 bytes
+			alignOutput(bin);
+			alignOutput(fallback);
+		}
 	}
 }
 
@@ -88,7 +174,7 @@ static void printMeshStats(const std::vector<Mesh>& meshes, const char* name)
 		const Mesh& mesh = meshes[i];
 
 		mesh_triangles += mesh.indices.size() / 3;
-		mesh_vertices += mesh.streams.empty() ? 0 : mesh.streams[0].data.size();
+		mesh_vertices += mesh.streams.empty() ? 0 : getVertexCount(mesh.streams[0]);
 
 		size_t instances = std::max(size_t(1), mesh.nodes.size() + mesh.instances.size());
 
@@ -114,10 +200,10 @@ static void printSceneStats(const std::vector<BufferView>& views, const std::vec
 
 	printf("output: %d nodes, %d meshes (%d primitives), %d materials\n", int(node_offset), int(mesh_offset), int(meshes.size()), int(material_offset));
 	printf("output: JSON %d bytes, buffers %d bytes\n", int(json_size), int(bin_size));
-	printf("output: buffers: vertex %d bytes, index %d bytes, skin %d bytes, time %d bytes, keyframe %d bytes, instance %d bytes, image %d bytes\n",
+	printf("output: buffers: vertex %d bytes, index %d bytes, skin %d bytes, time %d bytes, keyframe %d bytes, instance %d bytes, meshlet %d bytes, image %d bytes\n",
 	    int(bytes[BufferView::Kind_Vertex]), int(bytes[BufferView::Kind_Index]), int(bytes[BufferView::Kind_Skin]),
 	    int(bytes[BufferView::Kind_Time]), int(bytes[BufferView::Kind_Keyframe]), int(bytes[BufferView::Kind_Instance]),
-	    int(bytes[BufferView::Kind_Image]));
+	    int(bytes[BufferView::Kind_Meshlet]), int(bytes[BufferView::Kind_Image]));
 }
 
 static void printAttributeStats(const std::vector<BufferView>& views, BufferView::Kind kind, const char* name)
@@ -149,12 +235,12 @@ static void printAttributeStats(const std::vector<BufferView>& views, BufferView
 		default:;
 		}
 
-		size_t count = view.data.size() / view.stride;
+		size_t count = view.raw_bytes / view.stride;
 
 		printf("stats: %s %s: compressed %d bytes (%.1f bits), raw %d bytes (%d bits)\n",
 		    name, variant,
 		    int(view.bytes), double(view.bytes) / double(count) * 8,
-		    int(view.data.size()), int(view.stride * 8));
+		    int(view.raw_bytes), int(view.stride * 8));
 	}
 }
 
@@ -174,15 +260,30 @@ static void printImageStats(const std::vector<BufferView>& views, TextureKind ki
 			continue;
 
 		count += 1;
-		bytes += view.data.size();
+		bytes += view.raw_bytes;
 	}
 
 	if (count)
 		printf("stats: image %s: %d bytes in %d images\n", name, int(bytes), int(count));
 }
 
-static bool printReport(const char* path, const std::vector<BufferView>& views, const std::vector<Mesh>& meshes, size_t node_count, size_t mesh_count, size_t texture_count, size_t material_count, size_t animation_count, size_t json_size, size_t bin_size)
+struct ReportInfo
 {
+	std::vector<BufferView> views;
+
+	size_t node_count;
+	size_t mesh_count;
+	size_t texture_count;
+	size_t material_count;
+
+	size_t json_size;
+	size_t bin_size;
+};
+
+static bool printReport(const char* path, const ReportInfo& info, const std::vector<Mesh>& meshes, size_t animation_count)
+{
+	const std::vector<BufferView>& views = info.views;
+
 	size_t bytes[BufferView::Kind_Count] = {};
 
 	for (size_t i = 0; i < views.size(); ++i)
@@ -213,10 +314,10 @@ static bool printReport(const char* path, const std::vector<BufferView>& views,
 	fprintf(out, "{\n");
 	fprintf(out, "\t\"generator\": \"gltfpack %s\",\n", getVersion().c_str());
 	fprintf(out, "\t\"scene\": {\n");
-	fprintf(out, "\t\t\"nodeCount\": %d,\n", int(node_count));
-	fprintf(out, "\t\t\"meshCount\": %d,\n", int(mesh_count));
-	fprintf(out, "\t\t\"materialCount\": %d,\n", int(material_count));
-	fprintf(out, "\t\t\"textureCount\": %d,\n", int(texture_count));
+	fprintf(out, "\t\t\"nodeCount\": %d,\n", int(info.node_count));
+	fprintf(out, "\t\t\"meshCount\": %d,\n", int(info.mesh_count));
+	fprintf(out, "\t\t\"materialCount\": %d,\n", int(info.material_count));
+	fprintf(out, "\t\t\"textureCount\": %d,\n", int(info.texture_count));
 	fprintf(out, "\t\t\"animationCount\": %d\n", int(animation_count));
 	fprintf(out, "\t},\n");
 	fprintf(out, "\t\"render\": {\n");
@@ -225,15 +326,33 @@ static bool printReport(const char* path, const std::vector<BufferView>& views,
 	fprintf(out, "\t\t\"triangleCount\": %lld\n", (long long)total_triangles);
 	fprintf(out, "\t},\n");
 	fprintf(out, "\t\"data\": {\n");
-	fprintf(out, "\t\t\"json\": %d,\n", int(json_size));
-	fprintf(out, "\t\t\"binary\": %d,\n", int(bin_size));
+	fprintf(out, "\t\t\"json\": %d,\n", int(info.json_size));
+	fprintf(out, "\t\t\"binary\": %d,\n", int(info.bin_size));
 	fprintf(out, "\t\t\"buffers\": {\n");
 	fprintf(out, "\t\t\t\"vertex\": %d,\n", int(bytes[BufferView::Kind_Vertex]));
 	fprintf(out, "\t\t\t\"index\": %d,\n", int(bytes[BufferView::Kind_Index]));
 	fprintf(out, "\t\t\t\"animation\": %d,\n", int(bytes[BufferView::Kind_Time] + bytes[BufferView::Kind_Keyframe]));
 	fprintf(out, "\t\t\t\"transform\": %d,\n", int(bytes[BufferView::Kind_Skin] + bytes[BufferView::Kind_Instance]));
+	fprintf(out, "\t\t\t\"meshlet\": %d,\n", int(bytes[BufferView::Kind_Meshlet]));
 	fprintf(out, "\t\t\t\"image\": %d\n", int(bytes[BufferView::Kind_Image]));
 	fprintf(out, "\t\t}\n");
+	fprintf(out, "\t},\n");
+	fprintf(out, "\t\"profile\": {\n");
+
+	for (int i = 0; i < ProfileStage__Count; ++i)
+	{
+		ProfileStats stats = getProfileStats(ProfileStage(i));
+
+		fprintf(out, "\t\t\"%s\": {\n", stats.name);
+		fprintf(out, "\t\t\t\"count\": %d,\n", int(stats.count));
+		fprintf(out, "\t\t\t\"wallTime\": %.6f,\n", stats.wall_time);
+		fprintf(out, "\t\t\t\"cpuTime\": %.6f,\n", stats.cpu_time);
+		fprintf(out, "\t\t\t\"allocations\": %lld,\n", (long long)stats.allocations);
+		fprintf(out, "\t\t\t\"peakAllocated\": %lld\n", (long long)stats.peak_allocated);
+		fprintf(out, "\t\t},\n");
+	}
+
+	fprintf(out, "\t\t\"peakMemory\": %lld\n", (long long)getPeakMemory());
 	fprintf(out, "\t}\n");
 	fprintf(out, "}\n");
 
@@ -259,7 +378,116 @@ static bool isExtensionSupported(const ExtensionInfo* extensions, size_t count,
 	return false;
 }
 
-static void process(cgltf_data* data, const char* input_path, const char* output_path, const char* report_path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const Settings& settings, std::string& json, std::string& bin, std::string& fallback, size_t& fallback_size)
+struct ProcessTasks
+{
+	std::vector<Mesh>* meshes;
+	std::vector<Animation>* animations;
+	std::vector<size_t> order;
+	std::vector<std::pair<size_t, size_t> > tracks; // animation index, track index
+
+	const Settings* settings;
+};
+
+static void processMeshTask(void* task_data, size_t task_index)
+{
+	ProcessTasks& tasks = *static_cast<ProcessTasks*>(task_data);
+
+	Mesh& mesh = (*tasks.meshes)[tasks.order[task_index]];
+	const Settings& settings = *tasks.settings;
+
+	if (!settings.cache_path)
+	{
+		processMesh(mesh, settings);
+		return;
+	}
+
+	uint64_t key = hashMesh(mesh, settings);
+
+	if (readCachedMesh(mesh, key, settings))
+		return;
+
+	processMesh(mesh, settings);
+	writeCachedMesh(mesh, key, settings);
+}
+
+static void processAnimationTask(void* task_data, size_t task_index)
+{
+	ProcessTasks& tasks = *static_cast<ProcessTasks*>(task_data);
+
+	const std::pair<size_t, size_t>& track = tasks.tracks[tasks.order[task_index]];
+
+	Animation& animation = (*tasks.animations)[track.first];
+	processAnimationTrack(animation.tracks[track.second], animation, *tasks.settings);
+}
+
+struct TaskSizePredicate
+{
+	bool operator()(const std::pair<size_t, size_t>& lhs, const std::pair<size_t, size_t>& rhs) const
+	{
+		return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+	}
+};
+
+static void processMeshes(std::vector<Mesh>& meshes, const Settings& settings)
+{
+	ProcessTasks tasks = {};
+	tasks.meshes = &meshes;
+	tasks.settings = &settings;
+
+	// meshes are processed independently so the results don't depend on the order; large meshes go first to balance the load between threads
+	std::vector<std::pair<size_t, size_t> > sizes(meshes.size());
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+		sizes[i] = std::make_pair(meshes[i].indices.size() + (meshes[i].streams.empty() ? 0 : getVertexCount(meshes[i].streams[0])), i);
+
+	std::sort(sizes.begin(), sizes.end(), TaskSizePredicate());
+
+	tasks.order.resize(meshes.size());
+	for (size_t i = 0; i < meshes.size(); ++i)
+		tasks.order[i] = sizes[i].second;
+
+	int jobs = settings.jobs;
+
+	ProfileTimer timer = beginProfile(ProfileStage_Meshes);
+	runTasks(&jobs, processMeshTask, &tasks, meshes.size());
+	endProfile(timer);
+}
+
+static void processAnimations(std::vector<Animation>& animations, const Settings& settings)
+{
+	ProcessTasks tasks = {};
+	tasks.animations = &animations;
+	tasks.settings = &settings;
+
+	ProfileTimer timer = beginProfile(ProfileStage_Animation);
+
+	// tracks are resampled independently, which balances the load for files with few animations that have many channels; long tracks go first
+	std::vector<std::pair<size_t, size_t> > sizes;
+
+	for (size_t i = 0; i < animations.size(); ++i)
+	{
+		prepareAnimation(animations[i], settings);
+
+		for (size_t j = 0; j < animations[i].tracks.size(); ++j)
+		{
+			sizes.push_back(std::make_pair(size_t(animations[i].frames) * animations[i].tracks[j].components, tasks.tracks.size()));
+			tasks.tracks.push_back(std::make_pair(i, j));
+		}
+	}
+
+	std::sort(sizes.begin(), sizes.end(), TaskSizePredicate());
+
+	tasks.order.resize(sizes.size());
+	for (size_t i = 0; i < sizes.size(); ++i)
+		tasks.order[i] = sizes[i].second;
+
+	int jobs = settings.jobs;
+	runTasks(&jobs, processAnimationTask, &tasks, tasks.tracks.size());
+
+	endProfile(timer);
+}
+
+static void process(cgltf_data* data, const char* input_path, const char* output_path, ReportInfo* report, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const Settings& settings, std::string& json, BufferOutput& bin, BufferOutput& fallback)
 {
 	if (settings.verbose)
 	{
@@ -268,10 +496,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		printMeshStats(meshes, "input");
 	}
 
-	for (size_t i = 0; i < animations.size(); ++i)
-	{
-		processAnimation(animations[i], settings);
-	}
+	processAnimations(animations, settings);
 
 	std::vector<NodeInfo> nodes(data->nodes_count);
 
@@ -372,9 +597,11 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		filterStreams(mesh, mi);
 	}
 
+	ProfileTimer merge_timer = beginProfile(ProfileStage_Merge);
 	mergeMeshMaterials(data, meshes, settings);
 	mergeMeshes(meshes, settings);
 	filterEmptyMeshes(meshes);
+	endProfile(merge_timer);
 
 	markNeededNodes(data, nodes, meshes, animations, settings);
 	markNeededMaterials(data, materials, meshes, settings);
@@ -404,10 +631,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	}
 #endif
 
-	for (size_t i = 0; i < meshes.size(); ++i)
-	{
-		processMesh(meshes[i], settings);
-	}
+	processMeshes(meshes, settings);
 
 #ifndef NDEBUG
 	meshes.insert(meshes.end(), debug_meshes.begin(), debug_meshes.end());
@@ -452,6 +676,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	bool ext_dispersion = false;
 	bool ext_unlit = false;
 	bool ext_instancing = false;
+	bool ext_meshlets = false;
 	bool ext_texture_transform = false;
 	bool ext_texture_basisu = false;
 	bool ext_texture_webp = false;
@@ -479,7 +704,9 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	{
 		encoded_images.resize(data->images_count);
 
+		ProfileTimer timer = beginProfile(ProfileStage_Textures);
 		encodeImages(encoded_images.data(), data, images, input_path, settings);
+		endProfile(timer);
 	}
 #endif
 
@@ -615,9 +842,12 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 				append(json_meshes, size_t(mi.remap));
 			}
 
+			if (prim.variants.size() || prim.meshlets.size())
+				append(json_meshes, ",\"extensions\":{");
+
 			if (prim.variants.size())
 			{
-				append(json_meshes, ",\"extensions\":{\"KHR_materials_variants\":{\"mappings\":[");
+				append(json_meshes, "\"KHR_materials_variants\":{\"mappings\":[");
 
 				for (size_t j = 0; j < prim.variants.size(); ++j)
 				{
@@ -633,9 +863,18 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 					append(json_meshes, "]}");
 				}
 
-				append(json_meshes, "]}}");
+				append(json_meshes, "]}");
 			}
 
+			if (prim.meshlets.size())
+			{
+				comma(json_meshes);
+				writeMeshMeshlets(json_meshes, views, prim, qp, settings);
+			}
+
+			if (prim.variants.size() || prim.meshlets.size())
+				append(json_meshes, "}");
+
 			append(json_meshes, "}");
 		}
 
@@ -719,6 +958,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 
 		mesh_offset++;
 		ext_instancing = ext_instancing || !mesh.instances.empty();
+		ext_meshlets = ext_meshlets || !mesh.meshlets.empty();
 
 		// skip all meshes that we've written in this iteration
 		assert(pi > i);
@@ -842,6 +1082,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	    {"KHR_texture_basisu", (!json_textures.empty() && settings.texture_ktx2) || ext_texture_basisu, true},
 	    {"EXT_texture_webp", ext_texture_webp, true},
 	    {"EXT_mesh_gpu_instancing", ext_instancing, true},
+	    {"MESHOPT_meshlets", ext_meshlets, false},
 	};
 
 	for (size_t i = 0; i < data->extensions_required_count; ++i)
@@ -855,7 +1096,9 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	writeExtensions(json, extensions, sizeof(extensions) / sizeof(extensions[0]));
 
 	std::string json_views;
-	finalizeBufferViews(json_views, views, bin, settings.fallback ? &fallback : NULL, fallback_size);
+	ProfileTimer compress_timer = beginProfile(ProfileStage_Compress);
+	finalizeBufferViews(json_views, views, bin, fallback, settings);
+	endProfile(compress_timer);
 
 	writeArray(json, "bufferViews", json_views);
 	writeArray(json, "accessors", json_accessors);
@@ -896,7 +1139,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	if (settings.verbose)
 	{
 		printMeshStats(meshes, "output");
-		printSceneStats(views, meshes, node_offset, mesh_offset, material_offset, json.size(), bin.size());
+		printSceneStats(views, meshes, node_offset, mesh_offset, material_offset, json.size(), bin.size);
 	}
 
 	if (settings.verbose > 1)
@@ -912,12 +1155,15 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		printImageStats(views, TextureKind_Attrib, "attrib");
 	}
 
-	if (report_path)
+	if (report)
 	{
-		if (!printReport(report_path, views, meshes, node_offset, mesh_offset, texture_offset, material_offset, animations.size(), json.size(), bin.size()))
-		{
-			fprintf(stderr, "Warning: cannot save report to %s\n", report_path);
-		}
+		report->views.swap(views);
+		report->node_count = node_offset;
+		report->mesh_count = mesh_offset;
+		report->texture_count = texture_offset;
+		report->material_count = material_offset;
+		report->json_size = json.size();
+		report->bin_size = bin.size;
 	}
 }
 
@@ -976,6 +1222,122 @@ static std::string getBufferSpec(const char* bin_path, size_t bin_size, const ch
 	return json;
 }
 
+static std::string getTempPath(const std::string& path)
+{
+	return path + ".tmp";
+}
+
+static void discardOutput(BufferOutput& bin, BufferOutput& fallback, const std::string& binpath, const std::string& fbpath)
+{
+	if (bin.file)
+	{
+		fclose(bin.file);
+		removeFile(getTempPath(binpath).c_str());
+		bin.file = NULL;
+	}
+
+	if (fallback.file)
+	{
+		fclose(fallback.file);
+		removeFile(getTempPath(fbpath).c_str());
+		fallback.file = NULL;
+	}
+}
+
+static int saveOutput(const char* output, const std::string& oext, const Settings& settings, std::string& json, BufferOutput& bin, BufferOutput& fallback, const std::string& binpath, const std::string& fbpath)
+{
+	FILE* out = fopen(output, "wb");
+	if (!out)
+	{
+		discardOutput(bin, fallback, binpath, fbpath);
+
+		fprintf(stderr, "Error saving %s\n", output);
+		return 4;
+	}
+
+	int rc = 0;
+
+	if (oext == ".gltf")
+	{
+		std::string bufferspec = getBufferSpec(getBaseName(binpath.c_str()), bin.size, settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback.size, settings.compress);
+
+		fprintf(out, "{");
+		fwrite(bufferspec.c_str(), bufferspec.size(), 1, out);
+		fprintf(out, ",");
+		fwrite(json.c_str(), json.size(), 1, out);
+		fprintf(out, "}");
+	}
+	else
+	{
+		std::string bufferspec = getBufferSpec(NULL, bin.size, settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback.size, settings.compress);
+
+		json.insert(0, "{" + bufferspec + ",");
+		json.push_back('}');
+
+		while (json.size() % 4)
+			json.push_back(' ');
+
+		alignOutput(bin);
+
+		writeU32(out, 0x46546C67);
+		writeU32(out, 2);
+		writeU32(out, uint32_t(12 + 8 + json.size() + 8 + bin.size));
+
+		writeU32(out, uint32_t(json.size()));
+		writeU32(out, 0x4E4F534A);
+		fwrite(json.c_str(), json.size(), 1, out);
+
+		writeU32(out, uint32_t(bin.size));
+		writeU32(out, 0x004E4942);
+
+		rewind(bin.file);
+
+		std::vector<char> buffer(1 << 20);
+		size_t copied = 0;
+
+		while (size_t bytes = fread(&buffer[0], 1, buffer.size(), bin.file))
+		{
+			fwrite(&buffer[0], 1, bytes, out);
+			copied += bytes;
+		}
+
+		rc |= copied != bin.size;
+	}
+
+	rc |= fclose(out);
+	rc |= fclose(bin.file);
+	bin.file = NULL;
+
+	if (fallback.file)
+	{
+		rc |= fclose(fallback.file);
+		fallback.file = NULL;
+	}
+
+	// binary data of .glb files is embedded into the output so its temporary file is no longer needed; .bin files replace the previous contents only once everything is written
+	if (oext != ".gltf")
+		removeFile(getTempPath(binpath).c_str());
+	else if (!rc && !bin.error && !fallback.error)
+		rc |= !renameFile(getTempPath(binpath).c_str(), binpath.c_str());
+
+	if (settings.fallback && !rc && !bin.error && !fallback.error)
+		rc |= !renameFile(getTempPath(fbpath).c_str(), fbpath.c_str());
+
+	if (rc || bin.error || fallback.error)
+	{
+		removeFile(output);
+		removeFile(getTempPath(binpath).c_str());
+
+		if (settings.fallback)
+			removeFile(getTempPath(fbpath).c_str());
+
+		fprintf(stderr, "Error saving %s\n", output);
+		return 4;
+	}
+
+	return 0;
+}
+
 int gltfpack(const char* input, const char* output, const char* report, Settings settings)
 {
 	cgltf_data* data = NULL;
@@ -985,10 +1347,16 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 	std::string iext = getExtension(input);
 	std::string oext = output ? getExtension(output) : "";
 
+	// library allocations are only tracked for reports to avoid the overhead otherwise
+	if (report)
+		enableProfileAllocator();
+
+	ProfileTimer parse_timer = beginProfile(ProfileStage_Parse);
+
 	if (iext == ".gltf" || iext == ".glb")
 	{
 		const char* error = NULL;
-		data = parseGltf(input, meshes, animations, &error);
+		data = parseGltf(input, meshes, animations, &error, settings.jobs);
 
 		if (error)
 		{
@@ -1013,6 +1381,8 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		return 2;
 	}
 
+	endProfile(parse_timer);
+
 #ifndef WITH_BASISU
 	if (data->images_count && settings.texture_ktx2)
 	{
@@ -1052,116 +1422,59 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		}
 	}
 
-	std::string json, bin, fallback;
-	size_t fallback_size = 0;
-	process(data, input, output, report, meshes, animations, settings, json, bin, fallback, fallback_size);
-
-	cgltf_free(data);
-
-	if (!output)
-	{
-		return 0;
-	}
-
-	if (oext == ".gltf")
+	if (output && oext != ".gltf" && oext != ".glb")
 	{
-		std::string binpath = output;
-		binpath.replace(binpath.size() - 5, 5, ".bin");
-
-		std::string fbpath = output;
-		fbpath.replace(fbpath.size() - 5, 5, ".fallback.bin");
+		cgltf_free(data);
 
-		FILE* outjson = fopen(output, "wb");
-		FILE* outbin = fopen(binpath.c_str(), "wb");
-		FILE* outfb = settings.fallback ? fopen(fbpath.c_str(), "wb") : NULL;
-		if (!outjson || !outbin || (!outfb && settings.fallback))
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
-
-		std::string bufferspec = getBufferSpec(getBaseName(binpath.c_str()), bin.size(), settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
-
-		fprintf(outjson, "{");
-		fwrite(bufferspec.c_str(), bufferspec.size(), 1, outjson);
-		fprintf(outjson, ",");
-		fwrite(json.c_str(), json.size(), 1, outjson);
-		fprintf(outjson, "}");
-
-		fwrite(bin.c_str(), bin.size(), 1, outbin);
-
-		if (settings.fallback)
-			fwrite(fallback.c_str(), fallback.size(), 1, outfb);
-
-		int rc = 0;
-		rc |= fclose(outjson);
-		rc |= fclose(outbin);
-		if (outfb)
-			rc |= fclose(outfb);
-
-		if (rc)
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
+		fprintf(stderr, "Error saving %s: unknown extension (expected .gltf or .glb)\n", output);
+		return 4;
 	}
-	else if (oext == ".glb")
-	{
-		std::string fbpath = output;
-		fbpath.replace(fbpath.size() - 4, 4, ".fallback.bin");
 
-		FILE* out = fopen(output, "wb");
-		FILE* outfb = settings.fallback ? fopen(fbpath.c_str(), "wb") : NULL;
-		if (!out || (!outfb && settings.fallback))
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
+	// buffer data is written to disk as each buffer view is finalized; it goes to temporary files first since input buffers may still be read from files that the output replaces, and since the binary chunk follows the JSON chunk in .glb files
+	std::string binpath, fbpath;
+	FILE* outbin = NULL;
+	FILE* outfb = NULL;
 
-		std::string bufferspec = getBufferSpec(NULL, bin.size(), settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
+	if (output)
+	{
+		std::string outbase = output;
+		outbase.erase(outbase.size() - oext.size());
 
-		json.insert(0, "{" + bufferspec + ",");
-		json.push_back('}');
+		binpath = (oext == ".gltf") ? outbase + ".bin" : std::string(output);
+		fbpath = outbase + ".fallback.bin";
 
-		while (json.size() % 4)
-			json.push_back(' ');
+		outbin = fopen(getTempPath(binpath).c_str(), (oext == ".gltf") ? "wb" : "w+b");
+		outfb = settings.fallback ? fopen(getTempPath(fbpath).c_str(), "wb") : NULL;
+	}
 
-		while (bin.size() % 4)
-			bin.push_back('\0');
+	std::string json;
+	BufferOutput bin = {outbin};
+	BufferOutput fallback = {outfb};
 
-		writeU32(out, 0x46546C67);
-		writeU32(out, 2);
-		writeU32(out, uint32_t(12 + 8 + json.size() + 8 + bin.size()));
+	if (output && (!outbin || (!outfb && settings.fallback)))
+	{
+		discardOutput(bin, fallback, binpath, fbpath);
+		cgltf_free(data);
 
-		writeU32(out, uint32_t(json.size()));
-		writeU32(out, 0x4E4F534A);
-		fwrite(json.c_str(), json.size(), 1, out);
+		fprintf(stderr, "Error saving %s\n", output);
+		return 4;
+	}
 
-		writeU32(out, uint32_t(bin.size()));
-		writeU32(out, 0x004E4942);
-		fwrite(bin.c_str(), bin.size(), 1, out);
+	ReportInfo report_info = {};
+	process(data, input, output, report ? &report_info : NULL, meshes, animations, settings, json, bin, fallback);
 
-		if (settings.fallback)
-			fwrite(fallback.c_str(), fallback.size(), 1, outfb);
+	cgltf_free(data);
 
-		int rc = 0;
-		rc |= fclose(out);
-		if (outfb)
-			rc |= fclose(outfb);
+	ProfileTimer write_timer = beginProfile(ProfileStage_Write);
+	int result = output ? saveOutput(output, oext, settings, json, bin, fallback, binpath, fbpath) : 0;
+	endProfile(write_timer);
 
-		if (rc)
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
-	}
-	else
+	if (report && !printReport(report, report_info, meshes, animations.size()))
 	{
-		fprintf(stderr, "Error saving %s: unknown extension (expected .gltf or .glb)\n", output);
-		return 4;
+		fprintf(stderr, "Warning: cannot save report to %s\n", report);
 	}
 
-	return 0;
+	return result;
 }
 
 Settings defaults()
@@ -1178,6 +1491,7 @@ Settings defaults()
 	settings.anim_freq = 30;
 	settings.simplify_threshold = 1.f;
 	settings.texture_scale = 1.f;
+	settings.jobs = 1;
 	for (int kind = 0; kind < TextureKind__Count; ++kind)
 		settings.texture_quality[kind] = 8;
 
@@ -1332,6 +1646,10 @@ int main(int argc, char** argv)
 		{
 			settings.simplify_attributes = true;
 		}
+		else if (strcmp(arg, "-ml") == 0 && i + 1 < argc && isdigit(argv[i + 1][0]))
+		{
+			settings.meshlet_vertices = clamp(atoi(argv[++i]), 3, 255);
+		}
 #ifndef NDEBUG
 		else if (strcmp(arg, "-sd") == 0 && i + 1 < argc && isdigit(argv[i + 1][0]))
 		{
@@ -1405,6 +1723,14 @@ int main(int argc, char** argv)
 		{
 			settings.texture_jobs = clamp(atoi(argv[++i]), 0, 128);
 		}
+		else if (strcmp(arg, "-j") == 0 && i + 1 < argc && isdigit(argv[i + 1][0]))
+		{
+			settings.jobs = clamp(atoi(argv[++i]), 0, 128);
+		}
+		else if (strcmp(arg, "-cache") == 0 && i + 1 < argc)
+		{
+			settings.cache_path = argv[++i];
+		}
 		else if (strcmp(arg, "-noq") == 0)
 		{
 			// TODO: Warn if -noq is used and suggest -vpf instead; use -noqq to silence
@@ -1543,9 +1869,12 @@ int main(int argc, char** argv)
 			fprintf(stderr, "\t-ke: keep extras data\n");
 			fprintf(stderr, "\t-mm: merge instances of the same mesh together when possible\n");
 			fprintf(stderr, "\t-mi: use EXT_mesh_gpu_instancing when serializing multiple mesh instances\n");
+			fprintf(stderr, "\t-ml N: precompute meshlets with up to N vertices, culling bounds and local triangles and store them in MESHOPT_meshlets (N should be between 3 and 255)\n");
 			fprintf(stderr, "\nMiscellaneous:\n");
 			fprintf(stderr, "\t-cf: produce compressed gltf/glb files with fallback for loaders that don't support compression\n");
 			fprintf(stderr, "\t-noq: disable quantization; produces much larger glTF files with no extensions\n");
+			fprintf(stderr, "\t-j N: use N threads to decode, process and compress geometry and animation data (default: 1; 0 = use all cores)\n");
+			fprintf(stderr, "\t-cache dir: reuse processed meshes, compressed buffers and encoded textures from previous runs stored in an existing directory\n");
 			fprintf(stderr, "\t-v: verbose output (print version when used without other options)\n");
 			fprintf(stderr, "\t-r file: output a JSON report to file\n");
 			fprintf(stderr, "\t-h: display this help and exit\n");
@@ -1643,7 +1972,7 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* buffer, size_t size)
 	std::vector<Animation> animations;
 
 	const char* error = NULL;
-	cgltf_data* data = parseGlb(buffer, size, meshes, animations, &error);
+	cgltf_data* data = parseGlb(buffer, size, meshes, animations, &error, settings.jobs);
 
 	// this is a difficult tradeoff
 	// returning 0 on files that fail to parse means that fuzzing is more incremental: files with errors are put into the corpus,
@@ -1654,8 +1983,9 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* buffer, size_t size)
 		return -1;
 
 	std::string json, bin, fallback;
-	size_t fallback_size = 0;
-	process(data, NULL, NULL, NULL, meshes, animations, settings, json, bin, fallback, fallback_size);
+	BufferOutput bin_output = {NULL, &bin};
+	BufferOutput fallback_output = {NULL, &fallback};
+	process(data, NULL, NULL, NULL, meshes, animations, settings, json, bin_output, fallback_output);
 
 	cgltf_free(data);
 
@@ -18,6 +18,8 @@
 #include "../extern/cgltf.h"
 
 #include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
 
 #include <string>
 #include <vector>
@@ -35,7 +37,8 @@ struct Stream
 
 	const char* custom_name; // only valid for cgltf_attribute_type_custom
 
-	std::vector<Attr> data;
+	int components; // floats per vertex in data; see getStreamComponents
+	std::vector<float> data;
 };
 
 struct Transform
@@ -43,6 +46,19 @@ struct Transform
 	float data[16];
 };
 
+struct Meshlet
+{
+	unsigned int vertex_offset;
+	unsigned int triangle_offset; // in triangles
+	unsigned int vertex_count;
+	unsigned int triangle_count;
+
+	float center[3];
+	float radius;
+	float cone_axis[3];
+	float cone_cutoff;
+};
+
 struct Mesh
 {
 	int scene;
@@ -62,6 +78,11 @@ struct Mesh
 	std::vector<const char*> target_names;
 
 	std::vector<cgltf_material_mapping> variants;
+
+	// only filled for triangle meshes when Settings::meshlet_vertices is set
+	std::vector<Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned int> meshlet_triangles; // one triangle per element, 8 bits per local index
 };
 
 struct Track
@@ -140,6 +161,7 @@ struct Settings
 	float simplify_debug;
 
 	int meshlet_debug;
+	int meshlet_vertices;
 
 	bool texture_ktx2;
 	bool texture_embed;
@@ -155,6 +177,10 @@ struct Settings
 
 	int texture_jobs;
 
+	int jobs;
+
+	const char* cache_path;
+
 	bool quantize;
 
 	bool compress;
@@ -164,6 +190,43 @@ struct Settings
 	int verbose;
 };
 
+enum ProfileStage
+{
+	ProfileStage_Parse,
+	ProfileStage_Decompress,
+	ProfileStage_Merge,
+	ProfileStage_Meshes,
+	ProfileStage_Simplify,
+	ProfileStage_Optimize,
+	ProfileStage_Animation,
+	ProfileStage_Textures,
+	ProfileStage_Compress,
+	ProfileStage_Write,
+
+	ProfileStage__Count
+};
+
+struct ProfileTimer
+{
+	ProfileStage stage;
+
+	unsigned long long wall_time;
+	unsigned long long cpu_time;
+	unsigned long long allocations;
+};
+
+struct ProfileStats
+{
+	const char* name;
+	unsigned int count;
+
+	double wall_time;
+	double cpu_time; // thread time for stages that run in tasks, process time otherwise
+
+	unsigned long long allocations; // meshoptimizer allocations, only tracked when allocator is enabled
+	size_t peak_allocated;
+};
+
 struct QuantizationPosition
 {
 	float offset[3];
@@ -264,6 +327,7 @@ struct BufferView
 		Kind_Time,
 		Kind_Keyframe,
 		Kind_Instance,
+		Kind_Meshlet,
 		Kind_Image,
 		Kind_Count
 	};
@@ -285,6 +349,17 @@ struct BufferView
 	std::string data;
 
 	size_t bytes;
+	size_t raw_bytes;
+};
+
+struct BufferOutput
+{
+	// when file is NULL, data is appended to the string if present, or only counted otherwise
+	FILE* file;
+	std::string* data;
+
+	size_t size;
+	bool error;
 };
 
 std::string getTempPrefix();
@@ -294,20 +369,45 @@ std::string getFileName(const char* path);
 std::string getExtension(const char* path);
 
 bool readFile(const char* path, std::string& data);
+void* mapFile(const char* path, size_t& size);
+void unmapFile(void* data);
 bool writeFile(const char* path, const std::string& data);
 void removeFile(const char* path);
+bool renameFile(const char* from, const char* to);
+
+int getJobCount(int jobs);
+void runTasks(void* context, void (*task)(void* task_data, size_t task_index), void* task_data, size_t task_count);
+
+uint64_t hashCacheSeed(const char* kind);
+uint64_t hashCache(uint64_t hash, const void* data, size_t size);
+uint64_t hashCache(uint64_t hash, uint64_t value);
+bool readCache(const Settings& settings, const char* kind, uint64_t key, std::string& data);
+void writeCache(const Settings& settings, const char* kind, uint64_t key, const std::string& data);
+uint64_t hashMesh(const Mesh& mesh, const Settings& settings);
+bool readCachedMesh(Mesh& mesh, uint64_t key, const Settings& settings);
+void writeCachedMesh(const Mesh& mesh, uint64_t key, const Settings& settings);
+
+void enableProfileAllocator();
+ProfileTimer beginProfile(ProfileStage stage);
+void endProfile(const ProfileTimer& timer);
+ProfileStats getProfileStats(ProfileStage stage);
+size_t getPeakMemory();
 
 cgltf_data* parseObj(const char* path, std::vector<Mesh>& meshes, const char** error);
-cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error);
+cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error, int jobs);
 
-cgltf_data* parseGlb(const void* buffer, size_t size, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error);
+cgltf_data* parseGlb(const void* buffer, size_t size, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error, int jobs);
 
-void processAnimation(Animation& animation, const Settings& settings);
+void prepareAnimation(Animation& animation, const Settings& settings);
+void processAnimationTrack(Track& track, const Animation& animation, const Settings& settings);
 void processMesh(Mesh& mesh, const Settings& settings);
 
 void debugSimplify(const Mesh& mesh, Mesh& kinds, Mesh& loops, float ratio, bool attributes);
 void debugMeshlets(const Mesh& mesh, Mesh& meshlets, int max_vertices, bool scan);
 
+int getStreamComponents(cgltf_attribute_type type);
+size_t getVertexCount(const Stream& stream);
+
 bool compareMeshTargets(const Mesh& lhs, const Mesh& rhs);
 bool compareMeshVariants(const Mesh& lhs, const Mesh& rhs);
 bool compareMeshNodes(const Mesh& lhs, const Mesh& rhs);
@@ -375,6 +475,7 @@ void writeImage(std::string& json, std::vector<BufferView>& views, const cgltf_i
 void writeTexture(std::string& json, const cgltf_texture& texture, const ImageInfo* info, cgltf_data* data, const Settings& settings);
 void writeMeshAttributes(std::string& json, std::vector<BufferView>& views, std::string& json_accessors, size_t& accr_offset, const Mesh& mesh, int target, const QuantizationPosition& qp, const QuantizationTexture& qt, const Settings& settings);
 size_t writeMeshIndices(std::vector<BufferView>& views, std::string& json_accessors, size_t& accr_offset, const Mesh& mesh, const Settings& settings);
+void writeMeshMeshlets(std::string& json, std::vector<BufferView>& views, const Mesh& mesh, const QuantizationPosition& qp, const Settings& settings);
 size_t writeJointBindMatrices(std::vector<BufferView>& views, std::string& json_accessors, size_t& accr_offset, const cgltf_skin& skin, const QuantizationPosition& qp, const Settings& settings);
 size_t writeInstances(std::vector<BufferView>& views, std::string& json_accessors, size_t& accr_offset, const std::vector<Transform>& transforms, const QuantizationPosition& qp, const Settings& settings);
 void writeMeshNode(std::string& json, size_t mesh_offset, cgltf_node* node, cgltf_skin* skin, cgltf_data* data, const QuantizationPosition* qp);
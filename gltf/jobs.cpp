@@ -0,0 +1,79 @@
+// This file is part of gltfpack; see gltfpack.h for version/license details
+#include "gltfpack.h"
+
+#ifndef __wasi__
+#include <atomic>
+#include <thread>
+#endif
+
+#ifndef __wasi__
+struct TaskQueue
+{
+	void (*task)(void* task_data, size_t task_index);
+	void* task_data;
+	size_t task_count;
+
+	std::atomic<size_t> next;
+};
+
+static void runTaskQueue(TaskQueue* queue)
+{
+	for (;;)
+	{
+		size_t index = queue->next++;
+
+		if (index >= queue->task_count)
+			break;
+
+		queue->task(queue->task_data, index);
+	}
+}
+#endif
+
+int getJobCount(int jobs)
+{
+#ifndef __wasi__
+	if (jobs == 0)
+	{
+		unsigned int cores = std::thread::hardware_concurrency();
+		return cores ? int(cores) : 1;
+	}
+#endif
+
+	return jobs < 1 ? 1 : jobs;
+}
+
+void runTasks(void* context, void (*task)(void* task_data, size_t task_index), void* task_data, size_t task_count)
+{
+#ifndef __wasi__
+	int jobs = getJobCount(context ? *static_cast<const int*>(context) : 1);
+
+	if (jobs > 1 && task_count > 1)
+	{
+		TaskQueue queue;
+		queue.task = task;
+		queue.task_data = task_data;
+		queue.task_count = task_count;
+		queue.next = 0;
+
+		size_t thread_count = size_t(jobs) < task_count ? size_t(jobs) : task_count;
+
+		// the calling thread participates in processing as well
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < thread_count; ++i)
+			threads.push_back(std::thread(runTaskQueue, &queue));
+
+		runTaskQueue(&queue);
+
+		for (size_t i = 0; i < threads.size(); ++i)
+			threads[i].join();
+
+		return;
+	}
+#else
+	(void)context;
+#endif
+
+	for (size_t i = 0; i < task_count; ++i)
+		task(task_data, i);
+}
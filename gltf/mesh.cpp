@@ -86,18 +86,18 @@ static void transformMesh(Mesh& target, const Mesh& mesh, const cgltf_node* node
 
 		if (stream.type == cgltf_attribute_type_position)
 		{
-			for (size_t i = 0; i < stream.data.size(); ++i)
-				transformPosition(stream.data[i].f, source.data[i].f, transform);
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
+				transformPosition(&stream.data[i], &source.data[i], transform);
 		}
 		else if (stream.type == cgltf_attribute_type_normal)
 		{
-			for (size_t i = 0; i < stream.data.size(); ++i)
-				transformNormal(stream.data[i].f, source.data[i].f, transforminvt);
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
+				transformNormal(&stream.data[i], &source.data[i], transforminvt);
 		}
 		else if (stream.type == cgltf_attribute_type_tangent)
 		{
-			for (size_t i = 0; i < stream.data.size(); ++i)
-				transformNormal(stream.data[i].f, source.data[i].f, transform);
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
+				transformNormal(&stream.data[i], &source.data[i], transform);
 		}
 	}
 
@@ -112,6 +112,30 @@ static void transformMesh(Mesh& target, const Mesh& mesh, const cgltf_node* node
 	}
 }
 
+int getStreamComponents(cgltf_attribute_type type)
+{
+	switch (type)
+	{
+	case cgltf_attribute_type_position:
+	case cgltf_attribute_type_normal:
+		return 3;
+	case cgltf_attribute_type_texcoord:
+		return 2;
+	case cgltf_attribute_type_custom:
+		return 1;
+	default:
+		// tangents keep the sign in w, colors are expanded to RGBA, joints/weights hold 4 influences
+		return 4;
+	}
+}
+
+size_t getVertexCount(const Stream& stream)
+{
+	assert(stream.components > 0 && stream.data.size() % stream.components == 0);
+
+	return stream.data.size() / stream.components;
+}
+
 bool compareMeshTargets(const Mesh& lhs, const Mesh& rhs)
 {
 	if (lhs.targets != rhs.targets)
@@ -247,7 +271,7 @@ static void mergeMeshes(Mesh& target, const Mesh& mesh)
 {
 	assert(target.streams.size() == mesh.streams.size());
 
-	size_t vertex_offset = target.streams[0].data.size();
+	size_t vertex_offset = getVertexCount(target.streams[0]);
 	size_t index_offset = target.indices.size();
 
 	for (size_t i = 0; i < target.streams.size(); ++i)
@@ -295,54 +319,124 @@ void mergeMeshInstances(Mesh& mesh)
 	mesh.nodes.clear();
 }
 
+static cgltf_node* getMergeNode(cgltf_node* node, const Settings& settings)
+{
+	bool transform = node->has_translation | node->has_rotation | node->has_scale | node->has_matrix | (!!node->weights);
+
+	if (transform || (settings.keep_nodes && node->name && *node->name))
+		return node;
+
+	// nodes that can merge with siblings (see canMergeMeshNodes) are keyed by their parent
+	return node->parent;
+}
+
+// meshes that pass canMergeMeshes must have the same key; the reverse doesn't hold since nodes can collide with parents
+static uint64_t getMergeKey(const Mesh& mesh, const Settings& settings)
+{
+	uint64_t hash = hashCache(0, uint64_t(mesh.scene));
+
+	hash = hashCache(hash, mesh.nodes.size());
+
+	for (size_t i = 0; i < mesh.nodes.size(); ++i)
+		hash = hashCache(hash, uint64_t(uintptr_t(getMergeNode(mesh.nodes[i], settings))));
+
+	hash = hashCache(hash, mesh.instances.empty() ? NULL : &mesh.instances[0], mesh.instances.size() * sizeof(Transform));
+
+	hash = hashCache(hash, uint64_t(uintptr_t(mesh.material)));
+	hash = hashCache(hash, uint64_t(uintptr_t(mesh.skin)));
+	hash = hashCache(hash, mesh.type);
+
+	hash = hashCache(hash, mesh.targets);
+	hash = hashCache(hash, mesh.target_weights.size());
+	hash = hashCache(hash, mesh.target_names.size());
+
+	hash = hashCache(hash, mesh.variants.size());
+
+	for (size_t i = 0; i < mesh.variants.size(); ++i)
+	{
+		hash = hashCache(hash, mesh.variants[i].variant);
+		hash = hashCache(hash, uint64_t(uintptr_t(mesh.variants[i].material)));
+	}
+
+	hash = hashCache(hash, mesh.indices.empty());
+	hash = hashCache(hash, mesh.streams.size());
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		hash = hashCache(hash, mesh.streams[i].type);
+		hash = hashCache(hash, mesh.streams[i].index);
+		hash = hashCache(hash, mesh.streams[i].target);
+	}
+
+	return hash;
+}
+
 void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings)
 {
+	// group meshes by merge key so that each mesh is only compared against candidates from the same group
+	// groups are sorted by mesh index within the group, so the merge order is the same as a full scan
+	std::vector<std::pair<uint64_t, size_t> > order;
+	order.reserve(meshes.size());
+
 	for (size_t i = 0; i < meshes.size(); ++i)
+		if (!meshes[i].streams.empty())
+			order.push_back(std::make_pair(getMergeKey(meshes[i], settings), i));
+
+	std::sort(order.begin(), order.end());
+
+	for (size_t begin = 0, end = 0; begin < order.size(); begin = end)
 	{
-		Mesh& target = meshes[i];
+		end = begin + 1;
+		while (end < order.size() && order[end].first == order[begin].first)
+			end++;
 
-		if (target.streams.empty())
-			continue;
+		for (size_t i = begin; i < end; ++i)
+		{
+			Mesh& target = meshes[order[i].second];
 
-		size_t target_vertices = target.streams[0].data.size();
-		size_t target_indices = target.indices.size();
+			if (target.streams.empty())
+				continue;
 
-		size_t last_merged = i;
+			size_t target_vertices = getVertexCount(target.streams[0]);
+			size_t target_indices = target.indices.size();
 
-		for (size_t j = i + 1; j < meshes.size(); ++j)
-		{
-			Mesh& mesh = meshes[j];
+			size_t last_merged = i;
 
-			if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
+			for (size_t j = i + 1; j < end; ++j)
 			{
-				target_vertices += mesh.streams[0].data.size();
-				target_indices += mesh.indices.size();
-				last_merged = j;
-			}
-		}
+				Mesh& mesh = meshes[order[j].second];
 
-		for (size_t j = 0; j < target.streams.size(); ++j)
-			target.streams[j].data.reserve(target_vertices);
+				if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
+				{
+					target_vertices += getVertexCount(mesh.streams[0]);
+					target_indices += mesh.indices.size();
+					last_merged = j;
+				}
+			}
 
-		target.indices.reserve(target_indices);
+			for (size_t j = 0; j < target.streams.size(); ++j)
+				target.streams[j].data.reserve(target_vertices * target.streams[j].components);
 
-		for (size_t j = i + 1; j <= last_merged; ++j)
-		{
-			Mesh& mesh = meshes[j];
+			target.indices.reserve(target_indices);
 
-			if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
+			for (size_t j = i + 1; j <= last_merged; ++j)
 			{
-				mergeMeshes(target, mesh);
+				Mesh& mesh = meshes[order[j].second];
 
-				mesh.streams.clear();
-				mesh.indices.clear();
-				mesh.nodes.clear();
-				mesh.instances.clear();
+				if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
+				{
+					mergeMeshes(target, mesh);
+
+					mesh.streams.clear();
+					mesh.indices.clear();
+					mesh.nodes.clear();
+					mesh.instances.clear();
+				}
 			}
-		}
 
-		assert(target.streams[0].data.size() == target_vertices);
-		assert(target.indices.size() == target_indices);
+			assert(getVertexCount(target.streams[0]) == target_vertices);
+			assert(target.indices.size() == target_indices);
+		}
 	}
 }
 
@@ -380,14 +474,15 @@ void filterEmptyMeshes(std::vector<Mesh>& meshes)
 	meshes.resize(write);
 }
 
-static bool isConstant(const std::vector<Attr>& data, const Attr& value, float tolerance = 0.01f)
+static bool isConstant(const Stream& stream, const float* value, float tolerance = 0.01f)
 {
-	for (size_t i = 0; i < data.size(); ++i)
+	for (size_t i = 0; i < stream.data.size(); i += stream.components)
 	{
-		const Attr& a = data[i];
+		const float* a = &stream.data[i];
 
-		if (fabsf(a.f[0] - value.f[0]) > tolerance || fabsf(a.f[1] - value.f[1]) > tolerance || fabsf(a.f[2] - value.f[2]) > tolerance || fabsf(a.f[3] - value.f[3]) > tolerance)
-			return false;
+		for (int k = 0; k < stream.components; ++k)
+			if (fabsf(a[k] - value[k]) > tolerance)
+				return false;
 	}
 
 	return true;
@@ -395,6 +490,9 @@ static bool isConstant(const std::vector<Attr>& data, const Attr& value, float t
 
 void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 {
+	static const float kZero[4] = {0, 0, 0, 0};
+	static const float kOne[4] = {1, 1, 1, 1};
+
 	bool morph_normal = false;
 	bool morph_tangent = false;
 	int keep_texture_set = -1;
@@ -405,8 +503,8 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 
 		if (stream.target)
 		{
-			morph_normal = morph_normal || (stream.type == cgltf_attribute_type_normal && !isConstant(stream.data, {0, 0, 0, 0}));
-			morph_tangent = morph_tangent || (stream.type == cgltf_attribute_type_tangent && !isConstant(stream.data, {0, 0, 0, 0}));
+			morph_normal = morph_normal || (stream.type == cgltf_attribute_type_normal && !isConstant(stream, kZero));
+			morph_tangent = morph_tangent || (stream.type == cgltf_attribute_type_tangent && !isConstant(stream, kZero));
 		}
 
 		if (stream.type == cgltf_attribute_type_texcoord && stream.index < 32 && (mi.texture_set_mask & (1u << stream.index)) != 0)
@@ -433,7 +531,7 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 		if ((stream.type == cgltf_attribute_type_joints || stream.type == cgltf_attribute_type_weights) && !mesh.skin)
 			continue;
 
-		if (stream.type == cgltf_attribute_type_color && isConstant(stream.data, {1, 1, 1, 1}))
+		if (stream.type == cgltf_attribute_type_color && isConstant(stream, kOne))
 			continue;
 
 		if (stream.target && stream.type == cgltf_attribute_type_normal && !morph_normal)
@@ -442,11 +540,11 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 		if (stream.target && stream.type == cgltf_attribute_type_tangent && !morph_tangent)
 			continue;
 
-		if (mesh.type == cgltf_primitive_type_points && stream.type == cgltf_attribute_type_normal && !stream.data.empty() && isConstant(stream.data, stream.data[0]))
+		if (mesh.type == cgltf_primitive_type_points && stream.type == cgltf_attribute_type_normal && !stream.data.empty() && isConstant(stream, &stream.data[0]))
 			continue;
 
 		// the following code is roughly equivalent to streams[write] = std::move(stream)
-		std::vector<Attr> data;
+		std::vector<float> data;
 		data.swap(stream.data);
 
 		mesh.streams[write] = stream;
@@ -460,7 +558,7 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 
 static void reindexMesh(Mesh& mesh)
 {
-	size_t total_vertices = mesh.streams[0].data.size();
+	size_t total_vertices = getVertexCount(mesh.streams[0]);
 	size_t total_indices = mesh.indices.size();
 
 	std::vector<meshopt_Stream> streams;
@@ -469,15 +567,41 @@ static void reindexMesh(Mesh& mesh)
 		if (mesh.streams[i].target)
 			continue;
 
-		assert(mesh.streams[i].data.size() == total_vertices);
+		assert(getVertexCount(mesh.streams[i]) == total_vertices);
+
+		size_t stride = mesh.streams[i].components * sizeof(float);
 
-		meshopt_Stream stream = {&mesh.streams[i].data[0], sizeof(Attr), sizeof(Attr)};
+		meshopt_Stream stream = {&mesh.streams[i].data[0], stride, stride};
 		streams.push_back(stream);
 	}
 
 	if (streams.empty())
 		return;
 
+	// without morph targets, all streams participate in deduplication so reindexing can be done in one pass
+	if (streams.size() == mesh.streams.size())
+	{
+		std::vector<std::vector<float> > data(streams.size());
+		std::vector<void*> destinations(streams.size());
+
+		for (size_t i = 0; i < streams.size(); ++i)
+		{
+			data[i].resize(total_vertices * mesh.streams[i].components);
+			destinations[i] = &data[i][0];
+		}
+
+		size_t unique_vertices = meshopt_reindexMesh(&mesh.indices[0], &destinations[0], &mesh.indices[0], total_indices, total_vertices, &streams[0], streams.size());
+		assert(unique_vertices <= total_vertices);
+
+		for (size_t i = 0; i < mesh.streams.size(); ++i)
+		{
+			data[i].resize(unique_vertices * mesh.streams[i].components);
+			mesh.streams[i].data.swap(data[i]);
+		}
+
+		return;
+	}
+
 	std::vector<unsigned int> remap(total_vertices);
 	size_t unique_vertices = meshopt_generateVertexRemapMulti(&remap[0], &mesh.indices[0], total_indices, total_vertices, &streams[0], streams.size());
 	assert(unique_vertices <= total_vertices);
@@ -486,10 +610,10 @@ static void reindexMesh(Mesh& mesh)
 
 	for (size_t i = 0; i < mesh.streams.size(); ++i)
 	{
-		assert(mesh.streams[i].data.size() == total_vertices);
+		assert(getVertexCount(mesh.streams[i]) == total_vertices);
 
-		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], total_vertices, sizeof(Attr), &remap[0]);
-		mesh.streams[i].data.resize(unique_vertices);
+		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], total_vertices, mesh.streams[i].components * sizeof(float), &remap[0]);
+		mesh.streams[i].data.resize(unique_vertices * mesh.streams[i].components);
 	}
 }
 
@@ -538,7 +662,7 @@ static void simplifyMesh(Mesh& mesh, float threshold, bool attributes, bool aggr
 	if (!positions)
 		return;
 
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	size_t target_index_count = size_t(double(mesh.indices.size() / 3) * threshold) * 3;
 	float target_error = 1e-2f;
@@ -552,9 +676,9 @@ static void simplifyMesh(Mesh& mesh, float threshold, bool attributes, bool aggr
 
 	std::vector<unsigned int> indices(mesh.indices.size());
 	if (attributes && attr)
-		indices.resize(meshopt_simplifyWithAttributes(&indices[0], &mesh.indices[0], mesh.indices.size(), positions->data[0].f, vertex_count, sizeof(Attr), attr->data[0].f, sizeof(Attr), attrw, 3, NULL, target_index_count, target_error, options));
+		indices.resize(meshopt_simplifyWithAttributes(&indices[0], &mesh.indices[0], mesh.indices.size(), &positions->data[0], vertex_count, positions->components * sizeof(float), &attr->data[0], attr->components * sizeof(float), attrw, 3, NULL, target_index_count, target_error, options));
 	else
-		indices.resize(meshopt_simplify(&indices[0], &mesh.indices[0], mesh.indices.size(), positions->data[0].f, vertex_count, sizeof(Attr), target_index_count, target_error, options));
+		indices.resize(meshopt_simplify(&indices[0], &mesh.indices[0], mesh.indices.size(), &positions->data[0], vertex_count, positions->components * sizeof(float), target_index_count, target_error, options));
 	mesh.indices.swap(indices);
 
 	// Note: if the simplifier got stuck, we can try to reindex without normals/tangents and retry
@@ -563,7 +687,7 @@ static void simplifyMesh(Mesh& mesh, float threshold, bool attributes, bool aggr
 	// if the precise simplifier got "stuck", we'll try to simplify using the sloppy simplifier; this is only used when aggressive simplification is enabled as it breaks attribute discontinuities
 	if (aggressive && mesh.indices.size() > target_index_count)
 	{
-		indices.resize(meshopt_simplifySloppy(&indices[0], &mesh.indices[0], mesh.indices.size(), positions->data[0].f, vertex_count, sizeof(Attr), target_index_count, target_error_aggressive));
+		indices.resize(meshopt_simplifySloppy(&indices[0], &mesh.indices[0], mesh.indices.size(), &positions->data[0], vertex_count, positions->components * sizeof(float), target_index_count, target_error_aggressive));
 		mesh.indices.swap(indices);
 	}
 }
@@ -575,7 +699,7 @@ static void optimizeMesh(Mesh& mesh, bool compressmore)
 	if (mesh.indices.empty())
 		return;
 
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	if (compressmore)
 		meshopt_optimizeVertexCacheStrip(&mesh.indices[0], &mesh.indices[0], mesh.indices.size(), vertex_count);
@@ -590,10 +714,71 @@ static void optimizeMesh(Mesh& mesh, bool compressmore)
 
 	for (size_t i = 0; i < mesh.streams.size(); ++i)
 	{
-		assert(mesh.streams[i].data.size() == vertex_count);
+		assert(getVertexCount(mesh.streams[i]) == vertex_count);
 
-		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], vertex_count, sizeof(Attr), &remap[0]);
-		mesh.streams[i].data.resize(unique_vertices);
+		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], vertex_count, mesh.streams[i].components * sizeof(float), &remap[0]);
+		mesh.streams[i].data.resize(unique_vertices * mesh.streams[i].components);
+	}
+}
+
+static void buildMeshlets(Mesh& mesh, int max_vertices)
+{
+	assert(mesh.type == cgltf_primitive_type_triangles);
+
+	if (mesh.indices.empty())
+		return;
+
+	const Stream* positions = getStream(mesh, cgltf_attribute_type_position);
+	if (!positions)
+		return;
+
+	size_t vertex_count = getVertexCount(*positions);
+	size_t vertex_stride = positions->components * sizeof(float);
+
+	const float cone_weight = 0.25f;
+
+	size_t max_triangles = std::min((max_vertices * 2 + 3) & ~3, 512);
+	size_t max_meshlets = meshopt_buildMeshletsBound(mesh.indices.size(), max_vertices, max_triangles);
+
+	std::vector<meshopt_Meshlet> ml(max_meshlets);
+	std::vector<unsigned int> mlv(max_meshlets * max_vertices);
+	std::vector<unsigned char> mlt(max_meshlets * max_triangles * 3);
+
+	ml.resize(meshopt_buildMeshlets(&ml[0], &mlv[0], &mlt[0], &mesh.indices[0], mesh.indices.size(), &positions->data[0], vertex_count, vertex_stride, max_vertices, max_triangles, cone_weight));
+
+	mesh.meshlets.resize(ml.size());
+	mesh.meshlet_vertices.clear();
+	mesh.meshlet_triangles.clear();
+
+	// meshlet data is repacked contiguously; triangles are stored one per 32-bit element so that they can be fetched directly on the GPU
+	for (size_t i = 0; i < ml.size(); ++i)
+	{
+		const meshopt_Meshlet& m = ml[i];
+
+		meshopt_optimizeMeshlet(&mlv[m.vertex_offset], &mlt[m.triangle_offset], m.triangle_count, m.vertex_count);
+
+		meshopt_Bounds bounds = meshopt_computeMeshletBounds(&mlv[m.vertex_offset], &mlt[m.triangle_offset], m.triangle_count, &positions->data[0], vertex_count, vertex_stride);
+
+		Meshlet& r = mesh.meshlets[i];
+
+		r.vertex_offset = unsigned(mesh.meshlet_vertices.size());
+		r.triangle_offset = unsigned(mesh.meshlet_triangles.size());
+		r.vertex_count = m.vertex_count;
+		r.triangle_count = m.triangle_count;
+
+		memcpy(r.center, bounds.center, sizeof(r.center));
+		r.radius = bounds.radius;
+		memcpy(r.cone_axis, bounds.cone_axis, sizeof(r.cone_axis));
+		r.cone_cutoff = bounds.cone_cutoff;
+
+		mesh.meshlet_vertices.insert(mesh.meshlet_vertices.end(), &mlv[m.vertex_offset], &mlv[m.vertex_offset] + m.vertex_count);
+
+		for (size_t j = 0; j < m.triangle_count; ++j)
+		{
+			const unsigned char* t = &mlt[m.triangle_offset + j * 3];
+
+			mesh.meshlet_triangles.push_back(t[0] | (t[1] << 8) | (t[2] << 16));
+		}
 	}
 }
 
@@ -627,6 +812,8 @@ static void filterBones(Mesh& mesh)
 		if (!jg || !wg)
 			break;
 
+		assert(jg->components == 4 && wg->components == 4);
+
 		groups[group_count++] = std::make_pair(jg, wg);
 	}
 
@@ -636,7 +823,7 @@ static void filterBones(Mesh& mesh)
 	// weights below cutoff can't be represented in quantized 8-bit storage
 	const float weight_cutoff = 0.5f / 255.f;
 
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	BoneInfluence inf[kMaxGroups * 4] = {};
 
@@ -647,14 +834,14 @@ static void filterBones(Mesh& mesh)
 		// gather all bone influences for this vertex
 		for (int j = 0; j < group_count; ++j)
 		{
-			const Attr& ja = groups[j].first->data[i];
-			const Attr& wa = groups[j].second->data[i];
+			const float* ja = &groups[j].first->data[i * 4];
+			const float* wa = &groups[j].second->data[i * 4];
 
 			for (int k = 0; k < 4; ++k)
-				if (wa.f[k] > weight_cutoff)
+				if (wa[k] > weight_cutoff)
 				{
-					inf[count].i = ja.f[k];
-					inf[count].w = wa.f[k];
+					inf[count].i = ja[k];
+					inf[count].w = wa[k];
 					count++;
 				}
 		}
@@ -663,20 +850,20 @@ static void filterBones(Mesh& mesh)
 		std::sort(inf, inf + count, BoneInfluenceWeightPredicate());
 
 		// copy the top 4 influences back into stream 0 - we will remove other streams at the end
-		Attr& ja = groups[0].first->data[i];
-		Attr& wa = groups[0].second->data[i];
+		float* ja = &groups[0].first->data[i * 4];
+		float* wa = &groups[0].second->data[i * 4];
 
 		for (int k = 0; k < 4; ++k)
 		{
 			if (k < count)
 			{
-				ja.f[k] = inf[k].i;
-				wa.f[k] = inf[k].w;
+				ja[k] = inf[k].i;
+				wa[k] = inf[k].w;
 			}
 			else
 			{
-				ja.f[k] = 0.f;
-				wa.f[k] = 0.f;
+				ja[k] = 0.f;
+				wa[k] = 0.f;
 			}
 		}
 	}
@@ -706,7 +893,7 @@ static void simplifyPointMesh(Mesh& mesh, float threshold)
 
 	const Stream* colors = getStream(mesh, cgltf_attribute_type_color);
 
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	size_t target_vertex_count = size_t(double(vertex_count) * threshold);
 
@@ -714,18 +901,21 @@ static void simplifyPointMesh(Mesh& mesh, float threshold)
 
 	std::vector<unsigned int> indices(target_vertex_count);
 	if (target_vertex_count)
-		indices.resize(meshopt_simplifyPoints(&indices[0], positions->data[0].f, vertex_count, sizeof(Attr), colors ? colors->data[0].f : NULL, sizeof(Attr), color_weight, target_vertex_count));
+		indices.resize(meshopt_simplifyPoints(&indices[0], &positions->data[0], vertex_count, positions->components * sizeof(float), colors ? &colors->data[0] : NULL, colors ? colors->components * sizeof(float) : 0, color_weight, target_vertex_count));
 
-	std::vector<Attr> scratch(indices.size());
+	std::vector<float> scratch;
 
 	for (size_t i = 0; i < mesh.streams.size(); ++i)
 	{
-		std::vector<Attr>& data = mesh.streams[i].data;
+		std::vector<float>& data = mesh.streams[i].data;
+		int components = mesh.streams[i].components;
 
-		assert(data.size() == vertex_count);
+		assert(getVertexCount(mesh.streams[i]) == vertex_count);
+
+		scratch.resize(indices.size() * components);
 
 		for (size_t j = 0; j < indices.size(); ++j)
-			scratch[j] = data[indices[j]];
+			memcpy(&scratch[j * components], &data[indices[j] * components], components * sizeof(float));
 
 		data = scratch;
 	}
@@ -743,39 +933,55 @@ static void sortPointMesh(Mesh& mesh)
 	if (getStream(mesh, cgltf_attribute_type_custom))
 		return;
 
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	std::vector<unsigned int> remap(vertex_count);
-	meshopt_spatialSortRemap(&remap[0], positions->data[0].f, vertex_count, sizeof(Attr));
+	meshopt_spatialSortRemap(&remap[0], &positions->data[0], vertex_count, positions->components * sizeof(float));
 
 	for (size_t i = 0; i < mesh.streams.size(); ++i)
 	{
-		assert(mesh.streams[i].data.size() == vertex_count);
+		assert(getVertexCount(mesh.streams[i]) == vertex_count);
 
-		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], vertex_count, sizeof(Attr), &remap[0]);
+		meshopt_remapVertexBuffer(&mesh.streams[i].data[0], &mesh.streams[i].data[0], vertex_count, mesh.streams[i].components * sizeof(float), &remap[0]);
 	}
 }
 
 void processMesh(Mesh& mesh, const Settings& settings)
 {
+	ProfileTimer timer;
+
 	switch (mesh.type)
 	{
 	case cgltf_primitive_type_points:
 		assert(mesh.indices.empty());
+		timer = beginProfile(ProfileStage_Simplify);
 		simplifyPointMesh(mesh, settings.simplify_threshold);
+		endProfile(timer);
+		timer = beginProfile(ProfileStage_Optimize);
 		sortPointMesh(mesh);
+		endProfile(timer);
 		break;
 
 	case cgltf_primitive_type_lines:
 		break;
 
 	case cgltf_primitive_type_triangles:
+		timer = beginProfile(ProfileStage_Optimize);
 		filterBones(mesh);
 		reindexMesh(mesh);
 		filterTriangles(mesh);
+		endProfile(timer);
 		if (settings.simplify_threshold < 1)
+		{
+			timer = beginProfile(ProfileStage_Simplify);
 			simplifyMesh(mesh, settings.simplify_threshold, settings.simplify_attributes, settings.simplify_aggressive, settings.simplify_lock_borders);
+			endProfile(timer);
+		}
+		timer = beginProfile(ProfileStage_Optimize);
 		optimizeMesh(mesh, settings.compressmore);
+		if (settings.meshlet_vertices > 0)
+			buildMeshlets(mesh, settings.meshlet_vertices);
+		endProfile(timer);
 		break;
 
 	default:
@@ -800,7 +1006,7 @@ void debugSimplify(const Mesh& source, Mesh& kinds, Mesh& loops, float ratio, bo
 	filterTriangles(mesh);
 
 	// before simplification we need to setup target kind/loop arrays
-	size_t vertex_count = mesh.streams[0].data.size();
+	size_t vertex_count = getVertexCount(mesh.streams[0]);
 
 	std::vector<unsigned char> kind(vertex_count);
 	std::vector<unsigned int> loop(vertex_count);
@@ -822,7 +1028,7 @@ void debugSimplify(const Mesh& source, Mesh& kinds, Mesh& loops, float ratio, bo
 		live[mesh.indices[i]] = true;
 
 	// color palette for display
-	static const Attr kPalette[] = {
+	static const float kPalette[][4] = {
 	    {0.5f, 0.5f, 0.5f, 1.f}, // manifold
 	    {0.f, 0.f, 1.f, 1.f},    // border
 	    {0.f, 1.f, 0.f, 1.f},    // seam
@@ -850,10 +1056,11 @@ void debugSimplify(const Mesh& source, Mesh& kinds, Mesh& loops, float ratio, bo
 
 	// transform kind/loop data into lines & points
 	Stream colors = {cgltf_attribute_type_color};
-	colors.data.resize(vertex_count);
+	colors.components = getStreamComponents(colors.type);
+	colors.data.resize(vertex_count * 4);
 
 	for (size_t i = 0; i < vertex_count; ++i)
-		colors.data[i] = kPalette[kind[i]];
+		memcpy(&colors.data[i * 4], kPalette[kind[i]], 4 * sizeof(float));
 
 	kinds.type = cgltf_primitive_type_points;
 
@@ -907,9 +1114,9 @@ void debugMeshlets(const Mesh& source, Mesh& meshlets, int max_vertices, bool sc
 	std::vector<unsigned char> mlt(max_meshlets * max_triangles * 3);
 
 	if (scan)
-		ml.resize(meshopt_buildMeshletsScan(&ml[0], &mlv[0], &mlt[0], &mesh.indices[0], mesh.indices.size(), positions->data.size(), max_vertices, max_triangles));
+		ml.resize(meshopt_buildMeshletsScan(&ml[0], &mlv[0], &mlt[0], &mesh.indices[0], mesh.indices.size(), getVertexCount(*positions), max_vertices, max_triangles));
 	else
-		ml.resize(meshopt_buildMeshlets(&ml[0], &mlv[0], &mlt[0], &mesh.indices[0], mesh.indices.size(), positions->data[0].f, positions->data.size(), sizeof(Attr), max_vertices, max_triangles, cone_weight));
+		ml.resize(meshopt_buildMeshlets(&ml[0], &mlv[0], &mlt[0], &mesh.indices[0], mesh.indices.size(), &positions->data[0], getVertexCount(*positions), positions->components * sizeof(float), max_vertices, max_triangles, cone_weight));
 
 	// generate meshlet meshes, using unique colors
 	meshlets.nodes = mesh.nodes;
@@ -917,6 +1124,9 @@ void debugMeshlets(const Mesh& source, Mesh& meshlets, int max_vertices, bool sc
 	Stream mv = {cgltf_attribute_type_position};
 	Stream mc = {cgltf_attribute_type_color};
 
+	mv.components = getStreamComponents(mv.type);
+	mc.components = getStreamComponents(mc.type);
+
 	for (size_t i = 0; i < ml.size(); ++i)
 	{
 		const meshopt_Meshlet& m = ml[i];
@@ -926,14 +1136,16 @@ void debugMeshlets(const Mesh& source, Mesh& meshlets, int max_vertices, bool sc
 		h *= 0x5bd1e995;
 		h ^= h >> 15;
 
-		Attr c = {{float(h & 0xff) / 255.f, float((h >> 8) & 0xff) / 255.f, float((h >> 16) & 0xff) / 255.f, 1.f}};
+		float c[4] = {float(h & 0xff) / 255.f, float((h >> 8) & 0xff) / 255.f, float((h >> 16) & 0xff) / 255.f, 1.f};
 
-		unsigned int offset = unsigned(mv.data.size());
+		unsigned int offset = unsigned(getVertexCount(mv));
 
 		for (size_t j = 0; j < m.vertex_count; ++j)
 		{
-			mv.data.push_back(positions->data[mlv[m.vertex_offset + j]]);
-			mc.data.push_back(c);
+			const float* p = &positions->data[mlv[m.vertex_offset + j] * positions->components];
+
+			mv.data.insert(mv.data.end(), p, p + positions->components);
+			mc.data.insert(mc.data.end(), c, c + 4);
 		}
 
 		for (size_t j = 0; j < m.triangle_count; ++j)
@@ -66,6 +66,31 @@ static void readAccessor(std::vector<Attr>& data, const cgltf_accessor* accessor
 	}
 }
 
+static void readAccessor(std::vector<float>& data, size_t components, const cgltf_accessor* accessor)
+{
+	size_t source_components = cgltf_num_components(accessor->type);
+
+	data.resize(accessor->count * components);
+
+	if (data.empty())
+		return;
+
+	if (source_components == components)
+	{
+		cgltf_accessor_unpack_floats(accessor, &data[0], data.size());
+		return;
+	}
+
+	std::vector<float> temp(accessor->count * source_components);
+	cgltf_accessor_unpack_floats(accessor, &temp[0], temp.size());
+
+	for (size_t i = 0; i < accessor->count; ++i)
+	{
+		for (size_t k = 0; k < components; ++k)
+			data[i * components + k] = k < source_components ? temp[i * source_components + k] : 0.f;
+	}
+}
+
 static void fixupIndices(std::vector<unsigned int>& indices, cgltf_primitive_type& type)
 {
 	if (type == cgltf_primitive_type_line_loop)
@@ -230,12 +255,14 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 				if (attr.type == cgltf_attribute_type_custom)
 					s.custom_name = attr.name;
 
-				readAccessor(s.data, attr.data);
+				s.components = getStreamComponents(attr.type);
+
+				readAccessor(s.data, s.components, attr.data);
 
 				if (attr.type == cgltf_attribute_type_color && attr.data->type == cgltf_type_vec3)
 				{
-					for (size_t i = 0; i < s.data.size(); ++i)
-						s.data[i].f[3] = 1.0f;
+					for (size_t i = 3; i < s.data.size(); i += 4)
+						s.data[i] = 1.0f;
 				}
 			}
 
@@ -259,8 +286,9 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 					s.type = attr.type;
 					s.index = attr.index;
 					s.target = int(ti + 1);
+					s.components = getStreamComponents(attr.type);
 
-					readAccessor(s.data, attr.data);
+					readAccessor(s.data, s.components, attr.data);
 				}
 			}
 
@@ -459,15 +487,60 @@ static bool needsDummyBuffers(cgltf_data* data)
 	return false;
 }
 
+static cgltf_result readFileMapped(const cgltf_memory_options* memory_options, const cgltf_file_options* file_options, const char* path, cgltf_size* size, void** data)
+{
+	(void)memory_options;
+	(void)file_options;
+
+	size_t file_size = 0;
+	void* file_data = mapFile(path, file_size);
+	if (!file_data)
+		return cgltf_result_file_not_found;
+
+	// cgltf requests the exact buffer size for external buffers; like the default reader, we fail if the file is too short
+	if (size && *size && file_size < *size)
+	{
+		unmapFile(file_data);
+		return cgltf_result_io_error;
+	}
+
+	if (size && *size == 0)
+		*size = file_size;
+
+	*data = file_data;
+	return cgltf_result_success;
+}
+
+static void releaseFileMapped(const cgltf_memory_options* memory_options, const cgltf_file_options* file_options, void* data)
+{
+	(void)memory_options;
+	(void)file_options;
+
+	if (data)
+		unmapFile(data);
+}
+
 static void freeFile(cgltf_data* data)
 {
 	data->json = NULL;
 	data->bin = NULL;
 
-	free(data->file_data);
+	if (data->file.release)
+		data->file.release(&data->memory, &data->file, data->file_data);
+	else
+		free(data->file_data);
+
 	data->file_data = NULL;
 }
 
+static void freeBuffer(cgltf_data* data, cgltf_buffer& buffer)
+{
+	if (buffer.data_free_method == cgltf_data_free_method_file_release && data->file.release)
+		data->file.release(&data->memory, &data->file, buffer.data);
+	else if (buffer.data_free_method != cgltf_data_free_method_none)
+		free(buffer.data);
+}
+
 static bool freeUnusedBuffers(cgltf_data* data)
 {
 	std::vector<char> used(data->buffers_count);
@@ -503,7 +576,7 @@ static bool freeUnusedBuffers(cgltf_data* data)
 		if (!used[i] && buffer.data)
 		{
 			if (buffer.data != data->bin)
-				free(buffer.data);
+				freeBuffer(data, buffer);
 			else
 				free_bin = true;
 
@@ -514,66 +587,83 @@ static bool freeUnusedBuffers(cgltf_data* data)
 	return free_bin;
 }
 
-static cgltf_result decompressMeshopt(cgltf_data* data)
+struct DecompressTasks
 {
-	for (size_t i = 0; i < data->buffer_views_count; ++i)
-	{
-		if (!data->buffer_views[i].has_meshopt_compression)
-			continue;
-		cgltf_meshopt_compression* mc = &data->buffer_views[i].meshopt_compression;
+	cgltf_data* data;
 
-		const unsigned char* source = (const unsigned char*)mc->buffer->data;
-		if (!source)
-			return cgltf_result_invalid_gltf;
-		source += mc->offset;
+	std::vector<size_t> views;
+	std::vector<cgltf_result> results;
+};
 
-		void* result = malloc(mc->count * mc->stride);
-		if (!result)
-			return cgltf_result_out_of_memory;
+static cgltf_result decompressMeshopt(cgltf_buffer_view& view)
+{
+	cgltf_meshopt_compression* mc = &view.meshopt_compression;
 
-		int rc = -1;
+	const unsigned char* source = (const unsigned char*)mc->buffer->data;
+	if (!source)
+		return cgltf_result_invalid_gltf;
+	source += mc->offset;
 
-		switch (mc->mode)
-		{
-		case cgltf_meshopt_compression_mode_attributes:
-			rc = meshopt_decodeVertexBuffer(result, mc->count, mc->stride, source, mc->size);
-			break;
+	void* result = malloc(mc->count * mc->stride);
+	if (!result)
+		return cgltf_result_out_of_memory;
 
-		case cgltf_meshopt_compression_mode_triangles:
-			rc = meshopt_decodeIndexBuffer(result, mc->count, mc->stride, source, mc->size);
-			break;
+	// the decoded data is released by cgltf_free even if decoding fails
+	view.data = result;
 
-		case cgltf_meshopt_compression_mode_indices:
-			rc = meshopt_decodeIndexSequence(result, mc->count, mc->stride, source, mc->size);
-			break;
+	int rc = -1;
 
-		default:
-			return cgltf_result_invalid_gltf;
-		}
+	switch (mc->mode)
+	{
+	case cgltf_meshopt_compression_mode_attributes:
+		// filters are only valid for attributes and are applied to each block as it's decoded; meshopt_DecodeFilter matches cgltf filter enumeration
+		rc = meshopt_decodeVertexBufferFiltered(result, mc->count, mc->stride, source, mc->size, meshopt_DecodeFilter(mc->filter));
+		break;
 
-		if (rc != 0)
-			return cgltf_result_io_error;
+	case cgltf_meshopt_compression_mode_triangles:
+		rc = meshopt_decodeIndexBuffer(result, mc->count, mc->stride, source, mc->size);
+		break;
 
-		switch (mc->filter)
-		{
-		case cgltf_meshopt_compression_filter_octahedral:
-			meshopt_decodeFilterOct(result, mc->count, mc->stride);
-			break;
+	case cgltf_meshopt_compression_mode_indices:
+		rc = meshopt_decodeIndexSequence(result, mc->count, mc->stride, source, mc->size);
+		break;
 
-		case cgltf_meshopt_compression_filter_quaternion:
-			meshopt_decodeFilterQuat(result, mc->count, mc->stride);
-			break;
+	default:
+		return cgltf_result_invalid_gltf;
+	}
 
-		case cgltf_meshopt_compression_filter_exponential:
-			meshopt_decodeFilterExp(result, mc->count, mc->stride);
-			break;
+	if (rc != 0)
+		return cgltf_result_io_error;
 
-		default:
-			break;
-		}
+	return cgltf_result_success;
+}
 
-		data->buffer_views[i].data = result;
-	}
+static void decompressMeshoptTask(void* task_data, size_t task_index)
+{
+	DecompressTasks& tasks = *static_cast<DecompressTasks*>(task_data);
+
+	tasks.results[task_index] = decompressMeshopt(tasks.data->buffer_views[tasks.views[task_index]]);
+}
+
+static cgltf_result decompressMeshopt(cgltf_data* data, int jobs)
+{
+	DecompressTasks tasks;
+	tasks.data = data;
+
+	for (size_t i = 0; i < data->buffer_views_count; ++i)
+		if (data->buffer_views[i].has_meshopt_compression)
+			tasks.views.push_back(i);
+
+	tasks.results.resize(tasks.views.size(), cgltf_result_success);
+
+	// buffer views are decoded independently; errors are reported in view order so that the result doesn't depend on the job count
+	ProfileTimer timer = beginProfile(ProfileStage_Decompress);
+	runTasks(&jobs, decompressMeshoptTask, &tasks, tasks.views.size());
+	endProfile(timer);
+
+	for (size_t i = 0; i < tasks.results.size(); ++i)
+		if (tasks.results[i] != cgltf_result_success)
+			return tasks.results[i];
 
 	return cgltf_result_success;
 }
@@ -614,11 +704,15 @@ static cgltf_data* parseGltf(cgltf_data* data, cgltf_result result, std::vector<
 	return data;
 }
 
-cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error)
+cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error, int jobs)
 {
 	cgltf_data* data = NULL;
 
+	// input files are memory-mapped so that the GLB binary chunk and external buffers are referenced in place instead of being copied to the heap
 	cgltf_options options = {};
+	options.file.read = readFileMapped;
+	options.file.release = releaseFileMapped;
+
 	cgltf_result result = cgltf_parse_file(&options, path, &data);
 
 	if (data && !data->bin)
@@ -626,12 +720,12 @@ cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<A
 
 	result = (result == cgltf_result_success) ? cgltf_load_buffers(&options, data, path) : result;
 	result = (result == cgltf_result_success) ? cgltf_validate(data) : result;
-	result = (result == cgltf_result_success) ? decompressMeshopt(data) : result;
+	result = (result == cgltf_result_success) ? decompressMeshopt(data, jobs) : result;
 
 	return parseGltf(data, result, meshes, animations, error);
 }
 
-cgltf_data* parseGlb(const void* buffer, size_t size, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error)
+cgltf_data* parseGlb(const void* buffer, size_t size, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error, int jobs)
 {
 	cgltf_data* data = NULL;
 
@@ -642,7 +736,7 @@ cgltf_data* parseGlb(const void* buffer, size_t size, std::vector<Mesh>& meshes,
 
 	result = (result == cgltf_result_success) ? cgltf_load_buffers(&options, data, NULL) : result;
 	result = (result == cgltf_result_success) ? cgltf_validate(data) : result;
-	result = (result == cgltf_result_success) ? decompressMeshopt(data) : result;
+	result = (result == cgltf_result_success) ? decompressMeshopt(data, jobs) : result;
 
 	return parseGltf(data, result, meshes, animations, error);
 }
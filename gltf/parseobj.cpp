@@ -158,24 +158,28 @@ static void parseMeshObj(fastObjMesh* obj, unsigned int face_offset, unsigned in
 	mesh.streams.resize(1 + (nrm_stream >= 0) + (tex_stream >= 0) + (col_stream >= 0));
 
 	mesh.streams[pos_stream].type = cgltf_attribute_type_position;
-	mesh.streams[pos_stream].data.resize(unique_vertices);
+	mesh.streams[pos_stream].components = getStreamComponents(mesh.streams[pos_stream].type);
+	mesh.streams[pos_stream].data.resize(unique_vertices * mesh.streams[pos_stream].components);
 
 	if (nrm_stream >= 0)
 	{
 		mesh.streams[nrm_stream].type = cgltf_attribute_type_normal;
-		mesh.streams[nrm_stream].data.resize(unique_vertices);
+		mesh.streams[nrm_stream].components = getStreamComponents(mesh.streams[nrm_stream].type);
+		mesh.streams[nrm_stream].data.resize(unique_vertices * mesh.streams[nrm_stream].components);
 	}
 
 	if (tex_stream >= 0)
 	{
 		mesh.streams[tex_stream].type = cgltf_attribute_type_texcoord;
-		mesh.streams[tex_stream].data.resize(unique_vertices);
+		mesh.streams[tex_stream].components = getStreamComponents(mesh.streams[tex_stream].type);
+		mesh.streams[tex_stream].data.resize(unique_vertices * mesh.streams[tex_stream].components);
 	}
 
 	if (col_stream >= 0)
 	{
 		mesh.streams[col_stream].type = cgltf_attribute_type_color;
-		mesh.streams[col_stream].data.resize(unique_vertices);
+		mesh.streams[col_stream].components = getStreamComponents(mesh.streams[col_stream].type);
+		mesh.streams[col_stream].data.resize(unique_vertices * mesh.streams[col_stream].components);
 	}
 
 	mesh.indices.resize(index_count);
@@ -187,25 +191,32 @@ static void parseMeshObj(fastObjMesh* obj, unsigned int face_offset, unsigned in
 
 		fastObjIndex ii = obj->indices[face_vertex_offset + vi];
 
-		Attr p = {{obj->positions[ii.p * 3 + 0], obj->positions[ii.p * 3 + 1], obj->positions[ii.p * 3 + 2]}};
-		mesh.streams[pos_stream].data[target] = p;
+		float* p = &mesh.streams[pos_stream].data[target * 3];
+		p[0] = obj->positions[ii.p * 3 + 0];
+		p[1] = obj->positions[ii.p * 3 + 1];
+		p[2] = obj->positions[ii.p * 3 + 2];
 
 		if (nrm_stream >= 0)
 		{
-			Attr n = {{obj->normals[ii.n * 3 + 0], obj->normals[ii.n * 3 + 1], obj->normals[ii.n * 3 + 2]}};
-			mesh.streams[nrm_stream].data[target] = n;
+			float* n = &mesh.streams[nrm_stream].data[target * 3];
+			n[0] = obj->normals[ii.n * 3 + 0];
+			n[1] = obj->normals[ii.n * 3 + 1];
+			n[2] = obj->normals[ii.n * 3 + 2];
 		}
 
 		if (tex_stream >= 0)
 		{
-			Attr t = {{obj->texcoords[ii.t * 2 + 0], 1.f - obj->texcoords[ii.t * 2 + 1]}};
-			mesh.streams[tex_stream].data[target] = t;
+			float* t = &mesh.streams[tex_stream].data[target * 2];
+			t[0] = obj->texcoords[ii.t * 2 + 0];
+			t[1] = 1.f - obj->texcoords[ii.t * 2 + 1];
 		}
 
 		if (col_stream >= 0)
 		{
-			Attr c = {{obj->colors[ii.p * 3 + 0], obj->colors[ii.p * 3 + 1], obj->colors[ii.p * 3 + 2]}};
-			mesh.streams[col_stream].data[target] = c;
+			float* c = &mesh.streams[col_stream].data[target * 4];
+			c[0] = obj->colors[ii.p * 3 + 0];
+			c[1] = obj->colors[ii.p * 3 + 1];
+			c[2] = obj->colors[ii.p * 3 + 2];
 		}
 	}
 
@@ -0,0 +1,185 @@
+// This file is part of gltfpack; see gltfpack.h for version/license details
+#include "gltfpack.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#elif !defined(__wasi__)
+#include <sys/resource.h>
+#endif
+
+#include "../src/meshoptimizer.h"
+
+struct ProfileStageInfo
+{
+	const char* name;
+
+	// nested stages run inside other stages, possibly on worker threads; they don't track allocations
+	bool nested;
+	bool thread;
+};
+
+static const ProfileStageInfo kProfileStages[ProfileStage__Count] = {
+    {"parse", false, false},
+    {"decompress", true, false},
+    {"merge", false, false},
+    {"meshes", false, false},
+    {"simplify", true, true},
+    {"optimize", true, true},
+    {"animation", false, false},
+    {"textures", false, false},
+    {"compress", false, false},
+    {"write", false, false},
+};
+
+struct ProfileAccumulator
+{
+	std::atomic<unsigned int> count;
+	std::atomic<unsigned long long> wall_time; // ns
+	std::atomic<unsigned long long> cpu_time;  // ns
+
+	unsigned long long allocations;
+	size_t peak_allocated;
+};
+
+static ProfileAccumulator gProfileStages[ProfileStage__Count];
+
+static std::atomic<size_t> gAllocated;
+static std::atomic<size_t> gPeakAllocated;
+static std::atomic<unsigned long long> gAllocations;
+
+// allocations are prefixed with their size so that deallocation can update the counters
+static const size_t kAllocationHeader = 16;
+
+static void* MESHOPTIMIZER_ALLOC_CALLCONV profileAllocate(size_t size)
+{
+	char* result = static_cast<char*>(malloc(size + kAllocationHeader));
+	if (!result)
+		return NULL;
+
+	*reinterpret_cast<size_t*>(result) = size;
+
+	size_t allocated = gAllocated += size;
+	size_t peak = gPeakAllocated.load();
+
+	while (allocated > peak && !gPeakAllocated.compare_exchange_weak(peak, allocated))
+		;
+
+	gAllocations++;
+
+	return result + kAllocationHeader;
+}
+
+static void MESHOPTIMIZER_ALLOC_CALLCONV profileDeallocate(void* ptr)
+{
+	char* block = static_cast<char*>(ptr) - kAllocationHeader;
+
+	gAllocated -= *reinterpret_cast<size_t*>(block);
+
+	free(block);
+}
+
+void enableProfileAllocator()
+{
+	meshopt_setAllocator(profileAllocate, profileDeallocate);
+}
+
+static unsigned long long getWallTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static unsigned long long getCpuTime(bool thread)
+{
+#if defined(_WIN32)
+	FILETIME creation_time, exit_time, kernel, user;
+
+	if (thread ? !GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel, &user) : !GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel, &user))
+		return 0;
+
+	unsigned long long total = ((unsigned long long)kernel.dwHighDateTime << 32 | kernel.dwLowDateTime) + ((unsigned long long)user.dwHighDateTime << 32 | user.dwLowDateTime);
+	return total * 100;
+#elif defined(__wasi__)
+	(void)thread;
+	return 0;
+#else
+	timespec ts = {};
+	if (clock_gettime(thread ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &ts) != 0)
+		return 0;
+
+	return (unsigned long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+ProfileTimer beginProfile(ProfileStage stage)
+{
+	const ProfileStageInfo& info = kProfileStages[stage];
+
+	ProfileTimer result = {};
+	result.stage = stage;
+	result.wall_time = getWallTime();
+	result.cpu_time = getCpuTime(info.thread);
+
+	if (!info.nested)
+	{
+		result.allocations = gAllocations.load();
+		gPeakAllocated = gAllocated.load();
+	}
+
+	return result;
+}
+
+void endProfile(const ProfileTimer& timer)
+{
+	const ProfileStageInfo& info = kProfileStages[timer.stage];
+	ProfileAccumulator& stage = gProfileStages[timer.stage];
+
+	stage.count++;
+	stage.wall_time += getWallTime() - timer.wall_time;
+	stage.cpu_time += getCpuTime(info.thread) - timer.cpu_time;
+
+	if (!info.nested)
+	{
+		stage.allocations += gAllocations.load() - timer.allocations;
+		stage.peak_allocated = std::max(stage.peak_allocated, gPeakAllocated.load());
+	}
+}
+
+ProfileStats getProfileStats(ProfileStage stage)
+{
+	const ProfileAccumulator& acc = gProfileStages[stage];
+
+	ProfileStats result = {};
+	result.name = kProfileStages[stage].name;
+	result.count = acc.count;
+	result.wall_time = double(acc.wall_time) * 1e-9;
+	result.cpu_time = double(acc.cpu_time) * 1e-9;
+	result.allocations = acc.allocations;
+	result.peak_allocated = acc.peak_allocated;
+
+	return result;
+}
+
+size_t getPeakMemory()
+{
+#if defined(_WIN32) || defined(__wasi__)
+	return 0;
+#else
+	rusage usage = {};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef __APPLE__
+	return size_t(usage.ru_maxrss);
+#else
+	return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
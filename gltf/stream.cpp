@@ -7,6 +7,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "../src/meshoptimizer.h"
 
@@ -38,31 +39,32 @@ static void updateAttributeBounds(const Mesh& mesh, cgltf_attribute_type type, B
 		{
 			if (s.target == 0)
 			{
-				for (size_t k = 0; k < s.data.size(); ++k)
+				for (size_t k = 0; k < s.data.size(); k += s.components)
 				{
-					const Attr& a = s.data[k];
+					const float* a = &s.data[k];
 
-					b.min.f[0] = std::min(b.min.f[0], a.f[0]);
-					b.min.f[1] = std::min(b.min.f[1], a.f[1]);
-					b.min.f[2] = std::min(b.min.f[2], a.f[2]);
-					b.min.f[3] = std::min(b.min.f[3], a.f[3]);
+					for (int c = 0; c < s.components; ++c)
+					{
+						b.min.f[c] = std::min(b.min.f[c], a[c]);
+						b.max.f[c] = std::max(b.max.f[c], a[c]);
+					}
+				}
 
-					b.max.f[0] = std::max(b.max.f[0], a.f[0]);
-					b.max.f[1] = std::max(b.max.f[1], a.f[1]);
-					b.max.f[2] = std::max(b.max.f[2], a.f[2]);
-					b.max.f[3] = std::max(b.max.f[3], a.f[3]);
+				// components that aren't stored are zero
+				for (int c = s.components; c < 4 && !s.data.empty(); ++c)
+				{
+					b.min.f[c] = std::min(b.min.f[c], 0.f);
+					b.max.f[c] = std::max(b.max.f[c], 0.f);
 				}
 			}
 			else
 			{
-				for (size_t k = 0; k < s.data.size(); ++k)
+				for (size_t k = 0; k < s.data.size(); k += s.components)
 				{
-					const Attr& a = s.data[k];
+					const float* a = &s.data[k];
 
-					pad.f[0] = std::max(pad.f[0], fabsf(a.f[0]));
-					pad.f[1] = std::max(pad.f[1], fabsf(a.f[1]));
-					pad.f[2] = std::max(pad.f[2], fabsf(a.f[2]));
-					pad.f[3] = std::max(pad.f[3], fabsf(a.f[3]));
+					for (int c = 0; c < s.components; ++c)
+						pad.f[c] = std::max(pad.f[c], fabsf(a[c]));
 				}
 			}
 		}
@@ -185,14 +187,14 @@ void getPositionBounds(float min[3], float max[3], const Stream& stream, const Q
 	min[0] = min[1] = min[2] = FLT_MAX;
 	max[0] = max[1] = max[2] = -FLT_MAX;
 
-	for (size_t i = 0; i < stream.data.size(); ++i)
+	for (size_t i = 0; i < stream.data.size(); i += stream.components)
 	{
-		const Attr& a = stream.data[i];
+		const float* a = &stream.data[i];
 
 		for (int k = 0; k < 3; ++k)
 		{
-			min[k] = std::min(min[k], a.f[k]);
-			max[k] = std::max(max[k], a.f[k]);
+			min[k] = std::min(min[k], a[k]);
+			max[k] = std::max(max[k], a[k]);
 		}
 	}
 
@@ -245,41 +247,6 @@ static void renormalizeWeights(uint8_t (&w)[4])
 	w[max] += uint8_t(255 - sum);
 }
 
-static void encodeOct(int& fu, int& fv, float nx, float ny, float nz, int bits)
-{
-	float nl = fabsf(nx) + fabsf(ny) + fabsf(nz);
-	float ns = nl == 0.f ? 0.f : 1.f / nl;
-
-	nx *= ns;
-	ny *= ns;
-
-	float u = (nz >= 0.f) ? nx : (1 - fabsf(ny)) * (nx >= 0.f ? 1.f : -1.f);
-	float v = (nz >= 0.f) ? ny : (1 - fabsf(nx)) * (ny >= 0.f ? 1.f : -1.f);
-
-	fu = meshopt_quantizeSnorm(u, bits);
-	fv = meshopt_quantizeSnorm(v, bits);
-}
-
-static void encodeQuat(int16_t v[4], const Attr& a, int bits)
-{
-	const float scaler = sqrtf(2.f);
-
-	// establish maximum quaternion component
-	int qc = 0;
-	qc = fabsf(a.f[1]) > fabsf(a.f[qc]) ? 1 : qc;
-	qc = fabsf(a.f[2]) > fabsf(a.f[qc]) ? 2 : qc;
-	qc = fabsf(a.f[3]) > fabsf(a.f[qc]) ? 3 : qc;
-
-	// we use double-cover properties to discard the sign
-	float sign = a.f[qc] < 0.f ? -1.f : 1.f;
-
-	// note: we always encode a cyclical swizzle to be able to recover the order via rotation
-	v[0] = int16_t(meshopt_quantizeSnorm(a.f[(qc + 1) & 3] * scaler * sign, bits));
-	v[1] = int16_t(meshopt_quantizeSnorm(a.f[(qc + 2) & 3] * scaler * sign, bits));
-	v[2] = int16_t(meshopt_quantizeSnorm(a.f[(qc + 3) & 3] * scaler * sign, bits));
-	v[3] = int16_t((meshopt_quantizeSnorm(1.f, bits) & ~3) | qc);
-}
-
 static void encodeExpShared(uint32_t v[3], const Attr& a, int bits)
 {
 	// get exponents from all components
@@ -326,7 +293,7 @@ static uint32_t encodeExpOne(float v, int bits, int min_exp = -100)
 	return (m & mmask) | (unsigned(exp) << 24);
 }
 
-static void encodeExpParallel(std::string& bin, const Attr* data, size_t count, int channels, int bits, int min_exp = -100)
+static void encodeExpParallel(std::string& bin, const float* data, size_t count, size_t stride, int channels, int bits, int min_exp = -100)
 {
 	int exp[4] = {};
 
@@ -335,13 +302,13 @@ static void encodeExpParallel(std::string& bin, const Attr* data, size_t count,
 
 	for (size_t i = 0; i < count; ++i)
 	{
-		const Attr& a = data[i];
+		const float* a = &data[i * stride];
 
 		// use maximum exponent to encode values; this guarantees that mantissa is [-1, 1]
 		for (int k = 0; k < channels; ++k)
 		{
 			int e;
-			frexp(a.f[k], &e);
+			frexp(a[k], &e);
 			exp[k] = std::max(exp[k], e);
 		}
 	}
@@ -352,14 +319,14 @@ static void encodeExpParallel(std::string& bin, const Attr* data, size_t count,
 
 	for (size_t i = 0; i < count; ++i)
 	{
-		const Attr& a = data[i];
+		const float* a = &data[i * stride];
 
 		uint32_t v[4];
 
 		for (int k = 0; k < channels; ++k)
 		{
 			// compute renormalized rounded mantissas
-			int m = int(ldexp(a.f[k], -exp[k]) + (a.f[k] >= 0 ? 0.5f : -0.5f));
+			int m = int(ldexp(a[k], -exp[k]) + (a[k] >= 0 ? 0.5f : -0.5f));
 
 			// encode exponent & mantissa
 			int mmask = (1 << 24) - 1;
@@ -374,11 +341,22 @@ static StreamFormat writeVertexStreamRaw(std::string& bin, const Stream& stream,
 {
 	assert(components >= 1 && components <= 4);
 
-	for (size_t i = 0; i < stream.data.size(); ++i)
+	if (components == size_t(stream.components))
+	{
+		if (!stream.data.empty())
+			bin.append(reinterpret_cast<const char*>(&stream.data[0]), sizeof(float) * stream.data.size());
+	}
+	else
 	{
-		const Attr& a = stream.data[i];
+		size_t copy = std::min(components, size_t(stream.components));
+
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
+		{
+			float v[4] = {};
+			memcpy(v, &stream.data[i], sizeof(float) * copy);
 
-		bin.append(reinterpret_cast<const char*>(a.f), sizeof(float) * components);
+			bin.append(reinterpret_cast<const char*>(v), sizeof(float) * components);
+		}
 	}
 
 	StreamFormat format = {type, cgltf_component_type_r_32f, false, sizeof(float) * components};
@@ -393,26 +371,26 @@ static StreamFormat writeVertexStreamFloat(std::string& bin, const Stream& strea
 
 	if (settings.compressmore)
 	{
-		encodeExpParallel(bin, &stream.data[0], stream.data.size(), components, bits + 1, min_exp);
+		encodeExpParallel(bin, &stream.data[0], getVertexCount(stream), stream.components, components, bits + 1, min_exp);
 	}
 	else
 	{
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
 		{
-			const Attr& a = stream.data[i];
+			const float* a = &stream.data[i];
 
 			if (filter == StreamFormat::Filter_Exp)
 			{
 				uint32_t v[4];
 				for (int k = 0; k < components; ++k)
-					v[k] = encodeExpOne(a.f[k], bits + 1, min_exp);
+					v[k] = encodeExpOne(a[k], bits + 1, min_exp);
 				bin.append(reinterpret_cast<const char*>(v), sizeof(uint32_t) * components);
 			}
 			else
 			{
 				float v[4];
 				for (int k = 0; k < components; ++k)
-					v[k] = meshopt_quantizeFloat(a.f[k], bits);
+					v[k] = meshopt_quantizeFloat(a[k], bits);
 				bin.append(reinterpret_cast<const char*>(v), sizeof(float) * components);
 			}
 		}
@@ -446,14 +424,14 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 		{
 			float pos_rscale = qp.scale == 0.f ? 0.f : 1.f / qp.scale;
 
-			for (size_t i = 0; i < stream.data.size(); ++i)
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
 			{
-				const Attr& a = stream.data[i];
+				const float* a = &stream.data[i];
 
 				uint16_t v[4] = {
-				    uint16_t(meshopt_quantizeUnorm((a.f[0] - qp.offset[0]) * pos_rscale, qp.bits)),
-				    uint16_t(meshopt_quantizeUnorm((a.f[1] - qp.offset[1]) * pos_rscale, qp.bits)),
-				    uint16_t(meshopt_quantizeUnorm((a.f[2] - qp.offset[2]) * pos_rscale, qp.bits)),
+				    uint16_t(meshopt_quantizeUnorm((a[0] - qp.offset[0]) * pos_rscale, qp.bits)),
+				    uint16_t(meshopt_quantizeUnorm((a[1] - qp.offset[1]) * pos_rscale, qp.bits)),
+				    uint16_t(meshopt_quantizeUnorm((a[2] - qp.offset[2]) * pos_rscale, qp.bits)),
 				    0};
 				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 			}
@@ -467,25 +445,25 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 
 			int maxv = 0;
 
-			for (size_t i = 0; i < stream.data.size(); ++i)
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
 			{
-				const Attr& a = stream.data[i];
+				const float* a = &stream.data[i];
 
-				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a.f[0]) * pos_rscale, qp.bits));
-				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a.f[1]) * pos_rscale, qp.bits));
-				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a.f[2]) * pos_rscale, qp.bits));
+				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a[0]) * pos_rscale, qp.bits));
+				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a[1]) * pos_rscale, qp.bits));
+				maxv = std::max(maxv, meshopt_quantizeUnorm(fabsf(a[2]) * pos_rscale, qp.bits));
 			}
 
 			if (maxv <= 127 && !qp.normalized)
 			{
-				for (size_t i = 0; i < stream.data.size(); ++i)
+				for (size_t i = 0; i < stream.data.size(); i += stream.components)
 				{
-					const Attr& a = stream.data[i];
+					const float* a = &stream.data[i];
 
 					int8_t v[4] = {
-					    int8_t((a.f[0] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[0]) * pos_rscale, qp.bits)),
-					    int8_t((a.f[1] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[1]) * pos_rscale, qp.bits)),
-					    int8_t((a.f[2] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[2]) * pos_rscale, qp.bits)),
+					    int8_t((a[0] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[0]) * pos_rscale, qp.bits)),
+					    int8_t((a[1] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[1]) * pos_rscale, qp.bits)),
+					    int8_t((a[2] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[2]) * pos_rscale, qp.bits)),
 					    0};
 					bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 				}
@@ -495,14 +473,14 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 			}
 			else
 			{
-				for (size_t i = 0; i < stream.data.size(); ++i)
+				for (size_t i = 0; i < stream.data.size(); i += stream.components)
 				{
-					const Attr& a = stream.data[i];
+					const float* a = &stream.data[i];
 
 					int16_t v[4] = {
-					    int16_t((a.f[0] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[0]) * pos_rscale, qp.bits)),
-					    int16_t((a.f[1] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[1]) * pos_rscale, qp.bits)),
-					    int16_t((a.f[2] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a.f[2]) * pos_rscale, qp.bits)),
+					    int16_t((a[0] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[0]) * pos_rscale, qp.bits)),
+					    int16_t((a[1] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[1]) * pos_rscale, qp.bits)),
+					    int16_t((a[2] >= 0.f ? 1 : -1) * meshopt_quantizeUnorm(fabsf(a[2]) * pos_rscale, qp.bits)),
 					    0};
 					bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 				}
@@ -527,13 +505,13 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 		    qt.scale[1] == 0.f ? 0.f : 1.f / qt.scale[1],
 		};
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
 		{
-			const Attr& a = stream.data[i];
+			const float* a = &stream.data[i];
 
 			uint16_t v[2] = {
-			    uint16_t(meshopt_quantizeUnorm((a.f[0] - qt.offset[0]) * uv_rscale[0], qt.bits)),
-			    uint16_t(meshopt_quantizeUnorm((a.f[1] - qt.offset[1]) * uv_rscale[1], qt.bits)),
+			    uint16_t(meshopt_quantizeUnorm((a[0] - qt.offset[0]) * uv_rscale[0], qt.bits)),
+			    uint16_t(meshopt_quantizeUnorm((a[1] - qt.offset[1]) * uv_rscale[1], qt.bits)),
 			};
 			bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 		}
@@ -555,60 +533,38 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 
 		StreamFormat::Filter filter = oct ? StreamFormat::Filter_Oct : StreamFormat::Filter_None;
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		if (oct)
 		{
-			const Attr& a = stream.data[i];
-
-			float nx = a.f[0], ny = a.f[1], nz = a.f[2];
+			size_t stride = bits > 8 ? 8 : 4;
+			size_t vertex_count = getVertexCount(stream);
 
-			if (bits > 8)
-			{
-				int16_t v[4];
+			size_t offset = bin.size();
+			bin.resize(offset + vertex_count * stride);
 
-				if (oct)
-				{
-					int fu, fv;
-					encodeOct(fu, fv, nx, ny, nz, bits);
+			// the filter expects 4 floats per vector
+			std::vector<float> expanded(vertex_count * 4);
 
-					v[0] = int16_t(fu);
-					v[1] = int16_t(fv);
-					v[2] = int16_t(meshopt_quantizeSnorm(1.f, bits));
-					v[3] = 0;
-				}
-				else
-				{
-					v[0] = int16_t(meshopt_quantizeSnorm(nx, bits));
-					v[1] = int16_t(meshopt_quantizeSnorm(ny, bits));
-					v[2] = int16_t(meshopt_quantizeSnorm(nz, bits));
-					v[3] = 0;
-				}
+			for (size_t i = 0; i < vertex_count; ++i)
+				memcpy(&expanded[i * 4], &stream.data[i * 3], 3 * sizeof(float));
 
-				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
-			}
-			else
-			{
-				int8_t v[4];
+			if (vertex_count)
+				meshopt_encodeFilterOct(&bin[offset], vertex_count, stride, bits, &expanded[0]);
 
-				if (oct)
-				{
-					int fu, fv;
-					encodeOct(fu, fv, nx, ny, nz, bits);
+			// normals don't use the fourth component
+			for (size_t i = 0; i < vertex_count; ++i)
+				memset(&bin[offset + i * stride + stride / 4 * 3], 0, stride / 4);
+		}
+		else
+		{
+			size_t stride = bits > 8 ? 8 : 4;
+			size_t vertex_count = getVertexCount(stream);
 
-					v[0] = int8_t(fu);
-					v[1] = int8_t(fv);
-					v[2] = int8_t(meshopt_quantizeSnorm(1.f, bits));
-					v[3] = 0;
-				}
-				else
-				{
-					v[0] = int8_t(meshopt_quantizeSnorm(nx, bits));
-					v[1] = int8_t(meshopt_quantizeSnorm(ny, bits));
-					v[2] = int8_t(meshopt_quantizeSnorm(nz, bits));
-					v[3] = 0;
-				}
+			size_t offset = bin.size();
+			bin.resize(offset + vertex_count * stride);
 
-				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
-			}
+			// the fourth component stays zero; quantized values use 16-bit storage for bits > 8
+			if (vertex_count)
+				meshopt_quantizeSnormArray(&bin[offset], stride, &stream.data[0], stream.components * sizeof(float), vertex_count, 3, bits);
 		}
 
 		if (bits > 8)
@@ -632,33 +588,27 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 
 		StreamFormat::Filter filter = oct ? StreamFormat::Filter_Oct : StreamFormat::Filter_None;
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
-		{
-			const Attr& a = stream.data[i];
-
-			float nx = a.f[0], ny = a.f[1], nz = a.f[2], nw = a.f[3];
+		size_t vertex_count = getVertexCount(stream);
 
-			int8_t v[4];
+		if (oct)
+		{
+			size_t offset = bin.size();
+			bin.resize(offset + vertex_count * 4);
 
-			if (oct)
-			{
-				int fu, fv;
-				encodeOct(fu, fv, nx, ny, nz, bits);
+			if (vertex_count)
+				meshopt_encodeFilterOct(&bin[offset], vertex_count, 4, bits, &stream.data[0]);
 
-				v[0] = int8_t(fu);
-				v[1] = int8_t(fv);
-				v[2] = int8_t(meshopt_quantizeSnorm(1.f, bits));
-				v[3] = int8_t(meshopt_quantizeSnorm(nw, bits));
-			}
-			else
-			{
-				v[0] = int8_t(meshopt_quantizeSnorm(nx, bits));
-				v[1] = int8_t(meshopt_quantizeSnorm(ny, bits));
-				v[2] = int8_t(meshopt_quantizeSnorm(nz, bits));
-				v[3] = int8_t(meshopt_quantizeSnorm(nw, bits));
-			}
+			// the filter always encodes the fourth component with 8 bits, but we need to match the precision of other components
+			if (vertex_count)
+				meshopt_quantizeSnormArray(&bin[offset + 3], 4, &stream.data[3], 4 * sizeof(float), vertex_count, 1, bits);
+		}
+		else
+		{
+			size_t offset = bin.size();
+			bin.resize(offset + vertex_count * 4);
 
-			bin.append(reinterpret_cast<const char*>(v), sizeof(v));
+			if (vertex_count)
+				meshopt_quantizeSnormArray(&bin[offset], 4, &stream.data[0], 4 * sizeof(float), vertex_count, 4, bits);
 		}
 
 		cgltf_type type = (stream.target == 0) ? cgltf_type_vec4 : cgltf_type_vec3;
@@ -670,26 +620,26 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 	{
 		int bits = settings.col_bits;
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
 		{
-			const Attr& a = stream.data[i];
+			const float* a = &stream.data[i];
 
 			if (bits > 8)
 			{
 				uint16_t v[4] = {
-				    uint16_t(quantizeColor(a.f[0], 16, bits)),
-				    uint16_t(quantizeColor(a.f[1], 16, bits)),
-				    uint16_t(quantizeColor(a.f[2], 16, bits)),
-				    uint16_t(quantizeColor(a.f[3], 16, bits))};
+				    uint16_t(quantizeColor(a[0], 16, bits)),
+				    uint16_t(quantizeColor(a[1], 16, bits)),
+				    uint16_t(quantizeColor(a[2], 16, bits)),
+				    uint16_t(quantizeColor(a[3], 16, bits))};
 				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 			}
 			else
 			{
 				uint8_t v[4] = {
-				    uint8_t(quantizeColor(a.f[0], 8, bits)),
-				    uint8_t(quantizeColor(a.f[1], 8, bits)),
-				    uint8_t(quantizeColor(a.f[2], 8, bits)),
-				    uint8_t(quantizeColor(a.f[3], 8, bits))};
+				    uint8_t(quantizeColor(a[0], 8, bits)),
+				    uint8_t(quantizeColor(a[1], 8, bits)),
+				    uint8_t(quantizeColor(a[2], 8, bits)),
+				    uint8_t(quantizeColor(a[3], 8, bits))};
 				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 			}
 		}
@@ -707,18 +657,18 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 	}
 	else if (stream.type == cgltf_attribute_type_weights)
 	{
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
 		{
-			const Attr& a = stream.data[i];
+			const float* a = &stream.data[i];
 
-			float ws = a.f[0] + a.f[1] + a.f[2] + a.f[3];
+			float ws = a[0] + a[1] + a[2] + a[3];
 			float wsi = (ws == 0.f) ? 0.f : 1.f / ws;
 
 			uint8_t v[4] = {
-			    uint8_t(meshopt_quantizeUnorm(a.f[0] * wsi, 8)),
-			    uint8_t(meshopt_quantizeUnorm(a.f[1] * wsi, 8)),
-			    uint8_t(meshopt_quantizeUnorm(a.f[2] * wsi, 8)),
-			    uint8_t(meshopt_quantizeUnorm(a.f[3] * wsi, 8))};
+			    uint8_t(meshopt_quantizeUnorm(a[0] * wsi, 8)),
+			    uint8_t(meshopt_quantizeUnorm(a[1] * wsi, 8)),
+			    uint8_t(meshopt_quantizeUnorm(a[2] * wsi, 8)),
+			    uint8_t(meshopt_quantizeUnorm(a[3] * wsi, 8))};
 
 			if (wsi != 0.f)
 				renormalizeWeights(v);
@@ -733,22 +683,22 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 	{
 		unsigned int maxj = 0;
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
-			maxj = std::max(maxj, unsigned(stream.data[i].f[0]));
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
+			maxj = std::max(maxj, unsigned(stream.data[i]));
 
 		assert(maxj <= 65535);
 
 		if (maxj <= 255)
 		{
-			for (size_t i = 0; i < stream.data.size(); ++i)
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
 			{
-				const Attr& a = stream.data[i];
+				const float* a = &stream.data[i];
 
 				uint8_t v[4] = {
-				    uint8_t(a.f[0]),
-				    uint8_t(a.f[1]),
-				    uint8_t(a.f[2]),
-				    uint8_t(a.f[3])};
+				    uint8_t(a[0]),
+				    uint8_t(a[1]),
+				    uint8_t(a[2]),
+				    uint8_t(a[3])};
 				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 			}
 
@@ -757,15 +707,15 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 		}
 		else
 		{
-			for (size_t i = 0; i < stream.data.size(); ++i)
+			for (size_t i = 0; i < stream.data.size(); i += stream.components)
 			{
-				const Attr& a = stream.data[i];
+				const float* a = &stream.data[i];
 
 				uint16_t v[4] = {
-				    uint16_t(a.f[0]),
-				    uint16_t(a.f[1]),
-				    uint16_t(a.f[2]),
-				    uint16_t(a.f[3])};
+				    uint16_t(a[0]),
+				    uint16_t(a[1]),
+				    uint16_t(a[2]),
+				    uint16_t(a[3])};
 				bin.append(reinterpret_cast<const char*>(v), sizeof(v));
 			}
 
@@ -781,18 +731,18 @@ StreamFormat writeVertexStream(std::string& bin, const Stream& stream, const Qua
 
 		unsigned int maxv = 0;
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
-			maxv = std::max(maxv, unsigned(stream.data[i].f[0]));
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
+			maxv = std::max(maxv, unsigned(stream.data[i]));
 
 		// exp encoding uses a signed mantissa with only 23 significant bits; input glTF encoding may encode indices losslessly up to 2^24
 		if (maxv >= (1 << 23))
 			return writeVertexStreamRaw(bin, stream, cgltf_type_scalar, 1);
 
-		for (size_t i = 0; i < stream.data.size(); ++i)
+		for (size_t i = 0; i < stream.data.size(); i += stream.components)
 		{
-			const Attr& a = stream.data[i];
+			const float* a = &stream.data[i];
 
-			uint32_t id = uint32_t(a.f[0]);
+			uint32_t id = uint32_t(a[0]);
 			uint32_t v = id; // exp encoding of integers in [0..2^23-1] range is equivalent to the integer itself
 
 			bin.append(reinterpret_cast<const char*>(&v), sizeof(v));
@@ -856,25 +806,21 @@ StreamFormat writeKeyframeStream(std::string& bin, cgltf_animation_path_type typ
 	{
 		StreamFormat::Filter filter = settings.compressmore ? StreamFormat::Filter_Quat : StreamFormat::Filter_None;
 
-		for (size_t i = 0; i < data.size(); ++i)
+		if (filter == StreamFormat::Filter_Quat)
 		{
-			const Attr& a = data[i];
-
-			int16_t v[4];
+			size_t offset = bin.size();
+			bin.resize(offset + data.size() * 8);
 
-			if (filter == StreamFormat::Filter_Quat)
-			{
-				encodeQuat(v, a, settings.rot_bits);
-			}
-			else
-			{
-				v[0] = int16_t(meshopt_quantizeSnorm(a.f[0], 16));
-				v[1] = int16_t(meshopt_quantizeSnorm(a.f[1], 16));
-				v[2] = int16_t(meshopt_quantizeSnorm(a.f[2], 16));
-				v[3] = int16_t(meshopt_quantizeSnorm(a.f[3], 16));
-			}
+			if (!data.empty())
+				meshopt_encodeFilterQuat(&bin[offset], data.size(), 8, settings.rot_bits, data[0].f);
+		}
+		else
+		{
+			size_t offset = bin.size();
+			bin.resize(offset + data.size() * 8);
 
-			bin.append(reinterpret_cast<const char*>(v), sizeof(v));
+			if (!data.empty())
+				meshopt_quantizeSnormArray(&bin[offset], 8, data[0].f, sizeof(Attr), data.size(), 4, 16);
 		}
 
 		StreamFormat format = {cgltf_type_vec4, cgltf_component_type_r_16, true, 8, filter};
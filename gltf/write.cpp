@@ -2,6 +2,7 @@
 #include "gltfpack.h"
 
 #include <float.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -1017,11 +1018,11 @@ void writeMeshAttributes(std::string& json, std::vector<BufferView>& views, std:
 			float max[3] = {};
 			getPositionBounds(min, max, stream, qp, settings);
 
-			writeAccessor(json_accessors, view, offset, format.type, format.component_type, format.normalized, stream.data.size(), min, max, 3);
+			writeAccessor(json_accessors, view, offset, format.type, format.component_type, format.normalized, getVertexCount(stream), min, max, 3);
 		}
 		else
 		{
-			writeAccessor(json_accessors, view, offset, format.type, format.component_type, format.normalized, stream.data.size());
+			writeAccessor(json_accessors, view, offset, format.type, format.component_type, format.normalized, getVertexCount(stream));
 		}
 
 		size_t vertex_accr = accr_offset++;
@@ -1064,6 +1065,93 @@ size_t writeMeshIndices(std::vector<BufferView>& views, std::string& json_access
 	return index_accr;
 }
 
+static size_t writeMeshletData(std::vector<BufferView>& views, const std::string& data, size_t stride, BufferView::Compression compression, const Settings& settings)
+{
+	// meshlet offsets and vertex indices don't fit into 16 bits in general, and glTF only allows 32-bit integer accessors for primitive indices, so the extension references dedicated buffer views directly
+	size_t view = getBufferView(views, BufferView::Kind_Meshlet, StreamFormat::Filter_None, settings.compress ? compression : BufferView::Compression_None, stride, -1);
+
+	assert(views[view].data.empty());
+	views[view].data = data;
+
+	return view;
+}
+
+void writeMeshMeshlets(std::string& json, std::vector<BufferView>& views, const Mesh& mesh, const QuantizationPosition& qp, const Settings& settings)
+{
+	assert(!mesh.meshlets.empty());
+
+	std::string descriptors, spheres, cones;
+
+	// bounding spheres need to be in the same space as quantized positions; cones are invariant under uniform scale & offset
+	bool quantized = settings.quantize && !settings.pos_float;
+	float pos_rscale = qp.node_scale == 0.f ? 0.f : 1.f / qp.node_scale;
+	float pos_error = 0.5f * sqrtf(3.f) * (qp.normalized ? 1.f / 65535.f : 1.f);
+
+	// floating point positions keep qp.bits of mantissa, but exponents may be shared across the stream so the error depends on the largest coordinate
+	float pos_extent = 0.f;
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+		if (mesh.streams[i].type == cgltf_attribute_type_position && mesh.streams[i].target == 0)
+			for (size_t j = 0; j < mesh.streams[i].data.size(); ++j)
+				pos_extent = std::max(pos_extent, fabsf(mesh.streams[i].data[j]));
+
+	float pos_error_float = pos_extent * sqrtf(3.f) * ldexpf(1.f, -qp.bits);
+
+	for (size_t i = 0; i < mesh.meshlets.size(); ++i)
+	{
+		const Meshlet& m = mesh.meshlets[i];
+
+		uint32_t desc[4] = {m.vertex_offset, m.triangle_offset, m.vertex_count, m.triangle_count};
+		descriptors.append(reinterpret_cast<const char*>(desc), sizeof(desc));
+
+		float sphere[4] = {m.center[0], m.center[1], m.center[2], m.radius};
+
+		if (quantized)
+		{
+			for (int k = 0; k < 3; ++k)
+				sphere[k] = (m.center[k] - qp.offset[k]) * pos_rscale;
+
+			sphere[3] = m.radius * pos_rscale + pos_error;
+		}
+		else if (settings.quantize)
+		{
+			sphere[3] = m.radius + pos_error_float;
+		}
+
+		spheres.append(reinterpret_cast<const char*>(sphere), sizeof(sphere));
+
+		float cone[4] = {m.cone_axis[0], m.cone_axis[1], m.cone_axis[2], m.cone_cutoff};
+		cones.append(reinterpret_cast<const char*>(cone), sizeof(cone));
+	}
+
+	size_t descriptor_view = writeMeshletData(views, descriptors, 16, BufferView::Compression_Attribute, settings);
+	size_t sphere_view = writeMeshletData(views, spheres, 16, BufferView::Compression_Attribute, settings);
+	size_t cone_view = writeMeshletData(views, cones, 16, BufferView::Compression_Attribute, settings);
+
+	// vertex references within a meshlet are mostly sequential after vertex fetch optimization, which is what index sequence encoding is good at
+	std::string scratch;
+	scratch.append(reinterpret_cast<const char*>(&mesh.meshlet_vertices[0]), mesh.meshlet_vertices.size() * sizeof(unsigned int));
+
+	size_t vertex_view = writeMeshletData(views, scratch, 4, BufferView::Compression_IndexSequence, settings);
+
+	scratch.clear();
+	scratch.append(reinterpret_cast<const char*>(&mesh.meshlet_triangles[0]), mesh.meshlet_triangles.size() * sizeof(unsigned int));
+
+	size_t triangle_view = writeMeshletData(views, scratch, 4, BufferView::Compression_Attribute, settings);
+
+	append(json, "\"MESHOPT_meshlets\":{\"meshlets\":");
+	append(json, descriptor_view);
+	append(json, ",\"spheres\":");
+	append(json, sphere_view);
+	append(json, ",\"cones\":");
+	append(json, cone_view);
+	append(json, ",\"vertices\":");
+	append(json, vertex_view);
+	append(json, ",\"triangles\":");
+	append(json, triangle_view);
+	append(json, "}");
+}
+
 static size_t writeAnimationTime(std::vector<BufferView>& views, std::string& json_accessors, size_t& accr_offset, float mint, int frames, float period, const Settings& settings)
 {
 	std::vector<float> time(frames);
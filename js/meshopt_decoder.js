@@ -114,7 +114,11 @@ var MeshoptDecoder = (function() {
 		URL.revokeObjectURL(url);
 	}
 
-	function decodeWorker(count, size, source, mode, filter) {
+	function isShared(view) {
+		return typeof SharedArrayBuffer !== 'undefined' && view.buffer instanceof SharedArrayBuffer;
+	}
+
+	function decodeWorker(count, size, source, mode, filter, target) {
 		var worker = workers[0];
 
 		for (var i = 1; i < workers.length; ++i) {
@@ -124,12 +128,14 @@ var MeshoptDecoder = (function() {
 		}
 
 		return new Promise(function (resolve, reject) {
-			var data = new Uint8Array(source);
+			// shared memory is visible to the worker as is; everything else is copied and transferred
+			var data = isShared(source) ? source : new Uint8Array(source);
+			var output = target && isShared(target) ? target : undefined;
 			var id = ++requestId;
 
 			worker.pending += count;
 			worker.requests[id] = { resolve: resolve, reject: reject };
-			worker.object.postMessage({ id: id, count: count, size: size, source: data, mode: mode, filter: filter }, [ data.buffer ]);
+			worker.object.postMessage({ id: id, count: count, size: size, source: data, mode: mode, filter: filter, target: output }, data === source ? [] : [ data.buffer ]);
 		});
 	}
 
@@ -140,9 +146,10 @@ var MeshoptDecoder = (function() {
 		}
 		self.ready.then(function(instance) {
 			try {
-				var target = new Uint8Array(data.count * data.size);
+				// when the target is shared, the result is written in place and only completion is reported
+				var target = data.target || new Uint8Array(data.count * data.size);
 				decode(instance, instance.exports[data.mode], target, data.count, data.size, data.source, instance.exports[data.filter]);
-				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: target }, [ target.buffer ]);
+				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: data.target ? null : target }, data.target ? [] : [ target.buffer ]);
 			} catch (error) {
 				self.postMessage({ id: data.id, count: data.count, action: "reject", value: error });
 			}
@@ -167,16 +174,38 @@ var MeshoptDecoder = (function() {
 		decodeGltfBuffer: function(target, count, size, source, mode, filter) {
 			decode(instance, instance.exports[decoders[mode]], target, count, size, source, instance.exports[filters[filter]]);
 		},
-		decodeGltfBufferAsync: function(count, size, source, mode, filter) {
+		decodeGltfBufferAsync: function(count, size, source, mode, filter, target) {
+			var target8 = target && new Uint8Array(target.buffer, target.byteOffset, target.byteLength);
+
 			if (workers.length > 0) {
-				return decodeWorker(count, size, source, decoders[mode], filters[filter]);
+				return decodeWorker(count, size, source, decoders[mode], filters[filter], target8).then(function(result) {
+					if (target && result) {
+						target8.set(result);
+					}
+					return target || result;
+				});
 			}
 
 			return ready.then(function() {
-				var target = new Uint8Array(count * size);
-				decode(instance, instance.exports[decoders[mode]], target, count, size, source, instance.exports[filters[filter]]);
-				return target;
+				var result = target8 || new Uint8Array(count * size);
+				decode(instance, instance.exports[decoders[mode]], result, count, size, source, instance.exports[filters[filter]]);
+				return target || result;
+			});
+		},
+		decodeGltfBuffersAsync: function(requests) {
+			// larger requests are dispatched first so that the least loaded worker picks up the remaining small ones
+			var order = requests.map(function(request, index) { return index; });
+			order.sort(function(a, b) {
+				return requests[b].count * requests[b].size - requests[a].count * requests[a].size;
 			});
+
+			var results = new Array(requests.length);
+			for (var i = 0; i < order.length; ++i) {
+				var request = requests[order[i]];
+				results[order[i]] = this.decodeGltfBufferAsync(request.count, request.size, request.source, request.mode, request.filter, request.target);
+			}
+
+			return Promise.all(results);
 		}
 	};
 })();
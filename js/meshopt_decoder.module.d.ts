@@ -11,5 +11,6 @@ export const MeshoptDecoder: {
     decodeGltfBuffer: (target: Uint8Array, count: number, size: number, source: Uint8Array, mode: string, filter?: string) => void;
 
     useWorkers: (count: number) => void;
-    decodeGltfBufferAsync: (count: number, size: number, source: Uint8Array, mode: string, filter?: string) => Promise<Uint8Array>;
+    decodeGltfBufferAsync: <T extends ArrayBufferView = Uint8Array>(count: number, size: number, source: Uint8Array, mode: string, filter?: string, target?: T) => Promise<T>;
+    decodeGltfBuffersAsync: (requests: { count: number, size: number, source: Uint8Array, mode: string, filter?: string, target?: ArrayBufferView }[]) => Promise<ArrayBufferView[]>;
 };
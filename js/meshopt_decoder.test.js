@@ -297,6 +297,60 @@ var tests = {
 			assert.deepStrictEqual(result, expected);
 		});
 	},
+
+	decodeGltfBufferAsyncShared: function() {
+		var encoded = new Uint8Array([
+			0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00, 0x00,
+		]);
+
+		var expected = new Uint32Array([
+			0, 1, 51, 2, 49, 1000
+		]);
+
+		var target = new Uint32Array(new SharedArrayBuffer(expected.length * 4));
+
+		decoder.decodeGltfBufferAsync(6, 4, encoded, /* mode= */ "INDICES", /* filter= */ undefined, target).then(function (result) {
+			assert.strictEqual(result, target);
+			assert.deepStrictEqual(new Uint32Array(result), expected);
+		});
+	},
+
+	decodeGltfBuffersAsync: function() {
+		var encodedVertex = new Uint8Array([
+			0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01,
+			0x0c, 0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+			0x3f, 0x00, 0x00, 0x00, 0x17, 0x18, 0x17, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x00,
+			0x00, 0x00, 0x17, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		]);
+
+		var encodedIndex = new Uint8Array([
+			0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00, 0x00,
+		]);
+
+		var expectedVertex = new Uint8Array([
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			44, 1, 0, 0, 0, 0, 0, 0, 244, 1, 0, 0,
+			0, 0, 44, 1, 0, 0, 0, 0, 0, 0, 244, 1,
+			44, 1, 44, 1, 0, 0, 0, 0, 244, 1, 244, 1
+		]);
+
+		var expectedIndex = new Uint32Array([
+			0, 1, 51, 2, 49, 1000
+		]);
+
+		var requests = [
+			{ count: 6, size: 4, source: encodedIndex, mode: "INDICES", target: new Uint32Array(6) },
+			{ count: 4, size: 12, source: encodedVertex, mode: "ATTRIBUTES" },
+		];
+
+		decoder.decodeGltfBuffersAsync(requests).then(function (results) {
+			assert.strictEqual(results[0], requests[0].target);
+			assert.deepStrictEqual(results[0], expectedIndex);
+			assert.deepStrictEqual(results[1], expectedVertex);
+		});
+	},
 };
 
 decoder.ready.then(() => {
@@ -132,9 +132,111 @@ var MeshoptEncoder = (function() {
 		return target;
 	}
 
+	var workers = [];
+	var requestId = 0;
+
+	function createWorker(url) {
+		var worker = {
+			object: new Worker(url),
+			pending: 0,
+			requests: {}
+		};
+
+		worker.object.onmessage = function(event) {
+			var data = event.data;
+
+			worker.pending -= data.count;
+			worker.requests[data.id][data.action](data.value);
+			delete worker.requests[data.id];
+		};
+
+		return worker;
+	}
+
+	function initWorkers(count) {
+		var source =
+			"var instance; var ready = WebAssembly.instantiate(new Uint8Array([" + new Uint8Array(unpack(wasm)) + "]), {})" +
+			".then(function(result) { instance = result.instance; instance.exports.__wasm_call_ctors();" +
+			" instance.exports.meshopt_encodeVertexVersion(0); instance.exports.meshopt_encodeIndexVersion(1); });" +
+			"self.onmessage = " + workerProcess.name + ";" + bytes.toString() + encode.toString() + workerProcess.toString();
+
+		var blob = new Blob([source], {type: 'text/javascript'});
+		var url = URL.createObjectURL(blob);
+
+		for (var i = workers.length; i < count; ++i) {
+			workers[i] = createWorker(url);
+		}
+
+		for (var i = count; i < workers.length; ++i) {
+			workers[i].object.postMessage({});
+		}
+
+		workers.length = count;
+
+		URL.revokeObjectURL(url);
+	}
+
+	function encodeWorker(source, count, size, mode) {
+		var worker = workers[0];
+
+		for (var i = 1; i < workers.length; ++i) {
+			if (workers[i].pending < worker.pending) {
+				worker = workers[i];
+			}
+		}
+
+		// indices are widened to 32 bits and vertex data is copied so that it can be transferred
+		var data, encoder, bound, extent;
+		if (mode == "ATTRIBUTES") {
+			assert(size > 0 && size <= 256);
+			assert(size % 4 == 0);
+			data = new Uint8Array(bytes(source));
+			encoder = "meshopt_encodeVertexBuffer";
+			bound = "meshopt_encodeVertexBufferBound";
+			extent = size;
+		} else {
+			assert(mode == "TRIANGLES" || mode == "INDICES");
+			assert(size == 2 || size == 4);
+			assert(mode == "INDICES" || count % 3 == 0);
+			data = index32(source, size);
+			data = size == 4 ? data.slice() : data;
+			encoder = mode == "TRIANGLES" ? "meshopt_encodeIndexBuffer" : "meshopt_encodeIndexSequence";
+			bound = mode == "TRIANGLES" ? "meshopt_encodeIndexBufferBound" : "meshopt_encodeIndexSequenceBound";
+			extent = maxindex(data) + 1;
+			size = 4;
+		}
+
+		return new Promise(function (resolve, reject) {
+			var id = ++requestId;
+
+			worker.pending += count;
+			worker.requests[id] = { resolve: resolve, reject: reject };
+			worker.object.postMessage({ id: id, count: count, size: size, source: data, encoder: encoder, bound: bound, extent: extent }, [ data.buffer ]);
+		});
+	}
+
+	function workerProcess(event) {
+		var data = event.data;
+		if (!data.id) {
+			return self.close();
+		}
+		ready.then(function() {
+			try {
+				var bound = instance.exports[data.bound](data.count, data.extent);
+				var target = encode(instance.exports[data.encoder], bound, data.source, data.count, data.size);
+				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: target }, [ target.buffer ]);
+			} catch (error) {
+				self.postMessage({ id: data.id, count: data.count, action: "reject", value: error });
+			}
+		});
+	}
+
 	return {
 		ready: ready,
 		supported: true,
+		useWorkers: function(count) {
+			initWorkers(count);
+		},
 		reorderMesh: function(indices, triangles, optsize) {
 			var optf = triangles ? (optsize ? instance.exports.meshopt_optimizeVertexCacheStrip : instance.exports.meshopt_optimizeVertexCache) : undefined;
 			return reorder(instance.exports.meshopt_optimizeVertexFetchRemap, indices, maxindex(indices) + 1, optf);
@@ -173,6 +275,16 @@ var MeshoptEncoder = (function() {
 			assert(table[mode]);
 			return table[mode](source, count, size);
 		},
+		encodeGltfBufferAsync: function(source, count, size, mode) {
+			if (workers.length > 0) {
+				return encodeWorker(source, count, size, mode);
+			}
+
+			var encoder = this;
+			return ready.then(function() {
+				return encoder.encodeGltfBuffer(source, count, size, mode);
+			});
+		},
 		encodeFilterOct: function(source, count, stride, bits) {
 			assert(stride == 4 || stride == 8);
 			assert(bits >= 1 && bits <= 16);
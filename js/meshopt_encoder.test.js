@@ -219,6 +219,17 @@ var tests = {
 
 		assert.deepEqual(decoded, data);
 	},
+
+	encodeGltfBufferAsync: function() {
+		var data = new Uint16Array([0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9]);
+
+		encoder.encodeGltfBufferAsync(bytes(data), data.length, 2, 'TRIANGLES').then(function (encoded) {
+			var decoded = new Uint16Array(data.length);
+			decoder.decodeGltfBuffer(bytes(decoded), data.length, 2, encoded, 'TRIANGLES');
+
+			assert.deepEqual(decoded, data);
+		});
+	},
 };
 
 Promise.all([encoder.ready, decoder.ready]).then(() => {
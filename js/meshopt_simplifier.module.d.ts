@@ -15,6 +15,12 @@ export const MeshoptSimplifier: {
     // Experimental; requires useExperimentalFeatures to be set to true
     simplifyWithAttributes: (indices: Uint32Array, vertex_positions: Float32Array, vertex_positions_stride: number, vertex_attributes: Float32Array, vertex_attributes_stride: number, attribute_weights: number[], vertex_lock: boolean[] | null, target_index_count: number, target_error: number, flags?: Flags[]) => [Uint32Array, number];
 
+    useWorkers: (count: number) => void;
+    simplifyAsync: (indices: Uint32Array, vertex_positions: Float32Array, vertex_positions_stride: number, target_index_count: number, target_error: number, flags?: Flags[]) => Promise<[Uint32Array, number]>;
+
+    // Experimental; requires useExperimentalFeatures to be set to true
+    simplifyWithAttributesAsync: (indices: Uint32Array, vertex_positions: Float32Array, vertex_positions_stride: number, vertex_attributes: Float32Array, vertex_attributes_stride: number, attribute_weights: number[], vertex_lock: boolean[] | null, target_index_count: number, target_error: number, flags?: Flags[]) => Promise<[Uint32Array, number]>;
+
     getScale: (vertex_positions: Float32Array, vertex_positions_stride: number) => number;
 
     // Experimental; requires useExperimentalFeatures to be set to true
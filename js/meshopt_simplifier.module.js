@@ -158,6 +158,151 @@ var MeshoptSimplifier = (function() {
 		ErrorAbsolute: 4,
 	};
 
+	function simplifyFlags(flags) {
+		var options = 0;
+		for (var i = 0; i < (flags ? flags.length : 0); ++i) {
+			assert(flags[i] in simplifyOptions);
+			options |= simplifyOptions[flags[i]];
+		}
+		return options;
+	}
+
+	function simplifyArgs(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags) {
+		assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
+		assert(indices.length % 3 == 0);
+		assert(vertex_positions instanceof Float32Array);
+		assert(vertex_positions.length % vertex_positions_stride == 0);
+		assert(vertex_positions_stride >= 3);
+		assert(target_index_count >= 0 && target_index_count <= indices.length);
+		assert(target_index_count % 3 == 0);
+		assert(target_error >= 0);
+
+		var options = simplifyFlags(flags);
+		var indices32 = indices.BYTES_PER_ELEMENT == 4 ? indices : new Uint32Array(indices);
+		return [indices32, indices.length, vertex_positions, vertex_positions.length / vertex_positions_stride, vertex_positions_stride * 4, target_index_count, target_error, options];
+	}
+
+	function simplifyAttrArgs(indices, vertex_positions, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, vertex_lock, target_index_count, target_error, flags) {
+		assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
+		assert(indices.length % 3 == 0);
+		assert(vertex_positions instanceof Float32Array);
+		assert(vertex_positions.length % vertex_positions_stride == 0);
+		assert(vertex_positions_stride >= 3);
+		assert(vertex_attributes instanceof Float32Array);
+		assert(vertex_attributes.length % vertex_attributes_stride == 0);
+		assert(vertex_attributes_stride >= 0);
+		assert(vertex_lock == null || vertex_lock.length == vertex_positions.length);
+		assert(target_index_count >= 0 && target_index_count <= indices.length);
+		assert(target_index_count % 3 == 0);
+		assert(target_error >= 0);
+		assert(Array.isArray(attribute_weights));
+		assert(vertex_attributes_stride >= attribute_weights.length);
+		assert(attribute_weights.length <= 16);
+
+		var options = simplifyFlags(flags);
+		var indices32 = indices.BYTES_PER_ELEMENT == 4 ? indices : new Uint32Array(indices);
+		return [indices32, indices.length, vertex_positions, vertex_positions.length / vertex_positions_stride, vertex_positions_stride * 4, vertex_attributes, vertex_attributes_stride * 4, new Float32Array(attribute_weights), vertex_lock ? new Uint8Array(vertex_lock) : null, target_index_count, target_error, options];
+	}
+
+	function simplifyResult(indices, result) {
+		result[0] = (indices instanceof Uint32Array) ? result[0] : new indices.constructor(result[0]);
+		return result;
+	}
+
+	var simplifiers = {
+		simplify: [simplify, "meshopt_simplify"],
+		simplifyAttr: [simplifyAttr, "meshopt_simplifyWithAttributes"],
+	};
+
+	var workers = [];
+	var requestId = 0;
+
+	function createWorker(url) {
+		var worker = {
+			object: new Worker(url),
+			pending: 0,
+			requests: {}
+		};
+
+		worker.object.onmessage = function(event) {
+			var data = event.data;
+
+			worker.pending -= data.count;
+			worker.requests[data.id][data.action](data.value);
+			delete worker.requests[data.id];
+		};
+
+		return worker;
+	}
+
+	function initWorkers(count) {
+		var source =
+			"var instance; var ready = WebAssembly.instantiate(new Uint8Array([" + new Uint8Array(unpack(wasm)) + "]), {})" +
+			".then(function(result) { instance = result.instance; instance.exports.__wasm_call_ctors(); });" +
+			"self.onmessage = " + workerProcess.name + ";" +
+			bytes.toString() + simplify.toString() + simplifyAttr.toString() + workerProcess.toString();
+
+		var blob = new Blob([source], {type: 'text/javascript'});
+		var url = URL.createObjectURL(blob);
+
+		for (var i = workers.length; i < count; ++i) {
+			workers[i] = createWorker(url);
+		}
+
+		for (var i = count; i < workers.length; ++i) {
+			workers[i].object.postMessage({});
+		}
+
+		workers.length = count;
+
+		URL.revokeObjectURL(url);
+	}
+
+	function simplifyWorker(kind, args) {
+		var worker = workers[0];
+
+		for (var i = 1; i < workers.length; ++i) {
+			if (workers[i].pending < worker.pending) {
+				worker = workers[i];
+			}
+		}
+
+		return new Promise(function (resolve, reject) {
+			var id = ++requestId;
+			var count = args[1];
+
+			worker.pending += count;
+			worker.requests[id] = { resolve: resolve, reject: reject };
+			worker.object.postMessage({ id: id, count: count, kind: kind, fun: simplifiers[kind][1], args: args });
+		});
+	}
+
+	function workerProcess(event) {
+		var data = event.data;
+		if (!data.id) {
+			return self.close();
+		}
+		ready.then(function() {
+			try {
+				var simplifier = data.kind == "simplifyAttr" ? simplifyAttr : simplify;
+				var result = simplifier.apply(null, [instance.exports[data.fun]].concat(data.args));
+				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: result }, [ result[0].buffer ]);
+			} catch (error) {
+				self.postMessage({ id: data.id, count: data.count, action: "reject", value: error });
+			}
+		});
+	}
+
+	function simplifyAsync(kind, args) {
+		if (workers.length > 0) {
+			return simplifyWorker(kind, args);
+		}
+
+		return ready.then(function() {
+			return simplifiers[kind][0].apply(null, [instance.exports[simplifiers[kind][1]]].concat(args));
+		});
+	}
+
 	return {
 		ready: ready,
 		supported: true,
@@ -166,6 +311,10 @@ var MeshoptSimplifier = (function() {
 		// note that these functions are experimental and may change interface/behavior in a way that will require revising calling code
 		useExperimentalFeatures: false,
 
+		useWorkers: function(count) {
+			initWorkers(count);
+		},
+
 		compactMesh: function(indices) {
 			assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
 			assert(indices.length % 3 == 0);
@@ -175,57 +324,29 @@ var MeshoptSimplifier = (function() {
 		},
 
 		simplify: function(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags) {
-			assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
-			assert(indices.length % 3 == 0);
-			assert(vertex_positions instanceof Float32Array);
-			assert(vertex_positions.length % vertex_positions_stride == 0);
-			assert(vertex_positions_stride >= 3);
-			assert(target_index_count >= 0 && target_index_count <= indices.length);
-			assert(target_index_count % 3 == 0);
-			assert(target_error >= 0);
-
-			var options = 0;
-			for (var i = 0; i < (flags ? flags.length : 0); ++i) {
-				assert(flags[i] in simplifyOptions);
-				options |= simplifyOptions[flags[i]];
-			}
-
-			var indices32 = indices.BYTES_PER_ELEMENT == 4 ? indices : new Uint32Array(indices);
-			var result = simplify(instance.exports.meshopt_simplify, indices32, indices.length, vertex_positions, vertex_positions.length / vertex_positions_stride, vertex_positions_stride * 4, target_index_count, target_error, options);
-			result[0] = (indices instanceof Uint32Array) ? result[0] : new indices.constructor(result[0]);
-
-			return result;
+			var args = simplifyArgs(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags);
+			return simplifyResult(indices, simplify.apply(null, [instance.exports.meshopt_simplify].concat(args)));
 		},
 
 		simplifyWithAttributes: function(indices, vertex_positions, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, vertex_lock, target_index_count, target_error, flags) {
 			assert(this.useExperimentalFeatures); // set useExperimentalFeatures to use this; note that this function is experimental and may change interface in a way that will require revising calling code
-			assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
-			assert(indices.length % 3 == 0);
-			assert(vertex_positions instanceof Float32Array);
-			assert(vertex_positions.length % vertex_positions_stride == 0);
-			assert(vertex_positions_stride >= 3);
-			assert(vertex_attributes instanceof Float32Array);
-			assert(vertex_attributes.length % vertex_attributes_stride == 0);
-			assert(vertex_attributes_stride >= 0);
-			assert(vertex_lock == null || vertex_lock.length == vertex_positions.length);
-			assert(target_index_count >= 0 && target_index_count <= indices.length);
-			assert(target_index_count % 3 == 0);
-			assert(target_error >= 0);
-			assert(Array.isArray(attribute_weights));
-			assert(vertex_attributes_stride >= attribute_weights.length);
-			assert(attribute_weights.length <= 16);
-
-			var options = 0;
-			for (var i = 0; i < (flags ? flags.length : 0); ++i) {
-				assert(flags[i] in simplifyOptions);
-				options |= simplifyOptions[flags[i]];
-			}
+			var args = simplifyAttrArgs(indices, vertex_positions, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, vertex_lock, target_index_count, target_error, flags);
+			return simplifyResult(indices, simplifyAttr.apply(null, [instance.exports.meshopt_simplifyWithAttributes].concat(args)));
+		},
 
-			var indices32 = indices.BYTES_PER_ELEMENT == 4 ? indices : new Uint32Array(indices);
-			var result = simplifyAttr(instance.exports.meshopt_simplifyWithAttributes, indices32, indices.length, vertex_positions, vertex_positions.length / vertex_positions_stride, vertex_positions_stride * 4, vertex_attributes, vertex_attributes_stride * 4, new Float32Array(attribute_weights), vertex_lock ? new Uint8Array(vertex_lock) : null, target_index_count, target_error, options);
-			result[0] = (indices instanceof Uint32Array) ? result[0] : new indices.constructor(result[0]);
+		simplifyAsync: function(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags) {
+			var args = simplifyArgs(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags);
+			return simplifyAsync("simplify", args).then(function(result) {
+				return simplifyResult(indices, result);
+			});
+		},
 
-			return result;
+		simplifyWithAttributesAsync: function(indices, vertex_positions, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, vertex_lock, target_index_count, target_error, flags) {
+			assert(this.useExperimentalFeatures); // set useExperimentalFeatures to use this; note that this function is experimental and may change interface in a way that will require revising calling code
+			var args = simplifyAttrArgs(indices, vertex_positions, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, vertex_lock, target_index_count, target_error, flags);
+			return simplifyAsync("simplifyAttr", args).then(function(result) {
+				return simplifyResult(indices, result);
+			});
 		},
 
 		getScale: function(vertex_positions, vertex_positions_stride) {
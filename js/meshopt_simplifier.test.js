@@ -175,6 +175,32 @@ var tests = {
 		assert.deepEqual(res[0], expected);
 	},
 
+	simplifyAsync: function() {
+		var indices = new Uint16Array([
+			0, 2, 1,
+			1, 2, 3,
+			3, 2, 4,
+			2, 5, 4,
+		]);
+
+		var positions = new Float32Array([
+			0, 4, 0,
+			0, 1, 0,
+			2, 2, 0,
+			0, 0, 0,
+			1, 0, 0,
+			4, 0, 0,
+		]);
+
+		var expected = new Uint16Array([
+			0, 5, 3,
+		]);
+
+		simplifier.simplifyAsync(indices, positions, 3, /* target indices */ 3, /* target error */ 0.01).then(function (res) {
+			assert.deepEqual(res[0], expected);
+		});
+	},
+
 	getScale: function() {
 		var positions = new Float32Array([
 			0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3
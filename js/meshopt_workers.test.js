@@ -0,0 +1,187 @@
+var assert = require('assert').strict;
+var threads = require('worker_threads');
+
+process.on('unhandledRejection', error => {
+	console.log('unhandledRejection', error);
+	process.exit(1);
+});
+
+// Node.js has no blob URL workers; emulate the subset of Blob/URL/Worker that the libraries use on top of worker_threads
+var sources = {};
+var nextSource = 0;
+
+global.Blob = function(parts) {
+	this.source = parts.join('');
+};
+
+URL.createObjectURL = function(blob) {
+	var url = 'blob:meshopt/' + (nextSource++);
+	sources[url] = blob.source;
+	return url;
+};
+
+URL.revokeObjectURL = function(url) {
+	delete sources[url];
+};
+
+global.Worker = function(url) {
+	var prelude =
+		"var parentPort = require('worker_threads').parentPort;" +
+		"globalThis.self = globalThis;" +
+		"self.postMessage = function(message, transfer) { parentPort.postMessage(message, transfer); };" +
+		"self.close = function() { parentPort.close(); };" +
+		"parentPort.on('message', function(data) { self.onmessage({ data: data }); });\n";
+
+	this.thread = new threads.Worker(prelude + sources[url], { eval: true });
+};
+
+global.Worker.prototype.postMessage = function(message, transfer) {
+	this.thread.postMessage(message, transfer);
+};
+
+Object.defineProperty(global.Worker.prototype, 'onmessage', {
+	set: function(callback) {
+		this.thread.on('message', function(data) { callback({ data: data }); });
+	}
+});
+
+var encoder = require('./meshopt_encoder.js');
+var decoder = require('./meshopt_decoder.js');
+var simplifier = require('./meshopt_simplifier.js');
+
+function bytes(view) {
+	return new Uint8Array(view.buffer, view.byteOffset, view.byteLength);
+}
+
+function grid(size) {
+	var positions = [];
+	var indices = [];
+
+	for (var y = 0; y <= size; ++y) {
+		for (var x = 0; x <= size; ++x) {
+			positions.push(x, y, Math.sin(x * 0.3) * Math.cos(y * 0.2));
+		}
+	}
+
+	for (var y = 0; y < size; ++y) {
+		for (var x = 0; x < size; ++x) {
+			var v = y * (size + 1) + x;
+			indices.push(v, v + 1, v + size + 1, v + 1, v + size + 2, v + size + 1);
+		}
+	}
+
+	return { positions: new Float32Array(positions), indices: new Uint32Array(indices) };
+}
+
+var mesh = grid(32);
+
+var tests = {
+	encodeGltfBufferAsync: function() {
+		var vertices = bytes(mesh.positions);
+		var indices = new Uint16Array(mesh.indices);
+
+		var expectedVertices = encoder.encodeGltfBuffer(vertices, mesh.positions.length / 3, 12, 'ATTRIBUTES');
+		var expectedIndices = encoder.encodeGltfBuffer(bytes(indices), indices.length, 2, 'TRIANGLES');
+
+		return Promise.all([
+			encoder.encodeGltfBufferAsync(vertices, mesh.positions.length / 3, 12, 'ATTRIBUTES'),
+			encoder.encodeGltfBufferAsync(bytes(indices), indices.length, 2, 'TRIANGLES'),
+		]).then(function(results) {
+			assert.deepEqual(results[0], expectedVertices);
+			assert.deepEqual(results[1], expectedIndices);
+
+			// source data must not be transferred to the worker
+			assert.deepEqual(new Uint32Array(indices), mesh.indices);
+		});
+	},
+
+	decodeGltfBufferAsync: function() {
+		var count = mesh.positions.length / 3;
+		var encoded = encoder.encodeGltfBuffer(bytes(mesh.positions), count, 12, 'ATTRIBUTES');
+
+		return decoder.decodeGltfBufferAsync(count, 12, encoded, 'ATTRIBUTES').then(function(result) {
+			assert.deepEqual(result, bytes(mesh.positions));
+		});
+	},
+
+	decodeGltfBufferAsyncShared: function() {
+		var count = mesh.positions.length / 3;
+		var encoded = encoder.encodeGltfBuffer(bytes(mesh.positions), count, 12, 'ATTRIBUTES');
+
+		var target = new Float32Array(new SharedArrayBuffer(count * 12));
+
+		return decoder.decodeGltfBufferAsync(count, 12, encoded, 'ATTRIBUTES', undefined, target).then(function(result) {
+			assert.equal(result, target);
+			assert.deepEqual(target, mesh.positions);
+		});
+	},
+
+	decodeGltfBuffersAsync: function() {
+		var indices = new Uint16Array(mesh.indices);
+		var encoded = encoder.encodeGltfBuffer(bytes(indices), indices.length, 2, 'TRIANGLES');
+
+		// triangle codec may rotate triangles, so compare against synchronous decoding
+		var expected = new Uint16Array(indices.length);
+		decoder.decodeGltfBuffer(bytes(expected), indices.length, 2, encoded, 'TRIANGLES');
+
+		var requests = [
+			{ count: indices.length, size: 2, source: encoded, mode: 'TRIANGLES' },
+			{ count: indices.length, size: 2, source: encoded, mode: 'TRIANGLES', target: new Uint16Array(new SharedArrayBuffer(indices.length * 2)) },
+		];
+
+		return decoder.decodeGltfBuffersAsync(requests).then(function(results) {
+			assert.deepEqual(results[0], bytes(expected));
+			assert.equal(results[1], requests[1].target);
+			assert.deepEqual(results[1], expected);
+		});
+	},
+
+	decodeGltfBufferAsyncError: function() {
+		var count = mesh.positions.length / 3;
+		var encoded = encoder.encodeGltfBuffer(bytes(mesh.positions), count, 12, 'ATTRIBUTES');
+
+		return decoder.decodeGltfBufferAsync(count, 12, encoded.subarray(0, 10), 'ATTRIBUTES').then(function() {
+			assert.fail('decoding truncated data should fail');
+		}, function() {});
+	},
+
+	simplifyAsync: function() {
+		var expected = simplifier.simplify(mesh.indices, mesh.positions, 3, 600, 0.05);
+
+		return simplifier.simplifyAsync(mesh.indices, mesh.positions, 3, 600, 0.05).then(function(res) {
+			assert.deepEqual(res, expected);
+		});
+	},
+
+	simplifyWithAttributesAsync: function() {
+		var attributes = new Float32Array(mesh.positions.length / 3).fill(0.5);
+		var expected = simplifier.simplifyWithAttributes(mesh.indices, mesh.positions, 3, attributes, 1, [1], null, 600, 0.05);
+
+		return simplifier.simplifyWithAttributesAsync(mesh.indices, mesh.positions, 3, attributes, 1, [1], null, 600, 0.05).then(function(res) {
+			assert.deepEqual(res, expected);
+		});
+	},
+};
+
+simplifier.useExperimentalFeatures = true;
+
+Promise.all([encoder.ready, decoder.ready, simplifier.ready]).then(() => {
+	encoder.useWorkers(2);
+	decoder.useWorkers(2);
+	simplifier.useWorkers(2);
+
+	var count = 0;
+	var chain = Promise.resolve();
+
+	for (var key in tests) {
+		chain = chain.then(tests[key]).then(() => count++);
+	}
+
+	return chain.then(() => {
+		encoder.useWorkers(0);
+		decoder.useWorkers(0);
+		simplifier.useWorkers(0);
+
+		console.log(count, 'tests passed');
+	});
+});
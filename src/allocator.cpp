@@ -1,8 +1,150 @@
 // This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
 #include "meshoptimizer.h"
 
+#include <assert.h>
+
 void meshopt_setAllocator(void*(MESHOPTIMIZER_ALLOC_CALLCONV* allocate)(size_t), void(MESHOPTIMIZER_ALLOC_CALLCONV* deallocate)(void*))
 {
 	meshopt_Allocator::Storage::allocate = allocate;
 	meshopt_Allocator::Storage::deallocate = deallocate;
 }
+
+struct meshopt_Context
+{
+	void*(MESHOPTIMIZER_ALLOC_CALLCONV* allocate)(void*, size_t);
+	void(MESHOPTIMIZER_ALLOC_CALLCONV* deallocate)(void*, void*);
+	void* userdata;
+
+	unsigned char* arena;
+	size_t arena_size;
+	size_t arena_offset;
+
+	// memory in use by active allocations (including ones that didn't fit into the arena) and its peak since the arena was last resized
+	size_t live;
+	size_t peak;
+};
+
+namespace meshopt
+{
+
+// each allocation is prefixed with a header that holds its arena offset (or kHeapBlock) and its total size; this keeps 16-byte alignment
+const size_t kContextHeader = 16;
+const size_t kHeapBlock = ~size_t(0);
+
+static void* contextAllocate(meshopt_Context* context, size_t size)
+{
+	return context->allocate ? context->allocate(context->userdata, size) : meshopt_Allocator::Storage::allocate(size);
+}
+
+static void contextDeallocate(meshopt_Context* context, void* ptr)
+{
+	if (context->deallocate)
+		context->deallocate(context->userdata, ptr);
+	else
+		meshopt_Allocator::Storage::deallocate(ptr);
+}
+
+} // namespace meshopt
+
+meshopt_Context* meshopt_createContext(void*(MESHOPTIMIZER_ALLOC_CALLCONV* allocate)(void*, size_t), void(MESHOPTIMIZER_ALLOC_CALLCONV* deallocate)(void*, void*), void* userdata)
+{
+	using namespace meshopt;
+
+	assert((allocate == NULL) == (deallocate == NULL));
+
+	meshopt_Context temp = {allocate, deallocate, userdata, NULL, 0, 0, 0, 0};
+
+	meshopt_Context* context = static_cast<meshopt_Context*>(contextAllocate(&temp, sizeof(meshopt_Context)));
+	*context = temp;
+
+	return context;
+}
+
+void meshopt_destroyContext(meshopt_Context* context)
+{
+	using namespace meshopt;
+
+	if (!context)
+		return;
+
+	assert(context->live == 0);
+
+	meshopt_Context temp = *context;
+
+	if (temp.arena)
+		contextDeallocate(&temp, temp.arena);
+
+	contextDeallocate(&temp, context);
+}
+
+void* meshopt_allocateContext(meshopt_Context* context, size_t size)
+{
+	using namespace meshopt;
+
+	// sizes that can't be represented are forwarded as is so that the allocation callback can report the failure
+	size_t total = size > kHeapBlock - kContextHeader * 2 ? kHeapBlock : ((size + kContextHeader - 1) & ~(kContextHeader - 1)) + kContextHeader;
+
+	unsigned char* block = NULL;
+	size_t offset = kHeapBlock;
+
+	if (total <= context->arena_size - context->arena_offset)
+	{
+		offset = context->arena_offset;
+		block = context->arena + offset;
+		context->arena_offset += total;
+	}
+	else
+	{
+		block = static_cast<unsigned char*>(contextAllocate(context, total));
+	}
+
+	size_t* header = reinterpret_cast<size_t*>(block);
+	header[0] = offset;
+	header[1] = total;
+
+	context->live += total;
+	context->peak = context->live > context->peak ? context->live : context->peak;
+
+	return block + kContextHeader;
+}
+
+void meshopt_deallocateContext(meshopt_Context* context, void* ptr)
+{
+	using namespace meshopt;
+
+	unsigned char* block = static_cast<unsigned char*>(ptr) - kContextHeader;
+
+	size_t* header = reinterpret_cast<size_t*>(block);
+	size_t offset = header[0];
+	size_t total = header[1];
+
+	if (offset != kHeapBlock)
+	{
+		// allocations are released in stack order, so arena blocks are always at the top of the arena
+		assert(offset + total == context->arena_offset);
+		context->arena_offset = offset;
+	}
+	else
+	{
+		contextDeallocate(context, block);
+	}
+
+	assert(context->live >= total);
+	context->live -= total;
+
+	// once all temporary memory is released, grow the arena so that the next call with the same peak usage doesn't need extra allocations
+	if (context->live == 0 && context->peak > context->arena_size)
+	{
+		if (context->arena)
+			contextDeallocate(context, context->arena);
+
+		context->arena = NULL;
+		context->arena_size = 0;
+
+		context->arena = static_cast<unsigned char*>(contextAllocate(context, context->peak));
+		context->arena_size = context->peak;
+	}
+
+	if (context->live == 0)
+		context->peak = 0;
+}
@@ -1,11 +1,61 @@
 // This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
 #include "meshoptimizer.h"
+#include "internal.h"
 
 #include <assert.h>
 #include <float.h>
 #include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+// Prevent compiling other variant when wasm simd compilation is active
+#undef SIMD_NEON
+#undef SIMD_SSE
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 // This work is based on:
 // Graham Wihlidal. Optimizing the Graphics Pipeline with Compute. 2016
 // Matthaeus Chajdas. GeometryFX 1.2 - Cluster Culling. 2016
@@ -145,6 +195,300 @@ static void computeBoundingSphere(float result[4], const float points[][3], size
 	result[3] = radius;
 }
 
+static void expandBoundingSphere(float center[3], float& radius, const float* const points[3], size_t index)
+{
+	float p[3] = {points[0][index], points[1][index], points[2][index]};
+	float d2 = (p[0] - center[0]) * (p[0] - center[0]) + (p[1] - center[1]) * (p[1] - center[1]) + (p[2] - center[2]) * (p[2] - center[2]);
+
+	if (d2 > radius * radius)
+	{
+		float d = sqrtf(d2);
+		assert(d > 0);
+
+		float k = 0.5f + (radius / d) / 2;
+
+		center[0] = center[0] * k + p[0] * (1 - k);
+		center[1] = center[1] * k + p[1] * (1 - k);
+		center[2] = center[2] * k + p[2] * (1 - k);
+		radius = (radius + d) / 2;
+	}
+}
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#define SIMD_BOUNDS
+#endif
+
+#ifdef SIMD_SSE
+typedef __m128 BoundsSimd;
+
+static BoundsSimd boundsLoad(const float* data) { return _mm_loadu_ps(data); }
+static void boundsStore(float* data, BoundsSimd v) { _mm_storeu_ps(data, v); }
+static BoundsSimd boundsSplat(float v) { return _mm_set1_ps(v); }
+static BoundsSimd boundsAdd(BoundsSimd a, BoundsSimd b) { return _mm_add_ps(a, b); }
+static BoundsSimd boundsSub(BoundsSimd a, BoundsSimd b) { return _mm_sub_ps(a, b); }
+static BoundsSimd boundsMul(BoundsSimd a, BoundsSimd b) { return _mm_mul_ps(a, b); }
+static BoundsSimd boundsLess(BoundsSimd a, BoundsSimd b) { return _mm_cmplt_ps(a, b); }
+static BoundsSimd boundsGreater(BoundsSimd a, BoundsSimd b) { return _mm_cmpgt_ps(a, b); }
+static BoundsSimd boundsSelect(BoundsSimd mask, BoundsSimd a, BoundsSimd b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static bool boundsAny(BoundsSimd mask) { return _mm_movemask_ps(mask) != 0; }
+#endif
+
+#ifdef SIMD_NEON
+typedef float32x4_t BoundsSimd;
+
+static BoundsSimd boundsLoad(const float* data) { return vld1q_f32(data); }
+static void boundsStore(float* data, BoundsSimd v) { vst1q_f32(data, v); }
+static BoundsSimd boundsSplat(float v) { return vdupq_n_f32(v); }
+static BoundsSimd boundsAdd(BoundsSimd a, BoundsSimd b) { return vaddq_f32(a, b); }
+static BoundsSimd boundsSub(BoundsSimd a, BoundsSimd b) { return vsubq_f32(a, b); }
+static BoundsSimd boundsMul(BoundsSimd a, BoundsSimd b) { return vmulq_f32(a, b); }
+static BoundsSimd boundsLess(BoundsSimd a, BoundsSimd b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+static BoundsSimd boundsGreater(BoundsSimd a, BoundsSimd b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+static BoundsSimd boundsSelect(BoundsSimd mask, BoundsSimd a, BoundsSimd b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+
+static bool boundsAny(BoundsSimd mask)
+{
+	uint32x4_t m = vreinterpretq_u32_f32(mask);
+	uint32x2_t h = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+
+	return (vget_lane_u32(h, 0) | vget_lane_u32(h, 1)) != 0;
+}
+#endif
+
+#ifdef SIMD_WASM
+typedef v128_t BoundsSimd;
+
+static BoundsSimd boundsLoad(const float* data) { return wasm_v128_load(data); }
+static void boundsStore(float* data, BoundsSimd v) { wasm_v128_store(data, v); }
+static BoundsSimd boundsSplat(float v) { return wasm_f32x4_splat(v); }
+static BoundsSimd boundsAdd(BoundsSimd a, BoundsSimd b) { return wasm_f32x4_add(a, b); }
+static BoundsSimd boundsSub(BoundsSimd a, BoundsSimd b) { return wasm_f32x4_sub(a, b); }
+static BoundsSimd boundsMul(BoundsSimd a, BoundsSimd b) { return wasm_f32x4_mul(a, b); }
+static BoundsSimd boundsLess(BoundsSimd a, BoundsSimd b) { return wasm_f32x4_lt(a, b); }
+static BoundsSimd boundsGreater(BoundsSimd a, BoundsSimd b) { return wasm_f32x4_gt(a, b); }
+static BoundsSimd boundsSelect(BoundsSimd mask, BoundsSimd a, BoundsSimd b) { return wasm_v128_bitselect(a, b, mask); }
+static bool boundsAny(BoundsSimd mask) { return wasm_v128_any_true(mask); }
+#endif
+
+#ifdef SIMD_BOUNDS
+static size_t findExtremaSimd(size_t pmin[3], size_t pmax[3], const float* const points[3], size_t count)
+{
+	static const float kLaneIndex[4] = {0, 1, 2, 3};
+
+	if (count < 4)
+		return 0;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const float* data = points[axis];
+
+		// indices are tracked as floats to keep all lane operations in the same type; counts are small so the values are exact
+		BoundsSimd vmin = boundsLoad(data), vmax = vmin;
+		BoundsSimd index = boundsLoad(kLaneIndex), imin = index, imax = index;
+		BoundsSimd step = boundsSplat(4.f);
+
+		for (size_t i = 4; i + 4 <= count; i += 4)
+		{
+			BoundsSimd v = boundsLoad(data + i);
+			index = boundsAdd(index, step);
+
+			BoundsSimd lt = boundsLess(v, vmin);
+			BoundsSimd gt = boundsGreater(v, vmax);
+
+			vmin = boundsSelect(lt, v, vmin);
+			imin = boundsSelect(lt, index, imin);
+			vmax = boundsSelect(gt, v, vmax);
+			imax = boundsSelect(gt, index, imax);
+		}
+
+		float lmin[4], lmax[4], limin[4], limax[4];
+		boundsStore(lmin, vmin);
+		boundsStore(lmax, vmax);
+		boundsStore(limin, imin);
+		boundsStore(limax, imax);
+
+		// each lane has the first extremum among its points; pick the first extremum across lanes to match scalar code
+		int bmin = 0, bmax = 0;
+
+		for (int k = 1; k < 4; ++k)
+		{
+			bmin = (lmin[k] < lmin[bmin] || (lmin[k] == lmin[bmin] && limin[k] < limin[bmin])) ? k : bmin;
+			bmax = (lmax[k] > lmax[bmax] || (lmax[k] == lmax[bmax] && limax[k] < limax[bmax])) ? k : bmax;
+		}
+
+		pmin[axis] = size_t(limin[bmin]);
+		pmax[axis] = size_t(limax[bmax]);
+	}
+
+	return count & ~size_t(3);
+}
+
+static bool outsideBoundingSphereSimd(const float* const points[3], size_t index, const float center[3], float radius)
+{
+	BoundsSimd dx = boundsSub(boundsLoad(points[0] + index), boundsSplat(center[0]));
+	BoundsSimd dy = boundsSub(boundsLoad(points[1] + index), boundsSplat(center[1]));
+	BoundsSimd dz = boundsSub(boundsLoad(points[2] + index), boundsSplat(center[2]));
+
+	BoundsSimd d2 = boundsAdd(boundsAdd(boundsMul(dx, dx), boundsMul(dy, dy)), boundsMul(dz, dz));
+
+	return boundsAny(boundsGreater(d2, boundsSplat(radius * radius)));
+}
+#endif
+
+// computes the same sphere as computeBoundingSphere for points stored as separate x/y/z arrays, which allows processing 4 points at a time
+static void computeBoundingSphereSoA(float result[4], const float* const points[3], size_t count)
+{
+	assert(count > 0);
+
+	// find extremum points along all 3 axes; for each axis we get a pair of points with min/max coordinates
+	size_t pmin[3] = {0, 0, 0};
+	size_t pmax[3] = {0, 0, 0};
+	size_t offset = 0;
+
+#ifdef SIMD_BOUNDS
+	offset = findExtremaSimd(pmin, pmax, points, count);
+#endif
+
+	for (size_t i = offset; i < count; ++i)
+	{
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			pmin[axis] = (points[axis][i] < points[axis][pmin[axis]]) ? i : pmin[axis];
+			pmax[axis] = (points[axis][i] > points[axis][pmax[axis]]) ? i : pmax[axis];
+		}
+	}
+
+	// find the pair of points with largest distance
+	float paxisd2 = 0;
+	int paxis = 0;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		size_t i1 = pmin[axis], i2 = pmax[axis];
+
+		float dx = points[0][i2] - points[0][i1], dy = points[1][i2] - points[1][i1], dz = points[2][i2] - points[2][i1];
+		float d2 = dx * dx + dy * dy + dz * dz;
+
+		if (d2 > paxisd2)
+		{
+			paxisd2 = d2;
+			paxis = axis;
+		}
+	}
+
+	// use the longest segment as the initial sphere diameter
+	size_t i1 = pmin[paxis], i2 = pmax[paxis];
+
+	float center[3] = {(points[0][i1] + points[0][i2]) / 2, (points[1][i1] + points[1][i2]) / 2, (points[2][i1] + points[2][i2]) / 2};
+	float radius = sqrtf(paxisd2) / 2;
+
+	// iteratively adjust the sphere up until all points fit; groups of points that are inside the sphere can be skipped since it only grows
+	size_t i = 0;
+
+#ifdef SIMD_BOUNDS
+	for (; i + 4 <= count; i += 4)
+		if (outsideBoundingSphereSimd(points, i, center, radius))
+			for (size_t k = i; k < i + 4; ++k)
+				expandBoundingSphere(center, radius, points, k);
+#endif
+
+	for (; i < count; ++i)
+		expandBoundingSphere(center, radius, points, i);
+
+	result[0] = center[0];
+	result[1] = center[1];
+	result[2] = center[2];
+	result[3] = radius;
+}
+
+// fills bounds with the cluster bounding sphere and the normal cone; nsphere is the center of the bounding sphere of unit triangle normals
+static void computeClusterCone(meshopt_Bounds& bounds, const float center[3], float radius, const float nsphere[3], const float normals[][3], const float* origins, size_t origin_stride, size_t triangles)
+{
+	float axis[3] = {nsphere[0], nsphere[1], nsphere[2]};
+	float axislength = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+	float invaxislength = axislength == 0.f ? 0.f : 1.f / axislength;
+
+	axis[0] *= invaxislength;
+	axis[1] *= invaxislength;
+	axis[2] *= invaxislength;
+
+	// compute a tight cone around all normals, mindp = cos(angle/2)
+	float mindp = 1.f;
+
+	for (size_t i = 0; i < triangles; ++i)
+	{
+		float dp = normals[i][0] * axis[0] + normals[i][1] * axis[1] + normals[i][2] * axis[2];
+
+		mindp = (dp < mindp) ? dp : mindp;
+	}
+
+	// fill bounding sphere info; note that below we can return bounds without cone information for degenerate cones
+	bounds.center[0] = center[0];
+	bounds.center[1] = center[1];
+	bounds.center[2] = center[2];
+	bounds.radius = radius;
+
+	// degenerate cluster, normal cone is larger than a hemisphere => trivial accept
+	// note that if mindp is positive but close to 0, the triangle intersection code below gets less stable
+	// we arbitrarily decide that if a normal cone is ~168 degrees wide or more, the cone isn't useful
+	if (mindp <= 0.1f)
+	{
+		bounds.cone_cutoff = 1;
+		bounds.cone_cutoff_s8 = 127;
+		return;
+	}
+
+	float maxt = 0;
+
+	// we need to find the point on center-t*axis ray that lies in negative half-space of all triangles
+	for (size_t i = 0; i < triangles; ++i)
+	{
+		// dot(center-t*axis-corner, trinormal) = 0
+		// dot(center-corner, trinormal) - t * dot(axis, trinormal) = 0
+		float cx = center[0] - origins[i * origin_stride + 0];
+		float cy = center[1] - origins[i * origin_stride + 1];
+		float cz = center[2] - origins[i * origin_stride + 2];
+
+		float dc = cx * normals[i][0] + cy * normals[i][1] + cz * normals[i][2];
+		float dn = axis[0] * normals[i][0] + axis[1] * normals[i][1] + axis[2] * normals[i][2];
+
+		// dn should be larger than mindp cutoff above
+		assert(dn > 0.f);
+		float t = dc / dn;
+
+		maxt = (t > maxt) ? t : maxt;
+	}
+
+	// cone apex should be in the negative half-space of all cluster triangles by construction
+	bounds.cone_apex[0] = center[0] - axis[0] * maxt;
+	bounds.cone_apex[1] = center[1] - axis[1] * maxt;
+	bounds.cone_apex[2] = center[2] - axis[2] * maxt;
+
+	// note: this axis is the axis of the normal cone, but our test for perspective camera effectively negates the axis
+	bounds.cone_axis[0] = axis[0];
+	bounds.cone_axis[1] = axis[1];
+	bounds.cone_axis[2] = axis[2];
+
+	// cos(a) for normal cone is mindp; we need to add 90 degrees on both sides and invert the cone
+	// which gives us -cos(a+90) = -(-sin(a)) = sin(a) = sqrt(1 - cos^2(a))
+	bounds.cone_cutoff = sqrtf(1 - mindp * mindp);
+
+	// quantize axis & cutoff to 8-bit SNORM format
+	bounds.cone_axis_s8[0] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[0], 8));
+	bounds.cone_axis_s8[1] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[1], 8));
+	bounds.cone_axis_s8[2] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[2], 8));
+
+	// for the 8-bit test to be conservative, we need to adjust the cutoff by measuring the max. error
+	float cone_axis_s8_e0 = fabsf(bounds.cone_axis_s8[0] / 127.f - bounds.cone_axis[0]);
+	float cone_axis_s8_e1 = fabsf(bounds.cone_axis_s8[1] / 127.f - bounds.cone_axis[1]);
+	float cone_axis_s8_e2 = fabsf(bounds.cone_axis_s8[2] / 127.f - bounds.cone_axis[2]);
+
+	// note that we need to round this up instead of rounding to nearest, hence +1
+	int cone_cutoff_s8 = int(127 * (bounds.cone_cutoff + cone_axis_s8_e0 + cone_axis_s8_e1 + cone_axis_s8_e2) + 1);
+
+	bounds.cone_cutoff_s8 = (cone_cutoff_s8 > 127) ? 127 : (signed char)(cone_cutoff_s8);
+}
+
 struct Cone
 {
 	float px, py, pz;
@@ -533,6 +877,11 @@ size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_
 }
 
 size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
+{
+	return meshopt_buildMeshletsWithContext(NULL, meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+}
+
+size_t meshopt_buildMeshletsWithContext(meshopt_Context* context, meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
 {
 	using namespace meshopt;
 
@@ -546,7 +895,7 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 
 	assert(cone_weight >= 0 && cone_weight <= 1);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	TriangleAdjacency2 adjacency = {};
 	buildTriangleAdjacency(adjacency, indices, index_count, vertex_count, allocator);
@@ -670,6 +1019,154 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 	return meshlet_offset;
 }
 
+namespace meshopt
+{
+
+struct BuildMeshletsPartitions
+{
+	meshopt_Meshlet* meshlets;
+	unsigned int* meshlet_vertices;
+	unsigned char* meshlet_triangles;
+
+	const unsigned int* indices;
+	const float* vertex_positions;
+	const size_t* triangle_offsets;
+	const size_t* vertex_offsets;
+	const size_t* meshlet_offsets;
+	size_t* meshlet_counts;
+
+	size_t max_vertices;
+	size_t max_triangles;
+	float cone_weight;
+};
+
+static void buildMeshletsPartition(void* data, size_t index)
+{
+	const BuildMeshletsPartitions& job = *static_cast<const BuildMeshletsPartitions*>(data);
+
+	size_t meshlet_offset = job.meshlet_offsets[index];
+	size_t vertex_offset = job.vertex_offsets[index];
+
+	// each partition uses local vertex indices; the output goes to the partition's own region of the output buffers
+	job.meshlet_counts[index] = meshopt_buildMeshlets(job.meshlets + meshlet_offset, job.meshlet_vertices + meshlet_offset * job.max_vertices, job.meshlet_triangles + meshlet_offset * job.max_triangles * 3,
+	    job.indices + job.triangle_offsets[index] * 3, (job.triangle_offsets[index + 1] - job.triangle_offsets[index]) * 3,
+	    job.vertex_positions + vertex_offset * 3, job.vertex_offsets[index + 1] - vertex_offset, sizeof(float) * 3,
+	    job.max_vertices, job.max_triangles, job.cone_weight);
+}
+
+} // namespace meshopt
+
+size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= kMeshletMaxVertices);
+	assert(max_triangles >= 1 && max_triangles <= kMeshletMaxTriangles);
+	assert(max_triangles % 4 == 0); // ensures the caller will compute output space properly as index data is 4b aligned
+
+	assert(partition_count > 0);
+
+	size_t face_count = index_count / 3;
+
+	// partitions are made of whole groups of triangles that exactly fill meshopt_buildMeshletsBound limits; this guarantees that the sum of partition bounds doesn't exceed the bound for the entire mesh
+	size_t group_size = max_triangles * (max_vertices - 2);
+	size_t group_count = (face_count + group_size - 1) / group_size;
+
+	if (partition_count > group_count)
+		partition_count = group_count;
+
+	if (partition_count <= 1)
+		return meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+
+	meshopt_Allocator allocator;
+
+	size_t* triangle_offsets = allocator.allocate<size_t>(partition_count + 1);
+	size_t* vertex_offsets = allocator.allocate<size_t>(partition_count + 1);
+	size_t* meshlet_offsets = allocator.allocate<size_t>(partition_count + 1);
+	size_t* meshlet_counts = allocator.allocate<size_t>(partition_count);
+
+	for (size_t i = 0; i <= partition_count; ++i)
+	{
+		size_t offset = (group_count * i / partition_count) * group_size;
+		triangle_offsets[i] = offset < face_count ? offset : face_count;
+	}
+
+	meshlet_offsets[0] = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+		meshlet_offsets[i + 1] = meshlet_offsets[i] + meshopt_buildMeshletsBound((triangle_offsets[i + 1] - triangle_offsets[i]) * 3, max_vertices, max_triangles);
+
+	assert(meshlet_offsets[partition_count] <= meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles));
+
+	// sort triangles spatially and convert each partition to local vertex indices so that per-vertex data in partitions only covers the vertices they use
+	unsigned int* sorted = allocator.allocate<unsigned int>(index_count);
+	unsigned int* local_vertices = allocator.allocate<unsigned int>(index_count);
+	size_t local_vertex_count = partitionTriangles(sorted, local_vertices, vertex_offsets, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, triangle_offsets, partition_count);
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	float* local_positions = allocator.allocate<float>(local_vertex_count * 3);
+
+	for (size_t i = 0; i < local_vertex_count; ++i)
+		memcpy(&local_positions[i * 3], &vertex_positions[local_vertices[i] * vertex_stride_float], sizeof(float) * 3);
+
+	BuildMeshletsPartitions job = {};
+	job.meshlets = meshlets;
+	job.meshlet_vertices = meshlet_vertices;
+	job.meshlet_triangles = meshlet_triangles;
+	job.indices = sorted;
+	job.vertex_positions = local_positions;
+	job.triangle_offsets = triangle_offsets;
+	job.vertex_offsets = vertex_offsets;
+	job.meshlet_offsets = meshlet_offsets;
+	job.meshlet_counts = meshlet_counts;
+	job.max_vertices = max_vertices;
+	job.max_triangles = max_triangles;
+	job.cone_weight = cone_weight;
+
+	if (scheduler)
+		scheduler(scheduler_context, buildMeshletsPartition, &job, partition_count);
+	else
+		for (size_t i = 0; i < partition_count; ++i)
+			buildMeshletsPartition(&job, i);
+
+	// compact partition results; partition regions are ordered, so data only ever moves towards the start of the buffers
+	size_t meshlet_count = 0;
+	size_t vertex_write = 0;
+	size_t triangle_write = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		const unsigned int* partition_vertices = &local_vertices[vertex_offsets[i]];
+
+		for (size_t j = 0; j < meshlet_counts[i]; ++j)
+		{
+			meshopt_Meshlet meshlet = meshlets[meshlet_offsets[i] + j];
+
+			const unsigned int* source_vertices = &meshlet_vertices[meshlet_offsets[i] * max_vertices + meshlet.vertex_offset];
+			size_t triangle_size = (meshlet.triangle_count * 3 + 3) & ~3;
+
+			for (size_t k = 0; k < meshlet.vertex_count; ++k)
+				meshlet_vertices[vertex_write + k] = partition_vertices[source_vertices[k]];
+
+			memmove(&meshlet_triangles[triangle_write], &meshlet_triangles[meshlet_offsets[i] * max_triangles * 3 + meshlet.triangle_offset], triangle_size);
+
+			meshlet.vertex_offset = unsigned(vertex_write);
+			meshlet.triangle_offset = unsigned(triangle_write);
+			meshlets[meshlet_count++] = meshlet;
+
+			vertex_write += meshlet.vertex_count;
+			triangle_write += triangle_size;
+		}
+	}
+
+	return meshlet_count;
+}
+
 size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles)
 {
 	using namespace meshopt;
@@ -775,112 +1272,188 @@ meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t
 	float nsphere[4] = {};
 	computeBoundingSphere(nsphere, normals, triangles);
 
-	float axis[3] = {nsphere[0], nsphere[1], nsphere[2]};
-	float axislength = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
-	float invaxislength = axislength == 0.f ? 0.f : 1.f / axislength;
+	computeClusterCone(bounds, center, psphere[3], nsphere, normals, corners[0][0], 9, triangles);
 
-	axis[0] *= invaxislength;
-	axis[1] *= invaxislength;
-	axis[2] *= invaxislength;
+	return bounds;
+}
 
-	// compute a tight cone around all normals, mindp = cos(angle/2)
-	float mindp = 1.f;
+meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, size_t triangle_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+{
+	using namespace meshopt;
 
-	for (size_t i = 0; i < triangles; ++i)
+	assert(triangle_count <= kMeshletMaxTriangles);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	unsigned int indices[kMeshletMaxTriangles * 3];
+
+	for (size_t i = 0; i < triangle_count * 3; ++i)
 	{
-		float dp = normals[i][0] * axis[0] + normals[i][1] * axis[1] + normals[i][2] * axis[2];
+		unsigned int index = meshlet_vertices[meshlet_triangles[i]];
+		assert(index < vertex_count);
 
-		mindp = (dp < mindp) ? dp : mindp;
+		indices[i] = index;
 	}
 
-	// fill bounding sphere info; note that below we can return bounds without cone information for degenerate cones
-	bounds.center[0] = center[0];
-	bounds.center[1] = center[1];
-	bounds.center[2] = center[2];
-	bounds.radius = psphere[3];
+	return meshopt_computeClusterBounds(indices, triangle_count * 3, vertex_positions, vertex_count, vertex_positions_stride);
+}
 
-	// degenerate cluster, normal cone is larger than a hemisphere => trivial accept
-	// note that if mindp is positive but close to 0, the triangle intersection code below gets less stable
-	// we arbitrarily decide that if a normal cone is ~168 degrees wide or more, the cone isn't useful
-	if (mindp <= 0.1f)
+namespace meshopt
+{
+
+// the number of meshlets processed by a single task; large enough to amortize scheduling overhead
+const size_t kMeshletBoundsTaskSize = 256;
+
+struct MeshletBoundsBatch
+{
+	meshopt_Bounds* bounds;
+	meshopt_PackedBounds* packed_bounds;
+
+	const meshopt_Meshlet* meshlets;
+	size_t meshlet_count;
+	const unsigned int* meshlet_vertices;
+	const unsigned char* meshlet_triangles;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_stride_float;
+};
+
+static meshopt_Bounds computeMeshletBoundsLocal(const MeshletBoundsBatch& job, const meshopt_Meshlet& meshlet)
+{
+	assert(meshlet.vertex_count <= kMeshletMaxVertices);
+	assert(meshlet.triangle_count <= kMeshletMaxTriangles);
+
+	// gather meshlet vertex positions into separate x/y/z arrays
+	float px[kMeshletMaxVertices], py[kMeshletMaxVertices], pz[kMeshletMaxVertices];
+	const float* points[3] = {px, py, pz};
+
+	const unsigned int* vertices = &job.meshlet_vertices[meshlet.vertex_offset];
+
+	for (size_t i = 0; i < meshlet.vertex_count; ++i)
 	{
-		bounds.cone_cutoff = 1;
-		bounds.cone_cutoff_s8 = 127;
-		return bounds;
+		unsigned int index = vertices[i];
+		assert(index < job.vertex_count);
+
+		const float* p = job.vertex_positions + job.vertex_stride_float * index;
+
+		px[i] = p[0];
+		py[i] = p[1];
+		pz[i] = p[2];
 	}
 
-	float maxt = 0;
+	// compute triangle normals and gather a point on each triangle; this matches computations in meshopt_computeClusterBounds exactly
+	float normals[kMeshletMaxTriangles][3];
+	float origins[kMeshletMaxTriangles][3];
+	size_t triangles = 0;
 
-	// we need to find the point on center-t*axis ray that lies in negative half-space of all triangles
-	for (size_t i = 0; i < triangles; ++i)
+	// normals are also stored as separate x/y/z arrays for normal cone axis computation
+	float nx[kMeshletMaxTriangles], ny[kMeshletMaxTriangles], nz[kMeshletMaxTriangles];
+	const float* npoints[3] = {nx, ny, nz};
+
+	const unsigned char* indices = &job.meshlet_triangles[meshlet.triangle_offset];
+
+	for (size_t i = 0; i < meshlet.triangle_count; ++i)
 	{
-		// dot(center-t*axis-corner, trinormal) = 0
-		// dot(center-corner, trinormal) - t * dot(axis, trinormal) = 0
-		float cx = center[0] - corners[i][0][0];
-		float cy = center[1] - corners[i][0][1];
-		float cz = center[2] - corners[i][0][2];
+		unsigned int a = indices[i * 3 + 0], b = indices[i * 3 + 1], c = indices[i * 3 + 2];
+		assert(a < meshlet.vertex_count && b < meshlet.vertex_count && c < meshlet.vertex_count);
 
-		float dc = cx * normals[i][0] + cy * normals[i][1] + cz * normals[i][2];
-		float dn = axis[0] * normals[i][0] + axis[1] * normals[i][1] + axis[2] * normals[i][2];
+		float p10[3] = {px[b] - px[a], py[b] - py[a], pz[b] - pz[a]};
+		float p20[3] = {px[c] - px[a], py[c] - py[a], pz[c] - pz[a]};
 
-		// dn should be larger than mindp cutoff above
-		assert(dn > 0.f);
-		float t = dc / dn;
+		float normalx = p10[1] * p20[2] - p10[2] * p20[1];
+		float normaly = p10[2] * p20[0] - p10[0] * p20[2];
+		float normalz = p10[0] * p20[1] - p10[1] * p20[0];
 
-		maxt = (t > maxt) ? t : maxt;
-	}
+		float area = sqrtf(normalx * normalx + normaly * normaly + normalz * normalz);
 
-	// cone apex should be in the negative half-space of all cluster triangles by construction
-	bounds.cone_apex[0] = center[0] - axis[0] * maxt;
-	bounds.cone_apex[1] = center[1] - axis[1] * maxt;
-	bounds.cone_apex[2] = center[2] - axis[2] * maxt;
+		// no need to include degenerate triangles - they will be invisible anyway
+		if (area == 0.f)
+			continue;
 
-	// note: this axis is the axis of the normal cone, but our test for perspective camera effectively negates the axis
-	bounds.cone_axis[0] = axis[0];
-	bounds.cone_axis[1] = axis[1];
-	bounds.cone_axis[2] = axis[2];
+		normals[triangles][0] = normalx / area;
+		normals[triangles][1] = normaly / area;
+		normals[triangles][2] = normalz / area;
+		nx[triangles] = normals[triangles][0];
+		ny[triangles] = normals[triangles][1];
+		nz[triangles] = normals[triangles][2];
+		origins[triangles][0] = px[a];
+		origins[triangles][1] = py[a];
+		origins[triangles][2] = pz[a];
+		triangles++;
+	}
 
-	// cos(a) for normal cone is mindp; we need to add 90 degrees on both sides and invert the cone
-	// which gives us -cos(a+90) = -(-sin(a)) = sin(a) = sqrt(1 - cos^2(a))
-	bounds.cone_cutoff = sqrtf(1 - mindp * mindp);
+	meshopt_Bounds bounds = {};
 
-	// quantize axis & cutoff to 8-bit SNORM format
-	bounds.cone_axis_s8[0] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[0], 8));
-	bounds.cone_axis_s8[1] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[1], 8));
-	bounds.cone_axis_s8[2] = (signed char)(meshopt_quantizeSnorm(bounds.cone_axis[2], 8));
+	// degenerate cluster, no valid triangles => trivial reject (cone data is 0)
+	if (triangles == 0)
+		return bounds;
 
-	// for the 8-bit test to be conservative, we need to adjust the cutoff by measuring the max. error
-	float cone_axis_s8_e0 = fabsf(bounds.cone_axis_s8[0] / 127.f - bounds.cone_axis[0]);
-	float cone_axis_s8_e1 = fabsf(bounds.cone_axis_s8[1] / 127.f - bounds.cone_axis[1]);
-	float cone_axis_s8_e2 = fabsf(bounds.cone_axis_s8[2] / 127.f - bounds.cone_axis[2]);
+	// meshlet vertices are unique so computing the sphere from them is cheaper than using triangle corners
+	float psphere[4] = {};
+	computeBoundingSphereSoA(psphere, points, meshlet.vertex_count);
 
-	// note that we need to round this up instead of rounding to nearest, hence +1
-	int cone_cutoff_s8 = int(127 * (bounds.cone_cutoff + cone_axis_s8_e0 + cone_axis_s8_e1 + cone_axis_s8_e2) + 1);
+	float nsphere[4] = {};
+	computeBoundingSphereSoA(nsphere, npoints, triangles);
 
-	bounds.cone_cutoff_s8 = (cone_cutoff_s8 > 127) ? 127 : (signed char)(cone_cutoff_s8);
+	computeClusterCone(bounds, psphere, psphere[3], nsphere, normals, origins[0], 3, triangles);
 
 	return bounds;
 }
 
-meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, size_t triangle_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+static void computeMeshletBoundsRange(void* data, size_t index)
 {
-	using namespace meshopt;
+	const MeshletBoundsBatch& job = *static_cast<const MeshletBoundsBatch*>(data);
 
-	assert(triangle_count <= kMeshletMaxTriangles);
-	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
-	assert(vertex_positions_stride % sizeof(float) == 0);
-
-	unsigned int indices[kMeshletMaxTriangles * 3];
+	size_t begin = index * kMeshletBoundsTaskSize;
+	size_t end = begin + kMeshletBoundsTaskSize < job.meshlet_count ? begin + kMeshletBoundsTaskSize : job.meshlet_count;
 
-	for (size_t i = 0; i < triangle_count * 3; ++i)
+	for (size_t i = begin; i < end; ++i)
 	{
-		unsigned int index = meshlet_vertices[meshlet_triangles[i]];
-		assert(index < vertex_count);
+		meshopt_Bounds bounds = computeMeshletBoundsLocal(job, job.meshlets[i]);
 
-		indices[i] = index;
+		if (job.bounds)
+			job.bounds[i] = bounds;
+
+		if (job.packed_bounds)
+		{
+			meshopt_PackedBounds& packed = job.packed_bounds[i];
+
+			memcpy(packed.center, bounds.center, sizeof(packed.center));
+			packed.radius = bounds.radius;
+			memcpy(packed.cone_axis_s8, bounds.cone_axis_s8, sizeof(packed.cone_axis_s8));
+			packed.cone_cutoff_s8 = bounds.cone_cutoff_s8;
+		}
 	}
+}
 
-	return meshopt_computeClusterBounds(indices, triangle_count * 3, vertex_positions, vertex_count, vertex_positions_stride);
+} // namespace meshopt
+
+void meshopt_computeMeshletBoundsBatch(meshopt_Bounds* bounds, meshopt_PackedBounds* packed_bounds, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	MeshletBoundsBatch job = {};
+	job.bounds = bounds;
+	job.packed_bounds = packed_bounds;
+	job.meshlets = meshlets;
+	job.meshlet_count = meshlet_count;
+	job.meshlet_vertices = meshlet_vertices;
+	job.meshlet_triangles = meshlet_triangles;
+	job.vertex_positions = vertex_positions;
+	job.vertex_count = vertex_count;
+	job.vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	size_t task_count = (meshlet_count + kMeshletBoundsTaskSize - 1) / kMeshletBoundsTaskSize;
+
+	if (scheduler && task_count > 1)
+		scheduler(scheduler_context, computeMeshletBoundsRange, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			computeMeshletBoundsRange(&job, i);
 }
 
 void meshopt_optimizeMeshlet(unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, size_t triangle_count, size_t vertex_count)
@@ -972,3 +1545,583 @@ void meshopt_optimizeMeshlet(unsigned int* meshlet_vertices, unsigned char* mesh
 	assert(vertex_offset <= vertex_count);
 	memcpy(vertices, order, vertex_offset * sizeof(unsigned int));
 }
+
+namespace meshopt
+{
+
+// Number of partitions used to build the initial clusters; fixed to keep the results independent of the scheduler
+const size_t kClusterLodPartitions = 16;
+
+static void mergeSphere(float center[3], float& radius, const float other_center[3], float other_radius)
+{
+	float dx = other_center[0] - center[0], dy = other_center[1] - center[1], dz = other_center[2] - center[2];
+	float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+	// the other sphere is already inside
+	if (distance + other_radius <= radius)
+		return;
+
+	// the other sphere contains this sphere
+	if (distance + radius <= other_radius)
+	{
+		memcpy(center, other_center, 3 * sizeof(float));
+		radius = other_radius;
+		return;
+	}
+
+	float new_radius = (distance + radius + other_radius) * 0.5f;
+	float k = (new_radius - radius) / distance;
+
+	center[0] += dx * k;
+	center[1] += dy * k;
+	center[2] += dz * k;
+	radius = new_radius;
+}
+
+static size_t groupClusters(unsigned int* group_offsets, unsigned int* group_clusters, const meshopt_ClusterLod* clusters, const unsigned int* cluster_vertices, const unsigned int* active, size_t active_count, const unsigned int* position_remap, size_t position_count, size_t group_size)
+{
+	meshopt_Allocator allocator;
+
+	// build position => cluster adjacency; positions are deduplicated so that clusters are connected across attribute seams
+	unsigned int* counts = allocator.allocate<unsigned int>(position_count);
+	unsigned int* offsets = allocator.allocate<unsigned int>(position_count);
+	unsigned int* last = allocator.allocate<unsigned int>(position_count);
+
+	memset(counts, 0, position_count * sizeof(unsigned int));
+	memset(last, -1, position_count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < active_count; ++i)
+	{
+		const meshopt_ClusterLod& cluster = clusters[active[i]];
+
+		for (size_t j = 0; j < cluster.vertex_count; ++j)
+		{
+			unsigned int p = position_remap[cluster_vertices[cluster.vertex_offset + j]];
+
+			if (last[p] != i)
+			{
+				last[p] = unsigned(i);
+				counts[p]++;
+			}
+		}
+	}
+
+	unsigned int offset = 0;
+
+	for (size_t i = 0; i < position_count; ++i)
+	{
+		offsets[i] = offset;
+		offset += counts[i];
+	}
+
+	unsigned int* position_clusters = allocator.allocate<unsigned int>(offset);
+
+	memset(last, -1, position_count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < active_count; ++i)
+	{
+		const meshopt_ClusterLod& cluster = clusters[active[i]];
+
+		for (size_t j = 0; j < cluster.vertex_count; ++j)
+		{
+			unsigned int p = position_remap[cluster_vertices[cluster.vertex_offset + j]];
+
+			if (last[p] != i)
+			{
+				last[p] = unsigned(i);
+				position_clusters[offsets[p]++] = unsigned(i);
+			}
+		}
+	}
+
+	// fix offsets that have been disturbed by the previous pass
+	for (size_t i = 0; i < position_count; ++i)
+		offsets[i] -= counts[i];
+
+	// build cluster => cluster adjacency, weighted by the number of shared positions
+	unsigned int* adjacency_offsets = allocator.allocate<unsigned int>(active_count + 1);
+	unsigned int* stamp = allocator.allocate<unsigned int>(active_count);
+	unsigned int* weights = allocator.allocate<unsigned int>(active_count);
+
+	memset(stamp, -1, active_count * sizeof(unsigned int));
+
+	adjacency_offsets[0] = 0;
+
+	for (size_t i = 0; i < active_count; ++i)
+	{
+		const meshopt_ClusterLod& cluster = clusters[active[i]];
+		unsigned int degree = 0;
+
+		for (size_t j = 0; j < cluster.vertex_count; ++j)
+		{
+			unsigned int p = position_remap[cluster_vertices[cluster.vertex_offset + j]];
+
+			for (unsigned int k = offsets[p]; k < offsets[p] + counts[p]; ++k)
+			{
+				unsigned int other = position_clusters[k];
+
+				if (other != i && stamp[other] != i)
+				{
+					stamp[other] = unsigned(i);
+					degree++;
+				}
+			}
+		}
+
+		adjacency_offsets[i + 1] = adjacency_offsets[i] + degree;
+	}
+
+	unsigned int* adjacency = allocator.allocate<unsigned int>(adjacency_offsets[active_count]);
+	unsigned int* adjacency_weights = allocator.allocate<unsigned int>(adjacency_offsets[active_count]);
+
+	memset(stamp, -1, active_count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < active_count; ++i)
+	{
+		const meshopt_ClusterLod& cluster = clusters[active[i]];
+		unsigned int* neighbors = &adjacency[adjacency_offsets[i]];
+		unsigned int degree = 0;
+
+		for (size_t j = 0; j < cluster.vertex_count; ++j)
+		{
+			unsigned int p = position_remap[cluster_vertices[cluster.vertex_offset + j]];
+
+			for (unsigned int k = offsets[p]; k < offsets[p] + counts[p]; ++k)
+			{
+				unsigned int other = position_clusters[k];
+
+				if (other == i)
+					continue;
+
+				if (stamp[other] != i)
+				{
+					stamp[other] = unsigned(i);
+					weights[other] = 0;
+					neighbors[degree++] = other;
+				}
+
+				weights[other]++;
+			}
+		}
+
+		assert(degree == adjacency_offsets[i + 1] - adjacency_offsets[i]);
+
+		for (size_t j = 0; j < degree; ++j)
+			adjacency_weights[adjacency_offsets[i] + j] = weights[neighbors[j]];
+	}
+
+	// seed groups in spatial order so that leftover clusters are spatially close to the groups that are formed last
+	float* centers = allocator.allocate<float>(active_count * 3);
+	unsigned int* remap = allocator.allocate<unsigned int>(active_count);
+	unsigned int* order = allocator.allocate<unsigned int>(active_count);
+
+	for (size_t i = 0; i < active_count; ++i)
+		memcpy(&centers[i * 3], clusters[active[i]].self_center, 3 * sizeof(float));
+
+	meshopt_spatialSortRemap(remap, centers, active_count, sizeof(float) * 3);
+
+	for (size_t i = 0; i < active_count; ++i)
+		order[remap[i]] = unsigned(i);
+
+	// grow each group greedily by adding the neighbor that shares the most positions with the group
+	unsigned char* grouped = allocator.allocate<unsigned char>(active_count);
+	unsigned int* candidates = allocator.allocate<unsigned int>(active_count);
+
+	memset(grouped, 0, active_count);
+	memset(stamp, -1, active_count * sizeof(unsigned int));
+
+	size_t group_count = 0;
+	size_t write = 0;
+
+	for (size_t i = 0; i < active_count; ++i)
+	{
+		unsigned int next = order[i];
+
+		if (grouped[next])
+			continue;
+
+		group_offsets[group_count] = unsigned(write);
+
+		size_t candidate_count = 0;
+
+		for (size_t size = 0; size < group_size && next != ~0u; ++size)
+		{
+			grouped[next] = 1;
+			group_clusters[write++] = active[next];
+
+			for (unsigned int j = adjacency_offsets[next]; j < adjacency_offsets[next + 1]; ++j)
+			{
+				unsigned int other = adjacency[j];
+
+				if (grouped[other])
+					continue;
+
+				if (stamp[other] != group_count)
+				{
+					stamp[other] = unsigned(group_count);
+					weights[other] = 0;
+					candidates[candidate_count++] = other;
+				}
+
+				weights[other] += adjacency_weights[j];
+			}
+
+			next = ~0u;
+
+			for (size_t j = 0; j < candidate_count; ++j)
+			{
+				unsigned int other = candidates[j];
+
+				if (!grouped[other] && (next == ~0u || weights[other] > weights[next]))
+					next = other;
+			}
+		}
+
+		group_count++;
+	}
+
+	assert(write == active_count);
+	group_offsets[group_count] = unsigned(write);
+
+	return group_count;
+}
+
+struct ClusterLodGroups
+{
+	const meshopt_ClusterLod* clusters;
+	const unsigned int* cluster_vertices;
+	const unsigned char* cluster_triangles;
+
+	const float* vertex_positions;
+	size_t vertex_positions_stride;
+
+	const unsigned int* group_offsets;
+	const unsigned int* group_clusters;
+	const size_t* triangle_offsets;
+	const size_t* meshlet_offsets;
+
+	unsigned int* indices;
+	unsigned int* vertices;
+	float* positions;
+
+	meshopt_Meshlet* meshlets;
+	unsigned int* meshlet_vertices;
+	unsigned char* meshlet_triangles;
+	size_t* meshlet_counts;
+	float* errors;
+
+	size_t max_vertices;
+	size_t max_triangles;
+};
+
+static void simplifyClusterGroup(void* data, size_t index)
+{
+	const ClusterLodGroups& job = *static_cast<const ClusterLodGroups*>(data);
+
+	job.meshlet_counts[index] = 0;
+	job.errors[index] = 0.f;
+
+	// groups with a single cluster can't reduce the number of clusters
+	if (job.group_offsets[index + 1] - job.group_offsets[index] < 2)
+		return;
+
+	size_t triangle_offset = job.triangle_offsets[index];
+	size_t triangle_count = job.triangle_offsets[index + 1] - triangle_offset;
+
+	unsigned int* indices = job.indices + triangle_offset * 3;
+	unsigned int* vertices = job.vertices + triangle_offset * 3;
+	float* positions = job.positions + triangle_offset * 9;
+
+	meshopt_Allocator allocator;
+
+	// gather group triangles with local vertex indices so that the simplifier and clusterizer only process data for this group
+	size_t hashsize = 1;
+	while (hashsize < triangle_count * 3 * 2)
+		hashsize *= 2;
+
+	unsigned int* table = allocator.allocate<unsigned int>(hashsize);
+	memset(table, -1, hashsize * sizeof(unsigned int));
+
+	size_t vertex_count = 0;
+	size_t index_count = 0;
+
+	for (unsigned int i = job.group_offsets[index]; i < job.group_offsets[index + 1]; ++i)
+	{
+		const meshopt_ClusterLod& cluster = job.clusters[job.group_clusters[i]];
+
+		for (size_t j = 0; j < cluster.triangle_count * 3; ++j)
+		{
+			unsigned int v = job.cluster_vertices[cluster.vertex_offset + job.cluster_triangles[cluster.triangle_offset + j]];
+			unsigned int bucket = (v * 0x5bd1e995) & unsigned(hashsize - 1);
+
+			for (size_t probe = 0; table[bucket] != ~0u && vertices[table[bucket]] != v; ++probe)
+				bucket = (bucket + unsigned(probe) + 1) & unsigned(hashsize - 1);
+
+			if (table[bucket] == ~0u)
+			{
+				table[bucket] = unsigned(vertex_count);
+				vertices[vertex_count++] = v;
+			}
+
+			indices[index_count++] = table[bucket];
+		}
+	}
+
+	assert(index_count == triangle_count * 3);
+
+	size_t vertex_stride_float = job.vertex_positions_stride / sizeof(float);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		memcpy(&positions[i * 3], &job.vertex_positions[vertices[i] * vertex_stride_float], sizeof(float) * 3);
+
+	// group borders are shared with other groups and must be preserved to keep the hierarchy free of cracks
+	size_t target_index_count = (triangle_count / 2) * 3;
+	float error = 0.f;
+
+	size_t simplified = meshopt_simplify(indices, indices, index_count, positions, vertex_count, sizeof(float) * 3, target_index_count, FLT_MAX, meshopt_SimplifyLockBorder | meshopt_SimplifyErrorAbsolute, &error);
+
+	if (simplified == index_count)
+		return;
+
+	size_t meshlet_offset = job.meshlet_offsets[index];
+
+	meshopt_Meshlet* meshlets = job.meshlets + meshlet_offset;
+	unsigned int* meshlet_vertices = job.meshlet_vertices + meshlet_offset * job.max_vertices;
+	unsigned char* meshlet_triangles = job.meshlet_triangles + meshlet_offset * job.max_triangles * 3;
+
+	size_t meshlet_count = meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, indices, simplified, positions, vertex_count, sizeof(float) * 3, job.max_vertices, job.max_triangles, 0.f);
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+		for (size_t j = 0; j < meshlets[i].vertex_count; ++j)
+			meshlet_vertices[meshlets[i].vertex_offset + j] = vertices[meshlet_vertices[meshlets[i].vertex_offset + j]];
+
+	job.meshlet_counts[index] = meshlet_count;
+	job.errors[index] = error;
+}
+
+} // namespace meshopt
+
+size_t meshopt_buildClusterLodBound(size_t index_count, size_t max_vertices, size_t max_triangles)
+{
+	// every level that is added reduces the number of clusters it replaces by at least 25%
+	return meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles) * 4;
+}
+
+size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, size_t group_size, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= kMeshletMaxVertices);
+	assert(max_triangles >= 1 && max_triangles <= kMeshletMaxTriangles);
+	assert(max_triangles % 4 == 0); // ensures the caller will compute output space properly as index data is 4b aligned
+
+	assert(group_size >= 2);
+
+	meshopt_Allocator allocator;
+
+	size_t max_clusters = meshopt_buildClusterLodBound(index_count, max_vertices, max_triangles);
+
+	// build the initial clusters from the source mesh directly into the output
+	size_t cluster_count = 0;
+	size_t vertex_offset = 0;
+	size_t triangle_offset = 0;
+
+	{
+		size_t max_meshlets = meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles);
+		meshopt_Meshlet* meshlets = allocator.allocate<meshopt_Meshlet>(max_meshlets);
+
+		cluster_count = meshopt_buildMeshletsParallel(meshlets, cluster_vertices, cluster_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, 0.f, kClusterLodPartitions, scheduler, scheduler_context);
+
+		for (size_t i = 0; i < cluster_count; ++i)
+		{
+			const meshopt_Meshlet& m = meshlets[i];
+			meshopt_Bounds bounds = meshopt_computeMeshletBounds(&cluster_vertices[m.vertex_offset], &cluster_triangles[m.triangle_offset], m.triangle_count, vertex_positions, vertex_count, vertex_positions_stride);
+
+			meshopt_ClusterLod& cluster = clusters[i];
+
+			cluster.vertex_offset = m.vertex_offset;
+			cluster.triangle_offset = m.triangle_offset;
+			cluster.vertex_count = m.vertex_count;
+			cluster.triangle_count = m.triangle_count;
+			cluster.level = 0;
+
+			memcpy(cluster.self_center, bounds.center, 3 * sizeof(float));
+			cluster.self_radius = bounds.radius;
+			cluster.self_error = 0.f;
+
+			memcpy(cluster.parent_center, bounds.center, 3 * sizeof(float));
+			cluster.parent_radius = bounds.radius;
+			cluster.parent_error = FLT_MAX;
+
+			vertex_offset = m.vertex_offset + m.vertex_count;
+			triangle_offset = m.triangle_offset + ((m.triangle_count * 3 + 3) & ~3);
+		}
+
+		allocator.deallocate(meshlets);
+	}
+
+	// clusters are adjacent if they share positions, even if vertices differ in other attributes; unused vertices aren't remapped but they aren't referenced by clusters either
+	unsigned int* position_remap = allocator.allocate<unsigned int>(vertex_count);
+
+	meshopt_Stream position_stream = {vertex_positions, sizeof(float) * 3, vertex_positions_stride};
+	size_t position_count = meshopt_generateVertexRemapMulti(position_remap, indices, index_count, vertex_count, &position_stream, 1);
+
+	// clusters that haven't been simplified further; the number of active clusters never grows
+	unsigned int* active = allocator.allocate<unsigned int>(cluster_count);
+	unsigned int* group_offsets = allocator.allocate<unsigned int>(cluster_count + 1);
+	unsigned int* group_clusters = allocator.allocate<unsigned int>(cluster_count);
+	size_t active_count = cluster_count;
+
+	for (size_t i = 0; i < cluster_count; ++i)
+		active[i] = unsigned(i);
+
+	for (unsigned int level = 1; active_count > 1; ++level)
+	{
+		meshopt_Allocator level_allocator;
+
+		size_t group_count = groupClusters(group_offsets, group_clusters, clusters, cluster_vertices, active, active_count, position_remap, position_count, group_size);
+
+		// compute scratch space for each group; simplified groups never have more triangles than the source
+		size_t* triangle_offsets = level_allocator.allocate<size_t>(group_count + 1);
+		size_t* meshlet_offsets = level_allocator.allocate<size_t>(group_count + 1);
+
+		triangle_offsets[0] = 0;
+		meshlet_offsets[0] = 0;
+
+		for (size_t i = 0; i < group_count; ++i)
+		{
+			size_t triangle_count = 0;
+
+			for (unsigned int j = group_offsets[i]; j < group_offsets[i + 1]; ++j)
+				triangle_count += clusters[group_clusters[j]].triangle_count;
+
+			triangle_offsets[i + 1] = triangle_offsets[i] + triangle_count;
+			meshlet_offsets[i + 1] = meshlet_offsets[i] + meshopt_buildMeshletsBound(triangle_count * 3, max_vertices, max_triangles);
+		}
+
+		size_t total_triangles = triangle_offsets[group_count];
+		size_t total_meshlets = meshlet_offsets[group_count];
+
+		ClusterLodGroups job = {};
+		job.clusters = clusters;
+		job.cluster_vertices = cluster_vertices;
+		job.cluster_triangles = cluster_triangles;
+		job.vertex_positions = vertex_positions;
+		job.vertex_positions_stride = vertex_positions_stride;
+		job.group_offsets = group_offsets;
+		job.group_clusters = group_clusters;
+		job.triangle_offsets = triangle_offsets;
+		job.meshlet_offsets = meshlet_offsets;
+		job.indices = level_allocator.allocate<unsigned int>(total_triangles * 3);
+		job.vertices = level_allocator.allocate<unsigned int>(total_triangles * 3);
+		job.positions = level_allocator.allocate<float>(total_triangles * 9);
+		job.meshlets = level_allocator.allocate<meshopt_Meshlet>(total_meshlets);
+		job.meshlet_vertices = level_allocator.allocate<unsigned int>(total_meshlets * max_vertices);
+		job.meshlet_triangles = level_allocator.allocate<unsigned char>(total_meshlets * max_triangles * 3);
+		job.meshlet_counts = level_allocator.allocate<size_t>(group_count);
+		job.errors = level_allocator.allocate<float>(group_count);
+		job.max_vertices = max_vertices;
+		job.max_triangles = max_triangles;
+
+		if (scheduler)
+			scheduler(scheduler_context, simplifyClusterGroup, &job, group_count);
+		else
+			for (size_t i = 0; i < group_count; ++i)
+				simplifyClusterGroup(&job, i);
+
+		// accept groups that reduce the number of clusters sufficiently; clusters from other groups stay active for the next level
+		// the next active list is written over group_clusters in place, which is safe since accepted groups produce fewer clusters than they consume
+		size_t next_count = 0;
+
+		for (size_t i = 0; i < group_count; ++i)
+		{
+			size_t group_begin = group_offsets[i], group_end = group_offsets[i + 1];
+			size_t meshlet_count = job.meshlet_counts[i];
+
+			if (meshlet_count == 0 || meshlet_count * 4 > (group_end - group_begin) * 3)
+			{
+				for (size_t j = group_begin; j < group_end; ++j)
+					group_clusters[next_count++] = group_clusters[j];
+
+				continue;
+			}
+
+			// group bounds contain bounds of all source clusters and group error includes their error, which keeps LOD selection monotonic
+			float center[3];
+			float radius = clusters[group_clusters[group_begin]].self_radius;
+			float error = 0.f;
+
+			memcpy(center, clusters[group_clusters[group_begin]].self_center, 3 * sizeof(float));
+
+			for (size_t j = group_begin; j < group_end; ++j)
+			{
+				const meshopt_ClusterLod& cluster = clusters[group_clusters[j]];
+
+				mergeSphere(center, radius, cluster.self_center, cluster.self_radius);
+				error = cluster.self_error > error ? cluster.self_error : error;
+			}
+
+			error += job.errors[i];
+
+			for (size_t j = group_begin; j < group_end; ++j)
+			{
+				meshopt_ClusterLod& cluster = clusters[group_clusters[j]];
+
+				memcpy(cluster.parent_center, center, 3 * sizeof(float));
+				cluster.parent_radius = radius;
+				cluster.parent_error = error;
+			}
+
+			assert(cluster_count + meshlet_count <= max_clusters);
+			(void)max_clusters;
+
+			for (size_t j = 0; j < meshlet_count; ++j)
+			{
+				const meshopt_Meshlet& m = job.meshlets[job.meshlet_offsets[i] + j];
+				size_t triangle_size = (m.triangle_count * 3 + 3) & ~3;
+
+				memcpy(&cluster_vertices[vertex_offset], &job.meshlet_vertices[job.meshlet_offsets[i] * max_vertices + m.vertex_offset], m.vertex_count * sizeof(unsigned int));
+				memcpy(&cluster_triangles[triangle_offset], &job.meshlet_triangles[job.meshlet_offsets[i] * max_triangles * 3 + m.triangle_offset], triangle_size);
+
+				meshopt_ClusterLod& cluster = clusters[cluster_count];
+
+				cluster.vertex_offset = unsigned(vertex_offset);
+				cluster.triangle_offset = unsigned(triangle_offset);
+				cluster.vertex_count = m.vertex_count;
+				cluster.triangle_count = m.triangle_count;
+				cluster.level = level;
+
+				memcpy(cluster.self_center, center, 3 * sizeof(float));
+				cluster.self_radius = radius;
+				cluster.self_error = error;
+
+				memcpy(cluster.parent_center, center, 3 * sizeof(float));
+				cluster.parent_radius = radius;
+				cluster.parent_error = FLT_MAX;
+
+				group_clusters[next_count++] = unsigned(cluster_count);
+				cluster_count++;
+
+				vertex_offset += m.vertex_count;
+				triangle_offset += triangle_size;
+			}
+		}
+
+		// no group could be simplified, so the remaining clusters are the roots of the hierarchy
+		if (next_count == active_count)
+			break;
+
+		memcpy(active, group_clusters, next_count * sizeof(unsigned int));
+		active_count = next_count;
+	}
+
+	return cluster_count;
+}
+
+#undef SIMD_SSE
+#undef SIMD_NEON
+#undef SIMD_WASM
@@ -143,20 +143,12 @@ static int getCodeAuxIndex(unsigned char v, const unsigned char* table)
 	return -1;
 }
 
-static void writeTriangle(void* destination, size_t offset, size_t index_size, unsigned int a, unsigned int b, unsigned int c)
+template <typename T>
+static void writeTriangle(T* destination, size_t offset, unsigned int base_vertex, unsigned int a, unsigned int b, unsigned int c)
 {
-	if (index_size == 2)
-	{
-		static_cast<unsigned short*>(destination)[offset + 0] = (unsigned short)(a);
-		static_cast<unsigned short*>(destination)[offset + 1] = (unsigned short)(b);
-		static_cast<unsigned short*>(destination)[offset + 2] = (unsigned short)(c);
-	}
-	else
-	{
-		static_cast<unsigned int*>(destination)[offset + 0] = a;
-		static_cast<unsigned int*>(destination)[offset + 1] = b;
-		static_cast<unsigned int*>(destination)[offset + 2] = c;
-	}
+	destination[offset + 0] = T(a + base_vertex);
+	destination[offset + 1] = T(b + base_vertex);
+	destination[offset + 2] = T(c + base_vertex);
 }
 
 } // namespace meshopt
@@ -359,24 +351,13 @@ void meshopt_encodeIndexVersion(int version)
 	meshopt::gEncodeIndexVersion = version;
 }
 
-int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size)
+namespace meshopt
 {
-	using namespace meshopt;
-
-	assert(index_count % 3 == 0);
-	assert(index_size == 2 || index_size == 4);
-
-	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
-	if (buffer_size < 1 + index_count / 3 + 16)
-		return -2;
-
-	if ((buffer[0] & 0xf0) != kIndexHeader)
-		return -1;
-
-	int version = buffer[0] & 0x0f;
-	if (version > 1)
-		return -1;
 
+// the decoder is specialized for each index size to avoid branching on the index size for every triangle
+template <typename T>
+static int decodeIndexBuffer(T* destination, size_t index_count, unsigned int base_vertex, int version, const unsigned char* buffer, size_t buffer_size)
+{
 	EdgeFifo edgefifo;
 	memset(edgefifo, -1, sizeof(edgefifo));
 
@@ -430,7 +411,7 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 				next += fec0;
 
 				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
+				writeTriangle(destination, i, base_vertex, a, b, c);
 
 				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
 				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
@@ -447,7 +428,7 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 				last = c = (fec != 15) ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
 
 				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
+				writeTriangle(destination, i, base_vertex, a, b, c);
 
 				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
 				pushVertexFifo(vertexfifo, c, vertexfifooffset);
@@ -484,7 +465,7 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 				next += fec0;
 
 				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
+				writeTriangle(destination, i, base_vertex, a, b, c);
 
 				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
 				pushVertexFifo(vertexfifo, a, vertexfifooffset);
@@ -525,7 +506,7 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 					last = c = decodeIndex(data, last);
 
 				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
+				writeTriangle(destination, i, base_vertex, a, b, c);
 
 				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
 				pushVertexFifo(vertexfifo, a, vertexfifooffset);
@@ -546,6 +527,37 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 	return 0;
 }
 
+} // namespace meshopt
+
+int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt_decodeIndexBufferOffset(destination, index_count, index_size, 0, buffer, buffer_size);
+}
+
+int meshopt_decodeIndexBufferOffset(void* destination, size_t index_count, size_t index_size, unsigned int base_vertex, const unsigned char* buffer, size_t buffer_size)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(index_size == 2 || index_size == 4);
+
+	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
+	if (buffer_size < 1 + index_count / 3 + 16)
+		return -2;
+
+	if ((buffer[0] & 0xf0) != kIndexHeader)
+		return -1;
+
+	int version = buffer[0] & 0x0f;
+	if (version > 1)
+		return -1;
+
+	if (index_size == 2)
+		return decodeIndexBuffer(static_cast<unsigned short*>(destination), index_count, base_vertex, version, buffer, buffer_size);
+	else
+		return decodeIndexBuffer(static_cast<unsigned int*>(destination), index_count, base_vertex, version, buffer, buffer_size);
+}
+
 size_t meshopt_encodeIndexSequence(unsigned char* buffer, size_t buffer_size, const unsigned int* indices, size_t index_count)
 {
 	using namespace meshopt;
@@ -616,6 +628,11 @@ size_t meshopt_encodeIndexSequenceBound(size_t index_count, size_t vertex_count)
 }
 
 int meshopt_decodeIndexSequence(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt_decodeIndexSequenceOffset(destination, index_count, index_size, 0, buffer, buffer_size);
+}
+
+int meshopt_decodeIndexSequenceOffset(void* destination, size_t index_count, size_t index_size, unsigned int base_vertex, const unsigned char* buffer, size_t buffer_size)
 {
 	using namespace meshopt;
 
@@ -656,6 +673,80 @@ int meshopt_decodeIndexSequence(void* destination, size_t index_count, size_t in
 		// update last for the next iteration that uses it
 		last[current] = index;
 
+		if (index_size == 2)
+		{
+			static_cast<unsigned short*>(destination)[i] = (unsigned short)(index + base_vertex);
+		}
+		else
+		{
+			static_cast<unsigned int*>(destination)[i] = index + base_vertex;
+		}
+	}
+
+	// we should've read all data bytes and stopped at the boundary between data and tail
+	if (data != data_safe_end)
+		return -3;
+
+	return 0;
+}
+
+void meshopt_initIndexSequenceDecoder(meshopt_IndexSequenceDecoder* decoder, size_t index_count, size_t index_size)
+{
+	assert(index_size == 2 || index_size == 4);
+
+	decoder->index_count = index_count;
+	decoder->index_size = index_size;
+	decoder->index_offset = 0;
+	decoder->header = 0;
+	decoder->last[0] = 0;
+	decoder->last[1] = 0;
+}
+
+int meshopt_decodeIndexSequencePartial(meshopt_IndexSequenceDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size, size_t* consumed)
+{
+	using namespace meshopt;
+
+	size_t index_count = decoder->index_count;
+	size_t index_size = decoder->index_size;
+
+	const unsigned char* data = buffer;
+	const unsigned char* data_end = buffer + buffer_size;
+
+	*consumed = 0;
+
+	if (!decoder->header)
+	{
+		if (buffer_size == 0)
+			return 0;
+
+		if ((buffer[0] & 0xf0) != kSequenceHeader)
+			return -1;
+
+		int version = buffer[0] & 0x0f;
+		if (version > 1)
+			return -1;
+
+		decoder->header = 1;
+		data++;
+	}
+
+	unsigned int last[2] = {decoder->last[0], decoder->last[1]};
+
+	size_t i = decoder->index_offset;
+
+	// each index reads at most 5 bytes of data; since the stream ends with a 4 byte tail, the last index always has enough data available
+	for (; i < index_count && data_end - data >= 5; ++i)
+	{
+		unsigned int v = decodeVByte(data);
+
+		unsigned int current = v & 1;
+		v >>= 1;
+
+		unsigned int d = (v >> 1) ^ -int(v & 1);
+		unsigned int index = last[current] + d;
+
+		last[current] = index;
+
 		if (index_size == 2)
 		{
 			static_cast<unsigned short*>(destination)[i] = (unsigned short)(index);
@@ -666,9 +757,25 @@ int meshopt_decodeIndexSequence(void* destination, size_t index_count, size_t in
 		}
 	}
 
+	decoder->index_offset = i;
+	decoder->last[0] = last[0];
+	decoder->last[1] = last[1];
+
+	*consumed = data - buffer;
+
+	return 0;
+}
+
+int meshopt_finishIndexSequenceDecoder(meshopt_IndexSequenceDecoder* decoder, const unsigned char* buffer, size_t buffer_size)
+{
+	if (!decoder->header || decoder->index_offset < decoder->index_count)
+		return -2;
+
 	// we should've read all data bytes and stopped at the boundary between data and tail
-	if (data != data_safe_end)
+	if (buffer_size != 4)
 		return -3;
 
+	(void)buffer;
+
 	return 0;
 }
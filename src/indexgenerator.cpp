@@ -196,9 +196,300 @@ static void remapVertices(void* destination, const void* vertices, size_t vertex
 		}
 }
 
+const size_t kVertexRemapChunkSize = 65536;
+const int kVertexRemapShardBits = 8;
+
+template <typename Hash>
+struct VertexRemapShards
+{
+	const Hash* hasher;
+
+	const unsigned int* indices;
+	size_t index_count;
+	size_t vertex_count;
+
+	unsigned int* destination;
+
+	// first occurrence of each vertex in the index stream; after deduplication, first occurrence of each class for class representatives
+	unsigned int* first;
+
+	// vertex hashes; after deduplication, reused to store class indices for class representatives
+	unsigned int* hashes;
+	unsigned int* canonical;
+
+	unsigned int* order;
+	unsigned int* shard_counts;
+	unsigned int* shard_offsets;
+	unsigned int* index_counts;
+};
+
+template <typename Hash>
+struct VertexCachedHasher
+{
+	const Hash* hasher;
+	const unsigned int* hashes;
+
+	size_t hash(unsigned int index) const
+	{
+		return hashes[index];
+	}
+
+	bool equal(unsigned int lhs, unsigned int rhs) const
+	{
+		return hashes[lhs] == hashes[rhs] && hasher->equal(lhs, rhs);
+	}
+};
+
+template <typename Hash>
+static void hashVertexChunk(void* data, size_t chunk)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = chunk * kVertexRemapChunkSize;
+	size_t end = begin + kVertexRemapChunkSize < job.vertex_count ? begin + kVertexRemapChunkSize : job.vertex_count;
+
+	unsigned int* counts = job.shard_counts + (chunk << kVertexRemapShardBits);
+
+	for (size_t i = begin; i < end; ++i)
+		if (job.first[i] != ~0u)
+		{
+			unsigned int h = unsigned(job.hasher->hash(unsigned(i)));
+
+			job.hashes[i] = h;
+			counts[h >> (32 - kVertexRemapShardBits)]++;
+		}
+}
+
+template <typename Hash>
+static void scatterVertexChunk(void* data, size_t chunk)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = chunk * kVertexRemapChunkSize;
+	size_t end = begin + kVertexRemapChunkSize < job.vertex_count ? begin + kVertexRemapChunkSize : job.vertex_count;
+
+	// shard_counts contain the output offset of each shard for the chunk at this point
+	unsigned int* offsets = job.shard_counts + (chunk << kVertexRemapShardBits);
+
+	for (size_t i = begin; i < end; ++i)
+		if (job.first[i] != ~0u)
+			job.order[offsets[job.hashes[i] >> (32 - kVertexRemapShardBits)]++] = unsigned(i);
+}
+
+template <typename Hash>
+static void deduplicateVertexShard(void* data, size_t shard)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = job.shard_offsets[shard];
+	size_t end = job.shard_offsets[shard + 1];
+
+	if (begin == end)
+		return;
+
+	meshopt_Allocator allocator;
+
+	VertexCachedHasher<Hash> hasher = {job.hasher, job.hashes};
+
+	size_t table_size = hashBuckets(end - begin);
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	// vertices in each shard are sorted by index, so the representative of each class is its lowest vertex
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int index = job.order[i];
+		unsigned int* entry = hashLookup(table, table_size, hasher, index, ~0u);
+
+		if (*entry == ~0u)
+		{
+			*entry = index;
+			job.canonical[index] = index;
+		}
+		else
+		{
+			unsigned int rep = *entry;
+
+			job.canonical[index] = rep;
+			job.first[rep] = job.first[index] < job.first[rep] ? job.first[index] : job.first[rep];
+		}
+	}
+}
+
+template <typename Hash>
+static void countClassChunk(void* data, size_t chunk)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = chunk * kVertexRemapChunkSize;
+	size_t end = begin + kVertexRemapChunkSize < job.index_count ? begin + kVertexRemapChunkSize : job.index_count;
+
+	unsigned int count = 0;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int index = job.indices ? job.indices[i] : unsigned(i);
+
+		count += job.first[job.canonical[index]] == i;
+	}
+
+	job.index_counts[chunk] = count;
+}
+
+template <typename Hash>
+static void assignClassChunk(void* data, size_t chunk)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = chunk * kVertexRemapChunkSize;
+	size_t end = begin + kVertexRemapChunkSize < job.index_count ? begin + kVertexRemapChunkSize : job.index_count;
+
+	// index_counts contain the first class index for the chunk at this point
+	unsigned int next = job.index_counts[chunk];
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int index = job.indices ? job.indices[i] : unsigned(i);
+		unsigned int rep = job.canonical[index];
+
+		if (job.first[rep] == i)
+			job.hashes[rep] = next++;
+	}
+}
+
+template <typename Hash>
+static void remapVertexChunk(void* data, size_t chunk)
+{
+	const VertexRemapShards<Hash>& job = *static_cast<const VertexRemapShards<Hash>*>(data);
+
+	size_t begin = chunk * kVertexRemapChunkSize;
+	size_t end = begin + kVertexRemapChunkSize < job.vertex_count ? begin + kVertexRemapChunkSize : job.vertex_count;
+
+	for (size_t i = begin; i < end; ++i)
+		job.destination[i] = job.first[i] == ~0u ? ~0u : job.hashes[job.canonical[i]];
+}
+
+template <typename Hash>
+static size_t generateVertexRemapShards(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const Hash& hasher, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_Allocator allocator;
+
+	size_t chunk_count = (vertex_count + kVertexRemapChunkSize - 1) / kVertexRemapChunkSize;
+	size_t index_chunk_count = (index_count + kVertexRemapChunkSize - 1) / kVertexRemapChunkSize;
+	size_t shard_count = size_t(1) << kVertexRemapShardBits;
+
+	VertexRemapShards<Hash> job = {};
+	job.hasher = &hasher;
+	job.indices = indices;
+	job.index_count = index_count;
+	job.vertex_count = vertex_count;
+	job.destination = destination;
+	job.first = allocator.allocate<unsigned int>(vertex_count);
+	job.hashes = allocator.allocate<unsigned int>(vertex_count);
+	job.canonical = allocator.allocate<unsigned int>(vertex_count);
+	job.order = allocator.allocate<unsigned int>(vertex_count);
+	job.shard_counts = allocator.allocate<unsigned int>(chunk_count * shard_count);
+	job.shard_offsets = allocator.allocate<unsigned int>(shard_count + 1);
+	job.index_counts = allocator.allocate<unsigned int>(index_chunk_count);
+
+	// first occurrence order determines the output order, which makes the result identical to the serial version
+	if (indices)
+	{
+		memset(job.first, -1, vertex_count * sizeof(unsigned int));
+
+		for (size_t i = index_count; i > 0; --i)
+		{
+			assert(indices[i - 1] < vertex_count);
+			job.first[indices[i - 1]] = unsigned(i - 1);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < vertex_count; ++i)
+			job.first[i] = unsigned(i);
+	}
+
+	// hash vertices and distribute them into shards based on hash prefix, keeping the vertex order within each shard
+	memset(job.shard_counts, 0, chunk_count * shard_count * sizeof(unsigned int));
+
+	if (scheduler)
+		scheduler(scheduler_context, hashVertexChunk<Hash>, &job, chunk_count);
+	else
+		for (size_t i = 0; i < chunk_count; ++i)
+			hashVertexChunk<Hash>(&job, i);
+
+	unsigned int offset = 0;
+
+	for (size_t shard = 0; shard < shard_count; ++shard)
+	{
+		job.shard_offsets[shard] = offset;
+
+		for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+		{
+			unsigned int count = job.shard_counts[(chunk << kVertexRemapShardBits) + shard];
+
+			job.shard_counts[(chunk << kVertexRemapShardBits) + shard] = offset;
+			offset += count;
+		}
+	}
+
+	job.shard_offsets[shard_count] = offset;
+
+	if (scheduler)
+		scheduler(scheduler_context, scatterVertexChunk<Hash>, &job, chunk_count);
+	else
+		for (size_t i = 0; i < chunk_count; ++i)
+			scatterVertexChunk<Hash>(&job, i);
+
+	// deduplicate each shard; equal vertices have equal hashes and always end up in the same shard
+	if (scheduler)
+		scheduler(scheduler_context, deduplicateVertexShard<Hash>, &job, shard_count);
+	else
+		for (size_t i = 0; i < shard_count; ++i)
+			deduplicateVertexShard<Hash>(&job, i);
+
+	// assign class indices in the order of first occurrence using a prefix sum over index chunks
+	if (scheduler)
+		scheduler(scheduler_context, countClassChunk<Hash>, &job, index_chunk_count);
+	else
+		for (size_t i = 0; i < index_chunk_count; ++i)
+			countClassChunk<Hash>(&job, i);
+
+	unsigned int next_vertex = 0;
+
+	for (size_t chunk = 0; chunk < index_chunk_count; ++chunk)
+	{
+		unsigned int count = job.index_counts[chunk];
+
+		job.index_counts[chunk] = next_vertex;
+		next_vertex += count;
+	}
+
+	if (scheduler)
+		scheduler(scheduler_context, assignClassChunk<Hash>, &job, index_chunk_count);
+	else
+		for (size_t i = 0; i < index_chunk_count; ++i)
+			assignClassChunk<Hash>(&job, i);
+
+	if (scheduler)
+		scheduler(scheduler_context, remapVertexChunk<Hash>, &job, chunk_count);
+	else
+		for (size_t i = 0; i < chunk_count; ++i)
+			remapVertexChunk<Hash>(&job, i);
+
+	assert(next_vertex <= vertex_count);
+
+	return next_vertex;
+}
+
 } // namespace meshopt
 
 size_t meshopt_generateVertexRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	return meshopt_generateVertexRemapWithContext(NULL, destination, indices, index_count, vertices, vertex_count, vertex_size);
+}
+
+size_t meshopt_generateVertexRemapWithContext(meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
 {
 	using namespace meshopt;
 
@@ -206,7 +497,7 @@ size_t meshopt_generateVertexRemap(unsigned int* destination, const unsigned int
 	assert(!indices || index_count % 3 == 0);
 	assert(vertex_size > 0 && vertex_size <= 256);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	memset(destination, -1, vertex_count * sizeof(unsigned int));
 
@@ -302,6 +593,113 @@ size_t meshopt_generateVertexRemapMulti(unsigned int* destination, const unsigne
 	return next_vertex;
 }
 
+size_t meshopt_reindexMesh(unsigned int* destination, void* const* vertex_destinations, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count)
+{
+	using namespace meshopt;
+
+	assert(indices || index_count == vertex_count);
+	assert(index_count % 3 == 0);
+	assert(stream_count > 0 && stream_count <= 16);
+
+	for (size_t i = 0; i < stream_count; ++i)
+	{
+		assert(streams[i].size > 0 && streams[i].size <= 256);
+		assert(streams[i].size <= streams[i].stride);
+		assert(vertex_destinations[i] != streams[i].data);
+	}
+
+	meshopt_Allocator allocator;
+
+	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
+	memset(remap, -1, vertex_count * sizeof(unsigned int));
+
+	VertexStreamHasher hasher = {streams, stream_count};
+
+	size_t table_size = hashBuckets(vertex_count);
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	unsigned int next_vertex = 0;
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int index = indices ? indices[i] : unsigned(i);
+		assert(index < vertex_count);
+
+		if (remap[index] == ~0u)
+		{
+			unsigned int* entry = hashLookup(table, table_size, hasher, index, ~0u);
+
+			if (*entry == ~0u)
+			{
+				*entry = index;
+
+				// new vertices are written to the output streams as soon as they are referenced, which orders them by first use
+				for (size_t k = 0; k < stream_count; ++k)
+				{
+					const meshopt_Stream& s = streams[k];
+
+					memcpy(static_cast<unsigned char*>(vertex_destinations[k]) + next_vertex * s.size, static_cast<const unsigned char*>(s.data) + index * s.stride, s.size);
+				}
+
+				remap[index] = next_vertex++;
+			}
+			else
+			{
+				assert(remap[*entry] != ~0u);
+
+				remap[index] = remap[*entry];
+			}
+		}
+
+		destination[i] = remap[index];
+	}
+
+	assert(next_vertex <= vertex_count);
+
+	return next_vertex;
+}
+
+size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(indices || index_count == vertex_count);
+	assert(!indices || index_count % 3 == 0);
+	assert(vertex_size > 0 && vertex_size <= 256);
+
+	// small meshes don't benefit from sharding
+	if (vertex_count <= kVertexRemapChunkSize)
+		return meshopt_generateVertexRemap(destination, indices, index_count, vertices, vertex_count, vertex_size);
+
+	VertexHasher hasher = {static_cast<const unsigned char*>(vertices), vertex_size, vertex_size};
+
+	return generateVertexRemapShards(destination, indices, index_count, vertex_count, hasher, scheduler, scheduler_context);
+}
+
+size_t meshopt_generateVertexRemapMultiParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(indices || index_count == vertex_count);
+	assert(index_count % 3 == 0);
+	assert(stream_count > 0 && stream_count <= 16);
+
+	for (size_t i = 0; i < stream_count; ++i)
+	{
+		assert(streams[i].size > 0 && streams[i].size <= 256);
+		assert(streams[i].size <= streams[i].stride);
+	}
+
+	// small meshes don't benefit from sharding
+	if (vertex_count <= kVertexRemapChunkSize)
+		return meshopt_generateVertexRemapMulti(destination, indices, index_count, vertex_count, streams, stream_count);
+
+	VertexStreamHasher hasher = {streams, stream_count};
+
+	return generateVertexRemapShards(destination, indices, index_count, vertex_count, hasher, scheduler, scheduler_context);
+}
+
 void meshopt_remapVertexBuffer(void* destination, const void* vertices, size_t vertex_count, size_t vertex_size, const unsigned int* remap)
 {
 	using namespace meshopt;
@@ -0,0 +1,125 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#pragma once
+
+#include "meshoptimizer.h"
+
+#include <assert.h>
+
+// Internal helpers shared between library source files; this header is not part of the public interface
+namespace meshopt
+{
+
+/**
+ * Sorts triangles spatially and splits them into partitions given by triangle ranges [triangle_offsets[i], triangle_offsets[i + 1])
+ * Each partition is converted to local vertex indices that refer to local_vertices[vertex_offsets[i] + index]; this keeps per-vertex data in partitions proportional to partition size
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements); in-place operation is supported
+ * local_vertices must contain enough space for index_count elements, and vertex_offsets must contain enough space for partition_count + 1 elements
+ * Returns the total number of local vertices
+ */
+size_t partitionTriangles(unsigned int* destination, unsigned int* local_vertices, size_t* vertex_offsets, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* triangle_offsets, size_t partition_count);
+
+/**
+ * FIFO vertex transform cache model used by meshopt_analyzeVertexCache and meshopt_analyzeMesh
+ * timestamps must contain vertex_count zero-initialized elements
+ */
+struct VertexCacheSimulator
+{
+	unsigned int* timestamps;
+	unsigned int timestamp;
+	unsigned int warp_offset;
+	unsigned int primgroup_offset;
+
+	unsigned int cache_size;
+	unsigned int warp_size;
+	unsigned int primgroup_size;
+};
+
+inline void initVertexCache(VertexCacheSimulator& cache, unsigned int* timestamps, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size)
+{
+	cache.timestamps = timestamps;
+	cache.timestamp = cache_size + 1;
+	cache.warp_offset = 0;
+	cache.primgroup_offset = 0;
+
+	cache.cache_size = cache_size;
+	cache.warp_size = warp_size;
+	cache.primgroup_size = primgroup_size;
+}
+
+inline void simulateVertexCache(VertexCacheSimulator& cache, meshopt_VertexCacheStatistics& stats, const unsigned int* triangle)
+{
+	unsigned int cache_size = cache.cache_size;
+
+	bool ac = (cache.timestamp - cache.timestamps[triangle[0]]) > cache_size;
+	bool bc = (cache.timestamp - cache.timestamps[triangle[1]]) > cache_size;
+	bool cc = (cache.timestamp - cache.timestamps[triangle[2]]) > cache_size;
+
+	// flush cache if triangle doesn't fit into warp or into the primitive buffer
+	if ((cache.primgroup_size && cache.primgroup_offset == cache.primgroup_size) || (cache.warp_size && cache.warp_offset + ac + bc + cc > cache.warp_size))
+	{
+		stats.warps_executed += cache.warp_offset > 0;
+
+		cache.warp_offset = 0;
+		cache.primgroup_offset = 0;
+
+		// reset cache
+		cache.timestamp += cache_size + 1;
+	}
+
+	// update cache and add vertices to warp
+	for (int j = 0; j < 3; ++j)
+	{
+		unsigned int index = triangle[j];
+
+		if (cache.timestamp - cache.timestamps[index] > cache_size)
+		{
+			cache.timestamps[index] = cache.timestamp++;
+			stats.vertices_transformed++;
+			cache.warp_offset++;
+		}
+	}
+
+	cache.primgroup_offset++;
+}
+
+inline void finishVertexCache(const VertexCacheSimulator& cache, meshopt_VertexCacheStatistics& stats)
+{
+	stats.warps_executed += cache.warp_offset > 0;
+}
+
+/**
+ * Direct mapped vertex fetch cache model used by meshopt_analyzeVertexFetch and meshopt_analyzeMesh
+ * On typical mesh data this is close to 4-way cache, and this model is a gross approximation anyway
+ * lines must contain line_count zero-initialized elements
+ */
+struct VertexFetchSimulator
+{
+	size_t* lines;
+	size_t line_count;
+	size_t line_size;
+};
+
+// returns the number of bytes fetched from memory to read the address range
+inline size_t simulateVertexFetch(VertexFetchSimulator& fetch, size_t start_address, size_t end_address)
+{
+	size_t start_tag = start_address / fetch.line_size;
+	size_t end_tag = (end_address + fetch.line_size - 1) / fetch.line_size;
+
+	assert(start_tag < end_tag);
+
+	size_t result = 0;
+
+	for (size_t tag = start_tag; tag < end_tag; ++tag)
+	{
+		size_t line = tag % fetch.line_count;
+
+		// we store +1 since cache is filled with 0 by default
+		result += (fetch.lines[line] != tag + 1) * fetch.line_size;
+		fetch.lines[line] = tag + 1;
+	}
+
+	return result;
+}
+
+} // namespace meshopt
@@ -0,0 +1,123 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+#include "internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+namespace meshopt
+{
+
+// matches the cache used by meshopt_analyzeVertexFetch
+const size_t kMeshAnalyzerFetchCacheSize = 128 * 1024;
+
+} // namespace meshopt
+
+meshopt_MeshStatistics meshopt_analyzeMesh(const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_VertexCacheProfile* cache_profiles, size_t cache_profile_count, const size_t* stream_sizes, size_t stream_count, const unsigned int* cache_line_sizes, size_t cache_line_count)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(cache_profile_count <= meshopt_MeshStatisticsMaxProfiles);
+	assert(stream_count <= meshopt_MeshStatisticsMaxStreams);
+	assert(cache_line_count <= meshopt_MeshStatisticsMaxLines);
+
+	meshopt_Allocator allocator;
+
+	meshopt_MeshStatistics result = {};
+
+	VertexCacheSimulator caches[meshopt_MeshStatisticsMaxProfiles] = {};
+
+	for (size_t k = 0; k < cache_profile_count; ++k)
+	{
+		const meshopt_VertexCacheProfile& profile = cache_profiles[k];
+		assert(profile.cache_size >= 3);
+		assert(profile.warp_size == 0 || profile.warp_size >= 3);
+
+		unsigned int* timestamps = allocator.allocate<unsigned int>(vertex_count);
+		memset(timestamps, 0, vertex_count * sizeof(unsigned int));
+
+		initVertexCache(caches[k], timestamps, profile.cache_size, profile.warp_size, profile.primgroup_size);
+	}
+
+	// streams are stored in separate buffers that share the fetch cache; each buffer starts at a 256-byte boundary
+	size_t stream_offsets[meshopt_MeshStatisticsMaxStreams] = {};
+	size_t vertex_size = 0;
+	size_t stream_offset = 0;
+
+	for (size_t s = 0; s < stream_count; ++s)
+	{
+		assert(stream_sizes[s] > 0 && stream_sizes[s] <= 256);
+
+		stream_offsets[s] = stream_offset;
+		stream_offset += (vertex_count * stream_sizes[s] + 255) & ~size_t(255);
+		vertex_size += stream_sizes[s];
+	}
+
+	VertexFetchSimulator fetches[meshopt_MeshStatisticsMaxLines] = {};
+
+	for (size_t l = 0; l < cache_line_count; ++l)
+	{
+		assert(cache_line_sizes[l] > 0 && cache_line_sizes[l] <= 256);
+
+		fetches[l].line_size = cache_line_sizes[l];
+		fetches[l].line_count = kMeshAnalyzerFetchCacheSize / cache_line_sizes[l];
+		fetches[l].lines = allocator.allocate<size_t>(fetches[l].line_count);
+		memset(fetches[l].lines, 0, fetches[l].line_count * sizeof(size_t));
+	}
+
+	unsigned char* vertex_visited = allocator.allocate<unsigned char>(vertex_count);
+	memset(vertex_visited, 0, vertex_count);
+
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		assert(indices[i + 0] < vertex_count && indices[i + 1] < vertex_count && indices[i + 2] < vertex_count);
+
+		// simulate all transform cache profiles; this uses the same model as meshopt_analyzeVertexCache
+		for (size_t k = 0; k < cache_profile_count; ++k)
+			simulateVertexCache(caches[k], result.vertex_cache[k], &indices[i]);
+
+		// simulate fetch caches for all line sizes; this uses the same model as meshopt_analyzeVertexFetch
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned int index = indices[i + j];
+
+			vertex_visited[index] = 1;
+
+			for (size_t l = 0; l < cache_line_count; ++l)
+				for (size_t s = 0; s < stream_count; ++s)
+				{
+					size_t start_address = stream_offsets[s] + index * stream_sizes[s];
+
+					result.vertex_fetch[l].bytes_fetched += unsigned(simulateVertexFetch(fetches[l], start_address, start_address + stream_sizes[s]));
+				}
+		}
+	}
+
+	size_t unique_vertex_count = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		unique_vertex_count += vertex_visited[i];
+
+	result.triangles = unsigned(index_count / 3);
+	result.unique_vertices = unsigned(unique_vertex_count);
+
+	for (size_t k = 0; k < cache_profile_count; ++k)
+	{
+		meshopt_VertexCacheStatistics& stats = result.vertex_cache[k];
+
+		finishVertexCache(caches[k], stats);
+
+		stats.acmr = index_count == 0 ? 0 : float(stats.vertices_transformed) / float(index_count / 3);
+		stats.atvr = unique_vertex_count == 0 ? 0 : float(stats.vertices_transformed) / float(unique_vertex_count);
+	}
+
+	for (size_t l = 0; l < cache_line_count; ++l)
+	{
+		meshopt_VertexFetchStatistics& stats = result.vertex_fetch[l];
+
+		stats.overfetch = (unique_vertex_count == 0 || vertex_size == 0) ? 0 : float(stats.bytes_fetched) / float(unique_vertex_count * vertex_size);
+	}
+
+	return result;
+}
@@ -0,0 +1,651 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+
+#include <assert.h>
+#include <string.h>
+
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+// Prevent compiling other variant when wasm simd compilation is active
+#undef SIMD_NEON
+#undef SIMD_SSE
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
+#ifdef SIMD_WASM
+#define wasmx_unpacklo_v8x16(a, b) wasm_i8x16_shuffle(a, b, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23)
+#define wasmx_unpackhi_v8x16(a, b) wasm_i8x16_shuffle(a, b, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31)
+#define wasmx_unpacklo_v16x8(a, b) wasm_i16x8_shuffle(a, b, 0, 8, 1, 9, 2, 10, 3, 11)
+#define wasmx_unpackhi_v16x8(a, b) wasm_i16x8_shuffle(a, b, 4, 12, 5, 13, 6, 14, 7, 15)
+#endif
+
+// This work is based on:
+// Fabian Giesen. Simple lossless index buffer compression & follow-up. 2013
+// Conor Stokes. Vertex Cache Optimised Index Buffer Compression. 2014
+namespace meshopt
+{
+
+const unsigned char kMeshletHeader = 0xc0;
+
+// Local vertex indices are limited to 254 since meshlets can't have more than 255 vertices; 0xff is used as a fifo sentinel
+const size_t kMeshletCodecMaxVertices = 255;
+const size_t kMeshletCodecMaxTriangles = 512;
+
+typedef unsigned char MeshletVertexFifo[16];
+typedef unsigned char MeshletEdgeFifo[16][2];
+
+static const unsigned int kMeshletTriangleOrder[3][3] = {
+    {0, 1, 2},
+    {1, 2, 0},
+    {2, 0, 1},
+};
+
+static int getMeshletEdgeFifo(MeshletEdgeFifo fifo, unsigned char a, unsigned char b, unsigned char c, size_t offset)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		size_t index = (offset - 1 - i) & 15;
+
+		unsigned char e0 = fifo[index][0];
+		unsigned char e1 = fifo[index][1];
+
+		if (e0 == a && e1 == b)
+			return (i << 2) | 0;
+		if (e0 == b && e1 == c)
+			return (i << 2) | 1;
+		if (e0 == c && e1 == a)
+			return (i << 2) | 2;
+	}
+
+	return -1;
+}
+
+static void pushMeshletEdgeFifo(MeshletEdgeFifo fifo, unsigned char a, unsigned char b, size_t& offset)
+{
+	fifo[offset][0] = a;
+	fifo[offset][1] = b;
+	offset = (offset + 1) & 15;
+}
+
+static int getMeshletVertexFifo(MeshletVertexFifo fifo, unsigned char v, size_t offset)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		size_t index = (offset - 1 - i) & 15;
+
+		if (fifo[index] == v)
+			return i;
+	}
+
+	return -1;
+}
+
+static void pushMeshletVertexFifo(MeshletVertexFifo fifo, unsigned char v, size_t& offset, int cond = 1)
+{
+	fifo[offset] = v;
+	offset = (offset + cond) & 15;
+}
+
+static void encodeMeshletVByte(unsigned char*& data, unsigned int v)
+{
+	// encode 32-bit value in up to 5 7-bit groups
+	do
+	{
+		*data++ = (v & 127) | (v > 127 ? 128 : 0);
+		v >>= 7;
+	} while (v);
+}
+
+static bool decodeMeshletVByte(const unsigned char*& data, const unsigned char* data_end, unsigned int& result)
+{
+	result = 0;
+
+	// note that this loop always terminates, which is important for malformed data
+	for (unsigned int shift = 0; shift < 35; shift += 7)
+	{
+		if (data == data_end)
+			return false;
+
+		unsigned char group = *data++;
+		result |= unsigned(group & 127) << shift;
+
+		if (group < 128)
+			return true;
+	}
+
+	return false;
+}
+
+static unsigned char* encodeMeshletTriangles(unsigned char* data, const unsigned char* triangles, size_t triangle_count, size_t vertex_count)
+{
+	MeshletEdgeFifo edgefifo;
+	memset(edgefifo, -1, sizeof(edgefifo));
+
+	MeshletVertexFifo vertexfifo;
+	memset(vertexfifo, -1, sizeof(vertexfifo));
+
+	size_t edgefifooffset = 0;
+	size_t vertexfifooffset = 0;
+
+	unsigned char next = 0;
+
+	// codes for all triangles precede the explicit vertex indices so that the decoder can read them with a single pointer each
+	unsigned char* code = data;
+	data += triangle_count;
+
+	for (size_t i = 0; i < triangle_count * 3; i += 3)
+	{
+		assert(triangles[i + 0] < vertex_count && triangles[i + 1] < vertex_count && triangles[i + 2] < vertex_count);
+		(void)vertex_count;
+
+		int fer = getMeshletEdgeFifo(edgefifo, triangles[i + 0], triangles[i + 1], triangles[i + 2], edgefifooffset);
+
+		if (fer >= 0 && (fer >> 2) < 15)
+		{
+			const unsigned int* order = kMeshletTriangleOrder[fer & 3];
+
+			unsigned char a = triangles[i + order[0]], b = triangles[i + order[1]], c = triangles[i + order[2]];
+
+			// encode edge index and vertex fifo index, next or explicit index
+			int fe = fer >> 2;
+			int fc = getMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			int fec = (fc >= 1 && fc < 15) ? fc : (c == next ? (next++, 0) : 15);
+
+			*code++ = (unsigned char)((fe << 4) | fec);
+
+			if (fec == 15)
+				*data++ = c;
+
+			// we only need to push third vertex since first two are likely already in the vertex fifo
+			if (fec == 0 || fec == 15)
+				pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			// we only need to push two new edges to edge fifo since the third one is already there
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+		else
+		{
+			unsigned char a = triangles[i + 0], b = triangles[i + 1], c = triangles[i + 2];
+
+			// each vertex is either the next unused vertex or an explicit index
+			int fea = (a == next) ? (next++, 1) : 0;
+			int feb = (b == next) ? (next++, 2) : 0;
+			int fec = (c == next) ? (next++, 4) : 0;
+
+			*code++ = (unsigned char)(0xf0 | fea | feb | fec);
+
+			if (!fea)
+				*data++ = a;
+
+			if (!feb)
+				*data++ = b;
+
+			if (!fec)
+				*data++ = c;
+
+			pushMeshletVertexFifo(vertexfifo, a, vertexfifooffset);
+			pushMeshletVertexFifo(vertexfifo, b, vertexfifooffset);
+			pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			// all three edges aren't in the fifo; pushing all of them is important so that we can match them for later triangles
+			pushMeshletEdgeFifo(edgefifo, b, a, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+	}
+
+	return data;
+}
+
+static const unsigned char* decodeMeshletTriangles(unsigned char* triangles, size_t triangle_count, const unsigned char* data, const unsigned char* data_end)
+{
+	MeshletEdgeFifo edgefifo;
+	memset(edgefifo, -1, sizeof(edgefifo));
+
+	MeshletVertexFifo vertexfifo;
+	memset(vertexfifo, -1, sizeof(vertexfifo));
+
+	size_t edgefifooffset = 0;
+	size_t vertexfifooffset = 0;
+
+	unsigned char next = 0;
+
+	const unsigned char* code = data;
+	data += triangle_count;
+
+	for (size_t i = 0; i < triangle_count * 3; i += 3)
+	{
+		unsigned char codetri = *code++;
+
+		if (codetri < 0xf0)
+		{
+			int fe = codetri >> 4;
+
+			// fifo reads are wrapped around 16 entry buffer
+			unsigned char a = edgefifo[(edgefifooffset - 1 - fe) & 15][0];
+			unsigned char b = edgefifo[(edgefifooffset - 1 - fe) & 15][1];
+			unsigned char c = 0;
+
+			int fec = codetri & 15;
+
+			if (fec == 0)
+			{
+				c = next++;
+			}
+			else if (fec < 15)
+			{
+				c = vertexfifo[(vertexfifooffset - 1 - fec) & 15];
+			}
+			else
+			{
+				if (data == data_end)
+					return NULL;
+
+				c = *data++;
+			}
+
+			triangles[i + 0] = a;
+			triangles[i + 1] = b;
+			triangles[i + 2] = c;
+
+			// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+			pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+		else
+		{
+			int fe = codetri & 15;
+
+			// the encoder only uses the lower 3 bits
+			if (fe >= 8 || size_t(data_end - data) < size_t(3 - (fe & 1) - ((fe >> 1) & 1) - (fe >> 2)))
+				return NULL;
+
+			unsigned char a = (fe & 1) ? next++ : *data++;
+			unsigned char b = (fe & 2) ? next++ : *data++;
+			unsigned char c = (fe & 4) ? next++ : *data++;
+
+			triangles[i + 0] = a;
+			triangles[i + 1] = b;
+			triangles[i + 2] = c;
+
+			pushMeshletVertexFifo(vertexfifo, a, vertexfifooffset);
+			pushMeshletVertexFifo(vertexfifo, b, vertexfifooffset);
+			pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			pushMeshletEdgeFifo(edgefifo, b, a, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+	}
+
+	return data;
+}
+
+static size_t decodeMeshletVerticesSimd(unsigned int* destination, const unsigned char* data, size_t count, unsigned int base, int width)
+{
+	size_t i = 0;
+
+	// only full 16-byte groups are processed here, so loads and stores never cross the bounds of this meshlet's data
+#if defined(SIMD_SSE)
+	__m128i zero = _mm_setzero_si128();
+	__m128i bv = _mm_set1_epi32(int(base));
+
+	if (width == 0)
+	{
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i v0 = _mm_unpacklo_epi8(v, zero);
+			__m128i v1 = _mm_unpackhi_epi8(v, zero);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 0), _mm_add_epi32(_mm_unpacklo_epi16(v0, zero), bv));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 4), _mm_add_epi32(_mm_unpackhi_epi16(v0, zero), bv));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_add_epi32(_mm_unpacklo_epi16(v1, zero), bv));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 12), _mm_add_epi32(_mm_unpackhi_epi16(v1, zero), bv));
+		}
+	}
+	else if (width == 1)
+	{
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 2));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 0), _mm_add_epi32(_mm_unpacklo_epi16(v, zero), bv));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 4), _mm_add_epi32(_mm_unpackhi_epi16(v, zero), bv));
+		}
+	}
+	else
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_add_epi32(v, bv));
+		}
+	}
+#elif defined(SIMD_NEON)
+	uint32x4_t bv = vdupq_n_u32(base);
+
+	if (width == 0)
+	{
+		for (; i + 16 <= count; i += 16)
+		{
+			uint8x16_t v = vld1q_u8(data + i);
+			uint16x8_t v0 = vmovl_u8(vget_low_u8(v));
+			uint16x8_t v1 = vmovl_u8(vget_high_u8(v));
+
+			vst1q_u32(destination + i + 0, vaddq_u32(vmovl_u16(vget_low_u16(v0)), bv));
+			vst1q_u32(destination + i + 4, vaddq_u32(vmovl_u16(vget_high_u16(v0)), bv));
+			vst1q_u32(destination + i + 8, vaddq_u32(vmovl_u16(vget_low_u16(v1)), bv));
+			vst1q_u32(destination + i + 12, vaddq_u32(vmovl_u16(vget_high_u16(v1)), bv));
+		}
+	}
+	else if (width == 1)
+	{
+		for (; i + 8 <= count; i += 8)
+		{
+			uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(data + i * 2));
+
+			vst1q_u32(destination + i + 0, vaddq_u32(vmovl_u16(vget_low_u16(v)), bv));
+			vst1q_u32(destination + i + 4, vaddq_u32(vmovl_u16(vget_high_u16(v)), bv));
+		}
+	}
+	else
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(data + i * 4));
+
+			vst1q_u32(destination + i, vaddq_u32(v, bv));
+		}
+	}
+#elif defined(SIMD_WASM)
+	v128_t zero = wasm_i32x4_splat(0);
+	v128_t bv = wasm_i32x4_splat(int(base));
+
+	if (width == 0)
+	{
+		for (; i + 16 <= count; i += 16)
+		{
+			v128_t v = wasm_v128_load(data + i);
+			v128_t v0 = wasmx_unpacklo_v8x16(v, zero);
+			v128_t v1 = wasmx_unpackhi_v8x16(v, zero);
+
+			wasm_v128_store(destination + i + 0, wasm_i32x4_add(wasmx_unpacklo_v16x8(v0, zero), bv));
+			wasm_v128_store(destination + i + 4, wasm_i32x4_add(wasmx_unpackhi_v16x8(v0, zero), bv));
+			wasm_v128_store(destination + i + 8, wasm_i32x4_add(wasmx_unpacklo_v16x8(v1, zero), bv));
+			wasm_v128_store(destination + i + 12, wasm_i32x4_add(wasmx_unpackhi_v16x8(v1, zero), bv));
+		}
+	}
+	else if (width == 1)
+	{
+		for (; i + 8 <= count; i += 8)
+		{
+			v128_t v = wasm_v128_load(data + i * 2);
+
+			wasm_v128_store(destination + i + 0, wasm_i32x4_add(wasmx_unpacklo_v16x8(v, zero), bv));
+			wasm_v128_store(destination + i + 4, wasm_i32x4_add(wasmx_unpackhi_v16x8(v, zero), bv));
+		}
+	}
+	else
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			v128_t v = wasm_v128_load(data + i * 4);
+
+			wasm_v128_store(destination + i, wasm_i32x4_add(v, bv));
+		}
+	}
+#else
+	(void)destination;
+	(void)data;
+	(void)count;
+	(void)base;
+	(void)width;
+#endif
+
+	return i;
+}
+
+static void decodeMeshletVertices(unsigned int* destination, const unsigned char* data, size_t count, unsigned int base, int width)
+{
+	size_t i = decodeMeshletVerticesSimd(destination, data, count, base, width);
+
+	// vertex offsets are stored in little endian order
+	if (width == 0)
+	{
+		for (; i < count; ++i)
+			destination[i] = base + data[i];
+	}
+	else if (width == 1)
+	{
+		for (; i < count; ++i)
+			destination[i] = base + (data[i * 2 + 0] | (unsigned(data[i * 2 + 1]) << 8));
+	}
+	else
+	{
+		for (; i < count; ++i)
+			destination[i] = base + (data[i * 4 + 0] | (unsigned(data[i * 4 + 1]) << 8) | (unsigned(data[i * 4 + 2]) << 16) | (unsigned(data[i * 4 + 3]) << 24));
+	}
+}
+
+} // namespace meshopt
+
+size_t meshopt_encodeMeshlets(unsigned char* buffer, size_t buffer_size, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles)
+{
+	using namespace meshopt;
+
+	if (buffer_size < 1)
+		return 0;
+
+	unsigned char* data = buffer;
+	unsigned char* data_end = buffer + buffer_size;
+
+	*data++ = kMeshletHeader;
+
+	unsigned int last_base = 0;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[i];
+
+		assert(meshlet.vertex_count <= kMeshletCodecMaxVertices);
+		assert(meshlet.triangle_count <= kMeshletCodecMaxTriangles);
+
+		const unsigned int* vertices = &meshlet_vertices[meshlet.vertex_offset];
+
+		// vertices are encoded as offsets from the smallest vertex, using the smallest width that fits all offsets
+		unsigned int base = meshlet.vertex_count ? vertices[0] : last_base;
+		unsigned int range = 0;
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			base = vertices[j] < base ? vertices[j] : base;
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			range = vertices[j] - base > range ? vertices[j] - base : range;
+
+		int width = range < 256 ? 0 : (range < 65536 ? 1 : 2);
+
+		unsigned char header[8];
+		unsigned char* header_end = header;
+
+		*header_end++ = (unsigned char)meshlet.vertex_count;
+		*header_end++ = (unsigned char)(meshlet.triangle_count & 0xff);
+		*header_end++ = (unsigned char)((meshlet.triangle_count >> 8) | (width << 2));
+
+		// base vertex is delta-encoded relative to the previous meshlet since nearby meshlets usually reference nearby vertices
+		unsigned int delta = base - last_base;
+		encodeMeshletVByte(header_end, (delta << 1) ^ (int(delta) >> 31));
+
+		// each triangle takes at most 4 bytes; encoding triangles first lets us check the space for the entire meshlet at once
+		unsigned char triangles[kMeshletCodecMaxTriangles * 4];
+		size_t triangle_size = encodeMeshletTriangles(triangles, &meshlet_triangles[meshlet.triangle_offset], meshlet.triangle_count, meshlet.vertex_count) - triangles;
+
+		size_t header_size = header_end - header;
+		size_t vertex_size = meshlet.vertex_count << width;
+
+		if (size_t(data_end - data) < header_size + vertex_size + triangle_size)
+			return 0;
+
+		memcpy(data, header, header_size);
+		data += header_size;
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+		{
+			unsigned int v = vertices[j] - base;
+
+			for (int k = 0; k < (1 << width); ++k)
+				*data++ = (unsigned char)(v >> (k * 8));
+		}
+
+		memcpy(data, triangles, triangle_size);
+		data += triangle_size;
+
+		last_base = base;
+	}
+
+	assert(data <= data_end);
+
+	return data - buffer;
+}
+
+size_t meshopt_encodeMeshletsBound(size_t meshlet_count, size_t max_vertices, size_t max_triangles)
+{
+	using namespace meshopt;
+
+	assert(max_vertices <= kMeshletCodecMaxVertices);
+	assert(max_triangles <= kMeshletCodecMaxTriangles);
+
+	// header byte, and for each meshlet: up to 8 header bytes, 4 bytes per vertex and 4 bytes per triangle
+	return 1 + meshlet_count * (8 + max_vertices * 4 + max_triangles * 4);
+}
+
+int meshopt_decodeMeshlets(meshopt_Meshlet* meshlets, size_t meshlet_count, unsigned int* meshlet_vertices, size_t meshlet_vertices_size, unsigned char* meshlet_triangles, size_t meshlet_triangles_size, const unsigned char* buffer, size_t buffer_size)
+{
+	using namespace meshopt;
+
+	if (buffer_size < 1)
+		return -2;
+
+	if ((buffer[0] & 0xf0) != kMeshletHeader)
+		return -1;
+
+	int version = buffer[0] & 0x0f;
+	if (version > 0)
+		return -1;
+
+	const unsigned char* data = buffer + 1;
+	const unsigned char* data_end = buffer + buffer_size;
+
+	size_t vertex_offset = 0;
+	size_t triangle_offset = 0;
+
+	unsigned int last_base = 0;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		if (data_end - data < 3)
+			return -2;
+
+		size_t vertex_count = data[0];
+		size_t triangle_count = data[1] | ((data[2] & 3) << 8);
+		int width = data[2] >> 2;
+		data += 3;
+
+		if (width > 2 || triangle_count > kMeshletCodecMaxTriangles)
+			return -2;
+
+		// output is laid out the same way as meshopt_buildMeshlets output, with triangle data padded to 4 bytes
+		size_t triangle_size = (triangle_count * 3 + 3) & ~3;
+
+		if (meshlet_vertices_size - vertex_offset < vertex_count || meshlet_triangles_size - triangle_offset < triangle_size)
+			return -2;
+
+		unsigned int v = 0;
+		if (!decodeMeshletVByte(data, data_end, v))
+			return -2;
+
+		unsigned int base = last_base + ((v >> 1) ^ -int(v & 1));
+		last_base = base;
+
+		size_t vertex_bytes = vertex_count << width;
+
+		if (size_t(data_end - data) < vertex_bytes + triangle_count)
+			return -2;
+
+		decodeMeshletVertices(&meshlet_vertices[vertex_offset], data, vertex_count, base, width);
+		data += vertex_bytes;
+
+		data = decodeMeshletTriangles(&meshlet_triangles[triangle_offset], triangle_count, data, data_end);
+		if (!data)
+			return -2;
+
+		for (size_t j = triangle_count * 3; j < triangle_size; ++j)
+			meshlet_triangles[triangle_offset + j] = 0;
+
+		meshopt_Meshlet& meshlet = meshlets[i];
+
+		meshlet.vertex_offset = unsigned(vertex_offset);
+		meshlet.triangle_offset = unsigned(triangle_offset);
+		meshlet.vertex_count = unsigned(vertex_count);
+		meshlet.triangle_count = unsigned(triangle_count);
+
+		vertex_offset += vertex_count;
+		triangle_offset += triangle_size;
+	}
+
+	// we should've consumed all input data and filled all output data
+	if (data != data_end || vertex_offset != meshlet_vertices_size || triangle_offset != meshlet_triangles_size)
+		return -3;
+
+	return 0;
+}
+
+#undef SIMD_SSE
+#undef SIMD_NEON
+#undef SIMD_WASM
@@ -155,6 +155,25 @@ MESHOPTIMIZER_API void meshopt_optimizeVertexCache(unsigned int* destination, co
  */
 MESHOPTIMIZER_API void meshopt_optimizeVertexCacheStrip(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count);
 
+struct meshopt_VertexScoreTable
+{
+	/* score of a vertex at a given position in the cache (0 = most recently used); vertices outside of the cache get 0 */
+	float cache[16];
+
+	/* score of a vertex with a given number of remaining triangles (1..8, the last entry is used for 8 or more triangles) */
+	float live[8];
+};
+
+/**
+ * Experimental: Vertex transform cache optimizer with custom scores
+ * Reorders indices similarly to meshopt_optimizeVertexCache, using the vertex score table instead of the built-in scores; this can be used to target specific GPU cache profiles.
+ * Tables can be tuned for a set of meshes and a target cache profile using tools/vcachetuner.cpp.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ * table cache scores must be non-negative and live scores must be positive; the scores are usually in [0..1] range
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_VertexScoreTable* table);
+
 /**
  * Vertex transform cache optimizer for FIFO caches
  * Reorders indices to reduce the number of GPU vertex shader invocations
@@ -178,6 +197,29 @@ MESHOPTIMIZER_API void meshopt_optimizeVertexCacheFifo(unsigned int* destination
  */
 MESHOPTIMIZER_API void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold);
 
+/**
+ * Experimental: View-dependent overdraw optimizer
+ * Splits the index buffer into clusters of consecutive triangles using the same logic as meshopt_optimizeOverdraw, and sorts the clusters for each view direction.
+ * The index buffer itself is not modified; at draw time, the application can pick the cluster order for the closest view direction and render the clusters in that order, which keeps vertex cache efficiency within threshold while reducing overdraw for that view.
+ *
+ * meshopt_generateOverdrawClusters returns the number of clusters and writes the first triangle of each cluster to destination; cluster i spans triangles [destination[i]..destination[i+1]), and the last cluster ends at index_count / 3.
+ * destination must contain enough space for the cluster offsets, index_count / 3 elements worst case
+ * indices must contain index data that is the result of meshopt_optimizeVertexCache (*not* the original mesh indices!)
+ * threshold indicates how much the cluster split can degrade vertex cache efficiency (1.05 = up to 5%); smaller clusters result in more precise sorting
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateOverdrawClusters(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, float threshold);
+
+/**
+ * meshopt_sortOverdrawClusters writes view_count cluster permutations to destination; for view i, destination[i * cluster_count + k] is the k-th cluster to render.
+ * Clusters facing the viewer are rendered first in front to back order, followed by clusters facing away from the viewer.
+ *
+ * destination must contain enough space for the resulting permutations (view_count * cluster_count elements)
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * clusters should be the output of meshopt_generateOverdrawClusters for the same index buffer
+ * view_directions should contain view_count float3 directions that the camera looks along; they don't need to be normalized
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_sortOverdrawClusters(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count, const float* view_directions, size_t view_count);
+
 /**
  * Vertex fetch cache optimizer
  * Reorders vertices and changes indices to reduce the amount of GPU memory fetches during vertex processing
@@ -227,6 +269,15 @@ MESHOPTIMIZER_API void meshopt_encodeIndexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Index buffer decoder with base vertex
+ * Decodes index data like meshopt_decodeIndexBuffer and adds base_vertex to each index, which allows decoding multiple meshes into one shared index buffer.
+ * Note that the encoded data doesn't depend on the index size, so data encoded from 16-bit indices can be decoded into 32-bit indices by passing index_size = 4.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements); for 16-bit output, indices with base_vertex added must fit into 16 bits
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexBufferOffset(void* destination, size_t index_count, size_t index_size, unsigned int base_vertex, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Index sequence encoder
  * Encodes index sequence into an array of bytes that is generally smaller and compresses better compared to original.
@@ -248,6 +299,37 @@ MESHOPTIMIZER_API size_t meshopt_encodeIndexSequenceBound(size_t index_count, si
  */
 MESHOPTIMIZER_API int meshopt_decodeIndexSequence(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Index sequence decoder with base vertex
+ * Decodes index data like meshopt_decodeIndexSequence and adds base_vertex to each index; see meshopt_decodeIndexBufferOffset.
+ *
+ * destination must contain enough space for the resulting index sequence (index_count elements); for 16-bit output, indices with base_vertex added must fit into 16 bits
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexSequenceOffset(void* destination, size_t index_count, size_t index_size, unsigned int base_vertex, const unsigned char* buffer, size_t buffer_size);
+
+struct meshopt_IndexSequenceDecoder
+{
+	size_t index_count;
+	size_t index_size;
+	size_t index_offset; /* number of indices decoded so far */
+
+	/* internal decoding state */
+	int header;
+	unsigned int last[2];
+};
+
+/**
+ * Experimental: Incremental index sequence decoder
+ * Decodes index data from an array of bytes generated by meshopt_encodeIndexSequence as it arrives; see meshopt_VertexDecoder for the calling convention.
+ * decoder->index_offset contains the number of indices written to destination so far; decoded indices are final as soon as they are written.
+ * Note that index buffers produced by meshopt_encodeIndexBuffer can't be decoded incrementally, as triangle codes for the entire buffer precede the index data.
+ *
+ * destination must contain enough space for the resulting index sequence (index_count elements) and must be the same for all calls
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_initIndexSequenceDecoder(struct meshopt_IndexSequenceDecoder* decoder, size_t index_count, size_t index_size);
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexSequencePartial(struct meshopt_IndexSequenceDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size, size_t* consumed);
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_finishIndexSequenceDecoder(struct meshopt_IndexSequenceDecoder* decoder, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Vertex buffer encoder
  * Encodes vertex data into an array of bytes that is generally smaller and compresses better compared to original.
@@ -260,6 +342,18 @@ MESHOPTIMIZER_API int meshopt_decodeIndexSequence(void* destination, size_t inde
 MESHOPTIMIZER_API size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size);
 MESHOPTIMIZER_API size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size);
 
+/**
+ * Experimental: Vertex buffer block encoder
+ * Encodes vertex blocks [block_begin..block_end) of the vertex buffer; use meshopt_getVertexBlockCount to get the total number of blocks.
+ * Ranges can be encoded independently, for example on multiple threads; concatenating the results for consecutive ranges that cover all blocks produces the same data as meshopt_encodeVertexBuffer.
+ * Returns encoded data size on success, 0 on error; the only error condition is if buffer doesn't have enough space
+ *
+ * vertices must contain the entire vertex buffer (vertex_count elements), as the first vertex and the vertex preceding the range are used for encoding
+ * buffer must contain enough space for the encoded blocks (use meshopt_encodeVertexBufferBound with the number of vertices in the range to compute worst case size)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBlocks(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, size_t block_begin, size_t block_end);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_getVertexBlockCount(size_t vertex_count, size_t vertex_size);
+
 /**
  * Set vertex encoder format version
  * version must specify the data format version to encode; valid values are 0 (decodable by all library versions)
@@ -276,6 +370,59 @@ MESHOPTIMIZER_API void meshopt_encodeVertexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Vertex buffer block index
+ * Builds a seek table for the vertex buffer encoded with meshopt_encodeVertexBuffer that can be stored alongside the encoded data.
+ * The table allows meshopt_decodeVertexBlocks to decode disjoint block ranges independently, for example on multiple threads.
+ * Returns the number of vertex blocks in the table, or 0 if the destination is too small or the encoded buffer is malformed.
+ * The table stores a 4-byte offset and a copy of one vertex for each block; blocks contain up to 256 vertices and up to 8 KB of vertex data.
+ *
+ * destination must contain enough space for the table (use meshopt_encodeVertexBlockIndexBound to compute worst case size)
+ * buffer must contain data produced by meshopt_encodeVertexBuffer for the same vertices
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBlockIndex(unsigned char* destination, size_t destination_size, const unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBlockIndexBound(size_t vertex_count, size_t vertex_size);
+
+/**
+ * Experimental: Vertex buffer block decoder
+ * Decodes vertex blocks [block_begin..block_end) from an array of bytes generated by meshopt_encodeVertexBuffer, using the table generated by meshopt_encodeVertexBlockIndex
+ * Decoded vertices are written to the same locations in destination that meshopt_decodeVertexBuffer would use; calls with non-overlapping block ranges can run concurrently.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input and index, but it may produce garbage data.
+ *
+ * destination must contain enough space for the resulting vertex buffer (vertex_count * vertex_size bytes)
+ * block_end must not exceed the block count returned by meshopt_encodeVertexBlockIndex
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBlocks(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* index, size_t block_begin, size_t block_end);
+
+struct meshopt_VertexDecoder
+{
+	size_t vertex_count;
+	size_t vertex_size;
+	size_t vertex_offset; /* number of vertices decoded so far */
+
+	/* internal decoding state */
+	int header;
+	int baseline;
+	unsigned char last_vertex[256];
+};
+
+/**
+ * Experimental: Incremental vertex buffer decoder
+ * Decodes vertex data from an array of bytes generated by meshopt_encodeVertexBuffer as it arrives, for example over the network.
+ * meshopt_decodeVertexBufferPartial decodes all complete blocks from buffer and returns the number of bytes consumed via consumed; unconsumed bytes must be passed again, followed by new data, on the next call.
+ * decoder->vertex_offset contains the number of vertices written to destination so far; once all vertices are decoded, meshopt_finishVertexDecoder must be called with the remaining bytes.
+ * Each function returns 0 if decoding was successful (or needs more data), and an error code otherwise
+ * The decoder is safe to use for untrusted input, but it may produce garbage data.
+ *
+ * tail can be NULL; otherwise it must contain the last vertex_size bytes of the encoded buffer, and decoded vertices are final as soon as they are written.
+ * When tail is NULL, decoded vertices are final only after meshopt_finishVertexDecoder, which needs an extra pass over destination.
+ * destination must contain enough space for the resulting vertex buffer (vertex_count * vertex_size bytes) and must be the same for all calls
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_initVertexDecoder(struct meshopt_VertexDecoder* decoder, size_t vertex_count, size_t vertex_size, const unsigned char* tail);
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferPartial(struct meshopt_VertexDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size, size_t* consumed);
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_finishVertexDecoder(struct meshopt_VertexDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Vertex buffer filters
  * These functions can be used to filter output of meshopt_decodeVertexBuffer in-place.
@@ -293,6 +440,26 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterOct(void* buffer, size_t cou
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterQuat(void* buffer, size_t count, size_t stride);
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterExp(void* buffer, size_t count, size_t stride);
 
+/**
+ * Experimental: Vertex buffer decoder with filtering
+ * Decodes vertex data like meshopt_decodeVertexBuffer and applies the decode filter to each block of vertices right after it's decoded, while it's still in cache.
+ * The result is the same as calling meshopt_decodeVertexBuffer followed by the matching meshopt_decodeFilter function; vertex_size must satisfy the stride requirements of the filter.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ */
+enum meshopt_DecodeFilter
+{
+	/* No filter */
+	meshopt_DecodeFilterNone,
+	/* Filter with meshopt_decodeFilterOct */
+	meshopt_DecodeFilterOct,
+	/* Filter with meshopt_decodeFilterQuat */
+	meshopt_DecodeFilterQuat,
+	/* Filter with meshopt_decodeFilterExp */
+	meshopt_DecodeFilterExp,
+};
+
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, enum meshopt_DecodeFilter filter);
+
 /**
  * Vertex buffer filter encoders
  * These functions can be used to encode data in a format that meshopt_decodeFilter can decode
@@ -366,6 +533,40 @@ MESHOPTIMIZER_API size_t meshopt_simplify(unsigned int* destination, const unsig
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithAttributes(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error);
 
+/**
+ * Experimental: Mesh simplifier for LOD chains
+ * Generates lod_count levels of detail in one call; each level continues simplification from the previous level, reusing adjacency, classification and accumulated quadrics, which is much faster than calling meshopt_simplify once per level.
+ * Since quadrics are accumulated from the original mesh, errors are measured relative to the original mesh for every level; see meshopt_simplifyWithAttributes documentation for other parameters.
+ * Returns the total number of indices in all levels; levels are stored in destination one after another, starting from the most detailed level
+ *
+ * destination must contain enough space for all levels, worst case is index_count * lod_count elements
+ * lod_index_counts will contain the number of indices in each level (lod_count elements)
+ * lod_errors can be NULL; when it's not NULL, it will contain the resulting error for each level (lod_count elements)
+ * target_index_counts and target_errors should have lod_count elements each; target index counts must not increase between levels
+ * vertex_attributes can be NULL when attribute_count is 0
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyLods(unsigned int* destination, size_t* lod_index_counts, float* lod_errors, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options);
+
+/**
+ * Experimental: Task scheduler callback for parallel algorithms
+ * The scheduler must call task(task_data, i) once for every i in [0..task_count) and return after all calls have completed; calls may run concurrently on any threads.
+ * context is the user pointer passed to the function that takes the scheduler.
+ */
+typedef void (*meshopt_Scheduler)(void* context, void (*task)(void* task_data, size_t task_index), void* task_data, size_t task_count);
+
+/**
+ * Experimental: Parallel mesh simplifier
+ * Splits the mesh into partition_count spatially coherent partitions, simplifies each partition as a separate task with partition seams locked, and runs a final serial pass over the combined result to simplify the seams.
+ * The result is similar to meshopt_simplify but can have slightly lower quality around partition seams; the running time of the partitioned phase scales with the number of threads the scheduler uses.
+ * Returns the number of indices after simplification, with destination containing new index data
+ *
+ * destination must contain enough space for the target index buffer, worst case is index_count elements (*not* target_index_count)!
+ * options must be a bitmask composed of meshopt_SimplifyLockBorder and meshopt_SimplifyErrorAbsolute; other parameters are the same as meshopt_simplify
+ * partition_count should be a small multiple of the number of threads; 1 is equivalent to meshopt_simplify
+ * scheduler can be NULL; when it's NULL, partitions are simplified serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context);
+
 /**
  * Experimental: Mesh simplifier (sloppy)
  * Reduces the number of triangles in the mesh, sacrificing mesh appearance for simplification performance
@@ -381,6 +582,31 @@ MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithAttributes(unsigned int* d
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error);
 
+/**
+ * Experimental: Parallel mesh simplifier (sloppy)
+ * Equivalent to meshopt_simplifySloppy, but the passes over the mesh performed by grid search and cell accumulation are split into tasks that run on the scheduler.
+ * The grid size and triangle count match meshopt_simplifySloppy; cell quadrics are accumulated in a different order, so the selected vertices and the error can differ due to floating-point rounding.
+ * Results are deterministic and don't depend on the scheduler or the number of threads; parameters are the same as meshopt_simplifySloppy.
+ *
+ * scheduler can be NULL; when it's NULL, tasks run serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error, meshopt_Scheduler scheduler, void* scheduler_context);
+
+/**
+ * Experimental: Streaming mesh simplifier (sloppy)
+ * Simplifies a triangle stream that doesn't need to fit into memory by clustering vertices into a uniform grid with cell size derived from target_error, similarly to meshopt_simplifySloppy.
+ * Working memory is proportional to max_vertices and max_triangles and doesn't depend on the size of the input.
+ * Returns the number of vertices written to destination, or 0 if the output exceeds max_vertices or max_triangles; in that case the output is incomplete and should be discarded
+ *
+ * destination must contain enough space for max_vertices vertices (3 floats each); vertex positions are written after the entire stream has been read
+ * read_triangles is called repeatedly and must write up to triangle_count triangles (9 floats each) to triangle_positions, returning the number of triangles written; 0 marks the end of the stream
+ * write_indices is called after every batch that produced new triangles; indices reference vertices in destination, and triangles are never repeated
+ * bounds_min/bounds_max should contain all input positions (3 floats each); positions outside of the bounds are clamped
+ * target_error represents the error relative to the bounds extents that can be tolerated, e.g. 0.01 = 1% deformation; value range [0..1]
+ * result_error can be NULL; when it's not NULL, it will contain the resulting (relative) error after simplification
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppyStream(float* destination, size_t max_vertices, size_t max_triangles, size_t (*read_triangles)(void* context, float* triangle_positions, size_t triangle_count), void (*write_indices)(void* context, const unsigned int* indices, size_t index_count), void* context, const float* bounds_min, const float* bounds_max, float target_error, float* result_error);
+
 /**
  * Experimental: Point cloud simplifier
  * Reduces the number of points in the cloud to reach the given target
@@ -394,6 +620,20 @@ MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppy(unsigned int* destinati
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_colors, size_t vertex_colors_stride, float color_weight, size_t target_vertex_count);
 
+/**
+ * Experimental: Point cloud LOD builder
+ * Generates lod_count nested levels of detail in one call: every level contains all points of the previous level, so the output is a single point ordering where every level is a prefix.
+ * Each level is built like meshopt_simplifyPoints, except that grid cells that contain points of previous levels don't get new points; the first level matches meshopt_simplifyPoints.
+ * Returns the total number of points written to destination, which is equal to lod_vertex_counts[lod_count - 1]
+ *
+ * destination must contain enough space for the largest level (target_vertex_counts[lod_count - 1] elements)
+ * lod_vertex_counts will contain the number of points in each level, which is the length of the prefix of destination (lod_count elements)
+ * target_vertex_counts should have lod_count elements and must not decrease between levels; the target equal to vertex_count includes all points
+ * scheduler can be NULL; when it's not NULL, cell processing for each level is split into tasks that run on the scheduler; results don't depend on the scheduler
+ * other parameters are the same as meshopt_simplifyPoints
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyPointsLods(unsigned int* destination, size_t* lod_vertex_counts, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_colors, size_t vertex_colors_stride, float color_weight, const size_t* target_vertex_counts, size_t lod_count, meshopt_Scheduler scheduler, void* scheduler_context);
+
 /**
  * Returns the error scaling factor used by the simplifier to convert between absolute and relative extents
  *
@@ -415,6 +655,17 @@ MESHOPTIMIZER_API float meshopt_simplifyScale(const float* vertex_positions, siz
 MESHOPTIMIZER_API size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index);
 MESHOPTIMIZER_API size_t meshopt_stripifyBound(size_t index_count);
 
+/**
+ * Experimental: Windowed mesh stripifier
+ * Converts a previously vertex cache optimized triangle list to triangle strip, similarly to meshopt_stripify, but splits the input into consecutive windows of window_size triangles and never moves triangles across windows.
+ * This preserves the coarse triangle order produced by meshopt_optimizeVertexCache or by meshlet building; window_size should match the vertex cache size in triangles or maximum meshlet triangle count.
+ * Strips are connected using restart index or degenerate triangles; restart_index = 0 produces a restart-free strip.
+ *
+ * destination must contain enough space for the target index buffer, worst case can be computed with meshopt_stripifyBound
+ * restart_index should be 0xffff or 0xffffffff depending on index size, or 0 to use degenerate triangles
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_stripifyWindowed(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index, size_t window_size);
+
 /**
  * Mesh unstripifier
  * Converts a triangle strip to a triangle list
@@ -440,6 +691,23 @@ struct meshopt_VertexCacheStatistics
  */
 MESHOPTIMIZER_API struct meshopt_VertexCacheStatistics meshopt_analyzeVertexCache(const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size);
 
+struct meshopt_StripStatistics
+{
+	unsigned int triangles; /* non-degenerate triangles */
+	unsigned int indices; /* strip indices, including restart indices and degenerate triangles */
+	float index_ratio; /* strip indices / triangle list indices; less than 1.0 means strip uses less index bandwidth than the list */
+	struct meshopt_VertexCacheStatistics vertex_cache;
+};
+
+/**
+ * Experimental: Triangle strip analyzer
+ * Returns index bandwidth statistics of a triangle strip along with vertex cache statistics computed using meshopt_analyzeVertexCache
+ * Comparing index_ratio and vertex_cache with meshopt_analyzeVertexCache results for the source list can be used to pick strips or lists per mesh
+ *
+ * restart_index should match the value passed to meshopt_stripify, or be 0 if degenerate triangles were used
+ */
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_StripStatistics meshopt_analyzeStrip(const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size);
+
 struct meshopt_OverdrawStatistics
 {
 	unsigned int pixels_covered;
@@ -456,6 +724,19 @@ struct meshopt_OverdrawStatistics
  */
 MESHOPTIMIZER_API struct meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Overdraw analyzer with configurable views
+ * Returns overdraw statistics using a software rasterizer, similarly to meshopt_analyzeOverdraw, but renders the mesh from the specified view directions at the specified resolution.
+ * Higher resolution produces more stable results for meshes with small triangles; views are split into bands of rows that are rasterized in parallel when a scheduler is provided.
+ * Results are deterministic and don't depend on the scheduler; when a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe.
+ *
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * view_directions should contain view_count float3 directions that the camera looks along, or be NULL to use the coordinate axes (view_count is ignored in that case); faces facing away from the camera are measured as seen from the opposite direction
+ * resolution is the width and height of the rasterized image for each view in pixels; meshopt_analyzeOverdraw uses 256
+ * scheduler can be NULL; when it's NULL, all views are rasterized on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_OverdrawStatistics meshopt_analyzeOverdrawViews(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* view_directions, size_t view_count, unsigned int resolution, meshopt_Scheduler scheduler, void* scheduler_context);
+
 struct meshopt_VertexFetchStatistics
 {
 	unsigned int bytes_fetched;
@@ -469,6 +750,48 @@ struct meshopt_VertexFetchStatistics
  */
 MESHOPTIMIZER_API struct meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const unsigned int* indices, size_t index_count, size_t vertex_count, size_t vertex_size);
 
+struct meshopt_VertexCacheProfile
+{
+	unsigned int cache_size;
+	unsigned int warp_size;
+	unsigned int primgroup_size;
+};
+
+/* Limits for meshopt_analyzeMesh inputs; results are stored in fixed size arrays, so callers that need more configurations need to call it several times */
+enum
+{
+	/* Maximum number of vertex cache profiles per call */
+	meshopt_MeshStatisticsMaxProfiles = 8,
+	/* Maximum number of vertex fetch cache line sizes per call */
+	meshopt_MeshStatisticsMaxLines = 4,
+	/* Maximum number of vertex streams per call */
+	meshopt_MeshStatisticsMaxStreams = 16,
+};
+
+struct meshopt_MeshStatistics
+{
+	unsigned int triangles;
+	unsigned int unique_vertices; /* number of vertices referenced by the index buffer */
+
+	/* one entry per cache profile, matching the results of meshopt_analyzeVertexCache */
+	struct meshopt_VertexCacheStatistics vertex_cache[meshopt_MeshStatisticsMaxProfiles];
+
+	/* one entry per cache line size, accumulated over all vertex streams */
+	struct meshopt_VertexFetchStatistics vertex_fetch[meshopt_MeshStatisticsMaxLines];
+};
+
+/**
+ * Experimental: Combined mesh analyzer
+ * Returns statistics for several vertex transform cache profiles and vertex fetch cache line sizes, computed in a single pass over the index buffer
+ * Vertex cache statistics use the same model as meshopt_analyzeVertexCache; vertex fetch statistics use the same model as meshopt_analyzeVertexFetch, but support deinterleaved vertex data where each stream is stored in a separate buffer
+ * Overdraw needs vertex positions and is not included; use meshopt_analyzeOverdraw for that.
+ *
+ * cache_profiles should contain cache_profile_count (<= meshopt_MeshStatisticsMaxProfiles) profiles with parameters used by meshopt_analyzeVertexCache
+ * stream_sizes should contain stream_count (<= meshopt_MeshStatisticsMaxStreams) vertex sizes in bytes; a single stream with the full vertex size models interleaved data
+ * cache_line_sizes should contain cache_line_count (<= meshopt_MeshStatisticsMaxLines) cache line sizes in bytes (<= 256); meshopt_analyzeVertexFetch uses 64
+ */
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_MeshStatistics meshopt_analyzeMesh(const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_VertexCacheProfile* cache_profiles, size_t cache_profile_count, const size_t* stream_sizes, size_t stream_count, const unsigned int* cache_line_sizes, size_t cache_line_count);
+
 struct meshopt_Meshlet
 {
 	/* offsets within meshlet_vertices and meshlet_triangles arrays with meshlet data */
@@ -498,6 +821,17 @@ MESHOPTIMIZER_API size_t meshopt_buildMeshlets(struct meshopt_Meshlet* meshlets,
 MESHOPTIMIZER_API size_t meshopt_buildMeshletsScan(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles);
 MESHOPTIMIZER_API size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_t max_triangles);
 
+/**
+ * Experimental: Parallel meshlet builder
+ * Splits the mesh into spatially coherent partitions of triangles and builds meshlets for each partition in a separate task, using the same algorithm as meshopt_buildMeshlets.
+ * Meshlets never span partitions, so the result typically has slightly more meshlets than meshopt_buildMeshlets; the meshlet count never exceeds meshopt_buildMeshletsBound.
+ * Results are deterministic and don't depend on the scheduler or the number of threads; parameters are the same as meshopt_buildMeshlets.
+ *
+ * partition_count is an upper bound on the number of tasks; it's further limited so that each partition has at least max_triangles * (max_vertices - 2) triangles
+ * scheduler can be NULL; when it's NULL, tasks run serially on the calling thread. When a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsParallel(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context);
+
 /**
  * Experimental: Meshlet optimizer
  * Reorders meshlet vertices and triangles to maximize locality to improve rasterizer throughput
@@ -508,6 +842,32 @@ MESHOPTIMIZER_API size_t meshopt_buildMeshletsBound(size_t index_count, size_t m
  */
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeMeshlet(unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, size_t triangle_count, size_t vertex_count);
 
+/**
+ * Experimental: Meshlet encoder
+ * Encodes meshlet headers, vertex and triangle data into an array of bytes that is generally much smaller than the original.
+ * Vertex references are delta-coded per meshlet; local triangle indices are encoded using edge and vertex fifos, similarly to meshopt_encodeIndexBuffer.
+ * Returns encoded data size on success, 0 on error; the only error condition is if buffer doesn't have enough space
+ * For maximum efficiency, each meshlet should be optimized with meshopt_optimizeMeshlet first, and the source mesh should be optimized for vertex fetch.
+ *
+ * buffer must contain enough space for the encoded meshlet data (use meshopt_encodeMeshletsBound to compute worst case size)
+ * meshlet vertex_count and triangle_count must not exceed implementation limits (vertex_count <= 255, triangle_count <= 512)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeMeshlets(unsigned char* buffer, size_t buffer_size, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeMeshletsBound(size_t meshlet_count, size_t max_vertices, size_t max_triangles);
+
+/**
+ * Experimental: Meshlet decoder
+ * Decodes meshlet data from an array of bytes generated by meshopt_encodeMeshlets
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input, but it may produce garbage data (e.g. out of range indices).
+ *
+ * Meshlets are decoded in the layout produced by meshopt_buildMeshlets: vertex data is tightly packed and triangle data of each meshlet is padded to 4 bytes.
+ * Meshlet vertices and triangles are preserved, but the vertices of each triangle may be rotated (preserving winding order).
+ * meshlet_vertices must contain meshlet_vertices_size elements, which should be equal to the sum of vertex counts of all meshlets
+ * meshlet_triangles must contain meshlet_triangles_size bytes, which should be equal to the sum of (triangle_count * 3 + 3) & ~3 for all meshlets
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeMeshlets(struct meshopt_Meshlet* meshlets, size_t meshlet_count, unsigned int* meshlet_vertices, size_t meshlet_vertices_size, unsigned char* meshlet_triangles, size_t meshlet_triangles_size, const unsigned char* buffer, size_t buffer_size);
+
 struct meshopt_Bounds
 {
 	/* bounding sphere, useful for frustum and occlusion culling */
@@ -549,6 +909,74 @@ struct meshopt_Bounds
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, size_t triangle_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+struct meshopt_PackedBounds
+{
+	/* bounding sphere, useful for frustum and occlusion culling */
+	float center[3];
+	float radius;
+
+	/* normal cone axis and cutoff, stored in 8-bit SNORM format; decode using x/127.0 */
+	signed char cone_axis_s8[3];
+	signed char cone_cutoff_s8;
+};
+
+/**
+ * Experimental: Batch meshlet bounds generator
+ * Computes bounds for all meshlets in one call; results match meshopt_computeMeshletBounds, except that the bounding sphere is computed from meshlet vertices
+ * instead of triangle corners, so the sphere and cone apex may be slightly different (the bounds remain conservative).
+ * The packed bounds contain bounding sphere and 8-bit cone data (20 bytes per meshlet) that can be copied directly to GPU culling buffers; the cone should
+ * be tested using the formula that doesn't need cone apex (see meshopt_computeClusterBounds).
+ * When scheduler is not NULL, meshlets are split into ranges that are processed in parallel via scheduler callbacks.
+ *
+ * bounds must contain enough space for meshlet_count elements, or be NULL if only packed bounds are needed
+ * packed_bounds must contain enough space for meshlet_count elements, or be NULL
+ * meshlets, meshlet_vertices and meshlet_triangles should be the output of meshopt_buildMeshlets or a compatible source
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_computeMeshletBoundsBatch(struct meshopt_Bounds* bounds, struct meshopt_PackedBounds* packed_bounds, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Scheduler scheduler, void* scheduler_context);
+
+struct meshopt_ClusterLod
+{
+	/* offsets within cluster_vertices and cluster_triangles arrays with cluster data, same as meshopt_Meshlet */
+	unsigned int vertex_offset;
+	unsigned int triangle_offset;
+
+	/* number of vertices and triangles used in the cluster */
+	unsigned int vertex_count;
+	unsigned int triangle_count;
+
+	/* number of simplification steps between the source mesh and the cluster; 0 for clusters built from the source mesh */
+	unsigned int level;
+
+	/* bounds and error of the group the cluster was generated from; error is 0 for clusters built from the source mesh */
+	float self_center[3];
+	float self_radius;
+	float self_error;
+
+	/* bounds and error of the group that replaces the cluster at the next level; error is FLT_MAX for clusters that aren't simplified further */
+	float parent_center[3];
+	float parent_radius;
+	float parent_error;
+};
+
+/**
+ * Experimental: Cluster LOD hierarchy builder
+ * Splits the mesh into clusters, and repeatedly merges adjacent clusters into groups of up to group_size clusters, simplifies each group to half of its triangles with locked borders and splits it into new clusters.
+ * The result is a DAG of clusters; clusters built from the same group share self bounds and error, and clusters merged into the same group share parent bounds and error.
+ * Errors are absolute (in mesh coordinate units) and never decrease from a cluster to its parent, and each group's bounds contain the bounds of its source clusters, so a cluster can be selected
+ * independently of other clusters by checking that its self error is acceptable and its parent error isn't, both evaluated for their bounds (e.g. projected to screen space).
+ * Groups are simplified in tasks that run on the scheduler; results are deterministic and don't depend on the scheduler or the number of threads.
+ * Returns the number of clusters; clusters built from the source mesh come first.
+ *
+ * clusters must contain enough space for all clusters, worst case size can be computed with meshopt_buildClusterLodBound
+ * cluster_vertices must contain enough space for all clusters, worst case size is equal to max_clusters * max_vertices
+ * cluster_triangles must contain enough space for all clusters, worst case size is equal to max_clusters * max_triangles * 3
+ * max_vertices and max_triangles must not exceed implementation limits (max_vertices <= 255 - not 256!, max_triangles <= 512; max_triangles must be divisible by 4)
+ * group_size should be at least 2; 4-8 clusters per group is recommended
+ * scheduler can be NULL; when it's NULL, tasks run serially on the calling thread. When a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildClusterLod(struct meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, size_t group_size, meshopt_Scheduler scheduler, void* scheduler_context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildClusterLodBound(size_t index_count, size_t max_vertices, size_t max_triangles);
+
 /**
  * Spatial sorter
  * Generates a remap table that can be used to reorder points for spatial locality.
@@ -568,6 +996,84 @@ MESHOPTIMIZER_API void meshopt_spatialSortRemap(unsigned int* destination, const
  */
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Spatial sorting options
+ */
+enum
+{
+	/* Use 21 bits per axis (64-bit keys) instead of 10 bits per axis. Improves locality for large meshes where many vertices would share a key otherwise. */
+	meshopt_SpatialSortPrecise = 1 << 0,
+	/* Use Hilbert curve instead of Morton (Z) curve; neighboring keys are always adjacent in space, which results in more coherent groups. Implies meshopt_SpatialSortPrecise. */
+	meshopt_SpatialSortHilbert = 1 << 1,
+};
+
+/**
+ * Experimental: Parallel spatial sorters
+ * Equivalent to meshopt_spatialSortRemap/meshopt_spatialSortTriangles, but with configurable space filling curve and parallel radix sort.
+ * Keys are computed and sorted in chunks of vertices that are processed as tasks on the scheduler; the result doesn't depend on the scheduler, and options=0 produces the same result as the serial functions.
+ * When a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe.
+ *
+ * options must be a bitmask composed of meshopt_SpatialSortX options; 0 is equivalent to meshopt_spatialSortRemap
+ * scheduler can be NULL; when it's NULL, all tasks run serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortRemapParallel(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortTrianglesParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context);
+
+/**
+ * Experimental: Parallel vertex transform cache optimizer
+ * Reorders triangles for spatial locality, splits them into partition_count ranges and runs meshopt_optimizeVertexCache on each range as a separate task.
+ * The result has slightly worse vertex cache efficiency than meshopt_optimizeVertexCache because of the partition seams; the difference can be measured with meshopt_analyzeVertexCache.
+ * When a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * partition_count should be a small multiple of the number of threads; it's reduced so that each partition has at least 16384 triangles, and 1 is equivalent to meshopt_optimizeVertexCache
+ * scheduler can be NULL; when it's NULL, partitions are optimized serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context);
+
+/**
+ * Experimental: Parallel vertex remap generator
+ * Produces the same remap table as meshopt_generateVertexRemap/meshopt_generateVertexRemapMulti, including the first-occurrence order of the unique vertices, but hashes and deduplicates vertices in parallel.
+ * Vertices are hashed in chunks and distributed into shards by hash prefix; shards are deduplicated as separate tasks, and the final indices are assigned using a prefix sum over the index buffer.
+ * Meshes with up to 65536 vertices are processed serially. When a scheduler is used, allocation callbacks set by meshopt_setAllocator must be thread-safe.
+ *
+ * scheduler can be NULL; when it's NULL, all tasks run serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Scheduler scheduler, void* scheduler_context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapMultiParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count, meshopt_Scheduler scheduler, void* scheduler_context);
+
+/**
+ * Experimental: Mesh reindexer
+ * Combines meshopt_generateVertexRemapMulti, meshopt_remapIndexBuffer and meshopt_remapVertexBuffer for each stream into a single pass over the index buffer.
+ * Unique vertices are written in the order of first use, which also makes the result equivalent to running meshopt_optimizeVertexFetchRemap afterwards.
+ * Returns the number of unique vertices; each output stream is tightly packed (deinterleaved), with element i at offset i * streams[k].size.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements); it can be equal to indices
+ * vertex_destinations should contain stream_count pointers; each must have enough space for the resulting vertex stream (vertex_count elements worst case) and must not overlap the source streams
+ * indices can be NULL if the input is unindexed
+ * stream_count must be <= 16
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_reindexMesh(unsigned int* destination, void* const* vertex_destinations, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count);
+
+/**
+ * Experimental: Vertex welder
+ * Generates a vertex remap table that merges vertices that are close to each other, which is useful for meshes with near-duplicate vertices such as CAD or scan exports.
+ * Two vertices are merged when their positions are within position_epsilon (Euclidean distance), the angle between their normals is within normal_angle (radians) and each UV coordinate differs by at most uv_epsilon.
+ * Since this relation isn't transitive, each vertex is merged into the group of the earliest used vertex within tolerance; all vertices in a group are within tolerance of that vertex.
+ * Candidates are found using a uniform grid with cell size 2 * position_epsilon; the search runs in parallel when a scheduler is provided, and the result doesn't depend on the scheduler.
+ * Returns the number of unique vertices; the remap table uses the first-occurrence order and can be used in meshopt_remapVertexBuffer/meshopt_remapIndexBuffer.
+ * Note that meshopt_remapVertexBuffer will store the attributes of one of the merged vertices; when all epsilons are 0, only vertices with numerically equal attributes are merged.
+ *
+ * destination must contain enough space for the resulting remap table (vertex_count elements)
+ * indices can be NULL if the input is unindexed
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * vertex_normals can be NULL; when it's not NULL, it should have float3 normal in the first 12 bytes of each vertex
+ * vertex_uvs can be NULL; when it's not NULL, it should have float2 texture coordinates in the first 8 bytes of each vertex
+ * scheduler can be NULL; when it's NULL, all tasks run serially on the calling thread
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateWeldRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float position_epsilon, const float* vertex_normals, size_t vertex_normals_stride, float normal_angle, const float* vertex_uvs, size_t vertex_uvs_stride, float uv_epsilon, meshopt_Scheduler scheduler, void* scheduler_context);
+
 /**
  * Set allocation callbacks
  * These callbacks will be used instead of the default operator new/operator delete for all temporary allocations in the library.
@@ -576,6 +1082,39 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortTriangles(unsigned int* desti
  */
 MESHOPTIMIZER_API void meshopt_setAllocator(void* (MESHOPTIMIZER_ALLOC_CALLCONV *allocate)(size_t), void (MESHOPTIMIZER_ALLOC_CALLCONV *deallocate)(void*));
 
+/**
+ * Experimental: Allocation context
+ * Context objects own a scratch arena that is reused between calls to *WithContext functions, which removes repeated allocations of large temporary buffers.
+ * The arena grows to the peak temporary memory usage of the calls made so far; allocations that don't fit into the arena are served by the allocation callbacks until the call completes.
+ * A context can only be used by one thread at a time; use a separate context per thread to run functions concurrently.
+ *
+ * allocate/deallocate may be NULL, in which case callbacks set by meshopt_setAllocator are used; userdata is passed to both callbacks as is.
+ */
+struct meshopt_Context;
+
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_Context* meshopt_createContext(void* (MESHOPTIMIZER_ALLOC_CALLCONV *allocate)(void* userdata, size_t size), void (MESHOPTIMIZER_ALLOC_CALLCONV *deallocate)(void* userdata, void* ptr), void* userdata);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_destroyContext(struct meshopt_Context* context);
+
+/**
+ * Experimental: Context memory allocation
+ * Allocates temporary memory from the context arena; when the arena doesn't have enough space, the memory is allocated using the context callbacks instead.
+ * This is used by *WithContext functions, and can also be used by the application for its own temporary memory.
+ * Blocks must be deallocated in a stack-like order (last block to be allocated is deallocated first), and all blocks must be deallocated before the context is destroyed.
+ */
+MESHOPTIMIZER_EXPERIMENTAL void* meshopt_allocateContext(struct meshopt_Context* context, size_t size);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_deallocateContext(struct meshopt_Context* context, void* ptr);
+
+/**
+ * Experimental: Context variants of commonly used functions
+ * These functions produce results identical to their regular counterparts, but take temporary memory from the context; see meshopt_createContext.
+ * meshopt_simplifyWithContext uses the argument list of meshopt_simplifyWithAttributes; vertex_attributes and vertex_lock can be NULL.
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapWithContext(struct meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheWithContext(struct meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeOverdrawWithContext(struct meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithContext(struct meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsWithContext(struct meshopt_Context* context, struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -616,6 +1155,18 @@ MESHOPTIMIZER_API float meshopt_quantizeFloat(float v, int N);
  * Preserves Inf/NaN, flushes denormals to zero
  */
 MESHOPTIMIZER_API float meshopt_dequantizeHalf(unsigned short h);
+
+/**
+ * Experimental: Batch quantization
+ * Converts count vectors with components (<= 256) elements each; the results are bit-identical to calling meshopt_quantizeHalf, meshopt_dequantizeHalf, meshopt_quantizeUnorm and meshopt_quantizeSnorm on every element
+ * destination_stride and data_stride specify the distance in bytes between consecutive vectors and must be multiples of element size; tightly packed arrays are processed faster
+ *
+ * meshopt_quantizeUnormArray and meshopt_quantizeSnormArray store each element in the smallest integer type that fits N bits: 8-bit for N <= 8, 16-bit for N <= 16 and 32-bit otherwise (N <= 24)
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_quantizeHalfArray(unsigned short* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_dequantizeHalfArray(float* destination, size_t destination_stride, const unsigned short* data, size_t data_stride, size_t count, size_t components);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_quantizeUnormArray(void* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components, int N);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_quantizeSnormArray(void* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components, int N);
 #endif
 
 /**
@@ -632,6 +1183,14 @@ inline size_t meshopt_generateVertexRemap(unsigned int* destination, const T* in
 template <typename T>
 inline size_t meshopt_generateVertexRemapMulti(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count);
 template <typename T>
+inline size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
+inline size_t meshopt_generateVertexRemapMultiParallel(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
+inline size_t meshopt_reindexMesh(T* destination, void* const* vertex_destinations, const T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count);
+template <typename T>
+inline size_t meshopt_generateWeldRemap(unsigned int* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float position_epsilon, const float* vertex_normals, size_t vertex_normals_stride, float normal_angle, const float* vertex_uvs, size_t vertex_uvs_stride, float uv_epsilon, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline void meshopt_remapIndexBuffer(T* destination, const T* indices, size_t index_count, const unsigned int* remap);
 template <typename T>
 inline void meshopt_generateShadowIndexBuffer(T* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, size_t vertex_stride);
@@ -646,10 +1205,16 @@ inline void meshopt_optimizeVertexCache(T* destination, const T* indices, size_t
 template <typename T>
 inline void meshopt_optimizeVertexCacheStrip(T* destination, const T* indices, size_t index_count, size_t vertex_count);
 template <typename T>
+inline void meshopt_optimizeVertexCacheTable(T* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table);
+template <typename T>
 inline void meshopt_optimizeVertexCacheFifo(T* destination, const T* indices, size_t index_count, size_t vertex_count, unsigned int cache_size);
 template <typename T>
 inline void meshopt_optimizeOverdraw(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold);
 template <typename T>
+inline size_t meshopt_generateOverdrawClusters(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, float threshold);
+template <typename T>
+inline void meshopt_sortOverdrawClusters(unsigned int* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count, const float* view_directions, size_t view_count);
+template <typename T>
 inline size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count);
 template <typename T>
 inline size_t meshopt_optimizeVertexFetch(void* destination, T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size);
@@ -666,25 +1231,55 @@ inline size_t meshopt_simplify(T* destination, const T* indices, size_t index_co
 template <typename T>
 inline size_t meshopt_simplifyWithAttributes(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options = 0, float* result_error = NULL);
 template <typename T>
+inline size_t meshopt_simplifyLods(T* destination, size_t* lod_index_counts, float* lod_errors, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options = 0);
+template <typename T>
+inline size_t meshopt_simplifyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error = NULL);
 template <typename T>
+inline size_t meshopt_simplifySloppyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index);
 template <typename T>
+inline size_t meshopt_stripifyWindowed(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index, size_t window_size);
+template <typename T>
 inline size_t meshopt_unstripify(T* destination, const T* indices, size_t index_count, T restart_index);
 template <typename T>
 inline meshopt_VertexCacheStatistics meshopt_analyzeVertexCache(const T* indices, size_t index_count, size_t vertex_count, unsigned int cache_size, unsigned int warp_size, unsigned int buffer_size);
 template <typename T>
+inline meshopt_StripStatistics meshopt_analyzeStrip(const T* indices, size_t index_count, size_t vertex_count, T restart_index, unsigned int cache_size, unsigned int warp_size, unsigned int buffer_size);
+template <typename T>
 inline meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 template <typename T>
+inline meshopt_OverdrawStatistics meshopt_analyzeOverdrawViews(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* view_directions, size_t view_count, unsigned int resolution, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices, size_t index_count, size_t vertex_count, size_t vertex_size);
 template <typename T>
+inline meshopt_MeshStatistics meshopt_analyzeMesh(const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexCacheProfile* cache_profiles, size_t cache_profile_count, const size_t* stream_sizes, size_t stream_count, const unsigned int* cache_line_sizes, size_t cache_line_count);
+template <typename T>
 inline size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
 template <typename T>
 inline size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles);
 template <typename T>
+inline size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline meshopt_Bounds meshopt_computeClusterBounds(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 template <typename T>
+inline size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, size_t group_size, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
 inline void meshopt_spatialSortTriangles(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
+template <typename T>
+inline void meshopt_spatialSortTrianglesParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context);
+template <typename T>
+inline size_t meshopt_generateVertexRemapWithContext(meshopt_Context* context, unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size);
+template <typename T>
+inline void meshopt_optimizeVertexCacheWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, size_t vertex_count);
+template <typename T>
+inline void meshopt_optimizeOverdrawWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold);
+template <typename T>
+inline size_t meshopt_simplifyWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options = 0, float* result_error = NULL);
+template <typename T>
+inline size_t meshopt_buildMeshletsWithContext(meshopt_Context* context, meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
 #endif
 
 /* Inline implementation */
@@ -729,19 +1324,28 @@ public:
 	meshopt_Allocator()
 		: blocks()
 		, count(0)
+		, context(NULL)
+	{
+	}
+
+	explicit meshopt_Allocator(meshopt_Context* context_)
+		: blocks()
+		, count(0)
+		, context(context_)
 	{
 	}
 
 	~meshopt_Allocator()
 	{
 		for (size_t i = count; i > 0; --i)
-			Storage::deallocate(blocks[i - 1]);
+			release(blocks[i - 1]);
 	}
 
 	template <typename T> T* allocate(size_t size)
 	{
 		assert(count < sizeof(blocks) / sizeof(blocks[0]));
-		T* result = static_cast<T*>(Storage::allocate(size > size_t(-1) / sizeof(T) ? size_t(-1) : size * sizeof(T)));
+		size_t bytes = size > size_t(-1) / sizeof(T) ? size_t(-1) : size * sizeof(T);
+		T* result = static_cast<T*>(context ? meshopt_allocateContext(context, bytes) : Storage::allocate(bytes));
 		blocks[count++] = result;
 		return result;
 	}
@@ -749,13 +1353,22 @@ public:
 	void deallocate(void* ptr)
 	{
 		assert(count > 0 && blocks[count - 1] == ptr);
-		Storage::deallocate(ptr);
+		release(ptr);
 		count--;
 	}
 
 private:
 	void* blocks[24];
 	size_t count;
+	meshopt_Context* context;
+
+	void release(void* ptr)
+	{
+		if (context)
+			meshopt_deallocateContext(context, ptr);
+		else
+			Storage::deallocate(ptr);
+	}
 };
 
 // This makes sure that allocate/deallocate are lazily generated in translation units that need them and are deduplicated by the linker
@@ -830,6 +1443,39 @@ inline size_t meshopt_generateVertexRemapMulti(unsigned int* destination, const
 	return meshopt_generateVertexRemapMulti(destination, indices ? in.data : NULL, index_count, vertex_count, streams, stream_count);
 }
 
+template <typename T>
+inline size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, indices ? index_count : 0);
+
+	return meshopt_generateVertexRemapParallel(destination, indices ? in.data : NULL, index_count, vertices, vertex_count, vertex_size, scheduler, scheduler_context);
+}
+
+template <typename T>
+inline size_t meshopt_generateVertexRemapMultiParallel(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, indices ? index_count : 0);
+
+	return meshopt_generateVertexRemapMultiParallel(destination, indices ? in.data : NULL, index_count, vertex_count, streams, stream_count, scheduler, scheduler_context);
+}
+
+template <typename T>
+inline size_t meshopt_reindexMesh(T* destination, void* const* vertex_destinations, const T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, indices ? index_count : 0);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	return meshopt_reindexMesh(out.data, vertex_destinations, indices ? in.data : NULL, index_count, vertex_count, streams, stream_count);
+}
+
+template <typename T>
+inline size_t meshopt_generateWeldRemap(unsigned int* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float position_epsilon, const float* vertex_normals, size_t vertex_normals_stride, float normal_angle, const float* vertex_uvs, size_t vertex_uvs_stride, float uv_epsilon, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, indices ? index_count : 0);
+
+	return meshopt_generateWeldRemap(destination, indices ? in.data : NULL, index_count, vertex_positions, vertex_count, vertex_positions_stride, position_epsilon, vertex_normals, vertex_normals_stride, normal_angle, vertex_uvs, vertex_uvs_stride, uv_epsilon, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline void meshopt_remapIndexBuffer(T* destination, const T* indices, size_t index_count, const unsigned int* remap)
 {
@@ -893,6 +1539,15 @@ inline void meshopt_optimizeVertexCacheStrip(T* destination, const T* indices, s
 	meshopt_optimizeVertexCacheStrip(out.data, in.data, index_count, vertex_count);
 }
 
+template <typename T>
+inline void meshopt_optimizeVertexCacheTable(T* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	meshopt_optimizeVertexCacheTable(out.data, in.data, index_count, vertex_count, table);
+}
+
 template <typename T>
 inline void meshopt_optimizeVertexCacheFifo(T* destination, const T* indices, size_t index_count, size_t vertex_count, unsigned int cache_size)
 {
@@ -911,6 +1566,22 @@ inline void meshopt_optimizeOverdraw(T* destination, const T* indices, size_t in
 	meshopt_optimizeOverdraw(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, threshold);
 }
 
+template <typename T>
+inline size_t meshopt_generateOverdrawClusters(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, float threshold)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_generateOverdrawClusters(destination, in.data, index_count, vertex_count, threshold);
+}
+
+template <typename T>
+inline void meshopt_sortOverdrawClusters(unsigned int* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count, const float* view_directions, size_t view_count)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	meshopt_sortOverdrawClusters(destination, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, clusters, cluster_count, view_directions, view_count);
+}
+
 template <typename T>
 inline size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count)
 {
@@ -979,6 +1650,24 @@ inline size_t meshopt_simplifyWithAttributes(T* destination, const T* indices, s
 	return meshopt_simplifyWithAttributes(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, result_error);
 }
 
+template <typename T>
+inline size_t meshopt_simplifyLods(T* destination, size_t* lod_index_counts, float* lod_errors, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count * lod_count);
+
+	return meshopt_simplifyLods(out.data, lod_index_counts, lod_errors, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_counts, target_errors, lod_count, options);
+}
+
+template <typename T>
+inline size_t meshopt_simplifyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	return meshopt_simplifyParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, options, result_error, partition_count, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error)
 {
@@ -988,6 +1677,15 @@ inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t in
 	return meshopt_simplifySloppy(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, result_error);
 }
 
+template <typename T>
+inline size_t meshopt_simplifySloppyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	return meshopt_simplifySloppyParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, result_error, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index)
 {
@@ -997,6 +1695,15 @@ inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_co
 	return meshopt_stripify(out.data, in.data, index_count, vertex_count, unsigned(restart_index));
 }
 
+template <typename T>
+inline size_t meshopt_stripifyWindowed(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index, size_t window_size)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, (index_count / 3) * 5);
+
+	return meshopt_stripifyWindowed(out.data, in.data, index_count, vertex_count, unsigned(restart_index), window_size);
+}
+
 template <typename T>
 inline size_t meshopt_unstripify(T* destination, const T* indices, size_t index_count, T restart_index)
 {
@@ -1014,6 +1721,14 @@ inline meshopt_VertexCacheStatistics meshopt_analyzeVertexCache(const T* indices
 	return meshopt_analyzeVertexCache(in.data, index_count, vertex_count, cache_size, warp_size, buffer_size);
 }
 
+template <typename T>
+inline meshopt_StripStatistics meshopt_analyzeStrip(const T* indices, size_t index_count, size_t vertex_count, T restart_index, unsigned int cache_size, unsigned int warp_size, unsigned int buffer_size)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_analyzeStrip(in.data, index_count, vertex_count, unsigned(restart_index), cache_size, warp_size, buffer_size);
+}
+
 template <typename T>
 inline meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
@@ -1022,6 +1737,14 @@ inline meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const T* indices, size
 	return meshopt_analyzeOverdraw(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride);
 }
 
+template <typename T>
+inline meshopt_OverdrawStatistics meshopt_analyzeOverdrawViews(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* view_directions, size_t view_count, unsigned int resolution, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_analyzeOverdrawViews(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, view_directions, view_count, resolution, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices, size_t index_count, size_t vertex_count, size_t vertex_size)
 {
@@ -1030,6 +1753,14 @@ inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices
 	return meshopt_analyzeVertexFetch(in.data, index_count, vertex_count, vertex_size);
 }
 
+template <typename T>
+inline meshopt_MeshStatistics meshopt_analyzeMesh(const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexCacheProfile* cache_profiles, size_t cache_profile_count, const size_t* stream_sizes, size_t stream_count, const unsigned int* cache_line_sizes, size_t cache_line_count)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_analyzeMesh(in.data, index_count, vertex_count, cache_profiles, cache_profile_count, stream_sizes, stream_count, cache_line_sizes, cache_line_count);
+}
+
 template <typename T>
 inline size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
 {
@@ -1046,6 +1777,14 @@ inline size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int*
 	return meshopt_buildMeshletsScan(meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_count, max_vertices, max_triangles);
 }
 
+template <typename T>
+inline size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_buildMeshletsParallel(meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight, partition_count, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline meshopt_Bounds meshopt_computeClusterBounds(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
@@ -1054,6 +1793,14 @@ inline meshopt_Bounds meshopt_computeClusterBounds(const T* indices, size_t inde
 	return meshopt_computeClusterBounds(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride);
 }
 
+template <typename T>
+inline size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, size_t group_size, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_buildClusterLod(clusters, cluster_vertices, cluster_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, group_size, scheduler, scheduler_context);
+}
+
 template <typename T>
 inline void meshopt_spatialSortTriangles(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
@@ -1062,6 +1809,58 @@ inline void meshopt_spatialSortTriangles(T* destination, const T* indices, size_
 
 	meshopt_spatialSortTriangles(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride);
 }
+
+template <typename T>
+inline void meshopt_spatialSortTrianglesParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	meshopt_spatialSortTrianglesParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, options, scheduler, scheduler_context);
+}
+
+template <typename T>
+inline size_t meshopt_generateVertexRemapWithContext(meshopt_Context* context, unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, indices ? index_count : 0);
+
+	return meshopt_generateVertexRemapWithContext(context, destination, indices ? in.data : NULL, index_count, vertices, vertex_count, vertex_size);
+}
+
+template <typename T>
+inline void meshopt_optimizeVertexCacheWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, size_t vertex_count)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	meshopt_optimizeVertexCacheWithContext(context, out.data, in.data, index_count, vertex_count);
+}
+
+template <typename T>
+inline void meshopt_optimizeOverdrawWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	meshopt_optimizeOverdrawWithContext(context, out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, threshold);
+}
+
+template <typename T>
+inline size_t meshopt_simplifyWithContext(meshopt_Context* context, T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, NULL, index_count);
+
+	return meshopt_simplifyWithContext(context, out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, vertex_attributes, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, result_error);
+}
+
+template <typename T>
+inline size_t meshopt_buildMeshletsWithContext(meshopt_Context* context, meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_buildMeshletsWithContext(context, meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+}
 #endif
 
 /**
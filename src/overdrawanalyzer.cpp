@@ -3,8 +3,58 @@
 
 #include <assert.h>
 #include <float.h>
+#include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+// Prevent compiling other variant when wasm simd compilation is active
+#undef SIMD_NEON
+#undef SIMD_SSE
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 // This work is based on:
 // Nicolas Capens. Advanced Rasterization. 2004
 namespace meshopt
@@ -12,10 +62,18 @@ namespace meshopt
 
 const int kViewport = 256;
 
+// Each task rasterizes a band of rows of a single view; this keeps the buffer small and allows using more threads than there are views
+const int kOverdrawBandHeight = 256;
+
 struct OverdrawBuffer
 {
-	float z[kViewport][kViewport][2];
-	unsigned int overdraw[kViewport][kViewport][2];
+	// front-facing and back-facing layers, each has band_height rows with stride elements
+	float* z[2];
+	unsigned int* overdraw[2];
+
+	int viewport;
+	int stride;
+	int band_min, band_max;
 };
 
 #ifndef min
@@ -36,12 +94,163 @@ static float computeDepthGradients(float& dzdx, float& dzdy, float x1, float y1,
 	float det = (x2 - x1) * (y3 - y1) - (y2 - y1) * (x3 - x1);
 	float invdet = (det == 0) ? 0 : 1 / det;
 
-	dzdx = (z2 - z1) * (y3 - y1) - (y2 - y1) * (z3 - z1) * invdet;
-	dzdy = (x2 - x1) * (z3 - z1) - (z2 - z1) * (x3 - x1) * invdet;
+	dzdx = ((z2 - z1) * (y3 - y1) - (y2 - y1) * (z3 - z1)) * invdet;
+	dzdy = ((x2 - x1) * (z3 - z1) - (z2 - z1) * (x3 - x1)) * invdet;
 
 	return det;
 }
 
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#define SIMD_OVERDRAW
+#endif
+
+#ifndef SIMD_OVERDRAW
+// rasterizes pixels [minx..maxx) of a single row; CXn are edge equations at minx, SXn are their per-pixel decrements
+static void rasterizeRow(float* zrow, unsigned int* orow, int minx, int maxx, int CX1, int CX2, int CX3, int SX1, int SX2, int SX3, float ZY, float DZx)
+{
+	for (int x = minx; x < maxx; x++)
+	{
+		// check if all CXn are non-negative
+		if ((CX1 | CX2 | CX3) >= 0)
+		{
+			float ZX = ZY + DZx * float(x - minx);
+
+			if (ZX >= zrow[x])
+			{
+				zrow[x] = ZX;
+				orow[x]++;
+			}
+		}
+
+		CX1 -= SX1;
+		CX2 -= SX2;
+		CX3 -= SX3;
+	}
+}
+#endif
+
+// SIMD variants process 4 pixels at a time and produce the same results as rasterizeRow; buffer rows must have 3 elements of padding after maxx
+#ifdef SIMD_SSE
+static void rasterizeRowSimd(float* zrow, unsigned int* orow, int minx, int maxx, int CX1, int CX2, int CX3, int SX1, int SX2, int SX3, float ZY, float DZx)
+{
+	// signed overflow is UB so lane offsets are computed using unsigned math
+	__m128i e1 = _mm_setr_epi32(CX1, int(unsigned(CX1) - unsigned(SX1)), int(unsigned(CX1) - 2 * unsigned(SX1)), int(unsigned(CX1) - 3 * unsigned(SX1)));
+	__m128i e2 = _mm_setr_epi32(CX2, int(unsigned(CX2) - unsigned(SX2)), int(unsigned(CX2) - 2 * unsigned(SX2)), int(unsigned(CX2) - 3 * unsigned(SX2)));
+	__m128i e3 = _mm_setr_epi32(CX3, int(unsigned(CX3) - unsigned(SX3)), int(unsigned(CX3) - 2 * unsigned(SX3)), int(unsigned(CX3) - 3 * unsigned(SX3)));
+
+	__m128i s1 = _mm_set1_epi32(int(unsigned(SX1) << 2));
+	__m128i s2 = _mm_set1_epi32(int(unsigned(SX2) << 2));
+	__m128i s3 = _mm_set1_epi32(int(unsigned(SX3) << 2));
+
+	__m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+	__m128 offset = _mm_setr_ps(0, 1, 2, 3);
+	__m128 zy = _mm_set1_ps(ZY);
+	__m128 dzx = _mm_set1_ps(DZx);
+
+	for (int x = minx; x < maxx; x += 4)
+	{
+		__m128i inside = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(e1, e2), e3), _mm_set1_epi32(-1));
+		__m128i valid = _mm_cmpgt_epi32(_mm_set1_epi32(maxx - x), lane);
+
+		__m128 z = _mm_add_ps(zy, _mm_mul_ps(dzx, offset));
+		__m128 zb = _mm_loadu_ps(&zrow[x]);
+
+		__m128 pass = _mm_and_ps(_mm_cmpge_ps(z, zb), _mm_castsi128_ps(_mm_and_si128(inside, valid)));
+
+		_mm_storeu_ps(&zrow[x], _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, zb)));
+
+		__m128i ob = _mm_loadu_si128(reinterpret_cast<__m128i*>(&orow[x]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&orow[x]), _mm_sub_epi32(ob, _mm_castps_si128(pass)));
+
+		e1 = _mm_sub_epi32(e1, s1);
+		e2 = _mm_sub_epi32(e2, s2);
+		e3 = _mm_sub_epi32(e3, s3);
+		offset = _mm_add_ps(offset, _mm_set1_ps(4));
+	}
+}
+#endif
+
+#ifdef SIMD_NEON
+static void rasterizeRowSimd(float* zrow, unsigned int* orow, int minx, int maxx, int CX1, int CX2, int CX3, int SX1, int SX2, int SX3, float ZY, float DZx)
+{
+	static const int kLane[4] = {0, 1, 2, 3};
+	static const float kOffset[4] = {0, 1, 2, 3};
+
+	// signed overflow is UB so lane offsets are computed using unsigned math
+	uint32x4_t lane = vreinterpretq_u32_s32(vld1q_s32(kLane));
+
+	int32x4_t e1 = vreinterpretq_s32_u32(vsubq_u32(vdupq_n_u32(unsigned(CX1)), vmulq_u32(lane, vdupq_n_u32(unsigned(SX1)))));
+	int32x4_t e2 = vreinterpretq_s32_u32(vsubq_u32(vdupq_n_u32(unsigned(CX2)), vmulq_u32(lane, vdupq_n_u32(unsigned(SX2)))));
+	int32x4_t e3 = vreinterpretq_s32_u32(vsubq_u32(vdupq_n_u32(unsigned(CX3)), vmulq_u32(lane, vdupq_n_u32(unsigned(SX3)))));
+
+	int32x4_t s1 = vdupq_n_s32(int(unsigned(SX1) << 2));
+	int32x4_t s2 = vdupq_n_s32(int(unsigned(SX2) << 2));
+	int32x4_t s3 = vdupq_n_s32(int(unsigned(SX3) << 2));
+
+	float32x4_t offset = vld1q_f32(kOffset);
+	float32x4_t zy = vdupq_n_f32(ZY);
+	float32x4_t dzx = vdupq_n_f32(DZx);
+
+	for (int x = minx; x < maxx; x += 4)
+	{
+		uint32x4_t inside = vcgeq_s32(vorrq_s32(vorrq_s32(e1, e2), e3), vdupq_n_s32(0));
+		uint32x4_t valid = vcltq_s32(vld1q_s32(kLane), vdupq_n_s32(maxx - x));
+
+		float32x4_t z = vaddq_f32(zy, vmulq_f32(dzx, offset));
+		float32x4_t zb = vld1q_f32(&zrow[x]);
+
+		uint32x4_t pass = vandq_u32(vcgeq_f32(z, zb), vandq_u32(inside, valid));
+
+		vst1q_f32(&zrow[x], vbslq_f32(pass, z, zb));
+		vst1q_u32(&orow[x], vsubq_u32(vld1q_u32(&orow[x]), pass));
+
+		e1 = vsubq_s32(e1, s1);
+		e2 = vsubq_s32(e2, s2);
+		e3 = vsubq_s32(e3, s3);
+		offset = vaddq_f32(offset, vdupq_n_f32(4));
+	}
+}
+#endif
+
+#ifdef SIMD_WASM
+static void rasterizeRowSimd(float* zrow, unsigned int* orow, int minx, int maxx, int CX1, int CX2, int CX3, int SX1, int SX2, int SX3, float ZY, float DZx)
+{
+	// signed overflow is UB so lane offsets are computed using unsigned math
+	v128_t lane = wasm_i32x4_make(0, 1, 2, 3);
+
+	v128_t e1 = wasm_i32x4_sub(wasm_i32x4_splat(CX1), wasm_i32x4_mul(lane, wasm_i32x4_splat(SX1)));
+	v128_t e2 = wasm_i32x4_sub(wasm_i32x4_splat(CX2), wasm_i32x4_mul(lane, wasm_i32x4_splat(SX2)));
+	v128_t e3 = wasm_i32x4_sub(wasm_i32x4_splat(CX3), wasm_i32x4_mul(lane, wasm_i32x4_splat(SX3)));
+
+	v128_t s1 = wasm_i32x4_splat(int(unsigned(SX1) << 2));
+	v128_t s2 = wasm_i32x4_splat(int(unsigned(SX2) << 2));
+	v128_t s3 = wasm_i32x4_splat(int(unsigned(SX3) << 2));
+
+	v128_t offset = wasm_f32x4_make(0, 1, 2, 3);
+	v128_t zy = wasm_f32x4_splat(ZY);
+	v128_t dzx = wasm_f32x4_splat(DZx);
+
+	for (int x = minx; x < maxx; x += 4)
+	{
+		v128_t inside = wasm_i32x4_gt(wasm_v128_or(wasm_v128_or(e1, e2), e3), wasm_i32x4_splat(-1));
+		v128_t valid = wasm_i32x4_gt(wasm_i32x4_splat(maxx - x), lane);
+
+		v128_t z = wasm_f32x4_add(zy, wasm_f32x4_mul(dzx, offset));
+		v128_t zb = wasm_v128_load(&zrow[x]);
+
+		v128_t pass = wasm_v128_and(wasm_f32x4_ge(z, zb), wasm_v128_and(inside, valid));
+
+		wasm_v128_store(&zrow[x], wasm_v128_bitselect(z, zb, pass));
+		wasm_v128_store(&orow[x], wasm_i32x4_sub(wasm_v128_load(&orow[x]), pass));
+
+		e1 = wasm_i32x4_sub(e1, s1);
+		e2 = wasm_i32x4_sub(e2, s2);
+		e3 = wasm_i32x4_sub(e3, s3);
+		offset = wasm_f32x4_add(offset, wasm_f32x4_splat(4));
+	}
+}
+#endif
+
 // half-space fixed point triangle rasterizer
 static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, float v2x, float v2y, float v2z, float v3x, float v3y, float v3z)
 {
@@ -59,7 +268,7 @@ static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, f
 		t = v2y, v2y = v3y, v3y = t;
 
 		// flip depth since we rasterize backfacing triangles to second buffer with reverse Z; only v1z is used below
-		v1z = kViewport - v1z;
+		v1z = float(buffer->viewport) - v1z;
 		DZx = -DZx;
 		DZy = -DZy;
 	}
@@ -78,9 +287,16 @@ static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, f
 	// as for max, due to top-left filling convention we will never rasterize right/bottom edges
 	// so max >= 0.5 should round down
 	int minx = max((min(X1, min(X2, X3)) + 7) >> 4, 0);
-	int maxx = min((max(X1, max(X2, X3)) + 7) >> 4, kViewport);
+	int maxx = min((max(X1, max(X2, X3)) + 7) >> 4, buffer->viewport);
 	int miny = max((min(Y1, min(Y2, Y3)) + 7) >> 4, 0);
-	int maxy = min((max(Y1, max(Y2, Y3)) + 7) >> 4, kViewport);
+	int maxy = min((max(Y1, max(Y2, Y3)) + 7) >> 4, buffer->viewport);
+
+	// rows outside of the band are rasterized by other tasks
+	int bandy = max(miny, buffer->band_min);
+	int bandmaxy = min(maxy, buffer->band_max);
+
+	if (minx >= maxx || bandy >= bandmaxy)
+		return;
 
 	// deltas, 28.4 fixed point
 	int DX12 = X1 - X2;
@@ -103,40 +319,119 @@ static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, f
 	int CY1 = DX12 * (FY - Y1) - DY12 * (FX - X1) + TL1 - 1;
 	int CY2 = DX23 * (FY - Y2) - DY23 * (FX - X2) + TL2 - 1;
 	int CY3 = DX31 * (FY - Y3) - DY31 * (FX - X3) + TL3 - 1;
-	float ZY = v1z + (DZx * float(FX - X1) + DZy * float(FY - Y1)) * (1 / 16.f);
+	float Z = v1z + (DZx * float(FX - X1) + DZy * float(FY - Y1)) * (1 / 16.f);
+
+	// signed left shift is UB for negative numbers so use unsigned-signed casts
+	int SX1 = int(unsigned(DY12) << 4);
+	int SX2 = int(unsigned(DY23) << 4);
+	int SX3 = int(unsigned(DY31) << 4);
 
-	for (int y = miny; y < maxy; y++)
+	// edge equations and depth are computed from miny for every row so that the results don't depend on the band layout
+	for (int y = bandy; y < bandmaxy; y++)
 	{
-		int CX1 = CY1;
-		int CX2 = CY2;
-		int CX3 = CY3;
-		float ZX = ZY;
+		unsigned int dy = unsigned(y - miny);
+
+		int CX1 = int(unsigned(CY1) + dy * (unsigned(DX12) << 4));
+		int CX2 = int(unsigned(CY2) + dy * (unsigned(DX23) << 4));
+		int CX3 = int(unsigned(CY3) + dy * (unsigned(DX31) << 4));
+		float ZY = Z + DZy * float(y - miny);
+
+		size_t row = size_t(y - buffer->band_min) * buffer->stride;
+
+#ifdef SIMD_OVERDRAW
+		rasterizeRowSimd(buffer->z[sign] + row, buffer->overdraw[sign] + row, minx, maxx, CX1, CX2, CX3, SX1, SX2, SX3, ZY, DZx);
+#else
+		rasterizeRow(buffer->z[sign] + row, buffer->overdraw[sign] + row, minx, maxx, CX1, CX2, CX3, SX1, SX2, SX3, ZY, DZx);
+#endif
+	}
+}
+
+struct OverdrawViews
+{
+	const unsigned int* indices;
+	size_t index_count;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_stride_float;
+
+	// for each view, 3 basis vectors followed by the minimum coordinate along each vector
+	const float* views;
+	float scale;
+
+	int viewport;
+	int band_count;
+
+	unsigned int* pixels_covered;
+	unsigned int* pixels_shaded;
+};
+
+static void projectOverdrawVertex(float* result, const float* v, const float* view, float scale)
+{
+	for (int k = 0; k < 3; ++k)
+		result[k] = (v[0] * view[k * 3 + 0] + v[1] * view[k * 3 + 1] + v[2] * view[k * 3 + 2] - view[9 + k]) * scale;
+}
+
+static void rasterizeOverdrawBand(void* data, size_t index)
+{
+	const OverdrawViews& job = *static_cast<const OverdrawViews*>(data);
+
+	size_t view = index / job.band_count;
+	int band = int(index % job.band_count);
+
+	meshopt_Allocator allocator;
+
+	OverdrawBuffer buffer = {};
+	buffer.viewport = job.viewport;
+	buffer.stride = job.viewport + 3; // padding for SIMD rasterizer
+	buffer.band_min = band * kOverdrawBandHeight;
+	buffer.band_max = min(buffer.band_min + kOverdrawBandHeight, job.viewport);
+
+	size_t band_size = size_t(buffer.band_max - buffer.band_min) * buffer.stride;
 
-		for (int x = minx; x < maxx; x++)
+	float* z = allocator.allocate<float>(band_size * 2);
+	unsigned int* overdraw = allocator.allocate<unsigned int>(band_size * 2);
+
+	memset(z, 0, band_size * 2 * sizeof(float));
+	memset(overdraw, 0, band_size * 2 * sizeof(unsigned int));
+
+	buffer.z[0] = z;
+	buffer.z[1] = z + band_size;
+	buffer.overdraw[0] = overdraw;
+	buffer.overdraw[1] = overdraw + band_size;
+
+	const float* view_data = job.views + view * 12;
+
+	for (size_t i = 0; i < job.index_count; i += 3)
+	{
+		float v[3][3];
+
+		for (int k = 0; k < 3; ++k)
 		{
-			// check if all CXn are non-negative
-			if ((CX1 | CX2 | CX3) >= 0)
-			{
-				if (ZX >= buffer->z[y][x][sign])
-				{
-					buffer->z[y][x][sign] = ZX;
-					buffer->overdraw[y][x][sign]++;
-				}
-			}
+			unsigned int vi = job.indices[i + k];
+			assert(vi < job.vertex_count);
 
-			// signed left shift is UB for negative numbers so use unsigned-signed casts
-			CX1 -= int(unsigned(DY12) << 4);
-			CX2 -= int(unsigned(DY23) << 4);
-			CX3 -= int(unsigned(DY31) << 4);
-			ZX += DZx;
+			projectOverdrawVertex(v[k], job.vertex_positions + vi * job.vertex_stride_float, view_data, job.scale);
 		}
 
-		// signed left shift is UB for negative numbers so use unsigned-signed casts
-		CY1 += int(unsigned(DX12) << 4);
-		CY2 += int(unsigned(DX23) << 4);
-		CY3 += int(unsigned(DX31) << 4);
-		ZY += DZy;
+		rasterize(&buffer, v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
 	}
+
+	unsigned int pixels_covered = 0;
+	unsigned int pixels_shaded = 0;
+
+	for (int s = 0; s < 2; ++s)
+		for (int y = 0; y < buffer.band_max - buffer.band_min; ++y)
+			for (int x = 0; x < job.viewport; ++x)
+			{
+				unsigned int count = buffer.overdraw[s][size_t(y) * buffer.stride + x];
+
+				pixels_covered += count > 0;
+				pixels_shaded += count;
+			}
+
+	job.pixels_covered[index] = pixels_covered;
+	job.pixels_shaded[index] = pixels_shaded;
 }
 
 } // namespace meshopt
@@ -145,9 +440,18 @@ meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices,
 {
 	using namespace meshopt;
 
+	return meshopt_analyzeOverdrawViews(indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, NULL, 0, kViewport, NULL, NULL);
+}
+
+meshopt_OverdrawStatistics meshopt_analyzeOverdrawViews(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* view_directions, size_t view_count, unsigned int resolution, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
 	assert(index_count % 3 == 0);
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(view_directions || view_count == 0);
+	assert(resolution > 0 && resolution <= 16384);
 
 	meshopt_Allocator allocator;
 
@@ -155,75 +459,122 @@ meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices,
 
 	meshopt_OverdrawStatistics result = {};
 
-	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
-	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+	// by default, the mesh is viewed along the coordinate axes; each basis is a vector pair spanning the image plane and the depth axis
+	static const float kAxisViews[3][9] = {
+	    {0, 0, 1, 0, 1, 0, 1, 0, 0},
+	    {1, 0, 0, 0, 0, 1, 0, 1, 0},
+	    {0, 1, 0, 1, 0, 0, 0, 0, 1},
+	};
+
+	if (!view_directions)
+		view_count = 3;
 
-	for (size_t i = 0; i < vertex_count; ++i)
+	float* views = allocator.allocate<float>(view_count * 12);
+
+	for (size_t i = 0; i < view_count; ++i)
 	{
-		const float* v = vertex_positions + i * vertex_stride_float;
+		float* view = views + i * 12;
 
-		for (int j = 0; j < 3; ++j)
+		if (view_directions)
 		{
-			minv[j] = min(minv[j], v[j]);
-			maxv[j] = max(maxv[j], v[j]);
-		}
-	}
+			const float* d = view_directions + i * 3;
+			float dl = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+			assert(dl > 0);
 
-	float extent = max(maxv[0] - minv[0], max(maxv[1] - minv[1], maxv[2] - minv[2]));
-	float scale = kViewport / extent;
+			float w[3] = {d[0] / dl, d[1] / dl, d[2] / dl};
 
-	float* triangles = allocator.allocate<float>(index_count * 3);
+			// pick a helper axis that isn't collinear with the view direction
+			float a[3] = {fabsf(w[0]) < 0.9f ? 1.f : 0.f, fabsf(w[0]) < 0.9f ? 0.f : 1.f, 0.f};
 
-	for (size_t i = 0; i < index_count; ++i)
-	{
-		unsigned int index = indices[i];
-		assert(index < vertex_count);
+			float u[3] = {a[1] * w[2] - a[2] * w[1], a[2] * w[0] - a[0] * w[2], a[0] * w[1] - a[1] * w[0]};
+			float ul = sqrtf(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+
+			u[0] /= ul, u[1] /= ul, u[2] /= ul;
+
+			float v[3] = {w[1] * u[2] - w[2] * u[1], w[2] * u[0] - w[0] * u[2], w[0] * u[1] - w[1] * u[0]};
 
-		const float* v = vertex_positions + index * vertex_stride_float;
+			// depth increases towards the camera, so faces facing the camera are depth tested front to back along the view direction
+			// faces facing away are rasterized with reversed depth, as seen by the camera looking in the opposite direction
+			float z[3] = {-w[0], -w[1], -w[2]};
 
-		triangles[i * 3 + 0] = (v[0] - minv[0]) * scale;
-		triangles[i * 3 + 1] = (v[1] - minv[1]) * scale;
-		triangles[i * 3 + 2] = (v[2] - minv[2]) * scale;
+			memcpy(view + 0, u, sizeof(u));
+			memcpy(view + 3, v, sizeof(v));
+			memcpy(view + 6, z, sizeof(z));
+		}
+		else
+		{
+			memcpy(view, kAxisViews[i], sizeof(kAxisViews[i]));
+		}
+
+		view[9] = view[10] = view[11] = FLT_MAX;
 	}
 
-	OverdrawBuffer* buffer = allocator.allocate<OverdrawBuffer>(1);
+	// all views use the same scale so that the results for different views are comparable
+	float extent = 0;
 
-	for (int axis = 0; axis < 3; ++axis)
+	for (size_t i = 0; i < view_count; ++i)
 	{
-		memset(buffer, 0, sizeof(OverdrawBuffer));
+		float* view = views + i * 12;
+		float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
 
-		for (size_t i = 0; i < index_count; i += 3)
+		for (size_t j = 0; j < vertex_count; ++j)
 		{
-			const float* vn0 = &triangles[3 * (i + 0)];
-			const float* vn1 = &triangles[3 * (i + 1)];
-			const float* vn2 = &triangles[3 * (i + 2)];
+			const float* v = vertex_positions + j * vertex_stride_float;
 
-			switch (axis)
+			for (int k = 0; k < 3; ++k)
 			{
-			case 0:
-				rasterize(buffer, vn0[2], vn0[1], vn0[0], vn1[2], vn1[1], vn1[0], vn2[2], vn2[1], vn2[0]);
-				break;
-			case 1:
-				rasterize(buffer, vn0[0], vn0[2], vn0[1], vn1[0], vn1[2], vn1[1], vn2[0], vn2[2], vn2[1]);
-				break;
-			case 2:
-				rasterize(buffer, vn0[1], vn0[0], vn0[2], vn1[1], vn1[0], vn1[2], vn2[1], vn2[0], vn2[2]);
-				break;
+				float p = v[0] * view[k * 3 + 0] + v[1] * view[k * 3 + 1] + v[2] * view[k * 3 + 2];
+
+				view[9 + k] = min(view[9 + k], p);
+				maxv[k] = max(maxv[k], p);
 			}
 		}
 
-		for (int y = 0; y < kViewport; ++y)
-			for (int x = 0; x < kViewport; ++x)
-				for (int s = 0; s < 2; ++s)
-				{
-					unsigned int overdraw = buffer->overdraw[y][x][s];
+		for (int k = 0; k < 3; ++k)
+			extent = max(extent, maxv[k] - view[9 + k]);
+	}
 
-					result.pixels_covered += overdraw > 0;
-					result.pixels_shaded += overdraw;
-				}
+	if (index_count == 0 || extent <= 0)
+		return result;
+
+	int viewport = int(resolution);
+	int band_count = (viewport + kOverdrawBandHeight - 1) / kOverdrawBandHeight;
+	size_t task_count = view_count * band_count;
+
+	unsigned int* pixels_covered = allocator.allocate<unsigned int>(task_count);
+	unsigned int* pixels_shaded = allocator.allocate<unsigned int>(task_count);
+
+	OverdrawViews job = {};
+	job.indices = indices;
+	job.index_count = index_count;
+	job.vertex_positions = vertex_positions;
+	job.vertex_count = vertex_count;
+	job.vertex_stride_float = vertex_stride_float;
+	job.views = views;
+	job.scale = float(viewport) / extent;
+	job.viewport = viewport;
+	job.band_count = band_count;
+	job.pixels_covered = pixels_covered;
+	job.pixels_shaded = pixels_shaded;
+
+	if (scheduler)
+		scheduler(scheduler_context, rasterizeOverdrawBand, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			rasterizeOverdrawBand(&job, i);
+
+	for (size_t i = 0; i < task_count; ++i)
+	{
+		result.pixels_covered += pixels_covered[i];
+		result.pixels_shaded += pixels_shaded[i];
 	}
 
 	result.overdraw = result.pixels_covered ? float(result.pixels_shaded) / float(result.pixels_covered) : 0.f;
 
 	return result;
 }
+
+#undef SIMD_SSE
+#undef SIMD_NEON
+#undef SIMD_WASM
+#undef SIMD_OVERDRAW
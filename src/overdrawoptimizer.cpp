@@ -10,7 +10,8 @@
 namespace meshopt
 {
 
-static void calculateSortData(float* sort_data, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count)
+// computes centroid (relative to mesh centroid) and average normal for each cluster, 6 floats per cluster
+static void calculateClusterData(float* cluster_data, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count)
 {
 	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
 
@@ -76,9 +77,50 @@ static void calculateSortData(float* sort_data, const unsigned int* indices, siz
 		cluster_normal[1] *= inv_cluster_normal_length;
 		cluster_normal[2] *= inv_cluster_normal_length;
 
-		float centroid_vector[3] = {cluster_centroid[0] - mesh_centroid[0], cluster_centroid[1] - mesh_centroid[1], cluster_centroid[2] - mesh_centroid[2]};
+		float* data = cluster_data + cluster * 6;
 
-		sort_data[cluster] = centroid_vector[0] * cluster_normal[0] + centroid_vector[1] * cluster_normal[1] + centroid_vector[2] * cluster_normal[2];
+		data[0] = cluster_centroid[0] - mesh_centroid[0];
+		data[1] = cluster_centroid[1] - mesh_centroid[1];
+		data[2] = cluster_centroid[2] - mesh_centroid[2];
+		data[3] = cluster_normal[0];
+		data[4] = cluster_normal[1];
+		data[5] = cluster_normal[2];
+	}
+}
+
+static void calculateSortData(float* sort_data, const float* cluster_data, size_t cluster_count)
+{
+	for (size_t cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		const float* data = cluster_data + cluster * 6;
+
+		// clusters that are further away from the mesh centroid along their normal should come first as they are likely to occlude other clusters
+		sort_data[cluster] = data[0] * data[3] + data[1] * data[4] + data[2] * data[5];
+	}
+}
+
+static void calculateSortDataView(float* sort_data, const float* cluster_data, size_t cluster_count, const float* view)
+{
+	float depth_max = 0;
+
+	for (size_t cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		const float* data = cluster_data + cluster * 6;
+		float depth = data[0] * view[0] + data[1] * view[1] + data[2] * view[2];
+
+		depth_max = (depth_max < fabsf(depth)) ? fabsf(depth) : depth_max;
+	}
+
+	for (size_t cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		const float* data = cluster_data + cluster * 6;
+
+		float depth = data[0] * view[0] + data[1] * view[1] + data[2] * view[2];
+		float facing = data[3] * view[0] + data[4] * view[1] + data[5] * view[2];
+
+		// clusters facing the viewer come first, sorted front to back; clusters facing away are likely culled or occluded and come last
+		// both groups are separated in the key range so that the sort keys of the groups don't overlap
+		sort_data[cluster] = (facing <= 0 ? depth_max : -depth_max) - depth;
 	}
 }
 
@@ -265,9 +307,29 @@ static size_t generateSoftBoundaries(unsigned int* destination, const unsigned i
 	return result;
 }
 
+// clusters must contain enough space for index_count / 3 + 1 elements
+static size_t generateClusters(unsigned int* clusters, const unsigned int* indices, size_t index_count, size_t vertex_count, float threshold, meshopt_Allocator& allocator)
+{
+	unsigned int cache_size = 16;
+
+	unsigned int* cache_timestamps = allocator.allocate<unsigned int>(vertex_count);
+
+	// generate hard boundaries from full-triangle cache misses
+	unsigned int* hard_clusters = allocator.allocate<unsigned int>(index_count / 3);
+	size_t hard_cluster_count = generateHardBoundaries(hard_clusters, indices, index_count, vertex_count, cache_size, cache_timestamps);
+
+	// generate soft boundaries
+	return generateSoftBoundaries(clusters, indices, index_count, vertex_count, hard_clusters, hard_cluster_count, cache_size, threshold, cache_timestamps);
+}
+
 } // namespace meshopt
 
 void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold)
+{
+	meshopt_optimizeOverdrawWithContext(NULL, destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, threshold);
+}
+
+void meshopt_optimizeOverdrawWithContext(meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold)
 {
 	using namespace meshopt;
 
@@ -275,7 +337,7 @@ void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* ind
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	// guard for empty meshes
 	if (index_count == 0 || vertex_count == 0)
@@ -289,24 +351,16 @@ void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* ind
 		indices = indices_copy;
 	}
 
-	unsigned int cache_size = 16;
-
-	unsigned int* cache_timestamps = allocator.allocate<unsigned int>(vertex_count);
-
-	// generate hard boundaries from full-triangle cache misses
-	unsigned int* hard_clusters = allocator.allocate<unsigned int>(index_count / 3);
-	size_t hard_cluster_count = generateHardBoundaries(hard_clusters, indices, index_count, vertex_count, cache_size, cache_timestamps);
-
-	// generate soft boundaries
-	unsigned int* soft_clusters = allocator.allocate<unsigned int>(index_count / 3 + 1);
-	size_t soft_cluster_count = generateSoftBoundaries(soft_clusters, indices, index_count, vertex_count, hard_clusters, hard_cluster_count, cache_size, threshold, cache_timestamps);
-
-	const unsigned int* clusters = soft_clusters;
-	size_t cluster_count = soft_cluster_count;
+	// generate clusters
+	unsigned int* clusters = allocator.allocate<unsigned int>(index_count / 3 + 1);
+	size_t cluster_count = generateClusters(clusters, indices, index_count, vertex_count, threshold, allocator);
 
 	// fill sort data
+	float* cluster_data = allocator.allocate<float>(cluster_count * 6);
+	calculateClusterData(cluster_data, indices, index_count, vertex_positions, vertex_positions_stride, clusters, cluster_count);
+
 	float* sort_data = allocator.allocate<float>(cluster_count);
-	calculateSortData(sort_data, indices, index_count, vertex_positions, vertex_positions_stride, clusters, cluster_count);
+	calculateSortData(sort_data, cluster_data, cluster_count);
 
 	// sort clusters using sort data
 	unsigned short* sort_keys = allocator.allocate<unsigned short>(cluster_count);
@@ -331,3 +385,61 @@ void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* ind
 
 	assert(offset == index_count);
 }
+
+size_t meshopt_generateOverdrawClusters(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, float threshold)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+
+	meshopt_Allocator allocator;
+
+	// guard for empty meshes
+	if (index_count == 0 || vertex_count == 0)
+		return 0;
+
+	// soft boundary generation may temporarily write one extra element
+	unsigned int* clusters = allocator.allocate<unsigned int>(index_count / 3 + 1);
+	size_t cluster_count = generateClusters(clusters, indices, index_count, vertex_count, threshold, allocator);
+
+	memcpy(destination, clusters, cluster_count * sizeof(unsigned int));
+
+	return cluster_count;
+}
+
+void meshopt_sortOverdrawClusters(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned int* clusters, size_t cluster_count, const float* view_directions, size_t view_count)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(cluster_count <= index_count / 3);
+	(void)vertex_count;
+
+	meshopt_Allocator allocator;
+
+	if (cluster_count == 0)
+		return;
+
+	assert(clusters[0] == 0);
+
+	float* cluster_data = allocator.allocate<float>(cluster_count * 6);
+	calculateClusterData(cluster_data, indices, index_count, vertex_positions, vertex_positions_stride, clusters, cluster_count);
+
+	float* sort_data = allocator.allocate<float>(cluster_count);
+	unsigned short* sort_keys = allocator.allocate<unsigned short>(cluster_count);
+
+	for (size_t i = 0; i < view_count; ++i)
+	{
+		const float* d = view_directions + i * 3;
+		float dl = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+		float view[3] = {d[0], d[1], d[2]};
+
+		if (dl > 0)
+			view[0] /= dl, view[1] /= dl, view[2] /= dl;
+
+		calculateSortDataView(sort_data, cluster_data, cluster_count, view);
+		calculateSortOrderRadix(destination + i * cluster_count, sort_data, sort_keys, cluster_count);
+	}
+}
@@ -2,6 +2,56 @@
 #include "meshoptimizer.h"
 
 #include <assert.h>
+#include <string.h>
+
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+// Prevent compiling other variant when wasm simd compilation is active
+#undef SIMD_NEON
+#undef SIMD_SSE
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
 
 union FloatBits
 {
@@ -74,3 +124,505 @@ float meshopt_dequantizeHalf(unsigned short h)
 	u.ui = s | r;
 	return u.f;
 }
+
+namespace meshopt
+{
+
+// number of elements processed at a time when the source or destination is strided
+const size_t kQuantizeBlockSize = 256;
+
+// SIMD kernels below replicate the integer/float operations of the scalar functions exactly, so the results are bit-identical;
+// note that hardware fp16 conversion (F16C/NEON) can't be used since it rounds to even, preserves denormals and NaN payloads
+#if defined(SIMD_SSE)
+static void quantizeHalfSimd(unsigned short* destination, const float* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128i ui = _mm_castps_si128(_mm_loadu_ps(&data[i]));
+
+		__m128i s = _mm_and_si128(_mm_srli_epi32(ui, 16), _mm_set1_epi32(0x8000));
+		__m128i em = _mm_and_si128(ui, _mm_set1_epi32(0x7fffffff));
+
+		__m128i h = _mm_srai_epi32(_mm_add_epi32(em, _mm_set1_epi32(-(112 << 23) + (1 << 12))), 13);
+
+		__m128i uf = _mm_cmplt_epi32(em, _mm_set1_epi32(113 << 23));
+		__m128i of = _mm_cmpgt_epi32(em, _mm_set1_epi32((143 << 23) - 1));
+		__m128i nf = _mm_cmpgt_epi32(em, _mm_set1_epi32(255 << 23));
+
+		h = _mm_andnot_si128(uf, h);
+		h = _mm_or_si128(_mm_andnot_si128(of, h), _mm_and_si128(of, _mm_set1_epi32(0x7c00)));
+		h = _mm_or_si128(_mm_andnot_si128(nf, h), _mm_and_si128(nf, _mm_set1_epi32(0x7e00)));
+
+		// sign-extend 16-bit results so that signed saturation during packing preserves them
+		__m128i r = _mm_srai_epi32(_mm_slli_epi32(_mm_or_si128(s, h), 16), 16);
+
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(&destination[i]), _mm_packs_epi32(r, r));
+	}
+}
+
+static void dequantizeHalfSimd(float* destination, const unsigned short* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&data[i])), _mm_setzero_si128());
+
+		__m128i s = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+		__m128i em = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+
+		__m128i r = _mm_slli_epi32(_mm_add_epi32(em, _mm_set1_epi32(112 << 10)), 13);
+
+		r = _mm_andnot_si128(_mm_cmplt_epi32(em, _mm_set1_epi32(1 << 10)), r);
+		r = _mm_add_epi32(r, _mm_and_si128(_mm_cmpgt_epi32(em, _mm_set1_epi32((31 << 10) - 1)), _mm_set1_epi32(112 << 23)));
+
+		_mm_storeu_ps(&destination[i], _mm_castsi128_ps(_mm_or_si128(s, r)));
+	}
+}
+
+static void quantizeUnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	__m128 scale = _mm_set1_ps(float((1 << N) - 1));
+	__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), half = _mm_set1_ps(0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&data[i]);
+
+		// select-based clamping maps NaN to 0 similarly to the scalar version
+		v = _mm_and_ps(_mm_cmpge_ps(v, zero), v);
+		__m128 le = _mm_cmple_ps(v, one);
+		v = _mm_or_ps(_mm_and_ps(le, v), _mm_andnot_ps(le, one));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half)));
+	}
+}
+
+static void quantizeSnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	__m128 scale = _mm_set1_ps(float((1 << (N - 1)) - 1));
+	__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), minus1 = _mm_set1_ps(-1.f), half = _mm_set1_ps(0.5f), minushalf = _mm_set1_ps(-0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&data[i]);
+
+		__m128 ge0 = _mm_cmpge_ps(v, zero);
+		__m128 round = _mm_or_ps(_mm_and_ps(ge0, half), _mm_andnot_ps(ge0, minushalf));
+
+		// select-based clamping maps NaN to -1 similarly to the scalar version
+		__m128 ge = _mm_cmpge_ps(v, minus1);
+		v = _mm_or_ps(_mm_and_ps(ge, v), _mm_andnot_ps(ge, minus1));
+		__m128 le = _mm_cmple_ps(v, one);
+		v = _mm_or_ps(_mm_and_ps(le, v), _mm_andnot_ps(le, one));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), round)));
+	}
+}
+#endif
+
+#if defined(SIMD_NEON)
+static void quantizeHalfSimd(unsigned short* destination, const float* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		int32x4_t ui = vreinterpretq_s32_f32(vld1q_f32(&data[i]));
+
+		int32x4_t s = vandq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(ui), 16)), vdupq_n_s32(0x8000));
+		int32x4_t em = vandq_s32(ui, vdupq_n_s32(0x7fffffff));
+
+		int32x4_t h = vshrq_n_s32(vaddq_s32(em, vdupq_n_s32(-(112 << 23) + (1 << 12))), 13);
+
+		h = vbicq_s32(h, vreinterpretq_s32_u32(vcltq_s32(em, vdupq_n_s32(113 << 23))));
+		h = vbslq_s32(vcgeq_s32(em, vdupq_n_s32(143 << 23)), vdupq_n_s32(0x7c00), h);
+		h = vbslq_s32(vcgtq_s32(em, vdupq_n_s32(255 << 23)), vdupq_n_s32(0x7e00), h);
+
+		vst1_u16(&destination[i], vmovn_u32(vreinterpretq_u32_s32(vorrq_s32(s, h))));
+	}
+}
+
+static void dequantizeHalfSimd(float* destination, const unsigned short* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		int32x4_t h = vreinterpretq_s32_u32(vmovl_u16(vld1_u16(&data[i])));
+
+		int32x4_t s = vshlq_n_s32(vandq_s32(h, vdupq_n_s32(0x8000)), 16);
+		int32x4_t em = vandq_s32(h, vdupq_n_s32(0x7fff));
+
+		int32x4_t r = vshlq_n_s32(vaddq_s32(em, vdupq_n_s32(112 << 10)), 13);
+
+		r = vbicq_s32(r, vreinterpretq_s32_u32(vcltq_s32(em, vdupq_n_s32(1 << 10))));
+		r = vaddq_s32(r, vandq_s32(vreinterpretq_s32_u32(vcgeq_s32(em, vdupq_n_s32(31 << 10))), vdupq_n_s32(112 << 23)));
+
+		vst1q_f32(&destination[i], vreinterpretq_f32_s32(vorrq_s32(s, r)));
+	}
+}
+
+static void quantizeUnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	float32x4_t scale = vdupq_n_f32(float((1 << N) - 1));
+	float32x4_t zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f), half = vdupq_n_f32(0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		float32x4_t v = vld1q_f32(&data[i]);
+
+		// select-based clamping maps NaN to 0 similarly to the scalar version; note that vmaxq/vminq propagate NaN
+		v = vbslq_f32(vcgeq_f32(v, zero), v, zero);
+		v = vbslq_f32(vcleq_f32(v, one), v, one);
+
+		vst1q_s32(&destination[i], vcvtq_s32_f32(vaddq_f32(vmulq_f32(v, scale), half)));
+	}
+}
+
+static void quantizeSnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	float32x4_t scale = vdupq_n_f32(float((1 << (N - 1)) - 1));
+	float32x4_t zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f), minus1 = vdupq_n_f32(-1.f), half = vdupq_n_f32(0.5f), minushalf = vdupq_n_f32(-0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		float32x4_t v = vld1q_f32(&data[i]);
+
+		float32x4_t round = vbslq_f32(vcgeq_f32(v, zero), half, minushalf);
+
+		// select-based clamping maps NaN to -1 similarly to the scalar version; note that vmaxq/vminq propagate NaN
+		v = vbslq_f32(vcgeq_f32(v, minus1), v, minus1);
+		v = vbslq_f32(vcleq_f32(v, one), v, one);
+
+		vst1q_s32(&destination[i], vcvtq_s32_f32(vaddq_f32(vmulq_f32(v, scale), round)));
+	}
+}
+#endif
+
+#if defined(SIMD_WASM)
+static void quantizeHalfSimd(unsigned short* destination, const float* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		v128_t ui = wasm_v128_load(&data[i]);
+
+		v128_t s = wasm_v128_and(wasm_u32x4_shr(ui, 16), wasm_i32x4_splat(0x8000));
+		v128_t em = wasm_v128_and(ui, wasm_i32x4_splat(0x7fffffff));
+
+		v128_t h = wasm_i32x4_shr(wasm_i32x4_add(em, wasm_i32x4_splat(-(112 << 23) + (1 << 12))), 13);
+
+		h = wasm_v128_andnot(h, wasm_i32x4_lt(em, wasm_i32x4_splat(113 << 23)));
+		h = wasm_v128_bitselect(wasm_i32x4_splat(0x7c00), h, wasm_i32x4_ge(em, wasm_i32x4_splat(143 << 23)));
+		h = wasm_v128_bitselect(wasm_i32x4_splat(0x7e00), h, wasm_i32x4_gt(em, wasm_i32x4_splat(255 << 23)));
+
+		// gather low 16 bits of each lane into the low 64 bits of the vector
+		v128_t r = wasm_v128_or(s, h);
+		r = wasm_i16x8_shuffle(r, r, 0, 2, 4, 6, 0, 2, 4, 6);
+
+		long long r64 = wasm_i64x2_extract_lane(r, 0);
+		memcpy(&destination[i], &r64, 8);
+	}
+}
+
+static void dequantizeHalfSimd(float* destination, const unsigned short* data, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		long long h64;
+		memcpy(&h64, &data[i], 8);
+
+		v128_t h = wasm_i16x8_shuffle(wasm_i64x2_splat(h64), wasm_i32x4_splat(0), 0, 8, 1, 8, 2, 8, 3, 8);
+
+		v128_t s = wasm_i32x4_shl(wasm_v128_and(h, wasm_i32x4_splat(0x8000)), 16);
+		v128_t em = wasm_v128_and(h, wasm_i32x4_splat(0x7fff));
+
+		v128_t r = wasm_i32x4_shl(wasm_i32x4_add(em, wasm_i32x4_splat(112 << 10)), 13);
+
+		r = wasm_v128_andnot(r, wasm_i32x4_lt(em, wasm_i32x4_splat(1 << 10)));
+		r = wasm_i32x4_add(r, wasm_v128_and(wasm_i32x4_ge(em, wasm_i32x4_splat(31 << 10)), wasm_i32x4_splat(112 << 23)));
+
+		wasm_v128_store(&destination[i], wasm_v128_or(s, r));
+	}
+}
+
+static void quantizeUnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	v128_t scale = wasm_f32x4_splat(float((1 << N) - 1));
+	v128_t zero = wasm_f32x4_splat(0.f), one = wasm_f32x4_splat(1.f), half = wasm_f32x4_splat(0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		v128_t v = wasm_v128_load(&data[i]);
+
+		// select-based clamping maps NaN to 0 similarly to the scalar version
+		v = wasm_v128_bitselect(v, zero, wasm_f32x4_ge(v, zero));
+		v = wasm_v128_bitselect(v, one, wasm_f32x4_le(v, one));
+
+		wasm_v128_store(&destination[i], wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(wasm_f32x4_mul(v, scale), half)));
+	}
+}
+
+static void quantizeSnormSimd(int* destination, const float* data, size_t count, int N)
+{
+	v128_t scale = wasm_f32x4_splat(float((1 << (N - 1)) - 1));
+	v128_t zero = wasm_f32x4_splat(0.f), one = wasm_f32x4_splat(1.f), minus1 = wasm_f32x4_splat(-1.f), half = wasm_f32x4_splat(0.5f), minushalf = wasm_f32x4_splat(-0.5f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		v128_t v = wasm_v128_load(&data[i]);
+
+		v128_t round = wasm_v128_bitselect(half, minushalf, wasm_f32x4_ge(v, zero));
+
+		// select-based clamping maps NaN to -1 similarly to the scalar version
+		v = wasm_v128_bitselect(v, minus1, wasm_f32x4_ge(v, minus1));
+		v = wasm_v128_bitselect(v, one, wasm_f32x4_le(v, one));
+
+		wasm_v128_store(&destination[i], wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(wasm_f32x4_mul(v, scale), round)));
+	}
+}
+#endif
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#define SIMD_QUANTIZE
+#endif
+
+static void quantizeHalfBlock(unsigned short* destination, const float* data, size_t count)
+{
+	size_t offset = 0;
+
+#ifdef SIMD_QUANTIZE
+	offset = count & ~size_t(3);
+	quantizeHalfSimd(destination, data, offset);
+#endif
+
+	for (size_t i = offset; i < count; ++i)
+		destination[i] = meshopt_quantizeHalf(data[i]);
+}
+
+static void dequantizeHalfBlock(float* destination, const unsigned short* data, size_t count)
+{
+	size_t offset = 0;
+
+#ifdef SIMD_QUANTIZE
+	offset = count & ~size_t(3);
+	dequantizeHalfSimd(destination, data, offset);
+#endif
+
+	for (size_t i = offset; i < count; ++i)
+		destination[i] = meshopt_dequantizeHalf(data[i]);
+}
+
+static void quantizeUnormBlock(int* destination, const float* data, size_t count, int N)
+{
+	size_t offset = 0;
+
+#ifdef SIMD_QUANTIZE
+	offset = count & ~size_t(3);
+	quantizeUnormSimd(destination, data, offset, N);
+#endif
+
+	for (size_t i = offset; i < count; ++i)
+		destination[i] = meshopt_quantizeUnorm(data[i], N);
+}
+
+static void quantizeSnormBlock(int* destination, const float* data, size_t count, int N)
+{
+	size_t offset = 0;
+
+#ifdef SIMD_QUANTIZE
+	offset = count & ~size_t(3);
+	quantizeSnormSimd(destination, data, offset, N);
+#endif
+
+	for (size_t i = offset; i < count; ++i)
+		destination[i] = meshopt_quantizeSnorm(data[i], N);
+}
+
+template <typename T, int Components>
+static void gatherQuantizeBlock(T* block, const unsigned char* source, size_t data_stride, size_t rows, size_t components)
+{
+	size_t count = Components ? size_t(Components) : components;
+
+	for (size_t i = 0; i < rows; ++i)
+	{
+		const T* row = reinterpret_cast<const T*>(source + i * data_stride);
+
+		for (size_t j = 0; j < count; ++j)
+			block[i * count + j] = row[j];
+	}
+}
+
+template <typename T>
+static void gatherQuantizeBlock(T* block, const void* data, size_t data_stride, size_t rows, size_t components)
+{
+	const unsigned char* source = static_cast<const unsigned char*>(data);
+
+	// common vector sizes are specialized to avoid variable-length inner loops
+	switch (components)
+	{
+	case 1:
+		return gatherQuantizeBlock<T, 1>(block, source, data_stride, rows, components);
+	case 2:
+		return gatherQuantizeBlock<T, 2>(block, source, data_stride, rows, components);
+	case 3:
+		return gatherQuantizeBlock<T, 3>(block, source, data_stride, rows, components);
+	case 4:
+		return gatherQuantizeBlock<T, 4>(block, source, data_stride, rows, components);
+	default:
+		return gatherQuantizeBlock<T, 0>(block, source, data_stride, rows, components);
+	}
+}
+
+template <typename T, typename B, int Components>
+static void scatterQuantizeBlock(unsigned char* target, size_t destination_stride, const B* block, size_t rows, size_t components)
+{
+	size_t count = Components ? size_t(Components) : components;
+
+	for (size_t i = 0; i < rows; ++i)
+	{
+		T* row = reinterpret_cast<T*>(target + i * destination_stride);
+
+		for (size_t j = 0; j < count; ++j)
+			row[j] = T(block[i * count + j]);
+	}
+}
+
+template <typename T, typename B>
+static void scatterQuantizeBlock(void* destination, size_t destination_stride, const B* block, size_t rows, size_t components)
+{
+	unsigned char* target = static_cast<unsigned char*>(destination);
+
+	// common vector sizes are specialized to avoid variable-length inner loops
+	switch (components)
+	{
+	case 1:
+		return scatterQuantizeBlock<T, B, 1>(target, destination_stride, block, rows, components);
+	case 2:
+		return scatterQuantizeBlock<T, B, 2>(target, destination_stride, block, rows, components);
+	case 3:
+		return scatterQuantizeBlock<T, B, 3>(target, destination_stride, block, rows, components);
+	case 4:
+		return scatterQuantizeBlock<T, B, 4>(target, destination_stride, block, rows, components);
+	default:
+		return scatterQuantizeBlock<T, B, 0>(target, destination_stride, block, rows, components);
+	}
+}
+
+static void storeQuantizeBlock(void* destination, size_t destination_stride, const int* block, size_t rows, size_t components, int N, bool is_signed)
+{
+	if (N <= 8 && is_signed)
+		scatterQuantizeBlock<signed char>(destination, destination_stride, block, rows, components);
+	else if (N <= 8)
+		scatterQuantizeBlock<unsigned char>(destination, destination_stride, block, rows, components);
+	else if (N <= 16 && is_signed)
+		scatterQuantizeBlock<short>(destination, destination_stride, block, rows, components);
+	else if (N <= 16)
+		scatterQuantizeBlock<unsigned short>(destination, destination_stride, block, rows, components);
+	else
+		scatterQuantizeBlock<int>(destination, destination_stride, block, rows, components);
+}
+
+} // namespace meshopt
+
+void meshopt_quantizeHalfArray(unsigned short* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components)
+{
+	using namespace meshopt;
+
+	assert(components > 0 && components <= kQuantizeBlockSize);
+	assert(destination_stride >= components * sizeof(unsigned short) && destination_stride % sizeof(unsigned short) == 0);
+	assert(data_stride >= components * sizeof(float) && data_stride % sizeof(float) == 0);
+
+	// tightly packed arrays don't need to be copied through a temporary block
+	if (destination_stride == components * sizeof(unsigned short) && data_stride == components * sizeof(float))
+	{
+		quantizeHalfBlock(destination, data, count * components);
+		return;
+	}
+
+	float source[kQuantizeBlockSize];
+	unsigned short result[kQuantizeBlockSize];
+
+	size_t block_rows = kQuantizeBlockSize / components;
+
+	for (size_t i = 0; i < count; i += block_rows)
+	{
+		size_t rows = count - i < block_rows ? count - i : block_rows;
+
+		gatherQuantizeBlock(source, reinterpret_cast<const unsigned char*>(data) + i * data_stride, data_stride, rows, components);
+		quantizeHalfBlock(result, source, rows * components);
+		scatterQuantizeBlock<unsigned short>(reinterpret_cast<unsigned char*>(destination) + i * destination_stride, destination_stride, result, rows, components);
+	}
+}
+
+void meshopt_dequantizeHalfArray(float* destination, size_t destination_stride, const unsigned short* data, size_t data_stride, size_t count, size_t components)
+{
+	using namespace meshopt;
+
+	assert(components > 0 && components <= kQuantizeBlockSize);
+	assert(destination_stride >= components * sizeof(float) && destination_stride % sizeof(float) == 0);
+	assert(data_stride >= components * sizeof(unsigned short) && data_stride % sizeof(unsigned short) == 0);
+
+	// tightly packed arrays don't need to be copied through a temporary block
+	if (destination_stride == components * sizeof(float) && data_stride == components * sizeof(unsigned short))
+	{
+		dequantizeHalfBlock(destination, data, count * components);
+		return;
+	}
+
+	unsigned short source[kQuantizeBlockSize];
+	float result[kQuantizeBlockSize];
+
+	size_t block_rows = kQuantizeBlockSize / components;
+
+	for (size_t i = 0; i < count; i += block_rows)
+	{
+		size_t rows = count - i < block_rows ? count - i : block_rows;
+
+		gatherQuantizeBlock(source, reinterpret_cast<const unsigned char*>(data) + i * data_stride, data_stride, rows, components);
+		dequantizeHalfBlock(result, source, rows * components);
+		scatterQuantizeBlock<float>(reinterpret_cast<unsigned char*>(destination) + i * destination_stride, destination_stride, result, rows, components);
+	}
+}
+
+void meshopt_quantizeUnormArray(void* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components, int N)
+{
+	using namespace meshopt;
+
+	assert(N >= 1 && N <= 24);
+	assert(components > 0 && components <= kQuantizeBlockSize);
+	assert(destination_stride >= components * (N <= 8 ? 1 : N <= 16 ? 2 : 4) && destination_stride % (N <= 8 ? 1 : N <= 16 ? 2 : 4) == 0);
+	assert(data_stride >= components * sizeof(float) && data_stride % sizeof(float) == 0);
+
+	float source[kQuantizeBlockSize];
+	int result[kQuantizeBlockSize];
+
+	size_t block_rows = kQuantizeBlockSize / components;
+
+	for (size_t i = 0; i < count; i += block_rows)
+	{
+		size_t rows = count - i < block_rows ? count - i : block_rows;
+
+		gatherQuantizeBlock(source, reinterpret_cast<const unsigned char*>(data) + i * data_stride, data_stride, rows, components);
+		quantizeUnormBlock(result, source, rows * components, N);
+		storeQuantizeBlock(static_cast<unsigned char*>(destination) + i * destination_stride, destination_stride, result, rows, components, N, false);
+	}
+}
+
+void meshopt_quantizeSnormArray(void* destination, size_t destination_stride, const float* data, size_t data_stride, size_t count, size_t components, int N)
+{
+	using namespace meshopt;
+
+	assert(N >= 2 && N <= 24);
+	assert(components > 0 && components <= kQuantizeBlockSize);
+	assert(destination_stride >= components * (N <= 8 ? 1 : N <= 16 ? 2 : 4) && destination_stride % (N <= 8 ? 1 : N <= 16 ? 2 : 4) == 0);
+	assert(data_stride >= components * sizeof(float) && data_stride % sizeof(float) == 0);
+
+	float source[kQuantizeBlockSize];
+	int result[kQuantizeBlockSize];
+
+	size_t block_rows = kQuantizeBlockSize / components;
+
+	for (size_t i = 0; i < count; i += block_rows)
+	{
+		size_t rows = count - i < block_rows ? count - i : block_rows;
+
+		gatherQuantizeBlock(source, reinterpret_cast<const unsigned char*>(data) + i * data_stride, data_stride, rows, components);
+		quantizeSnormBlock(result, source, rows * components, N);
+		storeQuantizeBlock(static_cast<unsigned char*>(destination) + i * destination_stride, destination_stride, result, rows, components, N, true);
+	}
+}
@@ -6,6 +6,20 @@
 #include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// SSE2 is available unconditionally on all x64 targets; collapse ranking uses it to evaluate 4 collapses at a time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifndef TRACE
 #define TRACE 0
 #endif
@@ -1009,9 +1023,165 @@ static size_t pickEdgeCollapses(Collapse* collapses, size_t collapse_capacity, c
 	return collapse_count;
 }
 
+#ifdef SIMD_SSE2
+static void quadricLoad4(__m128* R, const Quadric& Q0, const Quadric& Q1, const Quadric& Q2, const Quadric& Q3)
+{
+	// Quadric has 11 floats; we load it as [a00 a11 a22 a10] [a20 a21 b0 b1] [b1 b2 c w] to avoid reading past the end of the array
+	__m128 q00 = _mm_loadu_ps(&Q0.a00), q01 = _mm_loadu_ps(&Q0.a20), q02 = _mm_loadu_ps(&Q0.b1);
+	__m128 q10 = _mm_loadu_ps(&Q1.a00), q11 = _mm_loadu_ps(&Q1.a20), q12 = _mm_loadu_ps(&Q1.b1);
+	__m128 q20 = _mm_loadu_ps(&Q2.a00), q21 = _mm_loadu_ps(&Q2.a20), q22 = _mm_loadu_ps(&Q2.b1);
+	__m128 q30 = _mm_loadu_ps(&Q3.a00), q31 = _mm_loadu_ps(&Q3.a20), q32 = _mm_loadu_ps(&Q3.b1);
+
+	_MM_TRANSPOSE4_PS(q00, q10, q20, q30);
+	_MM_TRANSPOSE4_PS(q01, q11, q21, q31);
+	_MM_TRANSPOSE4_PS(q02, q12, q22, q32);
+
+	// a00, a11, a22, a10, a20, a21, b0, b1, b2, c, w
+	R[0] = q00, R[1] = q10, R[2] = q20, R[3] = q30;
+	R[4] = q01, R[5] = q11, R[6] = q21, R[7] = q31;
+	R[8] = q12, R[9] = q22, R[10] = q32;
+}
+
+// evaluates the same expression as quadricError for 4 quadrics at once with the same sequence of operations for each lane, which produces identical results
+static __m128 quadricErrorBase4(const __m128* Q, __m128 vx, __m128 vy, __m128 vz)
+{
+	__m128 rx = _mm_add_ps(Q[6], _mm_mul_ps(Q[3], vy));
+	__m128 ry = _mm_add_ps(Q[7], _mm_mul_ps(Q[5], vz));
+	__m128 rz = _mm_add_ps(Q[8], _mm_mul_ps(Q[4], vx));
+
+	rx = _mm_add_ps(rx, rx);
+	ry = _mm_add_ps(ry, ry);
+	rz = _mm_add_ps(rz, rz);
+
+	rx = _mm_add_ps(rx, _mm_mul_ps(Q[0], vx));
+	ry = _mm_add_ps(ry, _mm_mul_ps(Q[1], vy));
+	rz = _mm_add_ps(rz, _mm_mul_ps(Q[2], vz));
+
+	__m128 r = Q[9];
+	r = _mm_add_ps(r, _mm_mul_ps(rx, vx));
+	r = _mm_add_ps(r, _mm_mul_ps(ry, vy));
+	r = _mm_add_ps(r, _mm_mul_ps(rz, vz));
+
+	return r;
+}
+
+static __m128 quadricError4(const Quadric& Q0, const Quadric& Q1, const Quadric& Q2, const Quadric& Q3, __m128 vx, __m128 vy, __m128 vz)
+{
+	__m128 Q[11];
+	quadricLoad4(Q, Q0, Q1, Q2, Q3);
+
+	__m128 r = quadricErrorBase4(Q, vx, vy, vz);
+	__m128 s = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.f), Q[10]), _mm_cmpneq_ps(Q[10], _mm_setzero_ps()));
+
+	return _mm_mul_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), r), s);
+}
+
+static __m128 quadricError4(const Quadric* const* QA, const QuadricGrad* const* GA, size_t attribute_count, __m128 vx, __m128 vy, __m128 vz, const float* const* va)
+{
+	__m128 Q[11];
+	quadricLoad4(Q, *QA[0], *QA[1], *QA[2], *QA[3]);
+
+	__m128 r = quadricErrorBase4(Q, vx, vy, vz);
+
+	for (size_t k = 0; k < attribute_count; ++k)
+	{
+		__m128 gx = _mm_loadu_ps(&GA[0][k].gx);
+		__m128 gy = _mm_loadu_ps(&GA[1][k].gx);
+		__m128 gz = _mm_loadu_ps(&GA[2][k].gx);
+		__m128 gw = _mm_loadu_ps(&GA[3][k].gx);
+
+		_MM_TRANSPOSE4_PS(gx, gy, gz, gw);
+
+		__m128 a = _mm_setr_ps(va[0][k], va[1][k], va[2][k], va[3][k]);
+		__m128 g = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, gx), _mm_mul_ps(vy, gy)), _mm_mul_ps(vz, gz)), gw);
+
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(a, a), Q[10]));
+		r = _mm_sub_ps(r, _mm_mul_ps(_mm_add_ps(a, a), g));
+	}
+
+	return _mm_andnot_ps(_mm_set1_ps(-0.f), r);
+}
+
+static void rankEdgeCollapsesSimd(Collapse* collapses, size_t collapse_count, const Vector3* vertex_positions, const float* vertex_attributes, const Quadric* vertex_quadrics, const Quadric* attribute_quadrics, const QuadricGrad* attribute_gradients, size_t attribute_count, const unsigned int* remap)
+{
+	for (size_t i = 0; i < collapse_count; i += 4)
+	{
+		Collapse* c = &collapses[i];
+
+		unsigned int i0[4], i1[4], j0[4], j1[4];
+
+		for (int k = 0; k < 4; ++k)
+		{
+			i0[k] = c[k].v0;
+			i1[k] = c[k].v1;
+
+			// same as in rankEdgeCollapses: unidirectional edges evaluate the same collapse twice
+			j0[k] = c[k].bidi ? i1[k] : i0[k];
+			j1[k] = c[k].bidi ? i0[k] : i1[k];
+		}
+
+		const Vector3 *pi0 = &vertex_positions[i1[0]], *pi1 = &vertex_positions[i1[1]], *pi2 = &vertex_positions[i1[2]], *pi3 = &vertex_positions[i1[3]];
+		const Vector3 *pj0 = &vertex_positions[j1[0]], *pj1 = &vertex_positions[j1[1]], *pj2 = &vertex_positions[j1[2]], *pj3 = &vertex_positions[j1[3]];
+
+		__m128 vix = _mm_setr_ps(pi0->x, pi1->x, pi2->x, pi3->x);
+		__m128 viy = _mm_setr_ps(pi0->y, pi1->y, pi2->y, pi3->y);
+		__m128 viz = _mm_setr_ps(pi0->z, pi1->z, pi2->z, pi3->z);
+
+		__m128 vjx = _mm_setr_ps(pj0->x, pj1->x, pj2->x, pj3->x);
+		__m128 vjy = _mm_setr_ps(pj0->y, pj1->y, pj2->y, pj3->y);
+		__m128 vjz = _mm_setr_ps(pj0->z, pj1->z, pj2->z, pj3->z);
+
+		__m128 ei = quadricError4(vertex_quadrics[remap[i0[0]]], vertex_quadrics[remap[i0[1]]], vertex_quadrics[remap[i0[2]]], vertex_quadrics[remap[i0[3]]], vix, viy, viz);
+		__m128 ej = quadricError4(vertex_quadrics[remap[j0[0]]], vertex_quadrics[remap[j0[1]]], vertex_quadrics[remap[j0[2]]], vertex_quadrics[remap[j0[3]]], vjx, vjy, vjz);
+
+		if (attribute_count)
+		{
+			const Quadric* qi[4];
+			const Quadric* qj[4];
+			const QuadricGrad* gi[4];
+			const QuadricGrad* gj[4];
+			const float* ai[4];
+			const float* aj[4];
+
+			for (int k = 0; k < 4; ++k)
+			{
+				qi[k] = &attribute_quadrics[remap[i0[k]]];
+				qj[k] = &attribute_quadrics[remap[j0[k]]];
+				gi[k] = &attribute_gradients[remap[i0[k]] * attribute_count];
+				gj[k] = &attribute_gradients[remap[j0[k]] * attribute_count];
+				ai[k] = &vertex_attributes[i1[k] * attribute_count];
+				aj[k] = &vertex_attributes[j1[k] * attribute_count];
+			}
+
+			ei = _mm_add_ps(ei, quadricError4(qi, gi, attribute_count, vix, viy, viz, ai));
+			ej = _mm_add_ps(ej, quadricError4(qj, gj, attribute_count, vjx, vjy, vjz, aj));
+		}
+
+		float eis[4], ejs[4];
+		_mm_storeu_ps(eis, ei);
+		_mm_storeu_ps(ejs, ej);
+
+		// pick edge direction with minimal error
+		for (int k = 0; k < 4; ++k)
+		{
+			c[k].v0 = eis[k] <= ejs[k] ? i0[k] : j0[k];
+			c[k].v1 = eis[k] <= ejs[k] ? i1[k] : j1[k];
+			c[k].error = eis[k] <= ejs[k] ? eis[k] : ejs[k];
+		}
+	}
+}
+#endif
+
 static void rankEdgeCollapses(Collapse* collapses, size_t collapse_count, const Vector3* vertex_positions, const float* vertex_attributes, const Quadric* vertex_quadrics, const Quadric* attribute_quadrics, const QuadricGrad* attribute_gradients, size_t attribute_count, const unsigned int* remap)
 {
-	for (size_t i = 0; i < collapse_count; ++i)
+	size_t start = 0;
+
+#ifdef SIMD_SSE2
+	start = collapse_count & ~size_t(3);
+	rankEdgeCollapsesSimd(collapses, start, vertex_positions, vertex_attributes, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, remap);
+#endif
+
+	for (size_t i = start; i < collapse_count; ++i)
 	{
 		Collapse& c = collapses[i];
 
@@ -1299,21 +1469,22 @@ struct TriangleHasher
 	}
 };
 
+inline unsigned int computeVertexId(const Vector3& v, float cell_scale)
+{
+	int xi = int(v.x * cell_scale + 0.5f);
+	int yi = int(v.y * cell_scale + 0.5f);
+	int zi = int(v.z * cell_scale + 0.5f);
+
+	return (xi << 20) | (yi << 10) | zi;
+}
+
 static void computeVertexIds(unsigned int* vertex_ids, const Vector3* vertex_positions, size_t vertex_count, int grid_size)
 {
 	assert(grid_size >= 1 && grid_size <= 1024);
 	float cell_scale = float(grid_size - 1);
 
 	for (size_t i = 0; i < vertex_count; ++i)
-	{
-		const Vector3& v = vertex_positions[i];
-
-		int xi = int(v.x * cell_scale + 0.5f);
-		int yi = int(v.y * cell_scale + 0.5f);
-		int zi = int(v.z * cell_scale + 0.5f);
-
-		vertex_ids[i] = (xi << 20) | (yi << 10) | zi;
-	}
+		vertex_ids[i] = computeVertexId(vertex_positions[i], cell_scale);
 }
 
 static size_t countTriangles(const unsigned int* vertex_ids, const unsigned int* indices, size_t index_count)
@@ -1553,22 +1724,28 @@ MESHOPTIMIZER_API unsigned int* meshopt_simplifyDebugLoop = NULL;
 MESHOPTIMIZER_API unsigned int* meshopt_simplifyDebugLoopBack = NULL;
 #endif
 
-size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+namespace meshopt
 {
-	using namespace meshopt;
 
+// simplifies the mesh through a sequence of LODs, reusing the simplifier state between levels; each LOD is appended to destination
+// when lod_count is 1, destination is used as a working buffer which saves a copy
+static size_t simplifyEdge(meshopt_Context* context, unsigned int* destination, size_t* lod_index_counts, float* lod_errors, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options)
+{
 	assert(index_count % 3 == 0);
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
-	assert(target_index_count <= index_count);
+	assert(lod_count > 0);
 	assert((options & ~(meshopt_SimplifyLockBorder | meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute)) == 0);
 	assert(vertex_attributes_stride >= attribute_count * sizeof(float) && vertex_attributes_stride <= 256);
 	assert(vertex_attributes_stride % sizeof(float) == 0);
 	assert(attribute_count <= kMaxAttributes);
 
-	meshopt_Allocator allocator;
+	for (size_t i = 0; i < lod_count; ++i)
+		assert(target_index_counts[i] <= (i == 0 ? index_count : target_index_counts[i - 1]));
+
+	meshopt_Allocator allocator(context);
 
-	unsigned int* result = destination;
+	unsigned int* result = (lod_count == 1) ? destination : allocator.allocate<unsigned int>(index_count);
 	if (result != indices)
 		memcpy(result, indices, index_count * sizeof(unsigned int));
 
@@ -1655,56 +1832,75 @@ size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indic
 	size_t result_count = index_count;
 	float result_error = 0;
 
+	size_t output_count = 0;
+
 	// target_error input is linear; we need to adjust it to match quadricError units
 	float error_scale = (options & meshopt_SimplifyErrorAbsolute) ? vertex_scale : 1.f;
-	float error_limit = (target_error * target_error) / (error_scale * error_scale);
 
-	while (result_count > target_index_count)
+	for (size_t lod = 0; lod < lod_count; ++lod)
 	{
-		// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
-		updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+		size_t target_index_count = target_index_counts[lod];
+		float error_limit = (target_errors[lod] * target_errors[lod]) / (error_scale * error_scale);
 
-		size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, collapse_capacity, result, result_count, remap, vertex_kind, loop);
-		assert(edge_collapse_count <= collapse_capacity);
+		while (result_count > target_index_count)
+		{
+			// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
+			updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
 
-		// no edges can be collapsed any more due to topology restrictions
-		if (edge_collapse_count == 0)
-			break;
+			size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, collapse_capacity, result, result_count, remap, vertex_kind, loop);
+			assert(edge_collapse_count <= collapse_capacity);
 
-		rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_attributes, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, remap);
+			// no edges can be collapsed any more due to topology restrictions
+			if (edge_collapse_count == 0)
+				break;
 
-		sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
+			rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_attributes, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, remap);
 
-		size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
+			sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
 
-		for (size_t i = 0; i < vertex_count; ++i)
-			collapse_remap[i] = unsigned(i);
+			size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
 
-		memset(collapse_locked, 0, vertex_count);
+			for (size_t i = 0; i < vertex_count; ++i)
+				collapse_remap[i] = unsigned(i);
+
+			memset(collapse_locked, 0, vertex_count);
 
 #if TRACE
-		printf("pass %d: ", int(pass_count++));
+			printf("pass %d: ", int(pass_count++));
 #endif
 
-		size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error);
+			size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error);
 
-		// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
-		if (collapses == 0)
-			break;
+			// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
+			if (collapses == 0)
+				break;
 
-		remapEdgeLoops(loop, vertex_count, collapse_remap);
-		remapEdgeLoops(loopback, vertex_count, collapse_remap);
+			remapEdgeLoops(loop, vertex_count, collapse_remap);
+			remapEdgeLoops(loopback, vertex_count, collapse_remap);
 
-		size_t new_count = remapIndexBuffer(result, result_count, collapse_remap);
-		assert(new_count < result_count);
+			size_t new_count = remapIndexBuffer(result, result_count, collapse_remap);
+			assert(new_count < result_count);
 
-		result_count = new_count;
-	}
+			result_count = new_count;
+		}
 
 #if TRACE
-	printf("result: %d triangles, error: %e; total %d passes\n", int(result_count / 3), sqrtf(result_error), int(pass_count));
+		printf("result: %d triangles, error: %e; total %d passes\n", int(result_count / 3), sqrtf(result_error), int(pass_count));
 #endif
 
+		// result_error is quadratic; we need to remap it back to linear
+		lod_index_counts[lod] = result_count;
+		lod_errors[lod] = sqrtf(result_error) * error_scale;
+
+		// subsequent levels continue from the current state, so we need to save a copy of the current level
+		// note that indices are converted back into the dense space of the larger mesh
+		if (lod_count > 1)
+			for (size_t i = 0; i < result_count; ++i)
+				destination[output_count + i] = sparse_remap ? sparse_remap[result[i]] : result[i];
+
+		output_count += result_count;
+	}
+
 #ifndef NDEBUG
 	if (meshopt_simplifyDebugKind)
 		memcpy(meshopt_simplifyDebugKind, vertex_kind, vertex_count);
@@ -1717,13 +1913,31 @@ size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indic
 #endif
 
 	// convert resulting indices back into the dense space of the larger mesh
-	if (sparse_remap)
+	if (sparse_remap && lod_count == 1)
 		for (size_t i = 0; i < result_count; ++i)
 			result[i] = sparse_remap[result[i]];
 
-	// result_error is quadratic; we need to remap it back to linear
+	return output_count;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	return meshopt_simplifyWithContext(NULL, destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, out_result_error);
+}
+
+size_t meshopt_simplifyWithContext(meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	using namespace meshopt;
+
+	size_t result_count = 0;
+	float result_error = 0;
+
+	simplifyEdge(context, destination, &result_count, &result_error, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, &target_index_count, &target_error, 1, options);
+
 	if (out_result_error)
-		*out_result_error = sqrtf(result_error) * error_scale;
+		*out_result_error = result_error;
 
 	return result_count;
 }
@@ -1738,7 +1952,63 @@ size_t meshopt_simplifyWithAttributes(unsigned int* destination, const unsigned
 	return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, out_result_error);
 }
 
-size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error)
+size_t meshopt_simplifyLods(unsigned int* destination, size_t* lod_index_counts, float* lod_errors, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options)
+{
+	using namespace meshopt;
+
+	if (lod_count == 0)
+		return 0;
+
+	// lod_errors is optional for callers, but the per-level results are always computed
+	meshopt_Allocator allocator;
+
+	if (!lod_errors)
+		lod_errors = allocator.allocate<float>(lod_count);
+
+	return simplifyEdge(NULL, destination, lod_index_counts, lod_errors, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_counts, target_errors, lod_count, options);
+}
+
+namespace meshopt
+{
+
+struct SimplifyPartitions
+{
+	unsigned int* indices;
+	const size_t* offsets;
+	size_t* counts;
+	float* errors;
+
+	const float* vertex_positions_data;
+	size_t vertex_count;
+	size_t vertex_positions_stride;
+	const unsigned char* vertex_lock;
+
+	double target_ratio;
+	float target_error;
+	unsigned int options;
+};
+
+static void simplifyPartition(void* data, size_t index)
+{
+	const SimplifyPartitions& job = *static_cast<const SimplifyPartitions*>(data);
+
+	unsigned int* indices = job.indices + job.offsets[index];
+	size_t index_count = job.offsets[index + 1] - job.offsets[index];
+	// triangles that touch locked seams can't be simplified much on their own; reduce the target to avoid excessive error in the remaining triangles
+	size_t seam_index_count = 0;
+
+	for (size_t i = 0; i < index_count; i += 3)
+		seam_index_count += (job.vertex_lock[indices[i + 0]] | job.vertex_lock[indices[i + 1]] | job.vertex_lock[indices[i + 2]]) ? 3 : 0;
+
+	size_t target_index_count = seam_index_count + size_t(double(index_count - seam_index_count) * job.target_ratio) / 3 * 3;
+
+	// partitions are simplified in place; error is absolute so that all partitions use the same error units
+	job.counts[index] = meshopt_simplifyEdge(indices, indices, index_count, job.vertex_positions_data, job.vertex_count, job.vertex_positions_stride, NULL, 0, NULL, 0, job.vertex_lock, target_index_count, job.target_error, job.options, &job.errors[index]);
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context)
 {
 	using namespace meshopt;
 
@@ -1746,23 +2016,276 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
 	assert(target_index_count <= index_count);
+	assert((options & ~(meshopt_SimplifyLockBorder | meshopt_SimplifyErrorAbsolute)) == 0);
+	assert(partition_count > 0);
 
-	// we expect to get ~2 triangles/vertex in the output
-	size_t target_cell_count = target_index_count / 6;
+	size_t face_count = index_count / 3;
+
+	// each partition needs enough triangles for simplification to be worthwhile
+	const size_t kMinPartitionTriangles = 1024;
+
+	if (partition_count > face_count / kMinPartitionTriangles)
+		partition_count = face_count / kMinPartitionTriangles;
+
+	if (partition_count <= 1)
+		return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, NULL, 0, NULL, 0, NULL, target_index_count, target_error, options, out_result_error);
 
 	meshopt_Allocator allocator;
 
-	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
-	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
+	// all passes use absolute errors since partitions have different extents
+	float error_scale = (options & meshopt_SimplifyErrorAbsolute) ? 1.f : rescalePositions(NULL, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	// spatially coherent triangle order makes equal triangle ranges reasonably compact partitions
+	unsigned int* result = allocator.allocate<unsigned int>(index_count);
+	meshopt_spatialSortTriangles(result, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	size_t* offsets = allocator.allocate<size_t>(partition_count + 1);
+
+	for (size_t i = 0; i <= partition_count; ++i)
+		offsets[i] = (face_count * i / partition_count) * 3;
+
+	// lock vertices whose positions are shared between partitions so that all partitions agree on the seams
+	unsigned char* vertex_lock = allocator.allocate<unsigned char>(vertex_count);
+	{
+		unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
+		unsigned int* wedge = allocator.allocate<unsigned int>(vertex_count);
+		buildPositionRemap(remap, wedge, vertex_positions_data, vertex_count, vertex_positions_stride, NULL, allocator);
+
+		unsigned int* vertex_partition = wedge; // no longer needed
+		memset(vertex_partition, -1, vertex_count * sizeof(unsigned int));
+		memset(vertex_lock, 0, vertex_count);
+
+		for (size_t i = 0; i < partition_count; ++i)
+			for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+			{
+				unsigned int r = remap[result[j]];
+
+				if (vertex_partition[r] == ~0u)
+					vertex_partition[r] = unsigned(i);
+				else if (vertex_partition[r] != i)
+					vertex_lock[r] = 1;
+			}
+
+		for (size_t i = 0; i < vertex_count; ++i)
+			vertex_lock[i] = vertex_lock[remap[i]];
+	}
+
+	size_t* counts = allocator.allocate<size_t>(partition_count);
+	float* errors = allocator.allocate<float>(partition_count);
+
+	SimplifyPartitions job = {};
+	job.indices = result;
+	job.offsets = offsets;
+	job.counts = counts;
+	job.errors = errors;
+	job.vertex_positions_data = vertex_positions_data;
+	job.vertex_count = vertex_count;
+	job.vertex_positions_stride = vertex_positions_stride;
+	job.vertex_lock = vertex_lock;
+	job.target_ratio = double(target_index_count) / double(index_count);
+	job.target_error = target_error * error_scale;
+	job.options = options | meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute;
+
+	if (scheduler)
+		scheduler(scheduler_context, simplifyPartition, &job, partition_count);
+	else
+		for (size_t i = 0; i < partition_count; ++i)
+			simplifyPartition(&job, i);
+
+	// compact partition results and simplify the seams; this pass only processes vertices that are still referenced
+	size_t result_count = 0;
+	float result_error = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		memmove(&result[result_count], &result[offsets[i]], counts[i] * sizeof(unsigned int));
+		result_count += counts[i];
+		result_error = result_error < errors[i] ? errors[i] : result_error;
+	}
+
+	float seam_error = 0;
+	result_count = meshopt_simplifyEdge(destination, result, result_count, vertex_positions_data, vertex_count, vertex_positions_stride, NULL, 0, NULL, 0, NULL, target_index_count < result_count ? target_index_count : result_count, target_error * error_scale, options | meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute, &seam_error);
+
+	// errors from separate passes are not cumulative; the maximum is a reasonable approximation
+	result_error = result_error < seam_error ? seam_error : result_error;
+
+	if (out_result_error)
+		*out_result_error = error_scale == 0.f ? 0.f : result_error / error_scale;
+
+	return result_count;
+}
+
+namespace meshopt
+{
+
+// tasks are split by element count (not by scheduler parallelism) so that the results don't depend on the scheduler
+const size_t kTaskSize = 65536;
+const size_t kMaxTasks = 64;
+
+struct SimplifySloppyJob
+{
+	meshopt_Scheduler scheduler;
+	void* scheduler_context;
+	size_t max_tasks;
+
+	const unsigned int* indices;
+	size_t index_count;
+	const Vector3* vertex_positions;
+	size_t vertex_count;
+
+	size_t task_count;
+
+	// grid search
+	int grid_size;
+	unsigned int* vertex_ids;
+	size_t* task_triangles;
+
+	// cell accumulation; per-task cell data is stored with a stride of cell_count and merged into the first task range
+	const unsigned int* vertex_cells;
+	size_t cell_count;
+	Quadric* cell_quadrics;
+	unsigned int* cell_remap;
+	float* cell_errors;
+	size_t merge_count;
+};
+
+static size_t getTaskCount(size_t count, size_t min_size)
+{
+	size_t result = count / (min_size > kTaskSize ? min_size : kTaskSize);
+
+	return result < 1 ? 1 : (result > kMaxTasks ? kMaxTasks : result);
+}
+
+static size_t getSloppyTaskCount(const SimplifySloppyJob& job, size_t count, size_t min_size)
+{
+	size_t result = getTaskCount(count, min_size);
+
+	return result > job.max_tasks ? job.max_tasks : result;
+}
+
+static void runSloppyTasks(SimplifySloppyJob& job, void (*task)(void*, size_t), size_t task_count)
+{
+	job.task_count = task_count;
+
+	if (job.scheduler && task_count > 1)
+		job.scheduler(job.scheduler_context, task, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			task(&job, i);
+}
+
+static void sloppyComputeVertexIds(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t begin = job.vertex_count * index / job.task_count, end = job.vertex_count * (index + 1) / job.task_count;
+
+	computeVertexIds(job.vertex_ids + begin, job.vertex_positions + begin, end - begin, job.grid_size);
+}
+
+static void sloppyCountTriangles(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t face_count = job.index_count / 3;
+	size_t begin = face_count * index / job.task_count, end = face_count * (index + 1) / job.task_count;
+
+	job.task_triangles[index] = countTriangles(job.vertex_ids, job.indices + begin * 3, (end - begin) * 3);
+}
+
+static void sloppyFillCellQuadrics(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t face_count = job.index_count / 3;
+	size_t begin = face_count * index / job.task_count, end = face_count * (index + 1) / job.task_count;
+
+	Quadric* cell_quadrics = job.cell_quadrics + index * job.cell_count;
+	memset(cell_quadrics, 0, job.cell_count * sizeof(Quadric));
+
+	fillCellQuadrics(cell_quadrics, job.indices + begin * 3, (end - begin) * 3, job.vertex_positions, job.vertex_cells);
+}
+
+static void sloppyMergeCellQuadrics(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t begin = job.cell_count * index / job.task_count, end = job.cell_count * (index + 1) / job.task_count;
+
+	// merge in task order to get the same result regardless of the order in which tasks ran
+	for (size_t i = begin; i < end; ++i)
+		for (size_t k = 1; k < job.merge_count; ++k)
+			quadricAdd(job.cell_quadrics[i], job.cell_quadrics[k * job.cell_count + i]);
+}
+
+static void sloppyFillCellRemap(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t begin = job.vertex_count * index / job.task_count, end = job.vertex_count * (index + 1) / job.task_count;
+
+	// note: remap entries are relative to the start of the task range
+	fillCellRemap(job.cell_remap + index * job.cell_count, job.cell_errors + index * job.cell_count, job.cell_count, job.vertex_cells + begin, job.cell_quadrics, job.vertex_positions + begin, end - begin);
+}
+
+static void sloppyMergeCellRemap(void* data, size_t index)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(data);
+
+	size_t begin = job.cell_count * index / job.task_count, end = job.cell_count * (index + 1) / job.task_count;
+
+	// tasks cover vertex ranges in order, so picking the first minimum selects the same vertex as a serial scan
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int best = ~0u;
+		float best_error = 0.f;
+
+		for (size_t k = 0; k < job.merge_count; ++k)
+		{
+			unsigned int vertex = job.cell_remap[k * job.cell_count + i];
+			float error = job.cell_errors[k * job.cell_count + i];
+
+			if (vertex != ~0u && (best == ~0u || best_error > error))
+			{
+				best = vertex + unsigned(job.vertex_count * k / job.merge_count);
+				best_error = error;
+			}
+		}
+
+		job.cell_remap[i] = best;
+		job.cell_errors[i] = best_error;
+	}
+}
+
+static size_t countSloppyTriangles(void* context, int grid_size)
+{
+	SimplifySloppyJob& job = *static_cast<SimplifySloppyJob*>(context);
+
+	size_t triangle_tasks = getSloppyTaskCount(job, job.index_count / 3, 0);
+
+	job.grid_size = grid_size;
+	runSloppyTasks(job, sloppyComputeVertexIds, getSloppyTaskCount(job, job.vertex_count, 0));
+	runSloppyTasks(job, sloppyCountTriangles, triangle_tasks);
+
+	size_t result = 0;
+	for (size_t i = 0; i < triangle_tasks; ++i)
+		result += job.task_triangles[i];
+
+	return result;
+}
+
+typedef size_t (*SloppyCountTriangles)(void* context, int grid_size);
+
+// finds the largest grid size that produces at most target_index_count/3 triangles using guided binary search
+static int searchSloppyGrid(size_t& out_triangles, size_t index_count, size_t target_index_count, float target_error, SloppyCountTriangles count_triangles, void* context)
+{
+	// we expect to get ~2 triangles/vertex in the output
+	size_t target_cell_count = target_index_count / 6;
 
-	// find the optimal grid size using guided binary search
 #if TRACE
-	printf("source: %d vertices, %d triangles\n", int(vertex_count), int(index_count / 3));
 	printf("target: %d cells, %d triangles\n", int(target_cell_count), int(target_index_count / 3));
 #endif
 
-	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
-
 	const int kInterpolationPasses = 5;
 
 	// invariant: # of triangles in min_grid <= target_count
@@ -1773,10 +2296,7 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 
 	// when we're error-limited, we compute the triangle count for the min. size; this accelerates convergence and provides the correct answer when we can't use a larger grid
 	if (min_grid > 1)
-	{
-		computeVertexIds(vertex_ids, vertex_positions, vertex_count, min_grid);
-		min_triangles = countTriangles(vertex_ids, indices, index_count);
-	}
+		min_triangles = count_triangles(context, min_grid);
 
 	// instead of starting in the middle, let's guess as to what the answer might be! triangle count usually grows as a square of grid size...
 	int next_grid_size = int(sqrtf(float(target_cell_count)) + 0.5f);
@@ -1790,8 +2310,7 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 		int grid_size = next_grid_size;
 		grid_size = (grid_size <= min_grid) ? min_grid + 1 : (grid_size >= max_grid ? max_grid - 1 : grid_size);
 
-		computeVertexIds(vertex_ids, vertex_positions, vertex_count, grid_size);
-		size_t triangles = countTriangles(vertex_ids, indices, index_count);
+		size_t triangles = count_triangles(context, grid_size);
 
 #if TRACE
 		printf("pass %d (%s): grid size %d, triangles %d, %s\n",
@@ -1818,47 +2337,95 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 		next_grid_size = (pass < kInterpolationPasses) ? int(tip + 0.5f) : (min_grid + max_grid) / 2;
 	}
 
-	if (min_triangles == 0)
-	{
-		if (out_result_error)
-			*out_result_error = 1.f;
-
-		return 0;
-	}
+	out_triangles = min_triangles;
+	return min_grid;
+}
+
+// max_tasks == 1 runs every pass as a single task, which matches the original serial algorithm exactly
+static size_t simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error, size_t max_tasks, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(target_index_count <= index_count);
+
+	meshopt_Allocator allocator;
+
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+#if TRACE
+	printf("source: %d vertices, %d triangles\n", int(vertex_count), int(index_count / 3));
+#endif
+
+	SimplifySloppyJob job = {};
+	job.scheduler = scheduler;
+	job.scheduler_context = scheduler_context;
+	job.max_tasks = max_tasks;
+	job.indices = indices;
+	job.index_count = index_count;
+	job.vertex_positions = vertex_positions;
+	job.vertex_count = vertex_count;
+	job.vertex_ids = allocator.allocate<unsigned int>(vertex_count);
+	job.task_triangles = allocator.allocate<size_t>(max_tasks);
+
+	size_t min_triangles = 0;
+	int min_grid = searchSloppyGrid(min_triangles, index_count, target_index_count, target_error, countSloppyTriangles, &job);
+
+	if (min_triangles == 0)
+	{
+		if (out_result_error)
+			*out_result_error = 1.f;
+
+		return 0;
+	}
 
 	// build vertex->cell association by mapping all vertices with the same quantized position to the same cell
+	job.grid_size = min_grid;
+	runSloppyTasks(job, sloppyComputeVertexIds, getSloppyTaskCount(job, vertex_count, 0));
+
 	size_t table_size = hashBuckets2(vertex_count);
 	unsigned int* table = allocator.allocate<unsigned int>(table_size);
 
 	unsigned int* vertex_cells = allocator.allocate<unsigned int>(vertex_count);
 
-	computeVertexIds(vertex_ids, vertex_positions, vertex_count, min_grid);
-	size_t cell_count = fillVertexCells(table, table_size, vertex_cells, vertex_ids, vertex_count);
+	size_t cell_count = fillVertexCells(table, table_size, vertex_cells, job.vertex_ids, vertex_count);
+
+	job.vertex_cells = vertex_cells;
+	job.cell_count = cell_count;
+
+	// build a quadric for each target cell; each task accumulates into its own copy of cell data, so tasks need to cover many more triangles than there are cells to keep copy & merge cheap
+	size_t quadric_tasks = getSloppyTaskCount(job, index_count / 3, cell_count * 8);
+	size_t merge_tasks = getSloppyTaskCount(job, cell_count, 0);
 
-	// build a quadric for each target cell
-	Quadric* cell_quadrics = allocator.allocate<Quadric>(cell_count);
-	memset(cell_quadrics, 0, cell_count * sizeof(Quadric));
+	job.cell_quadrics = allocator.allocate<Quadric>(cell_count * quadric_tasks);
+	runSloppyTasks(job, sloppyFillCellQuadrics, quadric_tasks);
 
-	fillCellQuadrics(cell_quadrics, indices, index_count, vertex_positions, vertex_cells);
+	job.merge_count = quadric_tasks;
+	runSloppyTasks(job, sloppyMergeCellQuadrics, merge_tasks);
 
 	// for each target cell, find the vertex with the minimal error
-	unsigned int* cell_remap = allocator.allocate<unsigned int>(cell_count);
-	float* cell_errors = allocator.allocate<float>(cell_count);
+	size_t remap_tasks = getSloppyTaskCount(job, vertex_count, cell_count * 8);
 
-	fillCellRemap(cell_remap, cell_errors, cell_count, vertex_cells, cell_quadrics, vertex_positions, vertex_count);
+	job.cell_remap = allocator.allocate<unsigned int>(cell_count * remap_tasks);
+	job.cell_errors = allocator.allocate<float>(cell_count * remap_tasks);
+	runSloppyTasks(job, sloppyFillCellRemap, remap_tasks);
+
+	job.merge_count = remap_tasks;
+	runSloppyTasks(job, sloppyMergeCellRemap, merge_tasks);
 
 	// compute error
 	float result_error = 0.f;
 
 	for (size_t i = 0; i < cell_count; ++i)
-		result_error = result_error < cell_errors[i] ? cell_errors[i] : result_error;
+		result_error = result_error < job.cell_errors[i] ? job.cell_errors[i] : result_error;
 
 	// collapse triangles!
 	// note that we need to filter out triangles that we've already output because we very frequently generate redundant triangles between cells :(
 	size_t tritable_size = hashBuckets2(min_triangles);
 	unsigned int* tritable = allocator.allocate<unsigned int>(tritable_size);
 
-	size_t write = filterTriangles(destination, tritable, tritable_size, indices, index_count, vertex_cells, cell_remap);
+	size_t write = filterTriangles(destination, tritable, tritable_size, indices, index_count, vertex_cells, job.cell_remap);
 
 #if TRACE
 	printf("result: %d cells, %d triangles (%d unfiltered), error %e\n", int(cell_count), int(write / 3), int(min_triangles), sqrtf(result_error));
@@ -1870,6 +2437,239 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 	return write;
 }
 
+} // namespace meshopt
+
+size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error)
+{
+	return meshopt::simplifySloppy(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, target_index_count, target_error, out_result_error, 1, NULL, NULL);
+}
+
+size_t meshopt_simplifySloppyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	return meshopt::simplifySloppy(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, target_index_count, target_error, out_result_error, meshopt::kMaxTasks, scheduler, scheduler_context);
+}
+
+namespace meshopt
+{
+
+// number of triangles read from the stream at a time
+const size_t kStreamBatchTriangles = 1024;
+
+struct StreamCell
+{
+	Quadric quadric;
+	Vector3 sum;
+	float count;
+};
+
+static bool quadricSolve(Vector3& result, const Quadric& Q)
+{
+	// solve A * x = -b; A is symmetric
+	float c00 = Q.a11 * Q.a22 - Q.a21 * Q.a21;
+	float c01 = Q.a20 * Q.a21 - Q.a10 * Q.a22;
+	float c02 = Q.a10 * Q.a21 - Q.a11 * Q.a20;
+	float c11 = Q.a00 * Q.a22 - Q.a20 * Q.a20;
+	float c12 = Q.a10 * Q.a20 - Q.a00 * Q.a21;
+	float c22 = Q.a00 * Q.a11 - Q.a10 * Q.a10;
+
+	float det = Q.a00 * c00 + Q.a10 * c01 + Q.a20 * c02;
+	float trace = Q.a00 + Q.a11 + Q.a22;
+
+	// flat and crease regions result in (nearly) singular matrices; the caller has to pick the position differently
+	if (fabsf(det) <= trace * trace * trace * 1e-5f || trace == 0.f)
+		return false;
+
+	float idet = 1.f / det;
+
+	result.x = -(c00 * Q.b0 + c01 * Q.b1 + c02 * Q.b2) * idet;
+	result.y = -(c01 * Q.b0 + c11 * Q.b1 + c12 * Q.b2) * idet;
+	result.z = -(c02 * Q.b0 + c12 * Q.b1 + c22 * Q.b2) * idet;
+
+	return true;
+}
+
+static Vector3 getCellPosition(const StreamCell& cell, unsigned int id, float cell_scale)
+{
+	Vector3 mean = {cell.sum.x / cell.count, cell.sum.y / cell.count, cell.sum.z / cell.count};
+
+	Vector3 result;
+	if (!quadricSolve(result, cell.quadric))
+		return mean;
+
+	// the optimal position can be far away from the cell when the matrix is badly conditioned; it must stay within the cell to avoid artifacts
+	float cx = float(id >> 20), cy = float((id >> 10) & 1023), cz = float(id & 1023);
+
+	if (fabsf(result.x * cell_scale - cx) > 0.5f || fabsf(result.y * cell_scale - cy) > 0.5f || fabsf(result.z * cell_scale - cz) > 0.5f)
+		return mean;
+
+	return result;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifySloppyStream(float* destination, size_t max_vertices, size_t max_triangles, size_t (*read_triangles)(void* context, float* triangle_positions, size_t triangle_count), void (*write_indices)(void* context, const unsigned int* indices, size_t index_count), void* context, const float* bounds_min, const float* bounds_max, float target_error, float* out_result_error)
+{
+	using namespace meshopt;
+
+	assert(read_triangles && write_indices);
+	assert(target_error >= 0);
+
+	// grid size is chosen so that the cell size matches the target error
+	int grid_size = int(1.f / (target_error < 1e-3f ? 1e-3f : target_error));
+	grid_size = grid_size < 2 ? 2 : (grid_size > 1024 ? 1024 : grid_size);
+
+	float cell_scale = float(grid_size - 1);
+
+	float extent = 0.f;
+	for (int k = 0; k < 3; ++k)
+		extent = (bounds_max[k] - bounds_min[k]) < extent ? extent : (bounds_max[k] - bounds_min[k]);
+
+	float scale = extent == 0 ? 0.f : 1.f / extent;
+
+	meshopt_Allocator allocator;
+
+	float* batch = allocator.allocate<float>(kStreamBatchTriangles * 9);
+
+	// cell data; cell_ids has an extra slot that holds the key during lookups
+	StreamCell* cells = allocator.allocate<StreamCell>(max_vertices);
+	unsigned int* cell_ids = allocator.allocate<unsigned int>(max_vertices + 1);
+
+	size_t cell_table_size = hashBuckets2(max_vertices);
+	unsigned int* cell_table = allocator.allocate<unsigned int>(cell_table_size);
+	memset(cell_table, -1, cell_table_size * sizeof(unsigned int));
+
+	// all output triangles are kept to filter out duplicates; triangles are reported to the caller after every batch
+	// the extra slot holds the key during lookups
+	unsigned int* triangles = allocator.allocate<unsigned int>((max_triangles + 1) * 3);
+
+	size_t triangle_table_size = hashBuckets2(max_triangles);
+	unsigned int* triangle_table = allocator.allocate<unsigned int>(triangle_table_size);
+	memset(triangle_table, -1, triangle_table_size * sizeof(unsigned int));
+
+	CellHasher cell_hasher = {cell_ids};
+	TriangleHasher triangle_hasher = {triangles};
+
+	size_t cell_count = 0;
+	size_t triangle_count = 0;
+
+	while (size_t batch_count = read_triangles(context, batch, kStreamBatchTriangles))
+	{
+		assert(batch_count <= kStreamBatchTriangles);
+
+		size_t batch_offset = triangle_count;
+
+		for (size_t i = 0; i < batch_count; ++i)
+		{
+			Vector3 p[3];
+			unsigned int c[3];
+
+			for (int k = 0; k < 3; ++k)
+			{
+				const float* v = &batch[i * 9 + k * 3];
+
+				// positions outside of the bounds are clamped to the boundary cells
+				float x = (v[0] - bounds_min[0]) * scale, y = (v[1] - bounds_min[1]) * scale, z = (v[2] - bounds_min[2]) * scale;
+
+				p[k].x = x < 0.f ? 0.f : (x > 1.f ? 1.f : x);
+				p[k].y = y < 0.f ? 0.f : (y > 1.f ? 1.f : y);
+				p[k].z = z < 0.f ? 0.f : (z > 1.f ? 1.f : z);
+
+				cell_ids[cell_count] = computeVertexId(p[k], cell_scale);
+
+				unsigned int* entry = hashLookup2(cell_table, cell_table_size, cell_hasher, unsigned(cell_count), ~0u);
+
+				if (*entry == ~0u)
+				{
+					// working memory is fixed, so we can't continue once all cells are used
+					if (cell_count == max_vertices)
+						return 0;
+
+					StreamCell& cell = cells[cell_count];
+					memset(&cell, 0, sizeof(cell));
+
+					*entry = unsigned(cell_count++);
+				}
+
+				c[k] = *entry;
+
+				StreamCell& cell = cells[c[k]];
+				cell.sum.x += p[k].x;
+				cell.sum.y += p[k].y;
+				cell.sum.z += p[k].z;
+				cell.count += 1;
+			}
+
+			// same weighting as fillCellQuadrics
+			int single_cell = (c[0] == c[1]) & (c[0] == c[2]);
+
+			Quadric Q;
+			quadricFromTriangle(Q, p[0], p[1], p[2], single_cell ? 3.f : 1.f);
+
+			quadricAdd(cells[c[0]].quadric, Q);
+
+			if (!single_cell)
+			{
+				quadricAdd(cells[c[1]].quadric, Q);
+				quadricAdd(cells[c[2]].quadric, Q);
+			}
+
+			if (c[0] != c[1] && c[0] != c[2] && c[1] != c[2])
+			{
+				// rotate triangle so that the smallest index is first, which makes duplicate detection independent of the winding start
+				unsigned int a = c[0], b = c[1], d = c[2];
+
+				if (b < a && b < d)
+				{
+					unsigned int t = a;
+					a = b, b = d, d = t;
+				}
+				else if (d < a && d < b)
+				{
+					unsigned int t = d;
+					d = b, b = a, a = t;
+				}
+
+				triangles[triangle_count * 3 + 0] = a;
+				triangles[triangle_count * 3 + 1] = b;
+				triangles[triangle_count * 3 + 2] = d;
+
+				unsigned int* entry = hashLookup2(triangle_table, triangle_table_size, triangle_hasher, unsigned(triangle_count), ~0u);
+
+				if (*entry == ~0u)
+				{
+					if (triangle_count == max_triangles)
+						return 0;
+
+					*entry = unsigned(triangle_count++);
+				}
+			}
+		}
+
+		if (triangle_count > batch_offset)
+			write_indices(context, &triangles[batch_offset * 3], (triangle_count - batch_offset) * 3);
+	}
+
+	// compute the final cell positions and error
+	float result_error = 0.f;
+
+	for (size_t i = 0; i < cell_count; ++i)
+	{
+		Vector3 v = getCellPosition(cells[i], cell_ids[i], cell_scale);
+
+		float error = quadricError(cells[i].quadric, v);
+		result_error = result_error < error ? error : result_error;
+
+		destination[i * 3 + 0] = v.x * extent + bounds_min[0];
+		destination[i * 3 + 1] = v.y * extent + bounds_min[1];
+		destination[i * 3 + 2] = v.z * extent + bounds_min[2];
+	}
+
+	if (out_result_error)
+		*out_result_error = sqrtf(result_error);
+
+	return cell_count;
+}
+
 size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_colors, size_t vertex_colors_stride, float color_weight, size_t target_vertex_count)
 {
 	using namespace meshopt;
@@ -1991,6 +2791,274 @@ size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_pos
 	return cell_count;
 }
 
+namespace meshopt
+{
+
+struct SimplifyPointsJob
+{
+	const Vector3* vertex_positions;
+	const float* vertex_colors;
+	size_t vertex_colors_stride;
+	float color_weight;
+
+	const unsigned int* cell_offsets;
+	const unsigned int* cell_vertices;
+	size_t cell_count;
+	const unsigned char* vertex_selected;
+	unsigned int* cell_remap;
+
+	size_t task_count;
+};
+
+static void simplifyPointsCells(void* data, size_t index)
+{
+	const SimplifyPointsJob& job = *static_cast<const SimplifyPointsJob*>(data);
+
+	static const float dummy_color[] = {0.f, 0.f, 0.f};
+
+	size_t vertex_colors_stride_float = job.vertex_colors_stride / sizeof(float);
+
+	size_t begin = job.cell_count * index / job.task_count, end = job.cell_count * (index + 1) / job.task_count;
+
+	for (size_t cell = begin; cell < end; ++cell)
+	{
+		const unsigned int* vertices = &job.cell_vertices[job.cell_offsets[cell]];
+		size_t count = job.cell_offsets[cell + 1] - job.cell_offsets[cell];
+
+		job.cell_remap[cell] = ~0u;
+
+		// cells that contain a point from one of the previous levels don't need a new point
+		bool covered = false;
+		for (size_t i = 0; i < count; ++i)
+			covered |= job.vertex_selected[vertices[i]] != 0;
+
+		if (covered)
+			continue;
+
+		// same computations as fillCellReservoirs/fillCellRemap; vertices are sorted within each cell so the results match
+		Reservoir r = {};
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Vector3& v = job.vertex_positions[vertices[i]];
+			const float* color = job.vertex_colors ? &job.vertex_colors[vertices[i] * vertex_colors_stride_float] : dummy_color;
+
+			r.x += v.x;
+			r.y += v.y;
+			r.z += v.z;
+			r.r += color[0];
+			r.g += color[1];
+			r.b += color[2];
+			r.w += 1.f;
+		}
+
+		float iw = r.w == 0.f ? 0.f : 1.f / r.w;
+
+		r.x *= iw;
+		r.y *= iw;
+		r.z *= iw;
+		r.r *= iw;
+		r.g *= iw;
+		r.b *= iw;
+
+		float best_error = 0.f;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Vector3& v = job.vertex_positions[vertices[i]];
+			const float* color = job.vertex_colors ? &job.vertex_colors[vertices[i] * vertex_colors_stride_float] : dummy_color;
+
+			float pos_error = (v.x - r.x) * (v.x - r.x) + (v.y - r.y) * (v.y - r.y) + (v.z - r.z) * (v.z - r.z);
+			float col_error = (color[0] - r.r) * (color[0] - r.r) + (color[1] - r.g) * (color[1] - r.g) + (color[2] - r.b) * (color[2] - r.b);
+			float error = pos_error + job.color_weight * col_error;
+
+			if (job.cell_remap[cell] == ~0u || best_error > error)
+			{
+				job.cell_remap[cell] = vertices[i];
+				best_error = error;
+			}
+		}
+	}
+}
+
+static size_t countNestedPoints(unsigned int* table, size_t table_size, const unsigned int* vertex_ids, size_t vertex_count, const unsigned int* selected, size_t selected_count)
+{
+	// every cell needs one point, unless it already has more than one point from previous levels
+	size_t cells = countVertexCells(table, table_size, vertex_ids, vertex_count);
+
+	IdHasher hasher;
+
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	size_t selected_cells = 0;
+
+	for (size_t i = 0; i < selected_count; ++i)
+	{
+		unsigned int id = vertex_ids[selected[i]];
+		unsigned int* entry = hashLookup2(table, table_size, hasher, id, ~0u);
+
+		selected_cells += (*entry == ~0u);
+		*entry = id;
+	}
+
+	return cells + selected_count - selected_cells;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyPointsLods(unsigned int* destination, size_t* lod_vertex_counts, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_colors, size_t vertex_colors_stride, float color_weight, const size_t* target_vertex_counts, size_t lod_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(vertex_colors_stride == 0 || (vertex_colors_stride >= 12 && vertex_colors_stride <= 256));
+	assert(vertex_colors_stride % sizeof(float) == 0);
+	assert(vertex_colors == NULL || vertex_colors_stride != 0);
+
+	for (size_t i = 0; i < lod_count; ++i)
+		assert(target_vertex_counts[i] <= vertex_count && (i == 0 || target_vertex_counts[i] >= target_vertex_counts[i - 1]));
+
+	meshopt_Allocator allocator;
+
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* vertex_cells = allocator.allocate<unsigned int>(vertex_count);
+
+	size_t table_size = hashBuckets2(vertex_count);
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+
+	unsigned char* vertex_selected = allocator.allocate<unsigned char>(vertex_count);
+	memset(vertex_selected, 0, vertex_count);
+
+	// cell data is reused between levels; there can't be more cells than vertices
+	unsigned int* cell_offsets = allocator.allocate<unsigned int>(vertex_count + 1);
+	unsigned int* cell_vertices = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* cell_remap = allocator.allocate<unsigned int>(vertex_count);
+
+	SimplifyPointsJob job = {};
+	job.vertex_positions = vertex_positions;
+	job.vertex_colors = vertex_colors;
+	job.vertex_colors_stride = vertex_colors_stride;
+	job.color_weight = color_weight * color_weight;
+	job.cell_offsets = cell_offsets;
+	job.cell_vertices = cell_vertices;
+	job.vertex_selected = vertex_selected;
+	job.cell_remap = cell_remap;
+
+	const int kInterpolationPasses = 5;
+
+	size_t result = 0;
+	int level_grid = 0;
+
+	for (size_t level = 0; level < lod_count; ++level)
+	{
+		size_t target = target_vertex_counts[level];
+
+		// the complete level doesn't need clustering; remaining points are appended in their original order
+		if (target == vertex_count)
+		{
+			for (size_t i = 0; i < vertex_count; ++i)
+				if (!vertex_selected[i])
+					destination[result++] = unsigned(i);
+
+			memset(vertex_selected, 1, vertex_count);
+
+			for (; level < lod_count; ++level)
+				lod_vertex_counts[level] = result;
+
+			break;
+		}
+
+		// find the optimal grid size using guided binary search, starting from the grid of the previous level since levels are nested
+		// invariant: # of points in min_grid <= target_count
+		int min_grid = level_grid;
+		int max_grid = 1025;
+		size_t min_vertices = result;
+		size_t max_vertices = vertex_count;
+
+		int next_grid_size = int(sqrtf(float(target)) + 0.5f);
+
+		for (int pass = 0; pass < 10 + kInterpolationPasses; ++pass)
+		{
+			if (min_vertices >= target || max_grid - min_grid <= 1)
+				break;
+
+			int grid_size = next_grid_size;
+			grid_size = (grid_size <= min_grid) ? min_grid + 1 : (grid_size >= max_grid ? max_grid - 1 : grid_size);
+
+			computeVertexIds(vertex_ids, vertex_positions, vertex_count, grid_size);
+			size_t vertices = countNestedPoints(table, table_size, vertex_ids, vertex_count, destination, result);
+
+			float tip = interpolate(float(target), float(min_grid), float(min_vertices), float(grid_size), float(vertices), float(max_grid), float(max_vertices));
+
+			if (vertices <= target)
+			{
+				min_grid = grid_size;
+				min_vertices = vertices;
+			}
+			else
+			{
+				max_grid = grid_size;
+				max_vertices = vertices;
+			}
+
+			next_grid_size = (pass < kInterpolationPasses) ? int(tip + 0.5f) : (min_grid + max_grid) / 2;
+		}
+
+		if (min_grid > level_grid)
+		{
+			computeVertexIds(vertex_ids, vertex_positions, vertex_count, min_grid);
+			size_t cell_count = fillVertexCells(table, table_size, vertex_cells, vertex_ids, vertex_count);
+
+			// sort vertices by cell so that each cell can be processed independently
+			memset(cell_offsets, 0, (cell_count + 1) * sizeof(unsigned int));
+
+			for (size_t i = 0; i < vertex_count; ++i)
+				cell_offsets[vertex_cells[i] + 1]++;
+
+			for (size_t i = 0; i < cell_count; ++i)
+				cell_offsets[i + 1] += cell_offsets[i];
+
+			for (size_t i = 0; i < vertex_count; ++i)
+				cell_vertices[cell_offsets[vertex_cells[i]]++] = unsigned(i);
+
+			// restore offsets
+			for (size_t i = cell_count; i > 0; --i)
+				cell_offsets[i] = cell_offsets[i - 1];
+
+			cell_offsets[0] = 0;
+
+			size_t task_count = getTaskCount(vertex_count, 0);
+
+			job.cell_count = cell_count;
+			job.task_count = task_count;
+
+			if (scheduler && task_count > 1)
+				scheduler(scheduler_context, simplifyPointsCells, &job, task_count);
+			else
+				for (size_t i = 0; i < task_count; ++i)
+					simplifyPointsCells(&job, i);
+
+			for (size_t i = 0; i < cell_count; ++i)
+				if (cell_remap[i] != ~0u)
+				{
+					destination[result++] = cell_remap[i];
+					vertex_selected[cell_remap[i]] = 1;
+				}
+
+			assert(result == min_vertices);
+			level_grid = min_grid;
+		}
+
+		lod_vertex_counts[level] = result;
+	}
+
+	return result;
+}
+
 float meshopt_simplifyScale(const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
 	using namespace meshopt;
@@ -2002,3 +3070,5 @@ float meshopt_simplifyScale(const float* vertex_positions, size_t vertex_count,
 
 	return extent;
 }
+
+#undef SIMD_SSE2
@@ -1,5 +1,6 @@
 // This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
 #include "meshoptimizer.h"
+#include "internal.h"
 
 #include <assert.h>
 #include <float.h>
@@ -7,6 +8,7 @@
 
 // This work is based on:
 // Fabian Giesen. Decoding Morton codes. 2009
+// John Skilling. Programming the Hilbert curve. 2004
 namespace meshopt
 {
 
@@ -107,6 +109,171 @@ static void radixPass(unsigned int* destination, const unsigned int* source, con
 	}
 }
 
+const size_t kSpatialSortChunkSize = 65536;
+const int kSpatialSortRadixBits = 11;
+
+// "Insert" two 0 bits after each of the 21 low bits of x
+inline unsigned long long part1By2Wide(unsigned long long x)
+{
+	x &= 0x1fffffULL;
+	x = (x | (x << 32)) & 0x1f00000000ffffULL;
+	x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+	x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+	x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+	x = (x | (x << 2)) & 0x1249249249249249ULL;
+	return x;
+}
+
+// Converts coordinates to the transposed Hilbert index in-place; interleaving the resulting bits (x first) produces the index along the curve
+static void axesToTranspose(unsigned int (&x)[3], int bits)
+{
+	unsigned int m = 1u << (bits - 1);
+
+	// inverse undo
+	for (unsigned int q = m; q > 1; q >>= 1)
+	{
+		unsigned int p = q - 1;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			if (x[i] & q)
+			{
+				x[0] ^= p;
+			}
+			else
+			{
+				unsigned int t = (x[0] ^ x[i]) & p;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+	// gray encode
+	x[1] ^= x[0];
+	x[2] ^= x[1];
+
+	unsigned int t = 0;
+
+	for (unsigned int q = m; q > 1; q >>= 1)
+		if (x[2] & q)
+			t ^= q - 1;
+
+	x[0] ^= t;
+	x[1] ^= t;
+	x[2] ^= t;
+}
+
+struct SpatialSortJob
+{
+	const float* positions;
+	size_t vertex_stride_float;
+	size_t count;
+
+	float minv[3];
+	float scale;
+	unsigned int options;
+
+	unsigned long long* keys;
+	unsigned long long* key_diff; // per chunk: bits that differ between keys
+
+	// keys are moved along with indices so that every pass reads its input sequentially
+	const unsigned long long* key_source;
+	unsigned long long* key_destination;
+	const unsigned int* source;
+	unsigned int* destination;
+	size_t chunk_size;
+	int shift;
+
+	unsigned int* histograms; // per chunk
+};
+
+static void computeKeysChunk(void* data, size_t chunk)
+{
+	SpatialSortJob& job = *static_cast<SpatialSortJob*>(data);
+
+	size_t begin = chunk * kSpatialSortChunkSize;
+	size_t end = begin + kSpatialSortChunkSize < job.count ? begin + kSpatialSortChunkSize : job.count;
+
+	bool wide = (job.options & (meshopt_SpatialSortPrecise | meshopt_SpatialSortHilbert)) != 0;
+	float grid = wide ? float((1 << 21) - 1) : 1023.f;
+
+	unsigned long long key_or = 0, key_and = ~0ull;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const float* v = job.positions + i * job.vertex_stride_float;
+
+		unsigned int x = unsigned(int((v[0] - job.minv[0]) * job.scale * grid + 0.5f));
+		unsigned int y = unsigned(int((v[1] - job.minv[1]) * job.scale * grid + 0.5f));
+		unsigned int z = unsigned(int((v[2] - job.minv[2]) * job.scale * grid + 0.5f));
+
+		unsigned long long key;
+
+		if (job.options & meshopt_SpatialSortHilbert)
+		{
+			unsigned int h[3] = {x, y, z};
+			axesToTranspose(h, 21);
+
+			key = (part1By2Wide(h[0]) << 2) | (part1By2Wide(h[1]) << 1) | part1By2Wide(h[2]);
+		}
+		else if (wide)
+			key = part1By2Wide(x) | (part1By2Wide(y) << 1) | (part1By2Wide(z) << 2);
+		else
+			key = part1By2(x) | (part1By2(y) << 1) | (part1By2(z) << 2);
+
+		job.keys[i] = key;
+
+		key_or |= key;
+		key_and &= key;
+	}
+
+	job.key_diff[chunk] = key_or ^ key_and;
+}
+
+static void countDigitsChunk(void* data, size_t chunk)
+{
+	const SpatialSortJob& job = *static_cast<const SpatialSortJob*>(data);
+
+	size_t begin = chunk * job.chunk_size;
+	size_t end = begin + job.chunk_size < job.count ? begin + job.chunk_size : job.count;
+
+	unsigned int* hist = job.histograms + (chunk << kSpatialSortRadixBits);
+	memset(hist, 0, sizeof(unsigned int) << kSpatialSortRadixBits);
+
+	for (size_t i = begin; i < end; ++i)
+		hist[(job.key_source[i] >> job.shift) & ((1 << kSpatialSortRadixBits) - 1)]++;
+}
+
+static void scatterDigitsChunk(void* data, size_t chunk)
+{
+	const SpatialSortJob& job = *static_cast<const SpatialSortJob*>(data);
+
+	size_t begin = chunk * job.chunk_size;
+	size_t end = begin + job.chunk_size < job.count ? begin + job.chunk_size : job.count;
+
+	// histograms contain output offsets for each digit of this chunk at this point
+	unsigned int* offsets = job.histograms + (chunk << kSpatialSortRadixBits);
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned long long key = job.key_source[i];
+		unsigned int offset = offsets[(key >> job.shift) & ((1 << kSpatialSortRadixBits) - 1)]++;
+
+		job.destination[offset] = job.source[i];
+		job.key_destination[offset] = key;
+	}
+}
+
+static void runSpatialSortTask(meshopt_Scheduler scheduler, void* scheduler_context, void (*task)(void*, size_t), SpatialSortJob& job, size_t task_count)
+{
+	if (scheduler)
+		scheduler(scheduler_context, task, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			task(&job, i);
+}
+
 } // namespace meshopt
 
 void meshopt_spatialSortRemap(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
@@ -140,6 +307,131 @@ void meshopt_spatialSortRemap(unsigned int* destination, const float* vertex_pos
 }
 
 void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+{
+	meshopt_spatialSortTrianglesParallel(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, 0, NULL, NULL);
+}
+
+void meshopt_spatialSortRemapParallel(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert((options & ~(meshopt_SpatialSortPrecise | meshopt_SpatialSortHilbert)) == 0);
+
+	// default ordering without a scheduler uses the serial sort with 30-bit Morton keys which is faster for that case
+	if (options == 0 && !scheduler)
+		return meshopt_spatialSortRemap(destination, vertex_positions, vertex_count, vertex_positions_stride);
+
+	meshopt_Allocator allocator;
+
+	if (vertex_count == 0)
+		return;
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		const float* v = vertex_positions + i * vertex_stride_float;
+
+		for (int j = 0; j < 3; ++j)
+		{
+			float vj = v[j];
+
+			minv[j] = minv[j] > vj ? vj : minv[j];
+			maxv[j] = maxv[j] < vj ? vj : maxv[j];
+		}
+	}
+
+	float extent = 0.f;
+
+	extent = (maxv[0] - minv[0]) < extent ? extent : (maxv[0] - minv[0]);
+	extent = (maxv[1] - minv[1]) < extent ? extent : (maxv[1] - minv[1]);
+	extent = (maxv[2] - minv[2]) < extent ? extent : (maxv[2] - minv[2]);
+
+	size_t chunk_count = (vertex_count + kSpatialSortChunkSize - 1) / kSpatialSortChunkSize;
+
+	SpatialSortJob job = {};
+	job.positions = vertex_positions;
+	job.vertex_stride_float = vertex_stride_float;
+	job.count = vertex_count;
+	memcpy(job.minv, minv, sizeof(minv));
+	job.scale = extent == 0 ? 0.f : 1.f / extent;
+	job.options = options;
+	job.keys = allocator.allocate<unsigned long long>(vertex_count);
+	job.key_diff = allocator.allocate<unsigned long long>(chunk_count);
+	job.histograms = allocator.allocate<unsigned int>(chunk_count << kSpatialSortRadixBits);
+
+	runSpatialSortTask(scheduler, scheduler_context, computeKeysChunk, job, chunk_count);
+
+	// digits that are the same for all keys don't affect the order so their passes can be skipped
+	unsigned long long key_diff = 0;
+
+	for (size_t i = 0; i < chunk_count; ++i)
+		key_diff |= job.key_diff[i];
+
+	unsigned int* order = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* scratch = allocator.allocate<unsigned int>(vertex_count);
+	unsigned long long* key_scratch = allocator.allocate<unsigned long long>(vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		order[i] = unsigned(i);
+
+	// without a scheduler, the entire array is sorted as one chunk which keeps the scatter pattern identical to a serial radix sort
+	size_t sort_chunk_count = scheduler ? chunk_count : 1;
+	job.chunk_size = scheduler ? kSpatialSortChunkSize : vertex_count;
+
+	unsigned long long* keys = job.keys;
+
+	// stable LSD radix sort; each pass computes per-chunk histograms and scatters chunks in parallel
+	for (int shift = 0; shift < 64; shift += kSpatialSortRadixBits)
+	{
+		if (((key_diff >> shift) & ((1 << kSpatialSortRadixBits) - 1)) == 0)
+			continue;
+
+		job.key_source = keys;
+		job.key_destination = key_scratch;
+		job.source = order;
+		job.destination = scratch;
+		job.shift = shift;
+
+		runSpatialSortTask(scheduler, scheduler_context, countDigitsChunk, job, sort_chunk_count);
+
+		// convert histograms to output offsets; for each digit, chunks are laid out in order to keep the sort stable
+		unsigned int offset = 0;
+
+		for (size_t digit = 0; digit < (1 << kSpatialSortRadixBits); ++digit)
+			for (size_t chunk = 0; chunk < sort_chunk_count; ++chunk)
+			{
+				unsigned int& h = job.histograms[(chunk << kSpatialSortRadixBits) + digit];
+				unsigned int count = h;
+
+				h = offset;
+				offset += count;
+			}
+
+		assert(offset == vertex_count);
+
+		runSpatialSortTask(scheduler, scheduler_context, scatterDigitsChunk, job, sort_chunk_count);
+
+		unsigned int* temp = order;
+		order = scratch;
+		scratch = temp;
+
+		unsigned long long* key_temp = keys;
+		keys = key_scratch;
+		key_scratch = key_temp;
+	}
+
+	// since our remap table is mapping old=>new, we need to reverse it
+	for (size_t i = 0; i < vertex_count; ++i)
+		destination[order[i]] = unsigned(i);
+}
+
+void meshopt_spatialSortTrianglesParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int options, meshopt_Scheduler scheduler, void* scheduler_context)
 {
 	using namespace meshopt;
 
@@ -172,7 +464,7 @@ void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int*
 
 	unsigned int* remap = allocator.allocate<unsigned int>(face_count);
 
-	meshopt_spatialSortRemap(remap, centroids, face_count, sizeof(float) * 3);
+	meshopt_spatialSortRemapParallel(remap, centroids, face_count, sizeof(float) * 3, options, scheduler, scheduler_context);
 
 	// support in-order remap
 	if (destination == indices)
@@ -192,3 +484,43 @@ void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int*
 		destination[r * 3 + 2] = c;
 	}
 }
+
+size_t meshopt::partitionTriangles(unsigned int* destination, unsigned int* local_vertices, size_t* vertex_offsets, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* triangle_offsets, size_t partition_count)
+{
+	assert(index_count % 3 == 0);
+	assert(triangle_offsets[0] == 0 && triangle_offsets[partition_count] == index_count / 3);
+
+	// spatially coherent triangle order makes contiguous triangle ranges reasonably compact partitions
+	meshopt_spatialSortTriangles(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride);
+
+	meshopt_Allocator allocator;
+
+	unsigned int* vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_local, -1, vertex_count * sizeof(unsigned int));
+
+	size_t local_vertex_count = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		vertex_offsets[i] = local_vertex_count;
+
+		for (size_t j = triangle_offsets[i] * 3; j < triangle_offsets[i + 1] * 3; ++j)
+		{
+			unsigned int v = destination[j];
+			assert(v < vertex_count);
+
+			// entries from previous partitions are recognized by their position in local_vertices
+			if (vertex_local[v] == ~0u || vertex_local[v] < vertex_offsets[i])
+			{
+				vertex_local[v] = unsigned(local_vertex_count);
+				local_vertices[local_vertex_count++] = v;
+			}
+
+			destination[j] = vertex_local[v] - unsigned(vertex_offsets[i]);
+		}
+	}
+
+	vertex_offsets[partition_count] = local_vertex_count;
+
+	return local_vertex_count;
+}
@@ -50,9 +50,15 @@ static int findStripNext(const unsigned int buffer[][3], unsigned int buffer_siz
 } // namespace meshopt
 
 size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index)
+{
+	return meshopt_stripifyWindowed(destination, indices, index_count, vertex_count, restart_index, index_count / 3);
+}
+
+size_t meshopt_stripifyWindowed(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index, size_t window_size)
 {
 	assert(destination != indices);
 	assert(index_count % 3 == 0);
+	assert(window_size > 0 || index_count == 0);
 
 	using namespace meshopt;
 
@@ -64,6 +70,7 @@ size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices,
 	unsigned int buffer_size = 0;
 
 	size_t index_offset = 0;
+	size_t window_end = 0;
 
 	unsigned int strip[2] = {};
 	unsigned int parity = 0;
@@ -88,8 +95,12 @@ size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices,
 	{
 		assert(next < 0 || (size_t(next >> 2) < buffer_size && (next & 3) < 3));
 
+		// advance to the next window once all triangles from the current one have been emitted; triangles never cross windows
+		if (buffer_size == 0 && index_offset == window_end)
+			window_end = (index_count - index_offset) / 3 > window_size ? index_offset + window_size * 3 : index_count;
+
 		// fill triangle buffer
-		while (buffer_size < buffer_capacity && index_offset < index_count)
+		while (buffer_size < buffer_capacity && index_offset < window_end)
 		{
 			buffer[buffer_size][0] = indices[index_offset + 0];
 			buffer[buffer_size][1] = indices[index_offset + 1];
@@ -287,6 +298,28 @@ size_t meshopt_unstripify(unsigned int* destination, const unsigned int* indices
 	return offset;
 }
 
+meshopt_StripStatistics meshopt_analyzeStrip(const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size)
+{
+	meshopt_StripStatistics result = {};
+
+	if (index_count < 3)
+		return result;
+
+	meshopt_Allocator allocator;
+
+	unsigned int* triangles = allocator.allocate<unsigned int>(meshopt_unstripifyBound(index_count));
+	size_t triangle_index_count = meshopt_unstripify(triangles, indices, index_count, restart_index);
+
+	result.triangles = unsigned(triangle_index_count / 3);
+	result.indices = unsigned(index_count);
+	result.index_ratio = triangle_index_count == 0 ? 0.f : float(index_count) / float(triangle_index_count);
+
+	// the GPU processes strip vertices in the order they are referenced, which matches the order of the unstripified list
+	result.vertex_cache = meshopt_analyzeVertexCache(triangles, triangle_index_count, vertex_count, cache_size, warp_size, primgroup_size);
+
+	return result;
+}
+
 size_t meshopt_unstripifyBound(size_t index_count)
 {
 	assert(index_count == 0 || index_count >= 3);
@@ -1,5 +1,6 @@
 // This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
 #include "meshoptimizer.h"
+#include "internal.h"
 
 #include <assert.h>
 #include <string.h>
@@ -13,6 +14,9 @@ namespace meshopt
 const size_t kCacheSizeMax = 16;
 const size_t kValenceMax = 8;
 
+// Smallest number of triangles in a partition for meshopt_optimizeVertexCacheParallel; smaller partitions lose too much efficiency on seams
+const size_t kVertexCachePartitionMin = 16384;
+
 struct VertexScoreTable
 {
 	float cache[1 + kCacheSizeMax];
@@ -164,15 +168,11 @@ static unsigned int getNextTriangleDeadEnd(unsigned int& input_cursor, const uns
 	return ~0u;
 }
 
-} // namespace meshopt
-
-void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt::VertexScoreTable* table)
+static void optimizeVertexCacheTable(meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const VertexScoreTable* table)
 {
-	using namespace meshopt;
-
 	assert(index_count % 3 == 0);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	// guard for empty meshes
 	if (index_count == 0 || vertex_count == 0)
@@ -342,14 +342,114 @@ void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned
 	assert(output_triangle == face_count);
 }
 
+struct VertexCachePartitions
+{
+	unsigned int* destination;
+	const unsigned int* indices;
+	const unsigned int* local_vertices;
+
+	const size_t* triangle_offsets;
+	const size_t* vertex_offsets;
+};
+
+static void optimizeVertexCachePartition(void* data, size_t index)
+{
+	const VertexCachePartitions& job = *static_cast<const VertexCachePartitions*>(data);
+
+	size_t offset = job.triangle_offsets[index] * 3;
+	size_t count = job.triangle_offsets[index + 1] * 3 - offset;
+
+	const unsigned int* local_vertices = job.local_vertices + job.vertex_offsets[index];
+
+	optimizeVertexCacheTable(NULL, job.destination + offset, job.indices + offset, count, job.vertex_offsets[index + 1] - job.vertex_offsets[index], &kVertexScoreTable);
+
+	// convert local vertex indices back to original vertex indices
+	for (size_t i = offset; i < offset + count; ++i)
+		job.destination[i] = local_vertices[job.destination[i]];
+}
+
+} // namespace meshopt
+
+void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table)
+{
+	using namespace meshopt;
+
+	assert(sizeof(table->cache) == kCacheSizeMax * sizeof(float));
+	assert(sizeof(table->live) == kValenceMax * sizeof(float));
+
+	for (size_t i = 0; i < kCacheSizeMax; ++i)
+		assert(table->cache[i] >= 0);
+
+	// positive live scores guarantee that triangles with live vertices have positive scores
+	for (size_t i = 0; i < kValenceMax; ++i)
+		assert(table->live[i] > 0);
+
+	// internal table reserves the first entries for vertices outside of the cache and vertices without live triangles
+	VertexScoreTable internal = {};
+	memcpy(internal.cache + 1, table->cache, sizeof(table->cache));
+	memcpy(internal.live + 1, table->live, sizeof(table->live));
+
+	optimizeVertexCacheTable(NULL, destination, indices, index_count, vertex_count, &internal);
+}
+
 void meshopt_optimizeVertexCache(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
 {
-	meshopt_optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable);
+	meshopt::optimizeVertexCacheTable(NULL, destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable);
+}
+
+void meshopt_optimizeVertexCacheParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t partition_count, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(partition_count > 0);
+
+	size_t face_count = index_count / 3;
+
+	// tiny partitions are dominated by seam costs
+	if (partition_count > face_count / kVertexCachePartitionMin)
+		partition_count = face_count / kVertexCachePartitionMin;
+
+	if (partition_count <= 1)
+		return optimizeVertexCacheTable(NULL, destination, indices, index_count, vertex_count, &kVertexScoreTable);
+
+	meshopt_Allocator allocator;
+
+	size_t* triangle_offsets = allocator.allocate<size_t>(partition_count + 1);
+	size_t* vertex_offsets = allocator.allocate<size_t>(partition_count + 1);
+
+	for (size_t i = 0; i <= partition_count; ++i)
+		triangle_offsets[i] = face_count * i / partition_count;
+
+	// sort triangles spatially and convert each partition to local vertex indices so that per-vertex data in partitions only covers the vertices they use; this also supports in-place optimization
+	unsigned int* sorted = allocator.allocate<unsigned int>(index_count);
+	unsigned int* local_vertices = allocator.allocate<unsigned int>(index_count);
+	partitionTriangles(sorted, local_vertices, vertex_offsets, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, triangle_offsets, partition_count);
+
+	VertexCachePartitions job = {};
+	job.destination = destination;
+	job.indices = sorted;
+	job.local_vertices = local_vertices;
+	job.triangle_offsets = triangle_offsets;
+	job.vertex_offsets = vertex_offsets;
+
+	if (scheduler)
+		scheduler(scheduler_context, optimizeVertexCachePartition, &job, partition_count);
+	else
+		for (size_t i = 0; i < partition_count; ++i)
+			optimizeVertexCachePartition(&job, i);
+}
+
+void meshopt_optimizeVertexCacheWithContext(meshopt_Context* context, unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
+{
+	meshopt::optimizeVertexCacheTable(context, destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable);
 }
 
 void meshopt_optimizeVertexCacheStrip(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
 {
-	meshopt_optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTableStrip);
+	meshopt::optimizeVertexCacheTable(NULL, destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTableStrip);
 }
 
 void meshopt_optimizeVertexCacheFifo(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int cache_size)
@@ -12,7 +12,12 @@
 #define SIMD_SSE
 #endif
 
-// An experimental implementation using AVX512 instructions; it's only enabled when AVX512 is enabled through compiler settings
+// The encoder uses SSE2 when it's available unconditionally; this includes all x64 targets
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2
+#endif
+
+// An experimental implementation using AVX512 instructions; it can be enabled through compiler settings, or selected at runtime (see SIMD_AVX_FALLBACK)
 #if defined(__AVX512VBMI2__) && defined(__AVX512VBMI__) && defined(__AVX512VL__) && defined(__POPCNT__)
 #undef SIMD_SSE
 #define SIMD_AVX
@@ -54,6 +59,16 @@
 #define SIMD_TARGET
 #endif
 
+// GCC 8+ and clang 7+ support targeting AVX512 VBMI2 from individual functions; when SSSE3 is selected at runtime, we can also select the AVX512 implementation via cpuid
+#if defined(SIMD_SSE) && defined(SIMD_FALLBACK) && ((defined(__clang__) && __clang_major__ >= 7) || (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 8))
+#define SIMD_AVX_FALLBACK
+#define SIMD_TARGET_AVX __attribute__((target("avx512vbmi2,avx512vbmi,avx512vl,avx512bw,popcnt")))
+#endif
+
+#ifndef SIMD_TARGET_AVX
+#define SIMD_TARGET_AVX
+#endif
+
 // When targeting AArch64/x64, optimize for latency to allow decoding of individual 16-byte groups to overlap
 // We don't do this for 32-bit systems because we need 64-bit math for this and this will hurt in-order CPUs
 #if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
@@ -62,6 +77,10 @@
 
 #endif // !MESHOPTIMIZER_NO_SIMD
 
+#ifdef SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef SIMD_SSE
 #include <tmmintrin.h>
 #endif
@@ -74,7 +93,7 @@
 #endif
 #endif
 
-#ifdef SIMD_AVX
+#if defined(SIMD_AVX) || defined(SIMD_AVX_FALLBACK)
 #include <immintrin.h>
 #endif
 
@@ -135,6 +154,7 @@ inline unsigned char unzigzag8(unsigned char v)
 	return -(v & 1) ^ (v >> 1);
 }
 
+#ifndef SIMD_SSE2
 static bool encodeBytesGroupZero(const unsigned char* buffer)
 {
 	for (size_t i = 0; i < kByteGroupSize; ++i)
@@ -164,6 +184,25 @@ static size_t encodeBytesGroupMeasure(const unsigned char* buffer, int bits)
 	return result;
 }
 
+static int encodeBytesGroupBits(const unsigned char* buffer, size_t& best_size)
+{
+	int best_bits = 8;
+	best_size = encodeBytesGroupMeasure(buffer, 8);
+
+	for (int bits = 1; bits < 8; bits *= 2)
+	{
+		size_t size = encodeBytesGroupMeasure(buffer, bits);
+
+		if (size < best_size)
+		{
+			best_bits = bits;
+			best_size = size;
+		}
+	}
+
+	return best_bits;
+}
+
 static unsigned char* encodeBytesGroup(unsigned char* data, const unsigned char* buffer, int bits)
 {
 	assert(bits >= 1 && bits <= 8);
@@ -210,6 +249,110 @@ static unsigned char* encodeBytesGroup(unsigned char* data, const unsigned char*
 	return data;
 }
 
+#endif
+
+#ifdef SIMD_SSE2
+static int popcount16(unsigned int mask)
+{
+	mask = mask - ((mask >> 1) & 0x5555);
+	mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+	mask = (mask + (mask >> 4)) & 0x0f0f;
+	return (mask + (mask >> 8)) & 0x1f;
+}
+
+static int encodeBytesGroupBits(const unsigned char* buffer, size_t& best_size)
+{
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xffff)
+	{
+		best_size = 0;
+		return 1;
+	}
+
+	// measure 2-bit and 4-bit encodings at once: each value at or above the sentinel takes an extra byte; v >= k is equivalent to max(v, k) == v
+	size_t size2 = kByteGroupSize * 2 / 8 + popcount16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(3)), v)));
+	size_t size4 = kByteGroupSize * 4 / 8 + popcount16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(15)), v)));
+
+	// same tie breaking as the scalar search: prefer fewer bits, and only pick a smaller encoding if it's strictly better than 8 bits
+	int best_bits = 8;
+	best_size = kByteGroupSize;
+
+	if (size2 < best_size)
+	{
+		best_bits = 2;
+		best_size = size2;
+	}
+
+	if (size4 < best_size)
+	{
+		best_bits = 4;
+		best_size = size4;
+	}
+
+	return best_bits;
+}
+
+static unsigned char* encodeBytesGroup(unsigned char* data, const unsigned char* buffer, int bits)
+{
+	assert(bits >= 1 && bits <= 8);
+
+	if (bits == 1)
+		return data;
+
+	if (bits == 8)
+	{
+		memcpy(data, buffer, kByteGroupSize);
+		return data + kByteGroupSize;
+	}
+
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+
+	// fixed portion: out-of-range values are replaced with 1...1 sentinel, which is the same as min(v, sentinel)
+	__m128i sentinel = _mm_set1_epi8(char((1 << bits) - 1));
+	__m128i enc = _mm_min_epu8(v, sentinel);
+
+	if (bits == 2)
+	{
+		// pack 4 values into each byte, first value in the high bits
+		__m128i mask = _mm_set1_epi32(0xff);
+		__m128i b0 = _mm_slli_epi32(_mm_and_si128(enc, mask), 6);
+		__m128i b1 = _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(enc, 8), mask), 4);
+		__m128i b2 = _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(enc, 16), mask), 2);
+		__m128i b3 = _mm_srli_epi32(enc, 24);
+
+		__m128i packed = _mm_or_si128(_mm_or_si128(b0, b1), _mm_or_si128(b2, b3));
+		packed = _mm_packs_epi32(packed, packed);
+		packed = _mm_packus_epi16(packed, packed);
+
+		int packed4 = _mm_cvtsi128_si32(packed);
+		memcpy(data, &packed4, 4);
+		data += 4;
+	}
+	else
+	{
+		// pack 2 values into each byte, first value in the high bits
+		__m128i b0 = _mm_slli_epi16(_mm_and_si128(enc, _mm_set1_epi16(0xff)), 4);
+		__m128i b1 = _mm_srli_epi16(enc, 8);
+
+		__m128i packed = _mm_packus_epi16(_mm_or_si128(b0, b1), _mm_setzero_si128());
+
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(data), packed);
+		data += 8;
+	}
+
+	// variable portion: full byte for each out-of-range value
+	int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(enc, sentinel));
+
+	if (mask)
+		for (size_t i = 0; i < kByteGroupSize; ++i)
+			if (mask & (1 << i))
+				*data++ = buffer[i];
+
+	return data;
+}
+#endif
+
 static unsigned char* encodeBytes(unsigned char* data, unsigned char* data_end, const unsigned char* buffer, size_t buffer_size)
 {
 	assert(buffer_size % kByteGroupSize == 0);
@@ -231,19 +374,8 @@ static unsigned char* encodeBytes(unsigned char* data, unsigned char* data_end,
 		if (size_t(data_end - data) < kByteGroupDecodeLimit)
 			return NULL;
 
-		int best_bits = 8;
-		size_t best_size = encodeBytesGroupMeasure(buffer + i, 8);
-
-		for (int bits = 1; bits < 8; bits *= 2)
-		{
-			size_t size = encodeBytesGroupMeasure(buffer + i, bits);
-
-			if (size < best_size)
-			{
-				best_bits = bits;
-				best_size = size;
-			}
-		}
+		size_t best_size = 0;
+		int best_bits = encodeBytesGroupBits(buffer + i, best_size);
 
 		int bitslog2 = (best_bits == 1) ? 0 : (best_bits == 2 ? 1 : (best_bits == 4 ? 2 : 3));
 		assert((1 << bitslog2) == best_bits);
@@ -296,6 +428,72 @@ static unsigned char* encodeVertexBlock(unsigned char* data, unsigned char* data
 	return data;
 }
 
+static const unsigned char* skipBytes(const unsigned char* data, const unsigned char* data_end, size_t buffer_size)
+{
+	assert(buffer_size % kByteGroupSize == 0);
+
+	const unsigned char* header = data;
+
+	// round number of groups to 4 to get number of header bytes
+	size_t header_size = (buffer_size / kByteGroupSize + 3) / 4;
+
+	if (size_t(data_end - data) < header_size)
+		return NULL;
+
+	data += header_size;
+
+	for (size_t i = 0; i < buffer_size; i += kByteGroupSize)
+	{
+		// same bounds check as decodeBytes so that the resulting offsets are consistent with the decoder
+		if (size_t(data_end - data) < kByteGroupDecodeLimit)
+			return NULL;
+
+		size_t header_offset = i / kByteGroupSize;
+
+		int bitslog2 = (header[header_offset / 4] >> ((header_offset % 4) * 2)) & 3;
+
+		if (bitslog2 == 0)
+			continue;
+
+		if (bitslog2 == 3)
+		{
+			data += kByteGroupSize;
+			continue;
+		}
+
+		// fixed portion is followed by a full byte for each sentinel value
+		int bits = 1 << bitslog2;
+		size_t fixed = kByteGroupSize * bits / 8;
+		unsigned char sentinel = (unsigned char)((1 << bits) - 1);
+
+		size_t count = 0;
+
+		for (size_t k = 0; k < fixed; ++k)
+			for (int j = 0; j < 8; j += bits)
+				count += ((data[k] >> j) & sentinel) == sentinel;
+
+		data += fixed + count;
+	}
+
+	return data;
+}
+
+static const unsigned char* skipVertexBlock(const unsigned char* data, const unsigned char* data_end, size_t vertex_count, size_t vertex_size)
+{
+	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
+
+	size_t vertex_count_aligned = (vertex_count + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+
+	for (size_t k = 0; k < vertex_size; ++k)
+	{
+		data = skipBytes(data, data_end, vertex_count_aligned);
+		if (!data)
+			return NULL;
+	}
+
+	return data;
+}
+
 #if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON) && !defined(SIMD_AVX) && !defined(SIMD_WASM))
 static const unsigned char* decodeBytesGroup(const unsigned char* data, unsigned char* buffer, int bitslog2)
 {
@@ -569,15 +767,16 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 }
 #endif
 
-#ifdef SIMD_AVX
-static const __m128i decodeBytesGroupConfig[] = {
-    _mm_set1_epi8(3),
-    _mm_set1_epi8(15),
-    _mm_setr_epi8(6, 4, 2, 0, 14, 12, 10, 8, 22, 20, 18, 16, 30, 28, 26, 24),
-    _mm_setr_epi8(4, 0, 12, 8, 20, 16, 28, 24, 36, 32, 44, 40, 52, 48, 60, 56),
+#if defined(SIMD_AVX) || defined(SIMD_AVX_FALLBACK)
+static const unsigned char kDecodeBytesGroupConfig[4][16] = {
+    {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3},
+    {15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15},
+    {6, 4, 2, 0, 14, 12, 10, 8, 22, 20, 18, 16, 30, 28, 26, 24},
+    {4, 0, 12, 8, 20, 16, 28, 24, 36, 32, 44, 40, 52, 48, 60, 56},
 };
 
-static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsigned char* buffer, int bitslog2)
+SIMD_TARGET_AVX
+static const unsigned char* decodeBytesGroupSimdAvx(const unsigned char* data, unsigned char* buffer, int bitslog2)
 {
 	switch (bitslog2)
 	{
@@ -598,11 +797,12 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 		__m128i selb = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
 		__m128i rest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(skip));
 
-		__m128i sent = decodeBytesGroupConfig[bitslog2 - 1];
-		__m128i ctrl = decodeBytesGroupConfig[bitslog2 + 1];
+		__m128i sent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[bitslog2 - 1]));
+		__m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[bitslog2 + 1]));
 
 		__m128i selw = _mm_shuffle_epi32(selb, 0x44);
-		__m128i sel = _mm_and_si128(sent, _mm_multishift_epi64_epi8(ctrl, selw));
+		// note: maskz form is equivalent but avoids a spurious -Wmaybe-uninitialized in gcc headers for _mm_multishift_epi64_epi8
+		__m128i sel = _mm_and_si128(sent, _mm_maskz_multishift_epi64_epi8(__mmask16(-1), ctrl, selw));
 		__mmask16 mask16 = _mm_cmp_epi8_mask(sel, sent, _MM_CMPINT_EQ);
 
 		__m128i result = _mm_mask_expand_epi8(sel, mask16, rest);
@@ -626,6 +826,13 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 		return data;
 	}
 }
+
+#ifdef SIMD_AVX
+static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsigned char* buffer, int bitslog2)
+{
+	return decodeBytesGroupSimdAvx(data, buffer, bitslog2);
+}
+#endif
 #endif
 
 #ifdef SIMD_NEON
@@ -972,8 +1179,74 @@ static const unsigned char* decodeBytesSimd(const unsigned char* data, const uns
 	return data;
 }
 
-SIMD_TARGET
-static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256])
+#ifdef SIMD_AVX_FALLBACK
+SIMD_TARGET_AVX
+static const unsigned char* decodeBytesSimdAvx(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+{
+	assert(buffer_size % kByteGroupSize == 0);
+
+	const unsigned char* header = data;
+
+	// round number of groups to 4 to get number of header bytes
+	size_t header_size = (buffer_size / kByteGroupSize + 3) / 4;
+
+	if (size_t(data_end - data) < header_size)
+		return NULL;
+
+	data += header_size;
+
+	size_t i = 0;
+
+	// fast-path: process 4 groups at a time, do a shared bounds check - each group reads <=24b
+	for (; i + kByteGroupSize * 4 <= buffer_size && size_t(data_end - data) >= kByteGroupDecodeLimit * 4; i += kByteGroupSize * 4)
+	{
+		size_t header_offset = i / kByteGroupSize;
+		unsigned char header_byte = header[header_offset / 4];
+
+		data = decodeBytesGroupSimdAvx(data, buffer + i + kByteGroupSize * 0, (header_byte >> 0) & 3);
+		data = decodeBytesGroupSimdAvx(data, buffer + i + kByteGroupSize * 1, (header_byte >> 2) & 3);
+		data = decodeBytesGroupSimdAvx(data, buffer + i + kByteGroupSize * 2, (header_byte >> 4) & 3);
+		data = decodeBytesGroupSimdAvx(data, buffer + i + kByteGroupSize * 3, (header_byte >> 6) & 3);
+	}
+
+	// slow-path: process remaining groups
+	for (; i < buffer_size; i += kByteGroupSize)
+	{
+		if (size_t(data_end - data) < kByteGroupDecodeLimit)
+			return NULL;
+
+		size_t header_offset = i / kByteGroupSize;
+
+		int bitslog2 = (header[header_offset / 4] >> ((header_offset % 4) * 2)) & 3;
+
+		data = decodeBytesGroupSimdAvx(data, buffer + i, bitslog2);
+	}
+
+	return data;
+}
+#endif
+
+// byte decoders are passed to decodeVertexBlockSimd as template arguments so that the calls in the block loop are direct and can be inlined
+struct BytesDecoder
+{
+	SIMD_TARGET static const unsigned char* decode(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+	{
+		return decodeBytesSimd(data, data_end, buffer, buffer_size);
+	}
+};
+
+#ifdef SIMD_AVX_FALLBACK
+struct BytesDecoderAvx
+{
+	SIMD_TARGET_AVX static const unsigned char* decode(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+	{
+		return decodeBytesSimdAvx(data, data_end, buffer, buffer_size);
+	}
+};
+#endif
+
+template <typename Decoder>
+SIMD_TARGET static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256])
 {
 	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
 
@@ -986,7 +1259,7 @@ static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, con
 	{
 		for (size_t j = 0; j < 4; ++j)
 		{
-			data = decodeBytesSimd(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned);
+			data = Decoder::decode(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned);
 			if (!data)
 				return NULL;
 		}
@@ -1086,9 +1359,103 @@ static unsigned int getCpuFeatures()
 static unsigned int cpuid = getCpuFeatures();
 #endif
 
+#ifdef SIMD_AVX_FALLBACK
+static bool getCpuFeaturesAvx()
+{
+	// AVX512 requires OS support for saving ZMM state (OSXSAVE + XCR0 bits 1-2 and 5-7)
+	if ((cpuid & (1 << 27)) == 0 || (cpuid & (1 << 23)) == 0)
+		return false;
+
+	if (__get_cpuid_max(0, NULL) < 7)
+		return false;
+
+	unsigned int eax, ebx, ecx, edx;
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+	unsigned int xcr0, xcr0hi;
+	__asm__("xgetbv"
+	        : "=a"(xcr0), "=d"(xcr0hi)
+	        : "c"(0));
+
+	bool avx512bw = (ebx & (1 << 30)) != 0;
+	bool avx512vl = (ebx & (1u << 31)) != 0;
+	bool avx512vbmi = (ecx & (1 << 1)) != 0;
+	bool avx512vbmi2 = (ecx & (1 << 6)) != 0;
+
+	return (xcr0 & 0xe6) == 0xe6 && avx512bw && avx512vl && avx512vbmi && avx512vbmi2;
+}
+
+static bool cpuidavx = getCpuFeaturesAvx();
+#endif
+
+typedef const unsigned char* (*DecodeVertexBlockFn)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256]);
+
+static DecodeVertexBlockFn getDecodeVertexBlock()
+{
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	assert(gDecodeBytesGroupInitialized);
+	(void)gDecodeBytesGroupInitialized;
+#endif
+
+#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+#ifdef SIMD_AVX_FALLBACK
+	if (cpuidavx)
+		return decodeVertexBlockSimd<BytesDecoderAvx>;
+#endif
+	if (cpuid & (1 << 9))
+		return decodeVertexBlockSimd<BytesDecoder>;
+
+	return decodeVertexBlock;
+#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	return decodeVertexBlockSimd<BytesDecoder>;
+#else
+	return decodeVertexBlock;
+#endif
+}
+
+static int decodeVertexVersion(unsigned char data_header)
+{
+	if ((data_header & 0xf0) != kVertexHeader)
+		return -1;
+
+	int version = data_header & 0x0f;
+	if (version > 0)
+		return -1;
+
+	return 0;
+}
+
+static int decodeVertexHeader(const unsigned char* buffer, size_t buffer_size, size_t vertex_size)
+{
+	if (buffer_size < 1 + vertex_size)
+		return -2;
+
+	return decodeVertexVersion(buffer[0]);
+}
+
+const size_t kVertexBlockIndexOffsetSize = 4;
+
+static void writeBlockOffset(unsigned char* entry, size_t offset)
+{
+	entry[0] = (unsigned char)(offset >> 0);
+	entry[1] = (unsigned char)(offset >> 8);
+	entry[2] = (unsigned char)(offset >> 16);
+	entry[3] = (unsigned char)(offset >> 24);
+}
+
+static size_t readBlockOffset(const unsigned char* entry)
+{
+	return size_t(entry[0]) | (size_t(entry[1]) << 8) | (size_t(entry[2]) << 16) | (size_t(entry[3]) << 24);
+}
+
 } // namespace meshopt
 
 size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	return meshopt_encodeVertexBlocks(buffer, buffer_size, vertices, vertex_count, vertex_size, 0, meshopt_getVertexBlockCount(vertex_count, vertex_size));
+}
+
+size_t meshopt_encodeVertexBlocks(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, size_t block_begin, size_t block_end)
 {
 	using namespace meshopt;
 
@@ -1097,30 +1464,39 @@ size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, con
 
 	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
 
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+
+	assert(block_begin <= block_end && block_end <= vertex_block_count);
+
 	unsigned char* data = buffer;
 	unsigned char* data_end = buffer + buffer_size;
 
-	if (size_t(data_end - data) < 1 + vertex_size)
-		return 0;
+	// the first range starts with the header
+	if (block_begin == 0)
+	{
+		if (size_t(data_end - data) < 1 + vertex_size)
+			return 0;
 
-	int version = gEncodeVertexVersion;
+		int version = gEncodeVertexVersion;
 
-	*data++ = (unsigned char)(kVertexHeader | version);
+		*data++ = (unsigned char)(kVertexHeader | version);
+	}
 
 	unsigned char first_vertex[256] = {};
 	if (vertex_count > 0)
 		memcpy(first_vertex, vertex_data, vertex_size);
 
+	// blocks only depend on each other through the delta baseline, which is the last vertex of the previous block
 	unsigned char last_vertex[256] = {};
-	memcpy(last_vertex, first_vertex, vertex_size);
+	memcpy(last_vertex, block_begin == 0 ? first_vertex : vertex_data + (block_begin * vertex_block_size - 1) * vertex_size, vertex_size);
 
-	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_offset = block_begin * vertex_block_size;
+	size_t vertex_end = block_end * vertex_block_size < vertex_count ? block_end * vertex_block_size : vertex_count;
 
-	size_t vertex_offset = 0;
-
-	while (vertex_offset < vertex_count)
+	while (vertex_offset < vertex_end)
 	{
-		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_end) ? vertex_block_size : vertex_end - vertex_offset;
 
 		data = encodeVertexBlock(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex);
 		if (!data)
@@ -1129,27 +1505,42 @@ size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, con
 		vertex_offset += block_size;
 	}
 
-	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+	// the last range ends with the tail
+	if (block_end == vertex_block_count)
+	{
+		size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
 
-	if (size_t(data_end - data) < tail_size)
-		return 0;
+		if (size_t(data_end - data) < tail_size)
+			return 0;
 
-	// write first vertex to the end of the stream and pad it to 32 bytes; this is important to simplify bounds checks in decoder
-	if (vertex_size < kTailMaxSize)
-	{
-		memset(data, 0, kTailMaxSize - vertex_size);
-		data += kTailMaxSize - vertex_size;
-	}
+		// write first vertex to the end of the stream and pad it to 32 bytes; this is important to simplify bounds checks in decoder
+		if (vertex_size < kTailMaxSize)
+		{
+			memset(data, 0, kTailMaxSize - vertex_size);
+			data += kTailMaxSize - vertex_size;
+		}
 
-	memcpy(data, first_vertex, vertex_size);
-	data += vertex_size;
+		memcpy(data, first_vertex, vertex_size);
+		data += vertex_size;
+	}
 
-	assert(data >= buffer + tail_size);
 	assert(data <= buffer + buffer_size);
 
 	return data - buffer;
 }
 
+size_t meshopt_getVertexBlockCount(size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+
+	return (vertex_count + vertex_block_size - 1) / vertex_block_size;
+}
+
 size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size)
 {
 	using namespace meshopt;
@@ -1175,56 +1566,200 @@ void meshopt_encodeVertexVersion(int version)
 	meshopt::gEncodeVertexVersion = version;
 }
 
-int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+namespace meshopt
 {
-	using namespace meshopt;
 
+typedef void (*DecodeFilterFn)(void*, size_t, size_t);
+
+static int decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, DecodeFilterFn filter)
+{
 	assert(vertex_size > 0 && vertex_size <= 256);
 	assert(vertex_size % 4 == 0);
 
-	const unsigned char* (*decode)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256]) = NULL;
-
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
-	decode = (cpuid & (1 << 9)) ? decodeVertexBlockSimd : decodeVertexBlock;
-#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	decode = decodeVertexBlockSimd;
-#else
-	decode = decodeVertexBlock;
-#endif
-
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	assert(gDecodeBytesGroupInitialized);
-	(void)gDecodeBytesGroupInitialized;
-#endif
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
 
 	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
 
-	const unsigned char* data = buffer;
+	int header = decodeVertexHeader(buffer, buffer_size, vertex_size);
+	if (header < 0)
+		return header;
+
+	const unsigned char* data = buffer + 1;
 	const unsigned char* data_end = buffer + buffer_size;
 
-	if (size_t(data_end - data) < 1 + vertex_size)
-		return -2;
+	unsigned char last_vertex[256];
+	memcpy(last_vertex, data_end - vertex_size, vertex_size);
 
-	unsigned char data_header = *data++;
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
 
-	if ((data_header & 0xf0) != kVertexHeader)
-		return -1;
+	size_t vertex_offset = 0;
 
-	int version = data_header & 0x0f;
-	if (version > 0)
+	while (vertex_offset < vertex_count)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+
+		data = decode(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex);
+		if (!data)
+			return -2;
+
+		// filter the block while it's still in cache; the decoder keeps its own copy of the last vertex, so this doesn't affect the next block
+		if (filter)
+			filter(vertex_data + vertex_offset * vertex_size, block_size, vertex_size);
+
+		vertex_offset += block_size;
+	}
+
+	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+
+	if (size_t(data_end - data) != tail_size)
+		return -3;
+
+	return 0;
+}
+
+} // namespace meshopt
+
+int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, buffer, buffer_size, NULL);
+}
+
+int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, meshopt_DecodeFilter filter)
+{
+	using namespace meshopt;
+
+	DecodeFilterFn filterfn = NULL;
+
+	switch (filter)
+	{
+	case meshopt_DecodeFilterNone:
+		break;
+	case meshopt_DecodeFilterOct:
+		filterfn = meshopt_decodeFilterOct;
+		break;
+	case meshopt_DecodeFilterQuat:
+		filterfn = meshopt_decodeFilterQuat;
+		break;
+	case meshopt_DecodeFilterExp:
+		filterfn = meshopt_decodeFilterExp;
+		break;
+	default:
+		assert(!"Unknown filter");
 		return -1;
+	}
 
-	unsigned char last_vertex[256];
-	memcpy(last_vertex, data_end - vertex_size, vertex_size);
+	return decodeVertexBuffer(destination, vertex_count, vertex_size, buffer, buffer_size, filterfn);
+}
+
+size_t meshopt_encodeVertexBlockIndex(unsigned char* destination, size_t destination_size, const unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+
+	if (decodeVertexHeader(buffer, buffer_size, vertex_size) < 0)
+		return 0;
+
+	const unsigned char* data = buffer + 1;
+	const unsigned char* data_end = buffer + buffer_size;
 
 	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t entry_size = kVertexBlockIndexOffsetSize + vertex_size;
 
 	size_t vertex_offset = 0;
+	size_t block_count = 0;
 
 	while (vertex_offset < vertex_count)
 	{
 		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
 
+		if (destination_size < (block_count + 1) * entry_size)
+			return 0;
+
+		unsigned char* entry = destination + block_count * entry_size;
+
+		// each seek point stores the block offset and the delta baseline that the decoder would have at this point
+		writeBlockOffset(entry, data - buffer);
+		memcpy(entry + kVertexBlockIndexOffsetSize, vertex_offset == 0 ? vertex_data : vertex_data + (vertex_offset - 1) * vertex_size, vertex_size);
+
+		data = skipVertexBlock(data, data_end, block_size, vertex_size);
+		if (!data)
+			return 0;
+
+		vertex_offset += block_size;
+		block_count++;
+	}
+
+	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+
+	if (size_t(data_end - data) != tail_size)
+		return 0;
+
+	return block_count;
+}
+
+size_t meshopt_encodeVertexBlockIndexBound(size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+
+	return vertex_block_count * (kVertexBlockIndexOffsetSize + vertex_size);
+}
+
+int meshopt_decodeVertexBlocks(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* index, size_t block_begin, size_t block_end)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+	assert(block_begin <= block_end);
+
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
+
+	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
+
+	int header = decodeVertexHeader(buffer, buffer_size, vertex_size);
+	if (header < 0)
+		return header;
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+	size_t entry_size = kVertexBlockIndexOffsetSize + vertex_size;
+
+	if (block_end > vertex_block_count)
+		return -2;
+
+	if (block_begin == block_end)
+		return 0;
+
+	const unsigned char* entry = index + block_begin * entry_size;
+	size_t offset = readBlockOffset(entry);
+
+	// the index may come from an untrusted source, so we validate the offset against the encoded stream
+	if (offset < 1 || offset > buffer_size)
+		return -2;
+
+	const unsigned char* data = buffer + offset;
+	const unsigned char* data_end = buffer + buffer_size;
+
+	unsigned char last_vertex[256];
+	memcpy(last_vertex, entry + kVertexBlockIndexOffsetSize, vertex_size);
+
+	size_t vertex_offset = block_begin * vertex_block_size;
+	size_t vertex_end = block_end * vertex_block_size < vertex_count ? block_end * vertex_block_size : vertex_count;
+
+	while (vertex_offset < vertex_end)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_end) ? vertex_block_size : vertex_end - vertex_offset;
+
 		data = decode(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex);
 		if (!data)
 			return -2;
@@ -1232,17 +1767,130 @@ int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t ve
 		vertex_offset += block_size;
 	}
 
+	// the range must end exactly where the next block starts, or at the tail for the last block
+	if (block_end == vertex_block_count)
+	{
+		size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+
+		if (size_t(data_end - data) != tail_size)
+			return -3;
+	}
+	else if (size_t(data - buffer) != readBlockOffset(index + block_end * entry_size))
+		return -3;
+
+	return 0;
+}
+
+void meshopt_initVertexDecoder(meshopt_VertexDecoder* decoder, size_t vertex_count, size_t vertex_size, const unsigned char* tail)
+{
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	decoder->vertex_count = vertex_count;
+	decoder->vertex_size = vertex_size;
+	decoder->vertex_offset = 0;
+	decoder->header = 0;
+
+	// when the first vertex isn't known yet, we decode deltas relative to it and fix the result up in meshopt_finishVertexDecoder
+	decoder->baseline = tail != NULL;
+
+	memset(decoder->last_vertex, 0, sizeof(decoder->last_vertex));
+
+	if (tail)
+		memcpy(decoder->last_vertex, tail, vertex_size);
+}
+
+int meshopt_decodeVertexBufferPartial(meshopt_VertexDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size, size_t* consumed)
+{
+	using namespace meshopt;
+
+	size_t vertex_count = decoder->vertex_count;
+	size_t vertex_size = decoder->vertex_size;
+
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
+
+	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
+
+	const unsigned char* data = buffer;
+	const unsigned char* data_end = buffer + buffer_size;
+
+	*consumed = 0;
+
+	if (!decoder->header)
+	{
+		if (buffer_size == 0)
+			return 0;
+
+		int header = decodeVertexVersion(buffer[0]);
+		if (header < 0)
+			return header;
+
+		decoder->header = 1;
+		data++;
+	}
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+
+	size_t vertex_offset = decoder->vertex_offset;
+
+	while (vertex_offset < vertex_count)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+
+		// block decoders don't modify the output or the baseline when they run out of data, so we can simply retry once more data arrives
+		const unsigned char* next = decode(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, decoder->last_vertex);
+		if (!next)
+			break;
+
+		data = next;
+		vertex_offset += block_size;
+	}
+
+	decoder->vertex_offset = vertex_offset;
+
+	*consumed = data - buffer;
+
+	return 0;
+}
+
+int meshopt_finishVertexDecoder(meshopt_VertexDecoder* decoder, void* destination, const unsigned char* buffer, size_t buffer_size)
+{
+	using namespace meshopt;
+
+	size_t vertex_count = decoder->vertex_count;
+	size_t vertex_size = decoder->vertex_size;
+
+	if (!decoder->header || decoder->vertex_offset < vertex_count)
+		return -2;
+
 	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
 
-	if (size_t(data_end - data) != tail_size)
+	// the remaining data must be exactly the tail
+	if (buffer_size != tail_size)
 		return -3;
 
+	if (!decoder->baseline)
+	{
+		unsigned char* vertex_data = static_cast<unsigned char*>(destination);
+		const unsigned char* first_vertex = buffer + buffer_size - vertex_size;
+
+		// delta decoding is bytewise modular addition, so we can apply the baseline after the fact
+		for (size_t i = 0; i < vertex_count; ++i)
+			for (size_t k = 0; k < vertex_size; ++k)
+				vertex_data[i * vertex_size + k] += first_vertex[k];
+
+		decoder->baseline = 1;
+	}
+
 	return 0;
 }
 
 #undef SIMD_NEON
 #undef SIMD_SSE
+#undef SIMD_SSE2
 #undef SIMD_AVX
 #undef SIMD_WASM
 #undef SIMD_FALLBACK
+#undef SIMD_AVX_FALLBACK
 #undef SIMD_TARGET
+#undef SIMD_TARGET_AVX
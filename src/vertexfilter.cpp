@@ -35,6 +35,21 @@
 #undef SIMD_SSE
 #endif
 
+// AVX2 kernels process 8 elements at a time; they are used unconditionally when AVX2 is enabled through compiler settings
+#if defined(SIMD_SSE) && defined(__AVX2__)
+#define SIMD_AVX2
+#endif
+
+// GCC 4.9+ and clang 3.8+ support targeting AVX2 from individual functions; we use a cpuid check to select AVX2 kernels at runtime
+#if defined(SIMD_SSE) && !defined(SIMD_AVX2) && ((defined(__clang__) && __clang_major__ * 100 + __clang_minor__ >= 308) || (defined(__GNUC__) && __GNUC__ * 100 + __GNUC_MINOR__ >= 409)) && (defined(__i386__) || defined(__x86_64__))
+#define SIMD_AVX2_FALLBACK
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#ifndef SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX2
+#endif
+
 #endif // !MESHOPTIMIZER_NO_SIMD
 
 #ifdef SIMD_SSE
@@ -42,6 +57,14 @@
 #include <stdint.h>
 #endif
 
+#if defined(SIMD_AVX2) || defined(SIMD_AVX2_FALLBACK)
+#include <immintrin.h>
+#endif
+
+#ifdef SIMD_AVX2_FALLBACK
+#include <cpuid.h> // __cpuid
+#endif
+
 #ifdef _MSC_VER
 #include <intrin.h>
 #endif
@@ -387,6 +410,239 @@ static void decodeFilterExpSimd(unsigned int* data, size_t count)
 }
 #endif
 
+#if defined(SIMD_AVX2) || defined(SIMD_AVX2_FALLBACK)
+// the kernels below process 8 elements at a time using the same operations as SSE kernels, so the results are identical
+// remaining elements (count is a multiple of 4) are processed with SSE kernels
+SIMD_TARGET_AVX2
+static void decodeFilterOctSimdAvx(signed char* data, size_t count)
+{
+	const __m256 sign = _mm256_set1_ps(-0.f);
+
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i n4 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&data[i * 4]));
+
+		// sign-extends each of x,y in [x y ? ?] with arithmetic shifts
+		__m256i xf = _mm256_srai_epi32(_mm256_slli_epi32(n4, 24), 24);
+		__m256i yf = _mm256_srai_epi32(_mm256_slli_epi32(n4, 16), 24);
+
+		// unpack z; note that z is unsigned so we technically don't need to sign extend it
+		__m256i zf = _mm256_srai_epi32(_mm256_slli_epi32(n4, 8), 24);
+
+		// convert x and y to floats and reconstruct z; this assumes zf encodes 1.f at the same bit count
+		__m256 x = _mm256_cvtepi32_ps(xf);
+		__m256 y = _mm256_cvtepi32_ps(yf);
+		__m256 z = _mm256_sub_ps(_mm256_cvtepi32_ps(zf), _mm256_add_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y)));
+
+		// fixup octahedral coordinates for z<0
+		__m256 t = _mm256_min_ps(z, _mm256_setzero_ps());
+
+		x = _mm256_add_ps(x, _mm256_xor_ps(t, _mm256_and_ps(x, sign)));
+		y = _mm256_add_ps(y, _mm256_xor_ps(t, _mm256_and_ps(y, sign)));
+
+		// compute normal length & scale
+		__m256 ll = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_add_ps(_mm256_mul_ps(y, y), _mm256_mul_ps(z, z)));
+		__m256 s = _mm256_mul_ps(_mm256_set1_ps(127.f), _mm256_rsqrt_ps(ll));
+
+		// rounded signed float->int
+		__m256i xr = _mm256_cvtps_epi32(_mm256_mul_ps(x, s));
+		__m256i yr = _mm256_cvtps_epi32(_mm256_mul_ps(y, s));
+		__m256i zr = _mm256_cvtps_epi32(_mm256_mul_ps(z, s));
+
+		// combine xr/yr/zr into final value
+		__m256i res = _mm256_and_si256(n4, _mm256_set1_epi32(0xff000000));
+		res = _mm256_or_si256(res, _mm256_and_si256(xr, _mm256_set1_epi32(0xff)));
+		res = _mm256_or_si256(res, _mm256_slli_epi32(_mm256_and_si256(yr, _mm256_set1_epi32(0xff)), 8));
+		res = _mm256_or_si256(res, _mm256_slli_epi32(_mm256_and_si256(zr, _mm256_set1_epi32(0xff)), 16));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&data[i * 4]), res);
+	}
+
+	decodeFilterOctSimd(data + i * 4, count - i);
+}
+
+SIMD_TARGET_AVX2
+static void decodeFilterOctSimdAvx(short* data, size_t count)
+{
+	const __m256 sign = _mm256_set1_ps(-0.f);
+
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 n4_0 = _mm256_loadu_ps(reinterpret_cast<float*>(&data[(i + 0) * 4]));
+		__m256 n4_1 = _mm256_loadu_ps(reinterpret_cast<float*>(&data[(i + 4) * 4]));
+
+		// gather both x/y 16-bit pairs in each 32-bit lane; shuffles work within 128-bit lanes, so elements are in 0 1 4 5 2 3 6 7 order
+		__m256i n4 = _mm256_castps_si256(_mm256_shuffle_ps(n4_0, n4_1, _MM_SHUFFLE(2, 0, 2, 0)));
+
+		// sign-extends each of x,y in [x y] with arithmetic shifts
+		__m256i xf = _mm256_srai_epi32(_mm256_slli_epi32(n4, 16), 16);
+		__m256i yf = _mm256_srai_epi32(n4, 16);
+
+		// unpack z; note that z is unsigned so we don't need to sign extend it
+		__m256i z4 = _mm256_castps_si256(_mm256_shuffle_ps(n4_0, n4_1, _MM_SHUFFLE(3, 1, 3, 1)));
+		__m256i zf = _mm256_and_si256(z4, _mm256_set1_epi32(0x7fff));
+
+		// convert x and y to floats and reconstruct z; this assumes zf encodes 1.f at the same bit count
+		__m256 x = _mm256_cvtepi32_ps(xf);
+		__m256 y = _mm256_cvtepi32_ps(yf);
+		__m256 z = _mm256_sub_ps(_mm256_cvtepi32_ps(zf), _mm256_add_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y)));
+
+		// fixup octahedral coordinates for z<0
+		__m256 t = _mm256_min_ps(z, _mm256_setzero_ps());
+
+		x = _mm256_add_ps(x, _mm256_xor_ps(t, _mm256_and_ps(x, sign)));
+		y = _mm256_add_ps(y, _mm256_xor_ps(t, _mm256_and_ps(y, sign)));
+
+		// compute normal length & scale
+		__m256 ll = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_add_ps(_mm256_mul_ps(y, y), _mm256_mul_ps(z, z)));
+		__m256 s = _mm256_div_ps(_mm256_set1_ps(32767.f), _mm256_sqrt_ps(ll));
+
+		// rounded signed float->int
+		__m256i xr = _mm256_cvtps_epi32(_mm256_mul_ps(x, s));
+		__m256i yr = _mm256_cvtps_epi32(_mm256_mul_ps(y, s));
+		__m256i zr = _mm256_cvtps_epi32(_mm256_mul_ps(z, s));
+
+		// mix x/z and y/0 to make 16-bit unpack easier
+		__m256i xzr = _mm256_or_si256(_mm256_and_si256(xr, _mm256_set1_epi32(0xffff)), _mm256_slli_epi32(zr, 16));
+		__m256i y0r = _mm256_and_si256(yr, _mm256_set1_epi32(0xffff));
+
+		// pack x/y/z using 16-bit unpacks; note that this has 0 where we should have .w
+		// unpacks work within 128-bit lanes as well, which restores the original element order
+		__m256i res_0 = _mm256_unpacklo_epi16(xzr, y0r);
+		__m256i res_1 = _mm256_unpackhi_epi16(xzr, y0r);
+
+		// patch in .w
+		res_0 = _mm256_or_si256(res_0, _mm256_and_si256(_mm256_castps_si256(n4_0), _mm256_set1_epi64x(0xffff000000000000)));
+		res_1 = _mm256_or_si256(res_1, _mm256_and_si256(_mm256_castps_si256(n4_1), _mm256_set1_epi64x(0xffff000000000000)));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&data[(i + 0) * 4]), res_0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&data[(i + 4) * 4]), res_1);
+	}
+
+	decodeFilterOctSimd(data + i * 4, count - i);
+}
+
+SIMD_TARGET_AVX2
+static void decodeFilterQuatSimdAvx(short* data, size_t count)
+{
+	const float scale = 1.f / sqrtf(2.f);
+
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 q4_0 = _mm256_loadu_ps(reinterpret_cast<float*>(&data[(i + 0) * 4]));
+		__m256 q4_1 = _mm256_loadu_ps(reinterpret_cast<float*>(&data[(i + 4) * 4]));
+
+		// gather both x/y 16-bit pairs in each 32-bit lane; shuffles work within 128-bit lanes, so elements are in 0 1 4 5 2 3 6 7 order
+		__m256i q4_xy = _mm256_castps_si256(_mm256_shuffle_ps(q4_0, q4_1, _MM_SHUFFLE(2, 0, 2, 0)));
+		__m256i q4_zc = _mm256_castps_si256(_mm256_shuffle_ps(q4_0, q4_1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		// sign-extends each of x,y in [x y] with arithmetic shifts
+		__m256i xf = _mm256_srai_epi32(_mm256_slli_epi32(q4_xy, 16), 16);
+		__m256i yf = _mm256_srai_epi32(q4_xy, 16);
+		__m256i zf = _mm256_srai_epi32(_mm256_slli_epi32(q4_zc, 16), 16);
+		__m256i cf = _mm256_srai_epi32(q4_zc, 16);
+
+		// get a floating-point scaler using zc with bottom 2 bits set to 1 (which represents 1.f)
+		__m256i sf = _mm256_or_si256(cf, _mm256_set1_epi32(3));
+		__m256 ss = _mm256_div_ps(_mm256_set1_ps(scale), _mm256_cvtepi32_ps(sf));
+
+		// convert x/y/z to [-1..1] (scaled...)
+		__m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(xf), ss);
+		__m256 y = _mm256_mul_ps(_mm256_cvtepi32_ps(yf), ss);
+		__m256 z = _mm256_mul_ps(_mm256_cvtepi32_ps(zf), ss);
+
+		// reconstruct w as a square root; we clamp to 0.f to avoid NaN due to precision errors
+		__m256 ww = _mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_add_ps(_mm256_mul_ps(y, y), _mm256_mul_ps(z, z))));
+		__m256 w = _mm256_sqrt_ps(_mm256_max_ps(ww, _mm256_setzero_ps()));
+
+		__m256 s = _mm256_set1_ps(32767.f);
+
+		// rounded signed float->int
+		__m256i xr = _mm256_cvtps_epi32(_mm256_mul_ps(x, s));
+		__m256i yr = _mm256_cvtps_epi32(_mm256_mul_ps(y, s));
+		__m256i zr = _mm256_cvtps_epi32(_mm256_mul_ps(z, s));
+		__m256i wr = _mm256_cvtps_epi32(_mm256_mul_ps(w, s));
+
+		// mix x/z and w/y to make 16-bit unpack easier
+		__m256i xzr = _mm256_or_si256(_mm256_and_si256(xr, _mm256_set1_epi32(0xffff)), _mm256_slli_epi32(zr, 16));
+		__m256i wyr = _mm256_or_si256(_mm256_and_si256(wr, _mm256_set1_epi32(0xffff)), _mm256_slli_epi32(yr, 16));
+
+		// pack x/y/z/w using 16-bit unpacks; we pack wxyz by default (for qc=0), which restores the original element order
+		__m256i res_0 = _mm256_unpacklo_epi16(wyr, xzr);
+		__m256i res_1 = _mm256_unpackhi_epi16(wyr, xzr);
+
+		// rotate each 64-bit element left by 16*qc bits, where qc is stored in the low 2 bits of the original .w
+		__m256i rot_0 = _mm256_and_si256(_mm256_srli_epi64(_mm256_castps_si256(q4_0), 44), _mm256_set1_epi64x(0x30));
+		__m256i rot_1 = _mm256_and_si256(_mm256_srli_epi64(_mm256_castps_si256(q4_1), 44), _mm256_set1_epi64x(0x30));
+
+		res_0 = _mm256_or_si256(_mm256_sllv_epi64(res_0, rot_0), _mm256_srlv_epi64(res_0, _mm256_sub_epi64(_mm256_set1_epi64x(64), rot_0)));
+		res_1 = _mm256_or_si256(_mm256_sllv_epi64(res_1, rot_1), _mm256_srlv_epi64(res_1, _mm256_sub_epi64(_mm256_set1_epi64x(64), rot_1)));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&data[(i + 0) * 4]), res_0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&data[(i + 4) * 4]), res_1);
+	}
+
+	decodeFilterQuatSimd(data + i * 4, count - i);
+}
+
+SIMD_TARGET_AVX2
+static void decodeFilterExpSimdAvx(unsigned int* data, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&data[i]));
+
+		// decode exponent into 2^x directly
+		__m256i ef = _mm256_srai_epi32(v, 24);
+		__m256i es = _mm256_slli_epi32(_mm256_add_epi32(ef, _mm256_set1_epi32(127)), 23);
+
+		// decode 24-bit mantissa into floating-point value
+		__m256i mf = _mm256_srai_epi32(_mm256_slli_epi32(v, 8), 8);
+		__m256 m = _mm256_cvtepi32_ps(mf);
+
+		__m256 r = _mm256_mul_ps(_mm256_castsi256_ps(es), m);
+
+		_mm256_storeu_ps(reinterpret_cast<float*>(&data[i]), r);
+	}
+
+	decodeFilterExpSimd(data + i, count - i);
+}
+#endif
+
+#ifdef SIMD_AVX2_FALLBACK
+static bool getCpuFeaturesAvx2()
+{
+	unsigned int eax, ebx, ecx, edx;
+	__cpuid(1, eax, ebx, ecx, edx);
+
+	// AVX2 requires OS support for saving YMM state (OSXSAVE + XCR0 bits 1-2)
+	if ((ecx & (1 << 27)) == 0 || (ecx & (1 << 28)) == 0)
+		return false;
+
+	if (__get_cpuid_max(0, NULL) < 7)
+		return false;
+
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+	unsigned int xcr0, xcr0hi;
+	__asm__("xgetbv"
+	        : "=a"(xcr0), "=d"(xcr0hi)
+	        : "c"(0));
+
+	return (xcr0 & 6) == 6 && (ebx & (1 << 5)) != 0;
+}
+
+static bool cpuidavx2 = getCpuFeaturesAvx2();
+#endif
+
 #if defined(SIMD_NEON) && !defined(__aarch64__) && !defined(_M_ARM64)
 inline float32x4_t vsqrtq_f32(float32x4_t x)
 {
@@ -823,6 +1079,201 @@ inline float optexp2(int e)
 	return u.f;
 }
 
+#ifdef SIMD_SSE
+inline __m128i quantizeSnormSimd(__m128 v, __m128 scale)
+{
+	const __m128 sign = _mm_set1_ps(-0.f);
+
+	// matches meshopt_quantizeSnorm exactly: rounding bias is selected before clamping, and max/min map NaN to -1
+	__m128 round = _mm_or_ps(_mm_set1_ps(0.5f), _mm_andnot_ps(_mm_cmpge_ps(v, _mm_setzero_ps()), sign));
+
+	v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+
+	return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), round));
+}
+
+static void encodeFilterOctSimd(void* destination, size_t count, size_t stride, int bits, const float* data)
+{
+	const __m128 sign = _mm_set1_ps(-0.f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	const __m128 scale = _mm_set1_ps(float((1 << (bits - 1)) - 1));
+	const __m128 wscale = _mm_set1_ps(float((1 << (stride * 2 - 1)) - 1));
+
+	__m128i fo = _mm_set1_epi32(meshopt_quantizeSnorm(1.f, bits));
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128 nx = _mm_loadu_ps(&data[(i + 0) * 4]);
+		__m128 ny = _mm_loadu_ps(&data[(i + 1) * 4]);
+		__m128 nz = _mm_loadu_ps(&data[(i + 2) * 4]);
+		__m128 nw = _mm_loadu_ps(&data[(i + 3) * 4]);
+
+		// transpose to get x, y, z, w in separate registers
+		_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+		// octahedral encoding of a unit vector
+		__m128 nl = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign, nx), _mm_andnot_ps(sign, ny)), _mm_andnot_ps(sign, nz));
+		__m128 ns = _mm_and_ps(_mm_div_ps(one, nl), _mm_cmpneq_ps(nl, zero));
+
+		nx = _mm_mul_ps(nx, ns);
+		ny = _mm_mul_ps(ny, ns);
+
+		// fold lower hemisphere; note that the sign is +1 for +0 and -1 for NaN, same as scalar comparisons
+		__m128 sx = _mm_or_ps(one, _mm_andnot_ps(_mm_cmpge_ps(nx, zero), sign));
+		__m128 sy = _mm_or_ps(one, _mm_andnot_ps(_mm_cmpge_ps(ny, zero), sign));
+
+		__m128 zp = _mm_cmpge_ps(nz, zero);
+
+		__m128 ur = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, ny)), sx);
+		__m128 vr = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, nx)), sy);
+
+		__m128 u = _mm_or_ps(_mm_and_ps(zp, nx), _mm_andnot_ps(zp, ur));
+		__m128 v = _mm_or_ps(_mm_and_ps(zp, ny), _mm_andnot_ps(zp, vr));
+
+		__m128i fu = quantizeSnormSimd(u, scale);
+		__m128i fv = quantizeSnormSimd(v, scale);
+		__m128i fw = quantizeSnormSimd(nw, wscale);
+
+		if (stride == 4)
+		{
+			// pack 8-bit components with truncation, same as scalar casts
+			const __m128i mask = _mm_set1_epi32(0xff);
+
+			__m128i res = _mm_or_si128(_mm_and_si128(fu, mask), _mm_slli_epi32(_mm_and_si128(fv, mask), 8));
+			res = _mm_or_si128(res, _mm_slli_epi32(_mm_and_si128(fo, mask), 16));
+			res = _mm_or_si128(res, _mm_slli_epi32(fw, 24));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(static_cast<signed char*>(destination) + i * 4), res);
+		}
+		else
+		{
+			// pack 16-bit components with truncation, same as scalar casts
+			const __m128i mask = _mm_set1_epi32(0xffff);
+
+			__m128i res0 = _mm_or_si128(_mm_and_si128(fu, mask), _mm_slli_epi32(fv, 16));
+			__m128i res1 = _mm_or_si128(_mm_and_si128(fo, mask), _mm_slli_epi32(fw, 16));
+
+			short* out = static_cast<short*>(destination) + i * 4;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[0]), _mm_unpacklo_epi32(res0, res1));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[8]), _mm_unpackhi_epi32(res0, res1));
+		}
+	}
+}
+
+static void encodeFilterQuatSimd(short* destination, size_t count, int bits, const float* data)
+{
+	const __m128 sign = _mm_set1_ps(-0.f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	const __m128 scale = _mm_set1_ps(float((1 << (bits - 1)) - 1));
+	const __m128 scaler = _mm_set1_ps(sqrtf(2.f));
+
+	__m128i fo = _mm_set1_epi32(meshopt_quantizeSnorm(1.f, bits) & ~3);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128 q0 = _mm_loadu_ps(&data[(i + 0) * 4]);
+		__m128 q1 = _mm_loadu_ps(&data[(i + 1) * 4]);
+		__m128 q2 = _mm_loadu_ps(&data[(i + 2) * 4]);
+		__m128 q3 = _mm_loadu_ps(&data[(i + 3) * 4]);
+
+		// transpose to get x, y, z, w in separate registers
+		_MM_TRANSPOSE4_PS(q0, q1, q2, q3);
+
+		// establish maximum quaternion component; strict comparisons keep the first maximum, same as scalar code
+		__m128 qm = q0;
+		__m128 am = _mm_andnot_ps(sign, q0);
+		__m128i qc = _mm_setzero_si128();
+
+		__m128 c1 = _mm_cmpgt_ps(_mm_andnot_ps(sign, q1), am);
+		am = _mm_or_ps(_mm_and_ps(c1, _mm_andnot_ps(sign, q1)), _mm_andnot_ps(c1, am));
+		qm = _mm_or_ps(_mm_and_ps(c1, q1), _mm_andnot_ps(c1, qm));
+		qc = _mm_or_si128(_mm_and_si128(_mm_castps_si128(c1), _mm_set1_epi32(1)), _mm_andnot_si128(_mm_castps_si128(c1), qc));
+
+		__m128 c2 = _mm_cmpgt_ps(_mm_andnot_ps(sign, q2), am);
+		am = _mm_or_ps(_mm_and_ps(c2, _mm_andnot_ps(sign, q2)), _mm_andnot_ps(c2, am));
+		qm = _mm_or_ps(_mm_and_ps(c2, q2), _mm_andnot_ps(c2, qm));
+		qc = _mm_or_si128(_mm_and_si128(_mm_castps_si128(c2), _mm_set1_epi32(2)), _mm_andnot_si128(_mm_castps_si128(c2), qc));
+
+		__m128 c3 = _mm_cmpgt_ps(_mm_andnot_ps(sign, q3), am);
+		qm = _mm_or_ps(_mm_and_ps(c3, q3), _mm_andnot_ps(c3, qm));
+		qc = _mm_or_si128(_mm_and_si128(_mm_castps_si128(c3), _mm_set1_epi32(3)), _mm_andnot_si128(_mm_castps_si128(c3), qc));
+
+		// we use double-cover properties to discard the sign
+		__m128 s = _mm_or_ps(one, _mm_and_ps(_mm_cmplt_ps(qm, zero), sign));
+
+		// cyclical swizzle: select components (qc+1)&3, (qc+2)&3, (qc+3)&3 for each lane
+		__m128 m0 = _mm_castsi128_ps(_mm_cmpeq_epi32(qc, _mm_setzero_si128()));
+		__m128 m1 = _mm_castsi128_ps(_mm_cmpeq_epi32(qc, _mm_set1_epi32(1)));
+		__m128 m2 = _mm_castsi128_ps(_mm_cmpeq_epi32(qc, _mm_set1_epi32(2)));
+		__m128 m3 = _mm_castsi128_ps(_mm_cmpeq_epi32(qc, _mm_set1_epi32(3)));
+
+		__m128 r0 = _mm_or_ps(_mm_or_ps(_mm_and_ps(m0, q1), _mm_and_ps(m1, q2)), _mm_or_ps(_mm_and_ps(m2, q3), _mm_and_ps(m3, q0)));
+		__m128 r1 = _mm_or_ps(_mm_or_ps(_mm_and_ps(m0, q2), _mm_and_ps(m1, q3)), _mm_or_ps(_mm_and_ps(m2, q0), _mm_and_ps(m3, q1)));
+		__m128 r2 = _mm_or_ps(_mm_or_ps(_mm_and_ps(m0, q3), _mm_and_ps(m1, q0)), _mm_or_ps(_mm_and_ps(m2, q1), _mm_and_ps(m3, q2)));
+
+		__m128i f0 = quantizeSnormSimd(_mm_mul_ps(_mm_mul_ps(r0, scaler), s), scale);
+		__m128i f1 = quantizeSnormSimd(_mm_mul_ps(_mm_mul_ps(r1, scaler), s), scale);
+		__m128i f2 = quantizeSnormSimd(_mm_mul_ps(_mm_mul_ps(r2, scaler), s), scale);
+		__m128i f3 = _mm_or_si128(fo, qc);
+
+		// pack 16-bit components with truncation, same as scalar casts
+		const __m128i mask = _mm_set1_epi32(0xffff);
+
+		__m128i res0 = _mm_or_si128(_mm_and_si128(f0, mask), _mm_slli_epi32(f1, 16));
+		__m128i res1 = _mm_or_si128(_mm_and_si128(f2, mask), _mm_slli_epi32(f3, 16));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i * 4 + 0]), _mm_unpacklo_epi32(res0, res1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i * 4 + 8]), _mm_unpackhi_epi32(res0, res1));
+	}
+}
+
+static void encodeFilterExpSimd(unsigned int* destination, size_t count, int bits, const float* data, const int* exps, int min_exp)
+{
+	const __m128 sign = _mm_set1_ps(-0.f);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&data[i]);
+
+		__m128i exp;
+
+		if (exps)
+		{
+			exp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&exps[i]));
+		}
+		else
+		{
+			// optlog2 for each component, clamped to min_exp
+			__m128i u = _mm_castps_si128(v);
+			__m128i e = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(u, 23), _mm_set1_epi32(0xff)), _mm_set1_epi32(126));
+			e = _mm_andnot_si128(_mm_cmpeq_epi32(u, _mm_setzero_si128()), e);
+
+			__m128i me = _mm_set1_epi32(min_exp);
+			__m128i ge = _mm_cmpgt_epi32(e, me);
+			exp = _mm_or_si128(_mm_and_si128(ge, e), _mm_andnot_si128(ge, me));
+		}
+
+		// note that we additionally scale the mantissa to make it a K-bit signed integer (K-1 bits for magnitude)
+		exp = _mm_sub_epi32(exp, _mm_set1_epi32(bits - 1));
+
+		// compute renormalized rounded mantissa for each component using optexp2(-exp)
+		__m128 ms = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(127), exp), 23));
+		__m128 round = _mm_or_ps(_mm_set1_ps(0.5f), _mm_andnot_ps(_mm_cmpge_ps(v, _mm_setzero_ps()), sign));
+
+		__m128i m = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, ms), round));
+
+		__m128i res = _mm_or_si128(_mm_and_si128(m, _mm_set1_epi32((1 << 24) - 1)), _mm_slli_epi32(exp, 24));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), res);
+	}
+}
+#endif
+
 } // namespace meshopt
 
 void meshopt_decodeFilterOct(void* buffer, size_t count, size_t stride)
@@ -831,11 +1282,27 @@ void meshopt_decodeFilterOct(void* buffer, size_t count, size_t stride)
 
 	assert(stride == 4 || stride == 8);
 
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#if defined(SIMD_AVX2)
 	if (stride == 4)
-		dispatchSimd(decodeFilterOctSimd, static_cast<signed char*>(buffer), count, 4);
+		dispatchSimd(decodeFilterOctSimdAvx, static_cast<signed char*>(buffer), count, 4);
 	else
-		dispatchSimd(decodeFilterOctSimd, static_cast<short*>(buffer), count, 4);
+		dispatchSimd(decodeFilterOctSimdAvx, static_cast<short*>(buffer), count, 4);
+#elif defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	void (*oct8)(signed char*, size_t) = decodeFilterOctSimd;
+	void (*oct16)(short*, size_t) = decodeFilterOctSimd;
+
+#ifdef SIMD_AVX2_FALLBACK
+	if (cpuidavx2)
+	{
+		oct8 = decodeFilterOctSimdAvx;
+		oct16 = decodeFilterOctSimdAvx;
+	}
+#endif
+
+	if (stride == 4)
+		dispatchSimd(oct8, static_cast<signed char*>(buffer), count, 4);
+	else
+		dispatchSimd(oct16, static_cast<short*>(buffer), count, 4);
 #else
 	if (stride == 4)
 		decodeFilterOct(static_cast<signed char*>(buffer), count);
@@ -851,7 +1318,11 @@ void meshopt_decodeFilterQuat(void* buffer, size_t count, size_t stride)
 	assert(stride == 8);
 	(void)stride;
 
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#if defined(SIMD_AVX2)
+	dispatchSimd(decodeFilterQuatSimdAvx, static_cast<short*>(buffer), count, 4);
+#elif defined(SIMD_AVX2_FALLBACK)
+	dispatchSimd(cpuidavx2 ? decodeFilterQuatSimdAvx : decodeFilterQuatSimd, static_cast<short*>(buffer), count, 4);
+#elif defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
 	dispatchSimd(decodeFilterQuatSimd, static_cast<short*>(buffer), count, 4);
 #else
 	decodeFilterQuat(static_cast<short*>(buffer), count);
@@ -864,7 +1335,11 @@ void meshopt_decodeFilterExp(void* buffer, size_t count, size_t stride)
 
 	assert(stride > 0 && stride % 4 == 0);
 
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+#if defined(SIMD_AVX2)
+	dispatchSimd(decodeFilterExpSimdAvx, static_cast<unsigned int*>(buffer), count * (stride / 4), 1);
+#elif defined(SIMD_AVX2_FALLBACK)
+	dispatchSimd(cpuidavx2 ? decodeFilterExpSimdAvx : decodeFilterExpSimd, static_cast<unsigned int*>(buffer), count * (stride / 4), 1);
+#elif defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
 	dispatchSimd(decodeFilterExpSimd, static_cast<unsigned int*>(buffer), count * (stride / 4), 1);
 #else
 	decodeFilterExp(static_cast<unsigned int*>(buffer), count * (stride / 4));
@@ -873,6 +1348,8 @@ void meshopt_decodeFilterExp(void* buffer, size_t count, size_t stride)
 
 void meshopt_encodeFilterOct(void* destination, size_t count, size_t stride, int bits, const float* data)
 {
+	using namespace meshopt;
+
 	assert(stride == 4 || stride == 8);
 	assert(bits >= 1 && bits <= 16);
 
@@ -881,7 +1358,15 @@ void meshopt_encodeFilterOct(void* destination, size_t count, size_t stride, int
 
 	int bytebits = int(stride * 2);
 
-	for (size_t i = 0; i < count; ++i)
+	size_t start = 0;
+
+#ifdef SIMD_SSE
+	start = count & ~size_t(3);
+	encodeFilterOctSimd(destination, start, stride, bits, data);
+#endif
+
+	// remaining vectors are encoded with scalar code; SIMD produces the same bits
+	for (size_t i = start; i < count; ++i)
 	{
 		const float* n = &data[i * 4];
 
@@ -920,6 +1405,8 @@ void meshopt_encodeFilterOct(void* destination, size_t count, size_t stride, int
 
 void meshopt_encodeFilterQuat(void* destination_, size_t count, size_t stride, int bits, const float* data)
 {
+	using namespace meshopt;
+
 	assert(stride == 8);
 	assert(bits >= 4 && bits <= 16);
 	(void)stride;
@@ -928,7 +1415,14 @@ void meshopt_encodeFilterQuat(void* destination_, size_t count, size_t stride, i
 
 	const float scaler = sqrtf(2.f);
 
-	for (size_t i = 0; i < count; ++i)
+	size_t start = 0;
+
+#ifdef SIMD_SSE
+	start = count & ~size_t(3);
+	encodeFilterQuatSimd(destination, start, bits, data);
+#endif
+
+	for (size_t i = start; i < count; ++i)
 	{
 		const float* q = &data[i * 4];
 		short* d = &destination[i * 4];
@@ -984,7 +1478,53 @@ void meshopt_encodeFilterExp(void* destination_, size_t count, size_t stride, in
 		}
 	}
 
-	for (size_t i = 0; i < count; ++i)
+	size_t start = 0;
+
+#ifdef SIMD_SSE
+	start = count & ~size_t(3);
+
+	if (mode == meshopt_EncodeExpSeparate)
+	{
+		encodeFilterExpSimd(destination, start * stride_float, bits, data, NULL, min_exp);
+	}
+	else
+	{
+		// SIMD code processes groups of 4 vectors at a time; this requires expanding exponents for every component of the group
+		int group_exp[4 * 64];
+
+		if (mode == meshopt_EncodeExpSharedComponent)
+			for (size_t k = 0; k < 4; ++k)
+				for (size_t j = 0; j < stride_float; ++j)
+					group_exp[k * stride_float + j] = component_exp[j];
+
+		for (size_t i = 0; i < start; i += 4)
+		{
+			if (mode == meshopt_EncodeExpSharedVector)
+			{
+				for (size_t k = 0; k < 4; ++k)
+				{
+					const float* v = &data[(i + k) * stride_float];
+
+					int vector_exp = min_exp;
+
+					for (size_t j = 0; j < stride_float; ++j)
+					{
+						int e = optlog2(v[j]);
+
+						vector_exp = (vector_exp < e) ? e : vector_exp;
+					}
+
+					for (size_t j = 0; j < stride_float; ++j)
+						group_exp[k * stride_float + j] = vector_exp;
+				}
+			}
+
+			encodeFilterExpSimd(&destination[i * stride_float], 4 * stride_float, bits, &data[i * stride_float], group_exp, min_exp);
+		}
+	}
+#endif
+
+	for (size_t i = start; i < count; ++i)
 	{
 		const float* v = &data[i * stride_float];
 		unsigned int* d = &destination[i * stride_float];
@@ -1029,5 +1569,8 @@ void meshopt_encodeFilterExp(void* destination_, size_t count, size_t stride, in
 }
 
 #undef SIMD_SSE
+#undef SIMD_AVX2
+#undef SIMD_AVX2_FALLBACK
+#undef SIMD_TARGET_AVX2
 #undef SIMD_NEON
 #undef SIMD_WASM
@@ -0,0 +1,349 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+namespace meshopt
+{
+
+const size_t kWeldChunkSize = 16384;
+
+// limit the grid to 2^20 cells per axis so that cell coordinates fit into int for tiny or zero epsilons
+const float kWeldGridResolution = float(1 << 20);
+
+struct WeldJob
+{
+	const float* positions;
+	size_t positions_stride_float;
+	const float* normals;
+	size_t normals_stride_float;
+	const float* uvs;
+	size_t uvs_stride_float;
+
+	float position_epsilon2;
+	float normal_threshold;
+	float uv_epsilon;
+
+	size_t vertex_count;
+
+	float grid_origin[3];
+	float grid_scale;
+
+	const unsigned int* first;
+
+	const int* cell_keys;
+	const unsigned int* cell_table;
+	size_t cell_table_size;
+	const unsigned int* cell_offsets;
+	const unsigned int* cell_vertices;
+
+	unsigned int* leaders;
+};
+
+static unsigned int hashCell(int x, int y, int z)
+{
+	// large primes from Teschner et al. Optimized Spatial Hashing for Collision Detection of Deformable Objects
+	return (unsigned(x) * 73856093) ^ (unsigned(y) * 19349663) ^ (unsigned(z) * 83492791);
+}
+
+// returns the bucket that contains the cell, or an empty bucket where the cell can be inserted
+static size_t findCell(const unsigned int* table, size_t buckets, const int* keys, int x, int y, int z)
+{
+	assert(buckets > 0);
+	assert((buckets & (buckets - 1)) == 0);
+
+	size_t hashmod = buckets - 1;
+	size_t bucket = hashCell(x, y, z) & hashmod;
+
+	for (size_t probe = 0; probe <= hashmod; ++probe)
+	{
+		unsigned int item = table[bucket];
+
+		if (item == ~0u)
+			return bucket;
+
+		const int* key = keys + item * 3;
+
+		if (key[0] == x && key[1] == y && key[2] == z)
+			return bucket;
+
+		// hash collision, quadratic probing
+		bucket = (bucket + probe + 1) & hashmod;
+	}
+
+	assert(false && "Hash table is full"); // unreachable
+	return 0;
+}
+
+static void getCellPosition(float* result, const float* v, const float* origin, float scale)
+{
+	result[0] = (v[0] - origin[0]) * scale;
+	result[1] = (v[1] - origin[1]) * scale;
+	result[2] = (v[2] - origin[2]) * scale;
+}
+
+static bool canWeld(const WeldJob& job, unsigned int a, unsigned int b)
+{
+	const float* pa = job.positions + a * job.positions_stride_float;
+	const float* pb = job.positions + b * job.positions_stride_float;
+
+	float dx = pa[0] - pb[0], dy = pa[1] - pb[1], dz = pa[2] - pb[2];
+
+	if (dx * dx + dy * dy + dz * dz > job.position_epsilon2)
+		return false;
+
+	if (job.normals)
+	{
+		const float* na = job.normals + a * job.normals_stride_float;
+		const float* nb = job.normals + b * job.normals_stride_float;
+
+		float dot = na[0] * nb[0] + na[1] * nb[1] + na[2] * nb[2];
+		float la = na[0] * na[0] + na[1] * na[1] + na[2] * na[2];
+		float lb = nb[0] * nb[0] + nb[1] * nb[1] + nb[2] * nb[2];
+
+		// compare cosine of the angle without normalizing; exactly equal normals always pass
+		if (dot < job.normal_threshold * sqrtf(la * lb) && memcmp(na, nb, 12) != 0)
+			return false;
+	}
+
+	if (job.uvs)
+	{
+		const float* ta = job.uvs + a * job.uvs_stride_float;
+		const float* tb = job.uvs + b * job.uvs_stride_float;
+
+		if (fabsf(ta[0] - tb[0]) > job.uv_epsilon || fabsf(ta[1] - tb[1]) > job.uv_epsilon)
+			return false;
+	}
+
+	return true;
+}
+
+static void findWeldLeaders(void* data, size_t chunk)
+{
+	const WeldJob& job = *static_cast<const WeldJob*>(data);
+
+	size_t begin = chunk * kWeldChunkSize;
+	size_t end = begin + kWeldChunkSize < job.vertex_count ? begin + kWeldChunkSize : job.vertex_count;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		if (job.first[i] == ~0u)
+			continue;
+
+		float cp[3];
+		getCellPosition(cp, job.positions + i * job.positions_stride_float, job.grid_origin, job.grid_scale);
+
+		// cells are at least twice as large as the tolerance, so all candidates are in the 2x2x2 block of cells closest to the vertex
+		int cell[3], step[3];
+
+		for (int k = 0; k < 3; ++k)
+		{
+			cell[k] = int(cp[k]);
+			step[k] = (cp[k] - float(cell[k]) < 0.5f) ? -1 : 1;
+		}
+
+		// leader is the earliest used vertex within tolerance; this doesn't depend on the order vertices are processed in
+		unsigned int leader = unsigned(i);
+
+		for (int n = 0; n < 8; ++n)
+		{
+			int cx = cell[0] + ((n & 1) ? step[0] : 0);
+			int cy = cell[1] + ((n & 2) ? step[1] : 0);
+			int cz = cell[2] + ((n & 4) ? step[2] : 0);
+
+			unsigned int cell_id = job.cell_table[findCell(job.cell_table, job.cell_table_size, job.cell_keys, cx, cy, cz)];
+
+			if (cell_id == ~0u)
+				continue;
+
+			for (size_t k = job.cell_offsets[cell_id]; k < job.cell_offsets[cell_id + 1]; ++k)
+			{
+				unsigned int other = job.cell_vertices[k];
+
+				if (job.first[other] < job.first[leader] && canWeld(job, unsigned(i), other))
+					leader = other;
+			}
+		}
+
+		job.leaders[i] = leader;
+	}
+}
+
+} // namespace meshopt
+
+size_t meshopt_generateWeldRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float position_epsilon, const float* vertex_normals, size_t vertex_normals_stride, float normal_angle, const float* vertex_uvs, size_t vertex_uvs_stride, float uv_epsilon, meshopt_Scheduler scheduler, void* scheduler_context)
+{
+	using namespace meshopt;
+
+	assert(indices || index_count == vertex_count);
+	assert(!indices || index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(!vertex_normals || (vertex_normals_stride >= 12 && vertex_normals_stride <= 256 && vertex_normals_stride % sizeof(float) == 0));
+	assert(!vertex_uvs || (vertex_uvs_stride >= 8 && vertex_uvs_stride <= 256 && vertex_uvs_stride % sizeof(float) == 0));
+	assert(position_epsilon >= 0 && normal_angle >= 0 && uv_epsilon >= 0);
+
+	meshopt_Allocator allocator;
+
+	size_t positions_stride_float = vertex_positions_stride / sizeof(float);
+
+	// first occurrence of each vertex determines the output order, similarly to meshopt_generateVertexRemap
+	unsigned int* first = allocator.allocate<unsigned int>(vertex_count);
+	memset(first, -1, vertex_count * sizeof(unsigned int));
+
+	for (size_t i = index_count; i > 0; --i)
+	{
+		unsigned int index = indices ? indices[i - 1] : unsigned(i - 1);
+		assert(index < vertex_count);
+
+		first[index] = unsigned(i - 1);
+	}
+
+	// the grid cell must be at least twice as large as the position tolerance so that all candidates are in the neighboring cells
+	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		const float* v = vertex_positions + i * positions_stride_float;
+
+		for (int j = 0; j < 3; ++j)
+		{
+			minv[j] = v[j] < minv[j] ? v[j] : minv[j];
+			maxv[j] = v[j] > maxv[j] ? v[j] : maxv[j];
+		}
+	}
+
+	float extent = 0.f;
+
+	for (int j = 0; j < 3; ++j)
+		extent = (maxv[j] - minv[j]) > extent ? (maxv[j] - minv[j]) : extent;
+
+	float cell_size = position_epsilon * 2 > extent / kWeldGridResolution ? position_epsilon * 2 : extent / kWeldGridResolution;
+	float cell_scale = cell_size > 0 ? 1.f / cell_size : 0.f;
+
+	// assign cell ids to occupied cells and bucket used vertices by cell, keeping the vertex order within each cell
+	size_t cell_table_size = 1;
+	while (cell_table_size < vertex_count + vertex_count / 4)
+		cell_table_size *= 2;
+
+	unsigned int* cell_table = allocator.allocate<unsigned int>(cell_table_size);
+	memset(cell_table, -1, cell_table_size * sizeof(unsigned int));
+
+	int* cell_keys = allocator.allocate<int>(vertex_count * 3);
+	unsigned int* vertex_cell_ids = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* cell_offsets = allocator.allocate<unsigned int>(vertex_count + 1);
+	size_t cell_count = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		if (first[i] == ~0u)
+			continue;
+
+		float cp[3];
+		getCellPosition(cp, vertex_positions + i * positions_stride_float, minv, cell_scale);
+
+		int cell[3] = {int(cp[0]), int(cp[1]), int(cp[2])};
+		unsigned int* entry = &cell_table[findCell(cell_table, cell_table_size, cell_keys, cell[0], cell[1], cell[2])];
+
+		if (*entry == ~0u)
+		{
+			memcpy(cell_keys + cell_count * 3, cell, 3 * sizeof(int));
+			cell_offsets[cell_count] = 0;
+			*entry = unsigned(cell_count++);
+		}
+
+		vertex_cell_ids[i] = *entry;
+		cell_offsets[*entry]++;
+	}
+
+	unsigned int offset = 0;
+
+	for (size_t i = 0; i < cell_count; ++i)
+	{
+		unsigned int count = cell_offsets[i];
+		cell_offsets[i] = offset;
+		offset += count;
+	}
+
+	cell_offsets[cell_count] = offset;
+
+	unsigned int* cell_vertices = allocator.allocate<unsigned int>(offset > 0 ? offset : 1);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		if (first[i] != ~0u)
+			cell_vertices[cell_offsets[vertex_cell_ids[i]]++] = unsigned(i);
+
+	// restore offsets after filling the cells
+	for (size_t i = cell_count; i > 0; --i)
+		cell_offsets[i] = cell_offsets[i - 1];
+
+	cell_offsets[0] = 0;
+
+	// find the leader for each vertex in parallel; this is the expensive part that compares vertices in all neighboring cells
+	unsigned int* leaders = vertex_cell_ids; // ids are no longer necessary
+
+	WeldJob job = {};
+	job.positions = vertex_positions;
+	job.positions_stride_float = positions_stride_float;
+	job.normals = vertex_normals;
+	job.normals_stride_float = vertex_normals_stride / sizeof(float);
+	job.uvs = vertex_uvs;
+	job.uvs_stride_float = vertex_uvs_stride / sizeof(float);
+	job.position_epsilon2 = position_epsilon * position_epsilon;
+	job.normal_threshold = cosf(normal_angle);
+	job.uv_epsilon = uv_epsilon;
+	job.vertex_count = vertex_count;
+	job.grid_origin[0] = minv[0];
+	job.grid_origin[1] = minv[1];
+	job.grid_origin[2] = minv[2];
+	job.grid_scale = cell_scale;
+	job.first = first;
+	job.cell_keys = cell_keys;
+	job.cell_table = cell_table;
+	job.cell_table_size = cell_table_size;
+	job.cell_offsets = cell_offsets;
+	job.cell_vertices = cell_vertices;
+	job.leaders = leaders;
+
+	size_t chunk_count = (vertex_count + kWeldChunkSize - 1) / kWeldChunkSize;
+
+	if (scheduler)
+		scheduler(scheduler_context, findWeldLeaders, &job, chunk_count);
+	else
+		for (size_t i = 0; i < chunk_count; ++i)
+			findWeldLeaders(&job, i);
+
+	// vertices that share a leader are welded; groups are numbered in the order of first use of any of their vertices
+	unsigned int* group_first = allocator.allocate<unsigned int>(vertex_count);
+	memset(group_first, -1, vertex_count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		if (first[i] != ~0u)
+		{
+			unsigned int& gf = group_first[leaders[i]];
+			gf = first[i] < gf ? first[i] : gf;
+		}
+
+	unsigned int* group_ids = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int next_vertex = 0;
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int index = indices ? indices[i] : unsigned(i);
+		unsigned int leader = leaders[index];
+
+		if (group_first[leader] == i)
+			group_ids[leader] = next_vertex++;
+	}
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		destination[i] = first[i] == ~0u ? ~0u : group_ids[leaders[i]];
+
+	assert(next_vertex <= vertex_count);
+
+	return next_vertex;
+}
@@ -1,11 +1,14 @@
 // This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
 #include "meshoptimizer.h"
+#include "internal.h"
 
 #include <assert.h>
 #include <string.h>
 
 meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const unsigned int* indices, size_t index_count, size_t vertex_count, size_t vertex_size)
 {
+	using namespace meshopt;
+
 	assert(index_count % 3 == 0);
 	assert(vertex_size > 0 && vertex_size <= 256);
 
@@ -19,9 +22,10 @@ meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const unsigned int* ind
 	const size_t kCacheLine = 64;
 	const size_t kCacheSize = 128 * 1024;
 
-	// simple direct mapped cache; on typical mesh data this is close to 4-way cache, and this model is a gross approximation anyway
 	size_t cache[kCacheSize / kCacheLine] = {};
 
+	VertexFetchSimulator fetch = {cache, kCacheSize / kCacheLine, kCacheLine};
+
 	for (size_t i = 0; i < index_count; ++i)
 	{
 		unsigned int index = indices[i];
@@ -29,22 +33,7 @@ meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const unsigned int* ind
 
 		vertex_visited[index] = 1;
 
-		size_t start_address = index * vertex_size;
-		size_t end_address = start_address + vertex_size;
-
-		size_t start_tag = start_address / kCacheLine;
-		size_t end_tag = (end_address + kCacheLine - 1) / kCacheLine;
-
-		assert(start_tag < end_tag);
-
-		for (size_t tag = start_tag; tag < end_tag; ++tag)
-		{
-			size_t line = tag % (sizeof(cache) / sizeof(cache[0]));
-
-			// we store +1 since cache is filled with 0 by default
-			result.bytes_fetched += (cache[line] != tag + 1) * kCacheLine;
-			cache[line] = tag + 1;
-		}
+		result.bytes_fetched += unsigned(simulateVertexFetch(fetch, index * vertex_size, index * vertex_size + vertex_size));
 	}
 
 	size_t unique_vertex_count = 0;
@@ -1,12 +1,23 @@
 #include "../src/meshoptimizer.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
+#include <assert.h>
+#include <float.h>
+#include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#include "../extern/fast_obj.h"
+
+#define CGLTF_IMPLEMENTATION
+#include "../extern/cgltf.h"
+
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 
@@ -161,15 +172,901 @@ void benchFilters(size_t count, double& besto8, double& besto12, double& bestq12
 	}
 }
 
+// The benchmark suite below runs every hot library function on real or synthetic meshes.
+// ISA selection is compile-time in the library, so different paths are measured by building with different configs (see Makefile).
+static const char* getIsa()
+{
+#if defined(MESHOPTIMIZER_NO_SIMD)
+	return "scalar";
+#elif defined(__wasm_simd128__)
+	return "wasm-simd";
+#elif defined(__wasm__)
+	return "wasm";
+#elif defined(__AVX512VBMI2__) && defined(__AVX512VBMI__) && defined(__AVX512VL__) && defined(__POPCNT__)
+	return "avx512";
+#elif defined(__AVX__) || defined(__SSSE3__)
+	return "sse";
+#elif defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+	return "sse-cpuid";
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(_M_ARM) || defined(_M_ARM64)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+struct PackedVertex
+{
+	uint16_t p[4];
+	int8_t n[4];
+	uint16_t t[2];
+	uint16_t pad[2];
+};
+
+struct Mesh
+{
+	std::string name;
+
+	std::vector<float> positions; // 3 floats per vertex
+	std::vector<float> attributes; // normal and uv, 5 floats per vertex
+	std::vector<unsigned int> indices;
+
+	// derived data, in the form that gltfpack produces and runtimes consume
+	std::vector<unsigned int> optimized;
+	std::vector<float> optimized_positions;
+	std::vector<PackedVertex> vertices;
+	std::vector<float> corners; // unindexed positions and attributes
+
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+
+	std::vector<unsigned char> vertex_encoded;
+	std::vector<unsigned char> index_encoded;
+	std::vector<unsigned char> sequence_encoded;
+	std::vector<unsigned char> meshlet_encoded;
+
+	std::vector<unsigned char> oct8, oct12, quat12, exp;
+};
+
+// per-thread buffers, allocated before timing starts
+struct Scratch
+{
+	std::vector<unsigned int> indices;
+	std::vector<unsigned int> remap;
+	std::vector<PackedVertex> vertices;
+	std::vector<unsigned char> bytes;
+
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+
+	std::vector<unsigned int> optimized_vertices;
+	std::vector<unsigned char> optimized_triangles;
+
+	std::vector<unsigned char> oct8, oct12, quat12, exp;
+
+	float sink;
+};
+
+const size_t kMeshletMaxVertices = 64;
+const size_t kMeshletMaxTriangles = 124;
+
+static size_t getVertexCount(const Mesh& mesh)
+{
+	return mesh.positions.size() / 3;
+}
+
+static void appendVertex(Mesh& mesh, const float* p, const float* n, const float* t)
+{
+	mesh.positions.insert(mesh.positions.end(), p, p + 3);
+	mesh.attributes.insert(mesh.attributes.end(), n, n + 3);
+	mesh.attributes.insert(mesh.attributes.end(), t, t + 2);
+}
+
+static bool loadObj(Mesh& mesh, const char* path)
+{
+	fastObjMesh* obj = fast_obj_read(path);
+	if (!obj)
+		return false;
+
+	size_t total_indices = 0;
+
+	for (unsigned int i = 0; i < obj->face_count; ++i)
+		total_indices += 3 * (obj->face_vertices[i] - 2);
+
+	size_t face_vertex_count = obj->index_count;
+
+	std::vector<unsigned int> remap(face_vertex_count);
+	size_t unique_vertices = meshopt_generateVertexRemap(&remap[0], NULL, face_vertex_count, obj->indices, face_vertex_count, sizeof(fastObjIndex));
+
+	mesh.positions.resize(unique_vertices * 3);
+	mesh.attributes.resize(unique_vertices * 5);
+	mesh.indices.resize(total_indices);
+
+	for (unsigned int vi = 0; vi < face_vertex_count; ++vi)
+	{
+		unsigned int target = remap[vi];
+		fastObjIndex ii = obj->indices[vi];
+
+		memcpy(&mesh.positions[target * 3], &obj->positions[ii.p * 3], 3 * sizeof(float));
+		memcpy(&mesh.attributes[target * 5 + 0], &obj->normals[ii.n * 3], 3 * sizeof(float));
+		memcpy(&mesh.attributes[target * 5 + 3], &obj->texcoords[ii.t * 2], 2 * sizeof(float));
+	}
+
+	size_t vertex_offset = 0;
+	size_t index_offset = 0;
+
+	for (unsigned int fi = 0; fi < obj->face_count; ++fi)
+	{
+		unsigned int face_vertices = obj->face_vertices[fi];
+
+		for (unsigned int vi = 2; vi < face_vertices; ++vi)
+		{
+			size_t to = index_offset + (vi - 2) * 3;
+
+			mesh.indices[to + 0] = remap[vertex_offset];
+			mesh.indices[to + 1] = remap[vertex_offset + vi - 1];
+			mesh.indices[to + 2] = remap[vertex_offset + vi];
+		}
+
+		vertex_offset += face_vertices;
+		index_offset += (face_vertices - 2) * 3;
+	}
+
+	fast_obj_destroy(obj);
+	return true;
+}
+
+static void decompressMeshopt(cgltf_data* data)
+{
+	for (size_t i = 0; i < data->buffer_views_count; ++i)
+	{
+		cgltf_buffer_view& view = data->buffer_views[i];
+
+		if (!view.has_meshopt_compression || !view.meshopt_compression.buffer->data)
+			continue;
+
+		const cgltf_meshopt_compression& mc = view.meshopt_compression;
+		const unsigned char* source = static_cast<const unsigned char*>(mc.buffer->data) + mc.offset;
+
+		void* result = malloc(mc.count * mc.stride);
+		int rc = -1;
+
+		if (mc.mode == cgltf_meshopt_compression_mode_attributes)
+			rc = meshopt_decodeVertexBuffer(result, mc.count, mc.stride, source, mc.size);
+		else if (mc.mode == cgltf_meshopt_compression_mode_triangles)
+			rc = meshopt_decodeIndexBuffer(result, mc.count, mc.stride, source, mc.size);
+		else if (mc.mode == cgltf_meshopt_compression_mode_indices)
+			rc = meshopt_decodeIndexSequence(result, mc.count, mc.stride, source, mc.size);
+
+		if (rc == 0 && mc.filter == cgltf_meshopt_compression_filter_octahedral)
+			meshopt_decodeFilterOct(result, mc.count, mc.stride);
+		else if (rc == 0 && mc.filter == cgltf_meshopt_compression_filter_quaternion)
+			meshopt_decodeFilterQuat(result, mc.count, mc.stride);
+		else if (rc == 0 && mc.filter == cgltf_meshopt_compression_filter_exponential)
+			meshopt_decodeFilterExp(result, mc.count, mc.stride);
+
+		// cgltf frees view data when the scene is released
+		if (rc == 0)
+			view.data = result;
+		else
+			free(result);
+	}
+}
+
+static bool loadGltf(Mesh& mesh, const char* path)
+{
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+
+	if (cgltf_parse_file(&options, path, &data) != cgltf_result_success)
+		return false;
+
+	if (cgltf_load_buffers(&options, data, path) != cgltf_result_success)
+	{
+		cgltf_free(data);
+		return false;
+	}
+
+	decompressMeshopt(data);
+
+	// all triangle primitives are concatenated into a single mesh; node transforms are ignored since they don't affect performance
+	for (size_t mi = 0; mi < data->meshes_count; ++mi)
+		for (size_t pi = 0; pi < data->meshes[mi].primitives_count; ++pi)
+		{
+			const cgltf_primitive& prim = data->meshes[mi].primitives[pi];
+
+			const cgltf_accessor* position = NULL;
+			const cgltf_accessor* normal = NULL;
+			const cgltf_accessor* texcoord = NULL;
+
+			for (size_t ai = 0; ai < prim.attributes_count; ++ai)
+			{
+				const cgltf_attribute& attr = prim.attributes[ai];
+
+				if (attr.type == cgltf_attribute_type_position)
+					position = attr.data;
+				else if (attr.type == cgltf_attribute_type_normal)
+					normal = attr.data;
+				else if (attr.type == cgltf_attribute_type_texcoord && attr.index == 0)
+					texcoord = attr.data;
+			}
+
+			if (prim.type != cgltf_primitive_type_triangles || !position)
+				continue;
+
+			unsigned int offset = unsigned(getVertexCount(mesh));
+
+			for (size_t i = 0; i < position->count; ++i)
+			{
+				float p[3] = {}, n[3] = {0, 0, 1}, t[2] = {};
+
+				cgltf_accessor_read_float(position, i, p, 3);
+				if (normal)
+					cgltf_accessor_read_float(normal, i, n, 3);
+				if (texcoord)
+					cgltf_accessor_read_float(texcoord, i, t, 2);
+
+				appendVertex(mesh, p, n, t);
+			}
+
+			size_t index_count = prim.indices ? prim.indices->count : position->count;
+
+			for (size_t i = 0; i < index_count; ++i)
+				mesh.indices.push_back(offset + unsigned(prim.indices ? cgltf_accessor_read_index(prim.indices, i) : i));
+		}
+
+	cgltf_free(data);
+	return true;
+}
+
+static void generateGrid(Mesh& mesh, int N)
+{
+	for (int x = 0; x <= N; ++x)
+		for (int y = 0; y <= N; ++y)
+		{
+			float h = float(murmur3(x * (N + 1) + y) & 1023) / 1023.f;
+
+			float p[3] = {float(x), float(y), h};
+			float n[3] = {0, 0, 1};
+			float t[2] = {float(x) / float(N), float(y) / float(N)};
+
+			appendVertex(mesh, p, n, t);
+		}
+
+	for (int x = 0; x < N; ++x)
+		for (int y = 0; y < N; ++y)
+		{
+			unsigned int v00 = (x + 0) * (N + 1) + (y + 0);
+			unsigned int v10 = (x + 1) * (N + 1) + (y + 0);
+			unsigned int v01 = (x + 0) * (N + 1) + (y + 1);
+			unsigned int v11 = (x + 1) * (N + 1) + (y + 1);
+
+			unsigned int quad[6] = {v00, v10, v01, v01, v10, v11};
+			mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+		}
+}
+
+static void prepareMesh(Mesh& mesh)
+{
+	size_t vertex_count = getVertexCount(mesh);
+	size_t index_count = mesh.indices.size();
+
+	// reproduce the order gltfpack produces for encoding and meshlet benchmarks
+	mesh.optimized.resize(index_count);
+	meshopt_optimizeVertexCache(&mesh.optimized[0], &mesh.indices[0], index_count, vertex_count);
+
+	std::vector<unsigned int> remap(vertex_count);
+	size_t unique_vertices = meshopt_optimizeVertexFetchRemap(&remap[0], &mesh.optimized[0], index_count, vertex_count);
+	meshopt_remapIndexBuffer(&mesh.optimized[0], &mesh.optimized[0], index_count, &remap[0]);
+
+	std::vector<float> attributes(unique_vertices * 5);
+	mesh.optimized_positions.resize(unique_vertices * 3);
+	meshopt_remapVertexBuffer(&mesh.optimized_positions[0], &mesh.positions[0], vertex_count, sizeof(float) * 3, &remap[0]);
+	meshopt_remapVertexBuffer(&attributes[0], &mesh.attributes[0], vertex_count, sizeof(float) * 5, &remap[0]);
+
+	float pmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX}, pmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+	float tmin[2] = {FLT_MAX, FLT_MAX}, tmax[2] = {-FLT_MAX, -FLT_MAX};
+
+	for (size_t i = 0; i < unique_vertices; ++i)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			pmin[k] = std::min(pmin[k], mesh.optimized_positions[i * 3 + k]);
+			pmax[k] = std::max(pmax[k], mesh.optimized_positions[i * 3 + k]);
+		}
+
+		for (int k = 0; k < 2; ++k)
+		{
+			tmin[k] = std::min(tmin[k], attributes[i * 5 + 3 + k]);
+			tmax[k] = std::max(tmax[k], attributes[i * 5 + 3 + k]);
+		}
+	}
+
+	mesh.vertices.resize(unique_vertices);
+
+	for (size_t i = 0; i < unique_vertices; ++i)
+	{
+		PackedVertex& v = mesh.vertices[i];
+		const float* n = &attributes[i * 5];
+
+		for (int k = 0; k < 3; ++k)
+			v.p[k] = uint16_t(meshopt_quantizeUnorm((mesh.optimized_positions[i * 3 + k] - pmin[k]) / std::max(pmax[k] - pmin[k], FLT_MIN), 16));
+		v.p[3] = 0;
+
+		for (int k = 0; k < 3; ++k)
+			v.n[k] = int8_t(meshopt_quantizeSnorm(n[k], 8));
+		v.n[3] = 0;
+
+		for (int k = 0; k < 2; ++k)
+			v.t[k] = uint16_t(meshopt_quantizeUnorm((n[3 + k] - tmin[k]) / std::max(tmax[k] - tmin[k], FLT_MIN), 16));
+
+		v.pad[0] = v.pad[1] = 0;
+	}
+
+	mesh.corners.resize(index_count * 8);
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		memcpy(&mesh.corners[i * 8 + 0], &mesh.positions[mesh.indices[i] * 3], 3 * sizeof(float));
+		memcpy(&mesh.corners[i * 8 + 3], &mesh.attributes[mesh.indices[i] * 5], 5 * sizeof(float));
+	}
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(index_count, kMeshletMaxVertices, kMeshletMaxTriangles);
+	mesh.meshlets.resize(max_meshlets);
+	mesh.meshlet_vertices.resize(max_meshlets * kMeshletMaxVertices);
+	mesh.meshlet_triangles.resize(max_meshlets * kMeshletMaxTriangles * 3);
+
+	mesh.meshlets.resize(meshopt_buildMeshlets(&mesh.meshlets[0], &mesh.meshlet_vertices[0], &mesh.meshlet_triangles[0], &mesh.optimized[0], index_count, &mesh.optimized_positions[0], unique_vertices, sizeof(float) * 3, kMeshletMaxVertices, kMeshletMaxTriangles, 0.25f));
+
+	for (size_t i = 0; i < mesh.meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = mesh.meshlets[i];
+		meshopt_optimizeMeshlet(&mesh.meshlet_vertices[m.vertex_offset], &mesh.meshlet_triangles[m.triangle_offset], m.triangle_count, m.vertex_count);
+	}
+
+	const meshopt_Meshlet& last = mesh.meshlets.back();
+	mesh.meshlet_vertices.resize(last.vertex_offset + last.vertex_count);
+	mesh.meshlet_triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3));
+
+	mesh.vertex_encoded.resize(meshopt_encodeVertexBufferBound(unique_vertices, sizeof(PackedVertex)));
+	mesh.vertex_encoded.resize(meshopt_encodeVertexBuffer(&mesh.vertex_encoded[0], mesh.vertex_encoded.size(), &mesh.vertices[0], unique_vertices, sizeof(PackedVertex)));
+
+	mesh.index_encoded.resize(meshopt_encodeIndexBufferBound(index_count, unique_vertices));
+	mesh.index_encoded.resize(meshopt_encodeIndexBuffer(&mesh.index_encoded[0], mesh.index_encoded.size(), &mesh.optimized[0], index_count));
+
+	mesh.sequence_encoded.resize(meshopt_encodeIndexSequenceBound(mesh.meshlet_vertices.size(), unique_vertices));
+	mesh.sequence_encoded.resize(meshopt_encodeIndexSequence(&mesh.sequence_encoded[0], mesh.sequence_encoded.size(), &mesh.meshlet_vertices[0], mesh.meshlet_vertices.size()));
+
+	mesh.meshlet_encoded.resize(meshopt_encodeMeshletsBound(mesh.meshlets.size(), kMeshletMaxVertices, kMeshletMaxTriangles));
+	mesh.meshlet_encoded.resize(meshopt_encodeMeshlets(&mesh.meshlet_encoded[0], mesh.meshlet_encoded.size(), &mesh.meshlets[0], mesh.meshlets.size(), &mesh.meshlet_vertices[0], &mesh.meshlet_triangles[0]));
+
+	// filter inputs use the same data that gltfpack would filter: normals, rotations and positions
+	std::vector<float> normals(unique_vertices * 4), quats(unique_vertices * 4);
+
+	for (size_t i = 0; i < unique_vertices; ++i)
+	{
+		const float* n = &attributes[i * 5];
+		float nl = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		float ns = nl == 0.f ? 0.f : 1.f / nl;
+
+		float q[4] = {n[0] * ns, n[1] * ns, n[2] * ns, 0.f};
+
+		memcpy(&normals[i * 4], q, sizeof(q));
+		memcpy(&quats[i * 4], q, sizeof(q));
+	}
+
+	mesh.oct8.resize(unique_vertices * 4);
+	mesh.oct12.resize(unique_vertices * 8);
+	mesh.quat12.resize(unique_vertices * 8);
+	mesh.exp.resize(unique_vertices * 12);
+
+	meshopt_encodeFilterOct(&mesh.oct8[0], unique_vertices, 4, 8, &normals[0]);
+	meshopt_encodeFilterOct(&mesh.oct12[0], unique_vertices, 8, 12, &normals[0]);
+	meshopt_encodeFilterQuat(&mesh.quat12[0], unique_vertices, 8, 12, &quats[0]);
+	meshopt_encodeFilterExp(&mesh.exp[0], unique_vertices, 12, 15, &mesh.optimized_positions[0], meshopt_EncodeExpSharedComponent);
+}
+
+static void prepareScratch(Scratch& scratch, const Mesh& mesh)
+{
+	size_t vertex_count = getVertexCount(mesh);
+	size_t index_count = mesh.indices.size();
+	size_t max_meshlets = meshopt_buildMeshletsBound(index_count, kMeshletMaxVertices, kMeshletMaxTriangles);
+
+	scratch.indices.resize(index_count);
+	scratch.remap.resize(std::max(std::max(vertex_count, index_count), mesh.meshlet_vertices.size()));
+	scratch.vertices.resize(mesh.vertices.size());
+
+	size_t bytes = meshopt_encodeVertexBufferBound(mesh.vertices.size(), sizeof(PackedVertex));
+	bytes = std::max(bytes, meshopt_encodeIndexBufferBound(index_count, vertex_count));
+	bytes = std::max(bytes, meshopt_encodeIndexSequenceBound(mesh.meshlet_vertices.size(), vertex_count));
+	bytes = std::max(bytes, meshopt_encodeMeshletsBound(mesh.meshlets.size(), kMeshletMaxVertices, kMeshletMaxTriangles));
+	scratch.bytes.resize(bytes);
+
+	scratch.meshlets.resize(max_meshlets);
+	scratch.meshlet_vertices.resize(max_meshlets * kMeshletMaxVertices);
+	scratch.meshlet_triangles.resize(max_meshlets * kMeshletMaxTriangles * 3);
+
+	scratch.optimized_vertices = mesh.meshlet_vertices;
+	scratch.optimized_triangles = mesh.meshlet_triangles;
+
+	// filters are branchless, so decoding already decoded data in place has the same cost
+	scratch.oct8 = mesh.oct8;
+	scratch.oct12 = mesh.oct12;
+	scratch.quat12 = mesh.quat12;
+	scratch.exp = mesh.exp;
+
+	scratch.sink = 0;
+}
+
+static size_t runEncodeVertex(const Mesh& mesh, Scratch& s)
+{
+	meshopt_encodeVertexBuffer(&s.bytes[0], s.bytes.size(), &mesh.vertices[0], mesh.vertices.size(), sizeof(PackedVertex));
+	return mesh.vertices.size() * sizeof(PackedVertex);
+}
+
+static size_t runDecodeVertex(const Mesh& mesh, Scratch& s)
+{
+	int rc = meshopt_decodeVertexBuffer(&s.vertices[0], mesh.vertices.size(), sizeof(PackedVertex), &mesh.vertex_encoded[0], mesh.vertex_encoded.size());
+	assert(rc == 0);
+	(void)rc;
+	return mesh.vertices.size() * sizeof(PackedVertex);
+}
+
+static size_t runEncodeIndex(const Mesh& mesh, Scratch& s)
+{
+	meshopt_encodeIndexBuffer(&s.bytes[0], s.bytes.size(), &mesh.optimized[0], mesh.optimized.size());
+	return mesh.optimized.size() * 4;
+}
+
+static size_t runDecodeIndex(const Mesh& mesh, Scratch& s)
+{
+	int rc = meshopt_decodeIndexBuffer(&s.indices[0], mesh.optimized.size(), 4, &mesh.index_encoded[0], mesh.index_encoded.size());
+	assert(rc == 0);
+	(void)rc;
+	return mesh.optimized.size() * 4;
+}
+
+static size_t runEncodeIndexSequence(const Mesh& mesh, Scratch& s)
+{
+	meshopt_encodeIndexSequence(&s.bytes[0], s.bytes.size(), &mesh.meshlet_vertices[0], mesh.meshlet_vertices.size());
+	return mesh.meshlet_vertices.size() * 4;
+}
+
+static size_t runDecodeIndexSequence(const Mesh& mesh, Scratch& s)
+{
+	int rc = meshopt_decodeIndexSequence(&s.remap[0], mesh.meshlet_vertices.size(), 4, &mesh.sequence_encoded[0], mesh.sequence_encoded.size());
+	assert(rc == 0);
+	(void)rc;
+	return mesh.meshlet_vertices.size() * 4;
+}
+
+static size_t runEncodeMeshlets(const Mesh& mesh, Scratch& s)
+{
+	meshopt_encodeMeshlets(&s.bytes[0], s.bytes.size(), &mesh.meshlets[0], mesh.meshlets.size(), &mesh.meshlet_vertices[0], &mesh.meshlet_triangles[0]);
+	return mesh.meshlet_vertices.size() * 4 + mesh.meshlet_triangles.size();
+}
+
+static size_t runDecodeMeshlets(const Mesh& mesh, Scratch& s)
+{
+	int rc = meshopt_decodeMeshlets(&s.meshlets[0], mesh.meshlets.size(), &s.meshlet_vertices[0], mesh.meshlet_vertices.size(), &s.meshlet_triangles[0], mesh.meshlet_triangles.size(), &mesh.meshlet_encoded[0], mesh.meshlet_encoded.size());
+	assert(rc == 0);
+	(void)rc;
+	return mesh.meshlet_vertices.size() * 4 + mesh.meshlet_triangles.size();
+}
+
+static size_t runDecodeFilterOct8(const Mesh& mesh, Scratch& s)
+{
+	meshopt_decodeFilterOct(&s.oct8[0], mesh.vertices.size(), 4);
+	return s.oct8.size();
+}
+
+static size_t runDecodeFilterOct12(const Mesh& mesh, Scratch& s)
+{
+	meshopt_decodeFilterOct(&s.oct12[0], mesh.vertices.size(), 8);
+	return s.oct12.size();
+}
+
+static size_t runDecodeFilterQuat12(const Mesh& mesh, Scratch& s)
+{
+	meshopt_decodeFilterQuat(&s.quat12[0], mesh.vertices.size(), 8);
+	return s.quat12.size();
+}
+
+static size_t runDecodeFilterExp(const Mesh& mesh, Scratch& s)
+{
+	meshopt_decodeFilterExp(&s.exp[0], mesh.vertices.size(), 12);
+	return s.exp.size();
+}
+
+static size_t runSimplify(const Mesh& mesh, Scratch& s)
+{
+	size_t target = mesh.indices.size() / 12 * 3;
+	meshopt_simplify(&s.indices[0], &mesh.indices[0], mesh.indices.size(), &mesh.positions[0], getVertexCount(mesh), sizeof(float) * 3, target, 1e-2f, 0, &s.sink);
+	return mesh.indices.size() / 3;
+}
+
+static size_t runSimplifyWithAttributes(const Mesh& mesh, Scratch& s)
+{
+	const float weights[5] = {0.5f, 0.5f, 0.5f, 0.1f, 0.1f};
+
+	size_t target = mesh.indices.size() / 12 * 3;
+	meshopt_simplifyWithAttributes(&s.indices[0], &mesh.indices[0], mesh.indices.size(), &mesh.positions[0], getVertexCount(mesh), sizeof(float) * 3, &mesh.attributes[0], sizeof(float) * 5, weights, 5, NULL, target, 1e-2f, 0, &s.sink);
+	return mesh.indices.size() / 3;
+}
+
+static size_t runSimplifySloppy(const Mesh& mesh, Scratch& s)
+{
+	size_t target = mesh.indices.size() / 12 * 3;
+	meshopt_simplifySloppy(&s.indices[0], &mesh.indices[0], mesh.indices.size(), &mesh.positions[0], getVertexCount(mesh), sizeof(float) * 3, target, FLT_MAX, &s.sink);
+	return mesh.indices.size() / 3;
+}
+
+static size_t runSimplifyPoints(const Mesh& mesh, Scratch& s)
+{
+	size_t vertex_count = getVertexCount(mesh);
+	meshopt_simplifyPoints(&s.remap[0], &mesh.positions[0], vertex_count, sizeof(float) * 3, NULL, 0, 0.f, vertex_count / 4);
+	return mesh.indices.size() / 3;
+}
+
+static size_t runBuildMeshlets(const Mesh& mesh, Scratch& s)
+{
+	meshopt_buildMeshlets(&s.meshlets[0], &s.meshlet_vertices[0], &s.meshlet_triangles[0], &mesh.optimized[0], mesh.optimized.size(), &mesh.optimized_positions[0], mesh.vertices.size(), sizeof(float) * 3, kMeshletMaxVertices, kMeshletMaxTriangles, 0.25f);
+	return mesh.optimized.size() / 3;
+}
+
+static size_t runBuildMeshletsScan(const Mesh& mesh, Scratch& s)
+{
+	meshopt_buildMeshletsScan(&s.meshlets[0], &s.meshlet_vertices[0], &s.meshlet_triangles[0], &mesh.optimized[0], mesh.optimized.size(), mesh.vertices.size(), kMeshletMaxVertices, kMeshletMaxTriangles);
+	return mesh.optimized.size() / 3;
+}
+
+static size_t runOptimizeMeshlet(const Mesh& mesh, Scratch& s)
+{
+	for (size_t i = 0; i < mesh.meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = mesh.meshlets[i];
+		meshopt_optimizeMeshlet(&s.optimized_vertices[m.vertex_offset], &s.optimized_triangles[m.triangle_offset], m.triangle_count, m.vertex_count);
+	}
+
+	return mesh.optimized.size() / 3;
+}
+
+static size_t runComputeMeshletBounds(const Mesh& mesh, Scratch& s)
+{
+	for (size_t i = 0; i < mesh.meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = mesh.meshlets[i];
+		meshopt_Bounds bounds = meshopt_computeMeshletBounds(&mesh.meshlet_vertices[m.vertex_offset], &mesh.meshlet_triangles[m.triangle_offset], m.triangle_count, &mesh.optimized_positions[0], mesh.vertices.size(), sizeof(float) * 3);
+		s.sink += bounds.radius;
+	}
+
+	return mesh.optimized.size() / 3;
+}
+
+static size_t runOptimizeVertexCache(const Mesh& mesh, Scratch& s)
+{
+	meshopt_optimizeVertexCache(&s.indices[0], &mesh.indices[0], mesh.indices.size(), getVertexCount(mesh));
+	return mesh.indices.size() / 3;
+}
+
+static size_t runOptimizeVertexCacheStrip(const Mesh& mesh, Scratch& s)
+{
+	meshopt_optimizeVertexCacheStrip(&s.indices[0], &mesh.indices[0], mesh.indices.size(), getVertexCount(mesh));
+	return mesh.indices.size() / 3;
+}
+
+static size_t runOptimizeVertexCacheFifo(const Mesh& mesh, Scratch& s)
+{
+	meshopt_optimizeVertexCacheFifo(&s.indices[0], &mesh.indices[0], mesh.indices.size(), getVertexCount(mesh), 16);
+	return mesh.indices.size() / 3;
+}
+
+static size_t runOptimizeOverdraw(const Mesh& mesh, Scratch& s)
+{
+	meshopt_optimizeOverdraw(&s.indices[0], &mesh.optimized[0], mesh.optimized.size(), &mesh.optimized_positions[0], mesh.vertices.size(), sizeof(float) * 3, 1.05f);
+	return mesh.optimized.size() / 3;
+}
+
+static size_t runOptimizeVertexFetch(const Mesh& mesh, Scratch& s)
+{
+	meshopt_optimizeVertexFetchRemap(&s.remap[0], &mesh.indices[0], mesh.indices.size(), getVertexCount(mesh));
+	return mesh.indices.size() / 3;
+}
+
+static size_t runGenerateVertexRemap(const Mesh& mesh, Scratch& s)
+{
+	meshopt_generateVertexRemap(&s.remap[0], NULL, mesh.indices.size(), &mesh.corners[0], mesh.indices.size(), sizeof(float) * 8);
+	return mesh.indices.size() / 3;
+}
+
+struct Benchmark
+{
+	const char* category;
+	const char* name;
+	bool bytes; // throughput is measured in bytes when true, and in triangles otherwise
+
+	size_t (*run)(const Mesh& mesh, Scratch& scratch);
+};
+
+static const Benchmark kBenchmarks[] = {
+    {"codec", "encodeVertex", true, runEncodeVertex},
+    {"codec", "decodeVertex", true, runDecodeVertex},
+    {"codec", "encodeIndex", true, runEncodeIndex},
+    {"codec", "decodeIndex", true, runDecodeIndex},
+    {"codec", "encodeIndexSequence", true, runEncodeIndexSequence},
+    {"codec", "decodeIndexSequence", true, runDecodeIndexSequence},
+    {"codec", "encodeMeshlets", true, runEncodeMeshlets},
+    {"codec", "decodeMeshlets", true, runDecodeMeshlets},
+    {"filter", "decodeFilterOct8", true, runDecodeFilterOct8},
+    {"filter", "decodeFilterOct12", true, runDecodeFilterOct12},
+    {"filter", "decodeFilterQuat12", true, runDecodeFilterQuat12},
+    {"filter", "decodeFilterExp", true, runDecodeFilterExp},
+    {"simplify", "simplify", false, runSimplify},
+    {"simplify", "simplifyWithAttributes", false, runSimplifyWithAttributes},
+    {"simplify", "simplifySloppy", false, runSimplifySloppy},
+    {"simplify", "simplifyPoints", false, runSimplifyPoints},
+    {"meshlet", "buildMeshlets", false, runBuildMeshlets},
+    {"meshlet", "buildMeshletsScan", false, runBuildMeshletsScan},
+    {"meshlet", "optimizeMeshlet", false, runOptimizeMeshlet},
+    {"meshlet", "computeMeshletBounds", false, runComputeMeshletBounds},
+    {"optimize", "optimizeVertexCache", false, runOptimizeVertexCache},
+    {"optimize", "optimizeVertexCacheStrip", false, runOptimizeVertexCacheStrip},
+    {"optimize", "optimizeVertexCacheFifo", false, runOptimizeVertexCacheFifo},
+    {"optimize", "optimizeOverdraw", false, runOptimizeOverdraw},
+    {"optimize", "optimizeVertexFetch", false, runOptimizeVertexFetch},
+    {"remap", "generateVertexRemap", false, runGenerateVertexRemap},
+};
+
+struct Result
+{
+	const Benchmark* bench;
+	std::string mesh;
+
+	double throughput; // GB/s or Mtri/s, aggregated over all threads
+	double latency[4]; // min, p50, p90, p99 in milliseconds
+};
+
+static bool matchBenchmark(const Benchmark& bench, const std::string& filter)
+{
+	if (filter.empty() || filter == "all")
+		return true;
+
+	size_t offset = 0;
+
+	while (offset <= filter.size())
+	{
+		size_t end = filter.find(',', offset);
+		std::string token = filter.substr(offset, end == std::string::npos ? std::string::npos : end - offset);
+
+		if (!token.empty() && (token == bench.category || strncmp(bench.name, token.c_str(), token.size()) == 0))
+			return true;
+
+		if (end == std::string::npos)
+			break;
+
+		offset = end + 1;
+	}
+
+	return false;
+}
+
+static double getPercentile(const std::vector<double>& sorted, double p)
+{
+	size_t index = size_t(p * double(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static Result runBenchmark(const Benchmark& bench, const Mesh& mesh, std::vector<Scratch>& scratch, int iterations)
+{
+	int threads = int(scratch.size());
+	std::vector<double> samples(threads * iterations);
+	size_t work = 0;
+
+	// warm up caches and the allocator outside of the measured region
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+	for (int thread = 0; thread < threads; ++thread)
+	{
+		size_t w = bench.run(mesh, scratch[thread]);
+
+		if (thread == 0)
+			work = w;
+	}
+
+	double start = timestamp();
+
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+	for (int thread = 0; thread < threads; ++thread)
+	{
+		for (int i = 0; i < iterations; ++i)
+		{
+			double t0 = timestamp();
+			bench.run(mesh, scratch[thread]);
+			samples[thread * iterations + i] = timestamp() - t0;
+		}
+	}
+
+	double end = timestamp();
+
+	std::sort(samples.begin(), samples.end());
+
+	Result result;
+	result.bench = &bench;
+	result.mesh = mesh.name;
+	result.throughput = double(work) * threads * iterations / (end - start) / (bench.bytes ? 1024 * 1024 * 1024 : 1e6);
+	result.latency[0] = samples[0] * 1000;
+	result.latency[1] = getPercentile(samples, 0.5) * 1000;
+	result.latency[2] = getPercentile(samples, 0.9) * 1000;
+	result.latency[3] = getPercentile(samples, 0.99) * 1000;
+
+	return result;
+}
+
+static bool writeJson(const char* path, const std::vector<Result>& results, int threads, int iterations)
+{
+	FILE* out = fopen(path, "wb");
+	if (!out)
+		return false;
+
+	fprintf(out, "{\n");
+	fprintf(out, "\t\"version\": \"%d.%d\",\n", MESHOPTIMIZER_VERSION / 1000, (MESHOPTIMIZER_VERSION % 1000) / 10);
+	fprintf(out, "\t\"isa\": \"%s\",\n", getIsa());
+	fprintf(out, "\t\"threads\": %d,\n", threads);
+	fprintf(out, "\t\"iterations\": %d,\n", iterations);
+	fprintf(out, "\t\"results\": [\n");
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& r = results[i];
+
+		std::string mesh;
+		for (size_t j = 0; j < r.mesh.size(); ++j)
+		{
+			if (r.mesh[j] == '"' || r.mesh[j] == '\\')
+				mesh += '\\';
+			mesh += r.mesh[j];
+		}
+
+		fprintf(out, "\t\t{\"mesh\": \"%s\", \"category\": \"%s\", \"benchmark\": \"%s\", ", mesh.c_str(), r.bench->category, r.bench->name);
+		fprintf(out, "\"throughput\": %.4f, \"unit\": \"%s\", ", r.throughput, r.bench->bytes ? "GB/s" : "Mtri/s");
+		fprintf(out, "\"min_ms\": %.4f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f}%s\n",
+		        r.latency[0], r.latency[1], r.latency[2], r.latency[3], i + 1 < results.size() ? "," : "");
+	}
+
+	fprintf(out, "\t]\n");
+	fprintf(out, "}\n");
+
+	return fclose(out) == 0;
+}
+
+static int runSuite(const std::vector<const char*>& files, const std::string& filter, int threads, int iterations, const char* json, bool verbose)
+{
+	std::vector<Mesh> meshes(files.empty() ? 1 : files.size());
+
+	if (files.empty())
+	{
+		meshes[0].name = "grid";
+		generateGrid(meshes[0], 1000);
+	}
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		const char* path = files[i];
+		const char* ext = strrchr(path, '.');
+
+		bool ok = (ext && (strcmp(ext, ".gltf") == 0 || strcmp(ext, ".glb") == 0)) ? loadGltf(meshes[i], path) : loadObj(meshes[i], path);
+
+		if (!ok || meshes[i].indices.empty())
+		{
+			fprintf(stderr, "Error loading %s\n", path);
+			return 1;
+		}
+
+		meshes[i].name = path;
+	}
+
+#ifndef _OPENMP
+	if (threads > 1)
+	{
+		fprintf(stderr, "Warning: built without OpenMP, running on 1 thread\n");
+		threads = 1;
+	}
+#endif
+
+	printf("meshoptimizer %d.%d, isa %s, %d threads, %d iterations\n", MESHOPTIMIZER_VERSION / 1000, (MESHOPTIMIZER_VERSION % 1000) / 10, getIsa(), threads, iterations);
+
+	std::vector<Result> results;
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		Mesh& mesh = meshes[i];
+
+		prepareMesh(mesh);
+
+		printf("%s: %d vertices, %d triangles, %d meshlets\n", mesh.name.c_str(), int(getVertexCount(mesh)), int(mesh.indices.size() / 3), int(mesh.meshlets.size()));
+
+		if (verbose)
+			printf("%s: vertex data %d -> %d bytes, index data %d -> %d bytes, meshlet data %d -> %d bytes\n", mesh.name.c_str(),
+			       int(mesh.vertices.size() * sizeof(PackedVertex)), int(mesh.vertex_encoded.size()),
+			       int(mesh.optimized.size() * 4), int(mesh.index_encoded.size()),
+			       int(mesh.meshlet_vertices.size() * 4 + mesh.meshlet_triangles.size()), int(mesh.meshlet_encoded.size()));
+
+		std::vector<Scratch> scratch(threads);
+		for (int t = 0; t < threads; ++t)
+			prepareScratch(scratch[t], mesh);
+
+		for (size_t bi = 0; bi < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++bi)
+		{
+			const Benchmark& bench = kBenchmarks[bi];
+
+			if (!matchBenchmark(bench, filter))
+				continue;
+
+			Result r = runBenchmark(bench, mesh, scratch, iterations);
+			results.push_back(r);
+
+			printf("%-26s %8.2f %-6s min %8.3f ms, p50 %8.3f ms, p90 %8.3f ms, p99 %8.3f ms\n",
+			       bench.name, r.throughput, bench.bytes ? "GB/s" : "Mtri/s", r.latency[0], r.latency[1], r.latency[2], r.latency[3]);
+		}
+	}
+
+	if (json && !writeJson(json, results, threads, iterations))
+	{
+		fprintf(stderr, "Error writing %s\n", json);
+		return 1;
+	}
+
+	return 0;
+}
+
 int main(int argc, char** argv)
 {
 	meshopt_encodeIndexVersion(1);
 
 	bool verbose = false;
+	bool suite = false;
+
+	std::vector<const char*> files;
+	std::string filter;
+	int threads = 1;
+	int iterations = 10;
+	const char* json = NULL;
 
 	for (int i = 1; i < argc; ++i)
-		if (strcmp(argv[i], "-v") == 0)
+	{
+		const char* arg = argv[i];
+
+		if (strcmp(arg, "-v") == 0)
+		{
 			verbose = true;
+			continue;
+		}
+
+		// any other option selects the benchmark suite
+		suite = true;
+
+		if (strcmp(arg, "-b") == 0 && i + 1 < argc)
+			filter = argv[++i];
+		else if (strcmp(arg, "-j") == 0 && i + 1 < argc)
+			threads = std::max(atoi(argv[++i]), 1);
+		else if (strcmp(arg, "-n") == 0 && i + 1 < argc)
+			iterations = std::max(atoi(argv[++i]), 1);
+		else if (strcmp(arg, "-json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else if (arg[0] != '-')
+			files.push_back(arg);
+		else
+		{
+			fprintf(stderr, "Usage: %s [-v] [-b benchmarks] [-j threads] [-n iterations] [-json file] [files...]\n", argv[0]);
+			fprintf(stderr, "\t-b: comma-separated list of benchmark name prefixes or categories (codec, filter, simplify, meshlet, optimize, remap)\n");
+			fprintf(stderr, "\tWithout options, runs the codec and filter benchmarks on a synthetic mesh and prints a summary score\n");
+			return 1;
+		}
+	}
+
+	if (suite)
+		return runSuite(files, filter, threads, iterations, json, verbose);
 
 	const int N = 1000;
 
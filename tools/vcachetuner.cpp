@@ -11,40 +11,34 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 const int kCacheSizeMax = 16;
 const int kValenceMax = 8;
-
-namespace meshopt
-{
-	struct VertexScoreTable
-	{
-		float cache[1 + kCacheSizeMax];
-		float live[1 + kValenceMax];
-	};
-} // namespace meshopt
-
-void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt::VertexScoreTable* table);
+const int kProfileMax = 16;
 
 struct Profile
 {
+	const char* name;
 	float weight;
 	int cache, warp, triangle; // vcache tuning parameters
 	int compression;
 };
 
-Profile profiles[] =
+const Profile kProfiles[] =
 {
-	{1.f, 0, 0, 0, 0},  // Compression
-	{1.f, 0, 0, 0, 1},  // Compression w/deflate
-	// {1.f, 14, 64, 128}, // AMD GCN
-	// {1.f, 32, 32, 32},  // NVidia Pascal
-	// {1.f, 16, 32, 32}, // NVidia Kepler, Maxwell
-	// {1.f, 128, 0, 0}, // Intel
+	{"comp", 1.f, 0, 0, 0, 0},       // Compression
+	{"compz", 1.f, 0, 0, 0, 1},      // Compression w/deflate
+	{"amd", 1.f, 14, 64, 128, 0},    // AMD GCN
+	{"nvidia", 1.f, 32, 32, 32, 0},  // NVidia Pascal
+	{"kepler", 1.f, 16, 32, 32, 0},  // NVidia Kepler, Maxwell
+	{"intel", 1.f, 128, 0, 0, 0},    // Intel
 };
 
-const int Profile_Count = sizeof(profiles) / sizeof(profiles[0]);
+// profiles selected on the command line; custom profiles can be specified as cache,warp,triangle
+std::vector<Profile> profiles;
+int Profile_Count = 0;
 
 struct pcg32_random_t
 {
@@ -91,7 +85,7 @@ struct Mesh
 	size_t vertex_count;
 	std::vector<unsigned int> indices;
 
-	float metric_base[Profile_Count];
+	float metric_base[kProfileMax];
 };
 
 Mesh gridmesh(unsigned int N)
@@ -203,15 +197,15 @@ size_t compress(const std::vector<T>& data, int level = SDEFL_LVL_DEF)
 	return sdeflate(&s, &cbuf[0], reinterpret_cast<const unsigned char*>(&data[0]), int(data.size() * sizeof(T)), level);
 }
 
-void compute_metric(const State* state, const Mesh& mesh, float result[Profile_Count])
+void compute_metric(const State* state, const Mesh& mesh, float result[kProfileMax])
 {
 	std::vector<unsigned int> indices(mesh.indices.size());
 
 	if (state)
 	{
-		meshopt::VertexScoreTable table = {};
-		memcpy(table.cache + 1, state->cache, kCacheSizeMax * sizeof(float));
-		memcpy(table.live + 1, state->live, kValenceMax * sizeof(float));
+		meshopt_VertexScoreTable table = {};
+		memcpy(table.cache, state->cache, kCacheSizeMax * sizeof(float));
+		memcpy(table.live, state->live, kValenceMax * sizeof(float));
 		meshopt_optimizeVertexCacheTable(&indices[0], &mesh.indices[0], mesh.indices.size(), mesh.vertex_count, &table);
 	}
 	else
@@ -219,7 +213,9 @@ void compute_metric(const State* state, const Mesh& mesh, float result[Profile_C
 		meshopt_optimizeVertexCache(&indices[0], &mesh.indices[0], mesh.indices.size(), mesh.vertex_count);
 	}
 
-	meshopt_optimizeVertexFetch(NULL, &indices[0], indices.size(), NULL, mesh.vertex_count, 0);
+	std::vector<unsigned int> remap(mesh.vertex_count);
+	meshopt_optimizeVertexFetchRemap(&remap[0], &indices[0], indices.size(), mesh.vertex_count);
+	meshopt_remapIndexBuffer(&indices[0], &indices[0], indices.size(), &remap[0]);
 
 	std::vector<unsigned char> ibuf;
 
@@ -249,24 +245,58 @@ void compute_metric(const State* state, const Mesh& mesh, float result[Profile_C
 	}
 }
 
-float fitness_score(const State& state, const std::vector<Mesh>& meshes)
+// live scores must be positive for meshopt_optimizeVertexCacheTable
+float clamp_cache(float v)
 {
-	float result = 0;
-	float count = 0;
+	return std::max(0.f, std::min(1.f, v));
+}
 
-	for (auto& mesh : meshes)
+float clamp_live(float v)
+{
+	return std::max(1e-3f, std::min(1.f, v));
+}
+
+// computes fitness of all states; every (state, mesh) pair is evaluated as a separate work item to keep all cores busy even when mesh sizes vary
+void evaluate(std::vector<State>& states, const std::vector<Mesh>& meshes)
+{
+	std::vector<float> metrics(states.size() * meshes.size() * kProfileMax);
+
+	// evaluate large meshes first to reduce the imbalance at the end of the loop
+	std::vector<size_t> order(meshes.size());
+	for (size_t i = 0; i < meshes.size(); ++i)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [&](size_t l, size_t r) { return meshes[l].indices.size() > meshes[r].indices.size(); });
+
+	int items = int(states.size() * meshes.size());
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int item = 0; item < items; ++item)
 	{
-		float metric[Profile_Count];
-		compute_metric(&state, mesh, metric);
+		size_t mesh = order[item / states.size()];
+		size_t state = item % states.size();
 
-		for (int profile = 0; profile < Profile_Count; ++profile)
+		compute_metric(&states[state], meshes[mesh], &metrics[(state * meshes.size() + mesh) * kProfileMax]);
+	}
+
+	for (size_t i = 0; i < states.size(); ++i)
+	{
+		float result = 0;
+		float count = 0;
+
+		for (size_t j = 0; j < meshes.size(); ++j)
 		{
-			result += mesh.metric_base[profile] / metric[profile] * profiles[profile].weight;
-			count += profiles[profile].weight;
+			const float* metric = &metrics[(i * meshes.size() + j) * kProfileMax];
+
+			for (int profile = 0; profile < Profile_Count; ++profile)
+			{
+				result += meshes[j].metric_base[profile] / metric[profile] * profiles[profile].weight;
+				count += profiles[profile].weight;
+			}
 		}
-	}
 
-	return result / count;
+		states[i].fitness = result / count;
+	}
 }
 
 std::vector<State> gen0(size_t count, const std::vector<Mesh>& meshes)
@@ -278,16 +308,16 @@ std::vector<State> gen0(size_t count, const std::vector<Mesh>& meshes)
 		State state = {};
 
 		for (int j = 0; j < kCacheSizeMax; ++j)
-			state.cache[j] = rand01();
+			state.cache[j] = clamp_cache(rand01());
 
 		for (int j = 0; j < kValenceMax; ++j)
-			state.live[j] = rand01();
-
-		state.fitness = fitness_score(state, meshes);
+			state.live[j] = clamp_live(rand01());
 
 		result.push_back(state);
 	}
 
+	evaluate(result, meshes);
+
 	return result;
 }
 
@@ -316,7 +346,7 @@ std::pair<State, float> genN(std::vector<State>& seed, const std::vector<Mesh>&
 				float r = rand01();
 
 				if (r < crossover || j == rc)
-					result[i].cache[j] = std::max(0.f, std::min(1.f, seed[a].cache[j] + weight * (seed[b].cache[j] - seed[c].cache[j])));
+					result[i].cache[j] = clamp_cache(seed[a].cache[j] + weight * (seed[b].cache[j] - seed[c].cache[j]));
 				else
 					result[i].cache[j] = seed[i].cache[j];
 			}
@@ -326,7 +356,7 @@ std::pair<State, float> genN(std::vector<State>& seed, const std::vector<Mesh>&
 				float r = rand01();
 
 				if (r < crossover || j == rl)
-					result[i].live[j] = std::max(0.f, std::min(1.f, seed[a].live[j] + weight * (seed[b].live[j] - seed[c].live[j])));
+					result[i].live[j] = clamp_live(seed[a].live[j] + weight * (seed[b].live[j] - seed[c].live[j]));
 				else
 					result[i].live[j] = seed[i].live[j];
 			}
@@ -335,11 +365,7 @@ std::pair<State, float> genN(std::vector<State>& seed, const std::vector<Mesh>&
 		}
 	}
 
-	#pragma omp parallel for
-	for (size_t i = 0; i < seed.size(); ++i)
-	{
-		result[i].fitness = fitness_score(result[i], meshes);
-	}
+	evaluate(result, meshes);
 
 	State best = {};
 	float bestfit = 0;
@@ -412,13 +438,24 @@ void dump_state(const State& state)
 	printf("\n");
 }
 
+void dump_table(const State& state)
+{
+	printf("const meshopt_VertexScoreTable table = {\n    {");
+	for (int i = 0; i < kCacheSizeMax; ++i)
+		printf("%s%.3ff", i == 0 ? "" : ", ", state.cache[i]);
+	printf("},\n    {");
+	for (int i = 0; i < kValenceMax; ++i)
+		printf("%s%.3ff", i == 0 ? "" : ", ", state.live[i]);
+	printf("},\n};\n");
+}
+
 void dump_stats(const State& state, const std::vector<Mesh>& meshes)
 {
-	float improvement[Profile_Count] = {};
+	float improvement[kProfileMax] = {};
 
 	for (size_t i = 0; i < meshes.size(); ++i)
 	{
-		float metric[Profile_Count];
+		float metric[kProfileMax];
 		compute_metric(&state, meshes[i], metric);
 
 		printf(" %s", meshes[i].name);
@@ -436,25 +473,75 @@ void dump_stats(const State& state, const std::vector<Mesh>& meshes)
 	printf("\n");
 }
 
+bool parse_profile(const char* arg, Profile& result)
+{
+	for (size_t i = 0; i < sizeof(kProfiles) / sizeof(kProfiles[0]); ++i)
+		if (strcmp(kProfiles[i].name, arg) == 0)
+		{
+			result = kProfiles[i];
+			return true;
+		}
+
+	Profile custom = {arg, 1.f, 0, 0, 0, 0};
+
+	if (sscanf(arg, "%d,%d,%d", &custom.cache, &custom.warp, &custom.triangle) == 3 && custom.cache > 0)
+	{
+		result = custom;
+		return true;
+	}
+
+	return false;
+}
+
 int main(int argc, char** argv)
 {
 	meshopt_encodeIndexVersion(1);
 
 	std::vector<Mesh> meshes;
+	int generations = 0;
 
 	meshes.push_back(gridmesh(50));
 
 	for (int i = 1; i < argc; ++i)
-		meshes.push_back(objmesh(argv[i]));
+	{
+		if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+		{
+			Profile profile;
 
-	size_t total_triangles = 0;
+			if (!parse_profile(argv[++i], profile) || profiles.size() == kProfileMax)
+			{
+				printf("Unknown profile %s; expected comp, compz, amd, nvidia, kepler, intel or cache,warp,triangle\n", argv[i]);
+				return 1;
+			}
 
-	for (auto& mesh : meshes)
+			profiles.push_back(profile);
+		}
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			generations = atoi(argv[++i]);
+		}
+		else
+		{
+			meshes.push_back(objmesh(argv[i]));
+		}
+	}
+
+	if (profiles.empty())
 	{
-		compute_metric(nullptr, mesh, mesh.metric_base);
+		profiles.push_back(kProfiles[0]);
+		profiles.push_back(kProfiles[1]);
+	}
+
+	Profile_Count = int(profiles.size());
+
+	size_t total_triangles = 0;
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < int(meshes.size()); ++i)
+		compute_metric(nullptr, meshes[i], meshes[i].metric_base);
 
+	for (auto& mesh : meshes)
 		total_triangles += mesh.indices.size() / 3;
-	}
 
 	std::vector<State> pop;
 	size_t gen = 0;
@@ -462,30 +549,44 @@ int main(int argc, char** argv)
 	if (load_state("mutator.state", pop))
 	{
 		printf("Loaded %d state vectors\n", int(pop.size()));
+
+		// states saved by older versions may have zero live scores
+		for (auto& state : pop)
+			for (int j = 0; j < kValenceMax; ++j)
+				state.live[j] = clamp_live(state.live[j]);
+
+		// fitness depends on the selected profiles and meshes
+		evaluate(pop, meshes);
 	}
 	else
 	{
 		pop = gen0(95, meshes);
 	}
 
-	printf("%d meshes, %.1fM triangles\n", int(meshes.size()), double(total_triangles) / 1e6);
+	printf("%d meshes, %.1fM triangles, profiles:", int(meshes.size()), double(total_triangles) / 1e6);
+	for (auto& profile : profiles)
+		printf(" %s", profile.name);
+	printf("\n");
+
+	State best = {};
 
-	for (;;)
+	for (; generations == 0 || int(gen) < generations;)
 	{
-		auto best = genN(pop, meshes);
+		auto result = genN(pop, meshes);
+		best = result.first;
 		gen++;
 
 		if (gen % 10 == 0)
 		{
-			printf("%d: fitness %f;", int(gen), best.second);
-			dump_stats(best.first, meshes);
+			printf("%d: fitness %f;", int(gen), result.second);
+			dump_stats(best, meshes);
 		}
 		else
 		{
-			printf("%d: fitness %f\n", int(gen), best.second);
+			printf("%d: fitness %f\n", int(gen), result.second);
 		}
 
-		dump_state(best.first);
+		dump_state(best);
 
 		if (save_state("mutator.state-temp", pop) && rename("mutator.state-temp", "mutator.state") == 0)
 		{
@@ -495,4 +596,6 @@ int main(int argc, char** argv)
 			printf("ERROR: Can't save state\n");
 		}
 	}
+
+	dump_table(best);
 }